@@ -0,0 +1,272 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+/*
+ * Compares reading many keys with one statement per key against token grouped multi-key statements executed with
+ * bounded parallelism. The database is replaced by a fake handle that simulates a server with a fixed number of cores
+ * where every request costs a fixed amount of CPU time plus some time per key it reads.
+ * Usage example:
+ * ```
+ * ./clio_benchmark --benchmark_filter="CassandraRead"
+ * ```
+ */
+
+#include "data/cassandra/Error.hpp"
+#include "data/cassandra/Types.hpp"
+#include "data/cassandra/impl/ExecutionStrategy.hpp"
+#include "data/cassandra/impl/TokenBatches.hpp"
+
+#include <benchmark/benchmark.h>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/spawn.hpp>
+#include <boost/asio/thread_pool.hpp>
+#include <boost/json/object.hpp>
+#include <cassandra.h>
+#include <xrpl/basics/base_uint.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t SERVER_CORES = 4;
+constexpr std::chrono::microseconds PER_KEY_COST{1};
+constexpr std::size_t READ_BATCH_SIZE = data::cassandra::Settings::DEFAULT_READ_BATCH_SIZE;
+constexpr std::size_t MAX_READ_BATCHES_IN_FLIGHT = data::cassandra::Settings::DEFAULT_MAX_READ_BATCHES_IN_FLIGHT;
+
+struct FakeResult {};
+
+struct FakeResultOrError {
+    operator bool() const
+    {
+        return true;
+    }
+
+    static data::cassandra::CassandraError
+    error()
+    {
+        return {"<none>", CASS_OK};
+    }
+
+    static FakeResult
+    value()
+    {
+        return {};
+    }
+};
+
+struct FakeFuture {
+    static FakeResultOrError
+    get()
+    {
+        return {};
+    }
+};
+
+struct FakeFutureWithCallback : FakeFuture {};
+
+struct FakeStatement {
+    std::size_t numKeys = 1;
+};
+
+struct FakePreparedStatement {};
+
+/**
+ * @brief Stands in for the database handle; executes statements on a simulated server.
+ */
+class FakeHandle {
+    boost::asio::thread_pool& server_;
+    std::chrono::microseconds perRequestCost_;
+
+public:
+    using ResultOrErrorType = FakeResultOrError;
+    using FutureWithCallbackType = FakeFutureWithCallback;
+    using FutureType = FakeFuture;
+    using StatementType = FakeStatement;
+    using PreparedStatementType = FakePreparedStatement;
+    using ResultType = FakeResult;
+
+    FakeHandle(boost::asio::thread_pool& server, std::chrono::microseconds perRequestCost)
+        : server_{server}, perRequestCost_{perRequestCost}
+    {
+    }
+
+    FutureWithCallbackType
+    asyncExecute(StatementType const& statement, std::function<void(ResultOrErrorType)>&& cb) const
+    {
+        auto const cost = perRequestCost_ + PER_KEY_COST * statement.numKeys;
+        boost::asio::post(server_, [cost, cb = std::move(cb)]() {
+            // occupy one of the server cores for the time it takes to serve the request
+            auto const until = std::chrono::steady_clock::now() + cost;
+            while (std::chrono::steady_clock::now() < until) {
+            }
+
+            cb({});
+        });
+        return {};
+    }
+};
+
+class NoopBackendCounters {
+public:
+    using PtrType = std::shared_ptr<NoopBackendCounters>;
+
+    static PtrType
+    make()
+    {
+        return std::make_shared<NoopBackendCounters>();
+    }
+
+    void
+    registerTooBusy()
+    {
+    }
+
+    void
+    registerWriteSync(std::chrono::steady_clock::time_point /* startTime */)
+    {
+    }
+
+    void
+    registerWriteSyncRetry()
+    {
+    }
+
+    void
+    registerWriteStarted()
+    {
+    }
+
+    void
+    registerWriteFinished(std::chrono::steady_clock::time_point /* startTime */)
+    {
+    }
+
+    void
+    registerWriteRetry()
+    {
+    }
+
+    void
+    registerReadStarted(std::uint64_t /* count */)
+    {
+    }
+
+    void
+    registerReadFinished(std::chrono::steady_clock::time_point /* startTime */, std::uint64_t /* count */)
+    {
+    }
+
+    void
+    registerReadRetry(std::uint64_t /* count */)
+    {
+    }
+
+    void
+    registerReadError(std::uint64_t /* count */)
+    {
+    }
+
+    static boost::json::object
+    report()
+    {
+        return {};
+    }
+};
+
+using ExecutionStrategy = data::cassandra::impl::DefaultExecutionStrategy<FakeHandle, NoopBackendCounters>;
+
+std::vector<ripple::uint256>
+generateKeys(std::size_t numKeys)
+{
+    std::mt19937_64 gen{numKeys};  // NOLINT(cert-msc32-c,cert-msc51-cpp)
+    std::vector<ripple::uint256> keys(numKeys);
+    for (auto& key : keys) {
+        for (auto& byte : key)
+            byte = static_cast<unsigned char>(gen());
+    }
+
+    return keys;
+}
+
+template <typename FnType>
+void
+runReads(benchmark::State& state, FnType&& makeStatements, std::size_t maxInFlight)
+{
+    auto const keys = generateKeys(static_cast<std::size_t>(state.range(0)));
+    auto server = boost::asio::thread_pool{SERVER_CORES};
+    auto const handle = FakeHandle{server, std::chrono::microseconds{state.range(1)}};
+    auto strategy = ExecutionStrategy{data::cassandra::Settings{}, handle, NoopBackendCounters::make()};
+    boost::asio::io_context ctx;
+
+    for (auto _ : state) {
+        boost::asio::spawn(ctx, [&](boost::asio::yield_context yield) {
+            auto const statements = makeStatements(keys);
+            auto const results = strategy.readEach(yield, statements, std::min(maxInFlight, statements.size()));
+            benchmark::DoNotOptimize(results);
+        });
+
+        ctx.run();
+        ctx.restart();
+    }
+
+    server.join();
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void
+benchmarkReadPerKey(benchmark::State& state)
+{
+    runReads(
+        state,
+        [](auto const& keys) { return std::vector<FakeStatement>(keys.size()); },
+        std::numeric_limits<std::size_t>::max()
+    );
+}
+
+void
+benchmarkReadTokenBatches(benchmark::State& state)
+{
+    runReads(
+        state,
+        [](auto const& keys) {
+            auto const batches = data::cassandra::impl::makeTokenBatches(keys, READ_BATCH_SIZE);
+            std::vector<FakeStatement> statements;
+            statements.reserve(batches.size());
+            for (auto const& batch : batches)
+                statements.push_back(FakeStatement{.numKeys = batch.size()});
+            return statements;
+        },
+        MAX_READ_BATCHES_IN_FLIGHT
+    );
+}
+
+}  // namespace
+
+// arguments are the number of keys and the fixed cost of a request in microseconds
+BENCHMARK(benchmarkReadPerKey)->ArgsProduct({{100, 1'000, 5'000}, {0, 20}})->UseRealTime();
+BENCHMARK(benchmarkReadTokenBatches)->ArgsProduct({{100, 1'000, 5'000}, {0, 20}})->UseRealTime();
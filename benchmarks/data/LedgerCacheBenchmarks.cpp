@@ -0,0 +1,243 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+/*
+ * Compares the sharded LedgerCache with the single std::map under one std::shared_mutex it replaced as well as the
+ * memory modes of LedgerCache with each other.
+ * Usage example:
+ * ```
+ * ./clio_benchmark --benchmark_filter="LedgerCache"
+ * ```
+ */
+
+#include "data/LedgerCache.hpp"
+#include "data/Types.hpp"
+#include "util/prometheus/Prometheus.hpp"
+
+#include <benchmark/benchmark.h>
+#include <xrpl/basics/base_uint.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <shared_mutex>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t NUM_OBJECTS = 1'000'000;
+constexpr std::size_t NUM_UPDATES_PER_LEDGER = 1'000;
+constexpr std::size_t BLOB_SIZE = 128;
+constexpr int MAX_THREADS = 16;
+
+/**
+ * @brief The previous cache design: one ordered map guarded by one shared mutex.
+ */
+class MapLedgerCache {
+    struct CacheEntry {
+        uint32_t seq = 0;
+        data::Blob blob;
+    };
+
+    std::map<ripple::uint256, CacheEntry> map_;
+    mutable std::shared_mutex mtx_;
+    uint32_t latestSeq_ = 0;
+
+public:
+    void
+    update(std::vector<data::LedgerObject> const& objs, uint32_t seq, bool /* isBackground */ = false)
+    {
+        std::scoped_lock const lck{mtx_};
+        latestSeq_ = std::max(seq, latestSeq_);
+        for (auto const& obj : objs) {
+            if (obj.blob.empty()) {
+                map_.erase(obj.key);
+                continue;
+            }
+
+            auto& e = map_[obj.key];
+            if (seq > e.seq)
+                e = {seq, obj.blob};
+        }
+    }
+
+    std::optional<data::Blob>
+    get(ripple::uint256 const& key, uint32_t seq) const
+    {
+        std::shared_lock const lck{mtx_};
+        if (seq > latestSeq_)
+            return {};
+        auto e = map_.find(key);
+        if (e == map_.end() or seq < e->second.seq)
+            return {};
+        return {e->second.blob};
+    }
+
+    std::optional<data::LedgerObject>
+    getSuccessor(ripple::uint256 const& key, uint32_t seq) const
+    {
+        std::shared_lock const lck{mtx_};
+        if (seq != latestSeq_)
+            return {};
+        auto e = map_.upper_bound(key);
+        if (e == map_.end())
+            return {};
+        return {{e->first, e->second.blob}};
+    }
+
+    uint32_t
+    latestLedgerSequence() const
+    {
+        std::shared_lock const lck{mtx_};
+        return latestSeq_;
+    }
+
+    void
+    setFull()
+    {
+    }
+};
+
+/**
+ * @brief LedgerCache using the given memory mode.
+ */
+template <data::LedgerCache::MemoryMode Mode>
+struct LedgerCacheWithMode : data::LedgerCache {
+    LedgerCacheWithMode()
+    {
+        setMemoryMode(Mode);
+    }
+};
+
+using CompactLedgerCache = LedgerCacheWithMode<data::LedgerCache::MemoryMode::Compact>;
+using CompressedLedgerCache = LedgerCacheWithMode<data::LedgerCache::MemoryMode::Compressed>;
+
+std::vector<ripple::uint256> const&
+keys()
+{
+    static auto const generated = [] {
+        std::mt19937_64 gen{42};  // NOLINT(cert-msc32-c,cert-msc51-cpp)
+        std::vector<ripple::uint256> result(NUM_OBJECTS);
+        for (auto& key : result) {
+            for (auto& byte : key)
+                byte = static_cast<unsigned char>(gen());
+        }
+        return result;
+    }();
+    return generated;
+}
+
+std::vector<data::LedgerObject>
+makeObjects(std::size_t offset, std::size_t count, unsigned char fill)
+{
+    std::vector<data::LedgerObject> objs;
+    objs.reserve(count);
+    for (std::size_t i = 0; i < count; ++i)
+        objs.push_back({keys()[(offset + i) % keys().size()], data::Blob(BLOB_SIZE, fill)});
+    return objs;
+}
+
+/**
+ * @brief Lazily creates one prefilled cache of the given type shared by all benchmark threads.
+ */
+template <typename CacheType>
+CacheType&
+sharedCache()
+{
+    static auto const instance = [] {
+        PrometheusService::init();
+        auto cache = std::make_unique<CacheType>();
+        cache->update(makeObjects(0, NUM_OBJECTS, 'a'), 1);
+        cache->setFull();
+        return cache;
+    }();
+    return *instance;
+}
+
+template <typename CacheType>
+void
+benchmarkGet(benchmark::State& state)
+{
+    auto const& cache = sharedCache<CacheType>();
+    std::mt19937_64 gen{static_cast<uint64_t>(state.thread_index())};  // NOLINT(cert-msc32-c,cert-msc51-cpp)
+
+    for (auto _ : state) {
+        auto const seq = cache.latestLedgerSequence();
+        benchmark::DoNotOptimize(cache.get(keys()[gen() % keys().size()], seq));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+template <typename CacheType>
+void
+benchmarkGetSuccessor(benchmark::State& state)
+{
+    auto const& cache = sharedCache<CacheType>();
+    std::mt19937_64 gen{static_cast<uint64_t>(state.thread_index())};  // NOLINT(cert-msc32-c,cert-msc51-cpp)
+
+    for (auto _ : state) {
+        auto const seq = cache.latestLedgerSequence();
+        benchmark::DoNotOptimize(cache.getSuccessor(keys()[gen() % keys().size()], seq));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+/**
+ * @brief Thread 0 keeps applying ledgers while all other threads read.
+ */
+template <typename CacheType>
+void
+benchmarkGetWhileUpdating(benchmark::State& state)
+{
+    auto& cache = sharedCache<CacheType>();
+    std::mt19937_64 gen{static_cast<uint64_t>(state.thread_index())};  // NOLINT(cert-msc32-c,cert-msc51-cpp)
+    std::size_t offset = 0;
+
+    for (auto _ : state) {
+        if (state.thread_index() == 0) {
+            auto const objs = makeObjects(offset, NUM_UPDATES_PER_LEDGER, static_cast<unsigned char>(offset));
+            offset += NUM_UPDATES_PER_LEDGER;
+            cache.update(objs, cache.latestLedgerSequence() + 1);
+        } else {
+            auto const seq = cache.latestLedgerSequence();
+            benchmark::DoNotOptimize(cache.get(keys()[gen() % keys().size()], seq));
+        }
+    }
+
+    if (state.thread_index() != 0)
+        state.SetItemsProcessed(state.iterations());
+}
+
+}  // namespace
+
+BENCHMARK(benchmarkGet<MapLedgerCache>)->ThreadRange(1, MAX_THREADS)->UseRealTime();
+BENCHMARK(benchmarkGet<data::LedgerCache>)->ThreadRange(1, MAX_THREADS)->UseRealTime();
+BENCHMARK(benchmarkGet<CompactLedgerCache>)->ThreadRange(1, MAX_THREADS)->UseRealTime();
+BENCHMARK(benchmarkGet<CompressedLedgerCache>)->ThreadRange(1, MAX_THREADS)->UseRealTime();
+
+BENCHMARK(benchmarkGetSuccessor<MapLedgerCache>)->ThreadRange(1, MAX_THREADS)->UseRealTime();
+BENCHMARK(benchmarkGetSuccessor<data::LedgerCache>)->ThreadRange(1, MAX_THREADS)->UseRealTime();
+
+BENCHMARK(benchmarkGetWhileUpdating<MapLedgerCache>)->ThreadRange(2, MAX_THREADS)->UseRealTime();
+BENCHMARK(benchmarkGetWhileUpdating<data::LedgerCache>)->ThreadRange(2, MAX_THREADS)->UseRealTime();
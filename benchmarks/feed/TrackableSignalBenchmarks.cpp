@@ -0,0 +1,212 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+/*
+ * Measures the time to publish one message to a growing number of subscribers using the copy-on-write TrackableSignal
+ * and TrackableSignalMap, compared to the previous design built on boost::signals2 where the map lock was held while
+ * calling the slots.
+ * Usage example:
+ * ```
+ * ./clio_benchmark --benchmark_filter="TrackableSignal"
+ * ```
+ */
+
+#include "feed/impl/TrackableSignal.hpp"
+#include "feed/impl/TrackableSignalMap.hpp"
+
+#include <benchmark/benchmark.h>
+#include <boost/signals2.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+constexpr std::int64_t MIN_SUBSCRIBERS = 16;
+constexpr std::int64_t MAX_SUBSCRIBERS = 64 * 1024;
+constexpr int MAX_THREADS = 16;
+constexpr std::uint32_t KEY = 42;
+
+struct Session {
+    std::size_t received = 0;
+};
+
+/**
+ * @brief The previous TrackableSignal: a boost::signals2 signal with every slot tracking its session.
+ */
+class Signals2Signal {
+    std::unordered_map<Session*, boost::signals2::connection> connections_;
+    std::mutex mutex_;
+    boost::signals2::signal<void(std::string const&)> signal_;
+
+public:
+    bool
+    connectTrackableSlot(std::shared_ptr<Session> const& trackable, std::function<void(std::string const&)> slot)
+    {
+        std::scoped_lock const lk(mutex_);
+        if (connections_.contains(trackable.get()))
+            return false;
+
+        using SlotType = boost::signals2::signal<void(std::string const&)>::slot_type;
+        connections_.emplace(trackable.get(), signal_.connect(SlotType(slot).track_foreign(trackable)));
+        return true;
+    }
+
+    void
+    emit(std::string const& msg) const
+    {
+        signal_(msg);
+    }
+};
+
+/**
+ * @brief The previous TrackableSignalMap: the map lock is held while the slots are called.
+ */
+class Signals2SignalMap {
+    std::mutex mutex_;
+    std::unordered_map<std::uint32_t, Signals2Signal> signalsMap_;
+
+public:
+    bool
+    connectTrackableSlot(
+        std::shared_ptr<Session> const& trackable,
+        std::uint32_t key,
+        std::function<void(std::string const&)> slot
+    )
+    {
+        std::scoped_lock const lk(mutex_);
+        return signalsMap_[key].connectTrackableSlot(trackable, std::move(slot));
+    }
+
+    void
+    emit(std::uint32_t key, std::string const& msg)
+    {
+        std::scoped_lock const lk(mutex_);
+        if (signalsMap_.contains(key))
+            signalsMap_[key].emit(msg);
+    }
+};
+
+using CowSignal = feed::impl::TrackableSignal<Session, std::string>;
+using CowSignalMap = feed::impl::TrackableSignalMap<std::uint32_t, Session, std::string>;
+
+std::vector<std::shared_ptr<Session>>
+makeSessions(std::int64_t count)
+{
+    std::vector<std::shared_ptr<Session>> sessions;
+    sessions.reserve(count);
+    for (std::int64_t i = 0; i < count; ++i)
+        sessions.push_back(std::make_shared<Session>());
+    return sessions;
+}
+
+std::function<void(std::string const&)>
+makeSlot(std::shared_ptr<Session> const& session)
+{
+    return [session = session.get()](std::string const& msg) { session->received += msg.size(); };
+}
+
+template <typename SignalType>
+void
+benchmarkEmit(benchmark::State& state)
+{
+    auto const sessions = makeSessions(state.range(0));
+    SignalType signal;
+    for (auto const& session : sessions)
+        signal.connectTrackableSlot(session, makeSlot(session));
+
+    std::string const msg = "message";
+    for (auto _ : state)
+        signal.emit(msg);
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename SignalMapType>
+void
+benchmarkMapEmit(benchmark::State& state)
+{
+    // shared by all the threads; every thread publishes to the same key
+    static std::unique_ptr<SignalMapType> signalMap;
+    static std::vector<std::shared_ptr<Session>> sessions;
+
+    if (state.thread_index() == 0) {
+        sessions = makeSessions(state.range(0));
+        signalMap = std::make_unique<SignalMapType>();
+        for (auto const& session : sessions)
+            signalMap->connectTrackableSlot(session, KEY, makeSlot(session));
+    }
+
+    std::string const msg = "message";
+    for (auto _ : state)
+        signalMap->emit(KEY, msg);
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+
+    if (state.thread_index() == 0) {
+        signalMap.reset();
+        sessions.clear();
+    }
+}
+
+}  // namespace
+
+static void
+benchmarkSignals2Emit(benchmark::State& state)
+{
+    benchmarkEmit<Signals2Signal>(state);
+}
+
+static void
+benchmarkTrackableSignalEmit(benchmark::State& state)
+{
+    benchmarkEmit<CowSignal>(state);
+}
+
+static void
+benchmarkSignals2MapEmit(benchmark::State& state)
+{
+    benchmarkMapEmit<Signals2SignalMap>(state);
+}
+
+static void
+benchmarkTrackableSignalMapEmit(benchmark::State& state)
+{
+    benchmarkMapEmit<CowSignalMap>(state);
+}
+
+BENCHMARK(benchmarkSignals2Emit)->RangeMultiplier(4)->Range(MIN_SUBSCRIBERS, MAX_SUBSCRIBERS);
+BENCHMARK(benchmarkTrackableSignalEmit)->RangeMultiplier(4)->Range(MIN_SUBSCRIBERS, MAX_SUBSCRIBERS);
+
+BENCHMARK(benchmarkSignals2MapEmit)
+    ->RangeMultiplier(16)
+    ->Range(MIN_SUBSCRIBERS, MAX_SUBSCRIBERS)
+    ->ThreadRange(1, MAX_THREADS)
+    ->UseRealTime();
+BENCHMARK(benchmarkTrackableSignalMapEmit)
+    ->RangeMultiplier(16)
+    ->Range(MIN_SUBSCRIBERS, MAX_SUBSCRIBERS)
+    ->ThreadRange(1, MAX_THREADS)
+    ->UseRealTime();
@@ -0,0 +1,189 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+/*
+ * Compares the sharded token bucket DOSGuard with the previous design of one std::mutex guarding maps keyed by the IP
+ * string while the number of threads calling it grows.
+ * Usage example:
+ * ```
+ * ./clio_benchmark --benchmark_filter="DOSGuard"
+ * ```
+ */
+
+#include "util/config/Config.hpp"
+#include "web/dosguard/DOSGuard.hpp"
+#include "web/dosguard/WhitelistHandlerInterface.hpp"
+
+#include <benchmark/benchmark.h>
+#include <boost/asio/ip/address.hpp>
+#include <boost/json/object.hpp>
+#include <boost/json/value.hpp>
+#include <fmt/core.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t NUM_CLIENTS = 10'000;
+constexpr std::uint32_t MESSAGE_SIZE = 256;
+constexpr int MAX_THREADS = 16;
+
+// limits high enough to never be hit
+constexpr std::uint32_t MAX_FETCHES = 4'000'000'000u;
+constexpr std::uint32_t MAX_REQUESTS = 4'000'000'000u;
+constexpr std::uint32_t MAX_CONNECTIONS = 1'000u;
+
+struct NoWhitelist : web::dosguard::WhitelistHandlerInterface {
+    bool
+    isWhiteListed(std::string_view) const override
+    {
+        return false;
+    }
+
+    bool
+    isWhiteListed(boost::asio::ip::address const&) const override
+    {
+        return false;
+    }
+};
+
+/**
+ * @brief The previous DOSGuard design: fixed windows in maps keyed by the IP string under one mutex.
+ */
+class MutexDOSGuard {
+    struct ClientState {
+        std::uint32_t transferedByte = 0;
+        std::uint32_t requestsCount = 0;
+    };
+
+    mutable std::mutex mtx_;
+    std::unordered_map<std::string, ClientState> ipState_;
+    std::unordered_map<std::string, std::uint32_t> ipConnCount_;
+
+public:
+    bool
+    isOk(std::string const& ip) const
+    {
+        std::scoped_lock const lck(mtx_);
+        if (auto const it = ipState_.find(ip); it != ipState_.end()) {
+            if (it->second.transferedByte > MAX_FETCHES || it->second.requestsCount > MAX_REQUESTS)
+                return false;
+        }
+        if (auto const it = ipConnCount_.find(ip); it != ipConnCount_.end())
+            return it->second <= MAX_CONNECTIONS;
+        return true;
+    }
+
+    bool
+    add(std::string const& ip, std::uint32_t numObjects)
+    {
+        {
+            std::scoped_lock const lck(mtx_);
+            ipState_[ip].transferedByte += numObjects;
+        }
+        return isOk(ip);
+    }
+
+    bool
+    request(std::string const& ip)
+    {
+        {
+            std::scoped_lock const lck(mtx_);
+            ipState_[ip].requestsCount++;
+        }
+        return isOk(ip);
+    }
+};
+
+util::Config const&
+config()
+{
+    static util::Config const instance{boost::json::object{
+        {"dos_guard",
+         boost::json::object{
+             {"max_fetches", MAX_FETCHES}, {"max_requests", MAX_REQUESTS}, {"max_connections", MAX_CONNECTIONS}
+         }}
+    }};
+    return instance;
+}
+
+std::vector<std::string> const&
+clientIps()
+{
+    static auto const generated = [] {
+        std::vector<std::string> result;
+        result.reserve(NUM_CLIENTS);
+        for (std::size_t i = 0; i < NUM_CLIENTS; ++i)
+            result.push_back(fmt::format("10.{}.{}.{}", (i >> 16) & 0xFF, (i >> 8) & 0xFF, i & 0xFF));
+        return result;
+    }();
+    return generated;
+}
+
+template <typename GuardType>
+GuardType&
+sharedGuard();
+
+template <>
+MutexDOSGuard&
+sharedGuard<MutexDOSGuard>()
+{
+    static MutexDOSGuard instance;
+    return instance;
+}
+
+template <>
+web::dosguard::DOSGuard&
+sharedGuard<web::dosguard::DOSGuard>()
+{
+    static NoWhitelist const whitelist;
+    static web::dosguard::DOSGuard instance{config(), whitelist};
+    return instance;
+}
+
+/**
+ * @brief Every iteration is what a websocket message costs: one request and the bytes of the message.
+ */
+template <typename GuardType>
+void
+benchmarkMessage(benchmark::State& state)
+{
+    auto& guard = sharedGuard<GuardType>();
+    auto const& ips = clientIps();
+    std::mt19937_64 gen{static_cast<uint64_t>(state.thread_index())};  // NOLINT(cert-msc32-c,cert-msc51-cpp)
+
+    for (auto _ : state) {
+        auto const& ip = ips[gen() % ips.size()];
+        benchmark::DoNotOptimize(guard.request(ip));
+        benchmark::DoNotOptimize(guard.add(ip, MESSAGE_SIZE));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+}  // namespace
+
+BENCHMARK(benchmarkMessage<MutexDOSGuard>)->ThreadRange(1, MAX_THREADS)->UseRealTime();
+BENCHMARK(benchmarkMessage<web::dosguard::DOSGuard>)->ThreadRange(1, MAX_THREADS)->UseRealTime();
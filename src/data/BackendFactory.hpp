@@ -21,6 +21,8 @@
 
 #include "data/BackendInterface.hpp"
 #include "data/CassandraBackend.hpp"
+#include "data/LedgerCache.hpp"
+#include "data/TransactionCache.hpp"
 #include "data/cassandra/SettingsProvider.hpp"
 #include "util/config/Config.hpp"
 #include "util/log/Logger.hpp"
@@ -28,6 +30,7 @@
 #include <boost/algorithm/string.hpp>
 #include <boost/algorithm/string/predicate.hpp>
 
+#include <cstddef>
 #include <memory>
 #include <stdexcept>
 #include <string>
@@ -59,6 +62,26 @@ make_Backend(util::Config const& config)
     if (!backend)
         throw std::runtime_error("Invalid database type");
 
+    backend->cache().setNumRecentLedgers(
+        config.valueOr<std::size_t>("cache.num_recent_ledgers", LedgerCache::DEFAULT_NUM_RECENT_LEDGERS)
+    );
+
+    auto const memoryMode = config.valueOr<std::string>("cache.memory_mode", "default");
+    if (boost::iequals(memoryMode, "compact")) {
+        backend->cache().setMemoryMode(LedgerCache::MemoryMode::Compact);
+    } else if (boost::iequals(memoryMode, "compressed")) {
+        backend->cache().setMemoryMode(LedgerCache::MemoryMode::Compressed);
+    } else if (not boost::iequals(memoryMode, "default")) {
+        throw std::runtime_error("Invalid cache memory mode: " + memoryMode);
+    }
+
+    static constexpr std::size_t BYTES_IN_MB = 1024 * 1024;
+    auto const txCacheSizeMb = config.valueOr<std::size_t>(
+        "cache.transactions.max_size_mb", TransactionCache::DEFAULT_MAX_BYTES / BYTES_IN_MB
+    );
+    backend->transactionCache().setMaxBytes(txCacheSizeMb * BYTES_IN_MB);
+    backend->setAccountTxReadAhead(config.valueOr("cache.transactions.account_tx_read_ahead", false));
+
     auto const rng = backend->hardFetchLedgerRangeNoThrow();
     if (rng)
         backend->setRange(rng->minSequence, rng->maxSequence);
@@ -25,21 +25,27 @@
 
 #include <boost/asio/spawn.hpp>
 #include <xrpl/basics/base_uint.h>
+#include <xrpl/basics/hardened_hash.h>
 #include <xrpl/basics/strHex.h>
 #include <xrpl/protocol/Fees.h>
 #include <xrpl/protocol/Indexes.h>
+#include <xrpl/protocol/LedgerHeader.h>
+#include <xrpl/protocol/Protocol.h>
 #include <xrpl/protocol/SField.h>
 #include <xrpl/protocol/STLedgerEntry.h>
 #include <xrpl/protocol/Serializer.h>
 
+#include <algorithm>
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <iterator>
 #include <mutex>
 #include <optional>
 #include <shared_mutex>
 #include <sstream>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -59,7 +65,7 @@ bool
 BackendInterface::finishWrites(std::uint32_t const ledgerSequence)
 {
     LOG(gLog.debug()) << "Want finish writes for " << ledgerSequence;
-    auto commitRes = doFinishWrites();
+    auto commitRes = doFinishWrites(ledgerSequence);
     if (commitRes) {
         LOG(gLog.debug()) << "Successfully commited. Updating range now to " << ledgerSequence;
         updateRange(ledgerSequence);
@@ -148,6 +154,50 @@ BackendInterface::fetchLedgerObjects(
     return results;
 }
 
+std::vector<std::optional<ripple::LedgerHeader>>
+BackendInterface::fetchLedgerHeaders(std::vector<std::uint32_t> const& sequences, boost::asio::yield_context yield)
+    const
+{
+    std::vector<std::optional<ripple::LedgerHeader>> results;
+    results.reserve(sequences.size());
+    std::vector<std::uint32_t> misses;
+    for (auto const seq : sequences) {
+        results.push_back(headerCache_.get(seq));
+        if (not results.back().has_value())
+            misses.push_back(seq);
+    }
+
+    if (misses.empty())
+        return results;
+
+    std::ranges::sort(misses);
+    auto const [first, last] = std::ranges::unique(misses);
+    misses.erase(first, last);
+
+    auto const headers = doFetchLedgerHeaders(misses, yield);
+    for (std::size_t i = 0; i < sequences.size(); ++i) {
+        if (results[i].has_value())
+            continue;
+
+        auto const it = std::ranges::lower_bound(misses, sequences[i]);
+        results[i] = headers[std::distance(misses.begin(), it)];
+    }
+
+    return results;
+}
+
+std::vector<std::optional<ripple::LedgerHeader>>
+BackendInterface::doFetchLedgerHeaders(std::vector<std::uint32_t> const& sequences, boost::asio::yield_context yield)
+    const
+{
+    std::vector<std::optional<ripple::LedgerHeader>> results;
+    results.reserve(sequences.size());
+    for (auto const seq : sequences)
+        results.push_back(fetchLedgerBySequence(seq, yield));
+
+    return results;
+}
+
 // Fetches the successor to key/index
 std::optional<ripple::uint256>
 BackendInterface::fetchSuccessorKey(
@@ -183,6 +233,52 @@ BackendInterface::fetchSuccessorObject(
     return {};
 }
 
+namespace {
+
+using DirectoryPages = std::unordered_map<ripple::uint256, Blob, ripple::hardened_hash<>>;
+
+// Pages are always appended after the last page of a directory, which the root page keeps track of. That makes the
+// pages following the root page known upfront, so they can be fetched in one batch rather than one by one.
+DirectoryPages
+fetchDirectoryPages(
+    BackendInterface const& backend,
+    LedgerObject const& root,
+    std::size_t const numOffers,
+    std::uint32_t const ledgerSequence,
+    boost::asio::yield_context yield
+)
+{
+    static constexpr std::uint64_t MAX_PAGES = 32;
+
+    ripple::STLedgerEntry const sle{ripple::SerialIter{root.blob.data(), root.blob.size()}, root.key};
+    if (sle.getFieldU64(ripple::sfIndexNext) == 0u)
+        return {};
+
+    auto const numPages = std::min(
+        {sle.getFieldU64(ripple::sfIndexPrevious),
+         MAX_PAGES,
+         static_cast<std::uint64_t>((numOffers + ripple::dirNodeMaxEntries - 1) / ripple::dirNodeMaxEntries)}
+    );
+    if (numPages < 2)
+        return {};
+
+    std::vector<ripple::uint256> keys;
+    keys.reserve(numPages);
+    for (std::uint64_t pageNum = 1; pageNum <= numPages; ++pageNum)
+        keys.push_back(ripple::keylet::page(root.key, pageNum).key);
+
+    auto blobs = backend.fetchLedgerObjects(keys, ledgerSequence, yield);
+
+    DirectoryPages pages;
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        if (not blobs[i].empty())
+            pages.emplace(keys[i], std::move(blobs[i]));
+    }
+    return pages;
+}
+
+}  // namespace
+
 BookOffersPage
 BackendInterface::fetchBookOffers(
     ripple::uint256 const& book,
@@ -191,14 +287,31 @@ BackendInterface::fetchBookOffers(
     boost::asio::yield_context yield
 ) const
 {
-    // TODO try to speed this up. This can take a few seconds. The goal is
-    // to get it down to a few hundred milliseconds.
     BookOffersPage page;
+    auto getMillis = [](auto diff) { return std::chrono::duration_cast<std::chrono::milliseconds>(diff).count(); };
+    auto begin = std::chrono::system_clock::now();
+
+    auto toPage = [&](std::vector<ripple::uint256> const& keys) {
+        auto objs = fetchLedgerObjects(keys, ledgerSequence, yield);
+        for (size_t i = 0; i < keys.size() && i < limit; ++i) {
+            LOG(gLog.trace()) << "Key = " << ripple::strHex(keys[i]) << " blob = " << ripple::strHex(objs[i])
+                              << " ledgerSequence = " << ledgerSequence;
+            ASSERT(!objs[i].empty(), "Ledger object can't be empty");
+            page.offers.push_back({keys[i], objs[i]});
+        }
+    };
+
+    if (auto const keys = cache_.getBookOffers(book, ledgerSequence, limit); keys) {
+        toPage(*keys);
+        LOG(gLog.debug()) << "Fetching " << keys->size() << " offers from the order book index took "
+                          << getMillis(std::chrono::system_clock::now() - begin)
+                          << " milliseconds. book = " << ripple::strHex(book);
+        return page;
+    }
+
     ripple::uint256 const bookEnd = ripple::getQualityNext(book);
     ripple::uint256 uTipIndex = book;
     std::vector<ripple::uint256> keys;
-    auto getMillis = [](auto diff) { return std::chrono::duration_cast<std::chrono::milliseconds>(diff).count(); };
-    auto begin = std::chrono::system_clock::now();
     std::uint32_t numSucc = 0;
     std::uint32_t numPages = 0;
     long succMillis = 0;
@@ -214,6 +327,7 @@ BackendInterface::fetchBookOffers(
             break;
         }
         uTipIndex = offerDir->key;
+        auto const prefetched = fetchDirectoryPages(*this, *offerDir, limit - keys.size(), ledgerSequence, yield);
         while (keys.size() < limit) {
             ++numPages;
             ripple::STLedgerEntry const sle{
@@ -227,22 +341,22 @@ BackendInterface::fetchBookOffers(
                 break;
             }
             auto nextKey = ripple::keylet::page(uTipIndex, next);
-            auto nextDir = fetchLedgerObject(nextKey.key, ledgerSequence, yield);
-            ASSERT(nextDir.has_value(), "Next dir must exist");
-            offerDir->blob = *nextDir;
+            if (auto const it = prefetched.find(nextKey.key); it != prefetched.end()) {
+                offerDir->blob = it->second;
+            } else {
+                auto nextDir = fetchLedgerObject(nextKey.key, ledgerSequence, yield);
+                ASSERT(nextDir.has_value(), "Next dir must exist");
+                offerDir->blob = *nextDir;
+            }
             offerDir->key = nextKey.key;
         }
         auto mid3 = std::chrono::system_clock::now();
         pageMillis += getMillis(mid3 - mid2);
     }
     auto mid = std::chrono::system_clock::now();
-    auto objs = fetchLedgerObjects(keys, ledgerSequence, yield);
-    for (size_t i = 0; i < keys.size() && i < limit; ++i) {
-        LOG(gLog.trace()) << "Key = " << ripple::strHex(keys[i]) << " blob = " << ripple::strHex(objs[i])
-                          << " ledgerSequence = " << ledgerSequence;
-        ASSERT(!objs[i].empty(), "Ledger object can't be empty");
-        page.offers.push_back({keys[i], objs[i]});
-    }
+    if (keys.size() > limit)
+        keys.resize(limit);
+    toPage(keys);
     auto end = std::chrono::system_clock::now();
     LOG(gLog.debug()) << "Fetching " << std::to_string(keys.size()) << " offers took "
                       << std::to_string(getMillis(mid - begin)) << " milliseconds. Fetching next dir took "
@@ -21,6 +21,8 @@
 
 #include "data/DBHelpers.hpp"
 #include "data/LedgerCache.hpp"
+#include "data/LedgerHeaderCache.hpp"
+#include "data/TransactionCache.hpp"
 #include "data/Types.hpp"
 #include "etl/CorruptionDetector.hpp"
 #include "util/log/Logger.hpp"
@@ -36,6 +38,7 @@
 #include <xrpl/protocol/Fees.h>
 #include <xrpl/protocol/LedgerHeader.h>
 
+#include <atomic>
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
@@ -140,6 +143,9 @@ protected:
     mutable std::shared_mutex rngMtx_;
     std::optional<LedgerRange> range;
     LedgerCache cache_;
+    LedgerHeaderCache headerCache_;
+    TransactionCache txCache_;
+    std::atomic_bool accountTxReadAhead_ = false;
     std::optional<etl::CorruptionDetector<LedgerCache>> corruptionDetector_;
 
 public:
@@ -165,6 +171,57 @@ public:
         return cache_;
     }
 
+    /**
+     * @return Immutable cache of recent ledger headers
+     */
+    LedgerHeaderCache const&
+    ledgerHeaderCache() const
+    {
+        return headerCache_;
+    }
+
+    /**
+     * @return Mutable cache of recent ledger headers
+     */
+    LedgerHeaderCache&
+    ledgerHeaderCache()
+    {
+        return headerCache_;
+    }
+
+    /**
+     * @return Immutable cache of transactions
+     */
+    TransactionCache const&
+    transactionCache() const
+    {
+        return txCache_;
+    }
+
+    /**
+     * @return Mutable cache of transactions
+     */
+    TransactionCache&
+    transactionCache()
+    {
+        return txCache_;
+    }
+
+    /**
+     * @brief Enables reading ahead the next page of account transactions.
+     *
+     * When enabled, backends that support it start fetching the transactions of the next page into the transaction
+     * cache while the current page is returned, so that a client paging through the history of an account does not
+     * wait for the database on each page.
+     *
+     * @param enabled Whether to read ahead
+     */
+    void
+    setAccountTxReadAhead(bool enabled)
+    {
+        accountTxReadAhead_ = enabled;
+    }
+
     /**
      * @brief Sets the corruption detector.
      *
@@ -186,6 +243,19 @@ public:
     virtual std::optional<ripple::LedgerHeader>
     fetchLedgerBySequence(std::uint32_t sequence, boost::asio::yield_context yield) const = 0;
 
+    /**
+     * @brief Fetches the headers of multiple ledgers by sequence number.
+     *
+     * Headers of recent ledgers are served from the ledger header cache. The remaining sequences are de-duplicated and
+     * fetched at once using doFetchLedgerHeaders.
+     *
+     * @param sequences The sequence numbers to fetch for; may contain duplicates
+     * @param yield The coroutine context
+     * @return The headers in the same order as the sequences; nullopt for ledgers that were not found
+     */
+    std::vector<std::optional<ripple::LedgerHeader>>
+    fetchLedgerHeaders(std::vector<std::uint32_t> const& sequences, boost::asio::yield_context yield) const;
+
     /**
      * @brief Fetches a specific ledger by hash.
      *
@@ -432,6 +502,18 @@ public:
     doFetchLedgerObjectSeq(ripple::uint256 const& key, std::uint32_t sequence, boost::asio::yield_context yield)
         const = 0;
 
+    /**
+     * @brief The database-specific implementation for fetching the headers of multiple ledgers.
+     *
+     * The default implementation fetches the headers one by one.
+     *
+     * @param sequences The sequence numbers to fetch for; sorted and unique
+     * @param yield The coroutine context
+     * @return The headers in the same order as the sequences; nullopt for ledgers that were not found
+     */
+    virtual std::vector<std::optional<ripple::LedgerHeader>>
+    doFetchLedgerHeaders(std::vector<std::uint32_t> const& sequences, boost::asio::yield_context yield) const;
+
     /**
      * @brief The database-specific implementation for fetching ledger objects.
      *
@@ -515,6 +597,9 @@ public:
     /**
      * @brief Fetches book offers.
      *
+     * The offers of the latest ledger are looked up in the order book index of the cache. Otherwise the quality
+     * directories of the book are walked, fetching the pages of each directory in one batch.
+     *
      * @param book Unsigned 256-bit integer.
      * @param ledgerSequence The ledger sequence to fetch for
      * @param limit Pagaing limit as to how many transactions returned per page.
@@ -646,6 +731,25 @@ public:
     bool
     finishWrites(std::uint32_t ledgerSequence);
 
+    /**
+     * @brief Tells database that all the writes of a ledger were submitted.
+     *
+     * Lets @ref finishWrites for that ledger wait only for its own writes while the writes of the next ledger are
+     * already submitted. Without it, finishWrites waits for all the writes submitted before it was called.
+     *
+     * @param ledgerSequence The ledger whose writes were all submitted
+     */
+    virtual void
+    markLedgerSubmitted(std::uint32_t ledgerSequence) = 0;
+
+    /**
+     * @brief Wait for all the writes submitted so far to finish without committing a ledger.
+     *
+     * Writes submitted while waiting are not waited for.
+     */
+    virtual void
+    waitForWrites() = 0;
+
     /**
      * @return true if database is overwhelmed; false otherwise
      */
@@ -670,12 +774,13 @@ private:
     doWriteLedgerObject(std::string&& key, std::uint32_t seq, std::string&& blob) = 0;
 
     /**
-     * @brief The implementation should wait for all pending writes to finish
+     * @brief The implementation should wait for the pending writes of the given ledger to finish and commit it
      *
+     * @param ledgerSequence The ledger sequence to commit
      * @return true on success; false otherwise
      */
     virtual bool
-    doFinishWrites() = 0;
+    doFinishWrites(std::uint32_t ledgerSequence) = 0;
 };
 
 }  // namespace data
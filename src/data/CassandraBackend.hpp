@@ -27,6 +27,7 @@
 #include "data/cassandra/SettingsProvider.hpp"
 #include "data/cassandra/Types.hpp"
 #include "data/cassandra/impl/ExecutionStrategy.hpp"
+#include "data/cassandra/impl/TokenBatches.hpp"
 #include "util/Assert.hpp"
 #include "util/LedgerUtils.hpp"
 #include "util/Profiler.hpp"
@@ -47,6 +48,7 @@
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <exception>
 #include <iterator>
 #include <limits>
 #include <optional>
@@ -77,7 +79,11 @@ class BasicCassandraBackend : public BackendInterface {
     // have to be mutable because BackendInterface constness :(
     mutable ExecutionStrategyType executor_;
 
-    std::atomic_uint32_t ledgerSequence_ = 0u;
+    std::size_t readBatchSize_;
+    std::size_t maxReadBatchesInFlight_;
+    std::size_t maxReadAheadsInFlight_;
+
+    mutable std::atomic_size_t readAheadsInFlight_ = 0u;
 
 public:
     /**
@@ -91,6 +97,9 @@ public:
         , schema_{settingsProvider_}
         , handle_{settingsProvider_.getSettings()}
         , executor_{settingsProvider_.getSettings(), handle_}
+        , readBatchSize_{settingsProvider_.getSettings().readBatchSize}
+        , maxReadBatchesInFlight_{settingsProvider_.getSettings().maxReadBatchesInFlight}
+        , maxReadAheadsInFlight_{settingsProvider_.getSettings().maxReadAheadsInFlight}
     {
         if (auto const res = handle_.connect(); not res)
             throw std::runtime_error("Could not connect to databse: " + res.error());
@@ -117,6 +126,12 @@ public:
         LOG(log_.info()) << "Created (revamped) CassandraBackend";
     }
 
+    ~BasicCassandraBackend() override
+    {
+        // account_tx read-aheads run on the executor and use this backend; join them before members go away
+        executor_.stop();
+    }
+
     TransactionsAndCursor
     fetchAccountTransactions(
         ripple::AccountID const& account,
@@ -126,81 +141,54 @@ public:
         boost::asio::yield_context yield
     ) const override
     {
-        auto rng = fetchLedgerRange();
-        if (!rng)
-            return {{}, {}};
-
-        Statement const statement = [this, forward, &account]() {
-            if (forward)
-                return schema_->selectAccountTxForward.bind(account);
-
-            return schema_->selectAccountTx.bind(account);
-        }();
-
-        auto cursor = cursorIn;
-        if (cursor) {
-            statement.bindAt(1, cursor->asTuple());
-            LOG(log_.debug()) << "account = " << ripple::strHex(account) << " tuple = " << cursor->ledgerSequence
-                              << cursor->transactionIndex;
-        } else {
-            auto const seq = forward ? rng->minSequence : rng->maxSequence;
-            auto const placeHolder = forward ? 0u : std::numeric_limits<std::uint32_t>::max();
-
-            statement.bindAt(1, std::make_tuple(placeHolder, placeHolder));
-            LOG(log_.debug()) << "account = " << ripple::strHex(account) << " idx = " << seq
-                              << " tuple = " << placeHolder;
-        }
-
-        // FIXME: Limit is a hack to support uint32_t properly for the time
-        // being. Should be removed later and schema updated to use proper
-        // types.
-        statement.bindAt(2, Limit{limit});
-        auto const res = executor_.read(yield, statement);
-        auto const& results = res.value();
-        if (not results.hasRows()) {
-            LOG(log_.debug()) << "No rows returned";
+        auto const [hashes, cursor] = fetchAccountTransactionHashes(account, limit, forward, cursorIn, yield);
+        if (hashes.empty())
             return {};
-        }
-
-        std::vector<ripple::uint256> hashes = {};
-        auto numRows = results.numRows();
-        LOG(log_.info()) << "num_rows = " << numRows;
-
-        for (auto [hash, data] : extract<ripple::uint256, std::tuple<uint32_t, uint32_t>>(results)) {
-            hashes.push_back(hash);
-            if (--numRows == 0) {
-                LOG(log_.debug()) << "Setting cursor";
-                cursor = data;
-            }
-        }
 
         auto const txns = fetchTransactions(hashes, yield);
         LOG(log_.debug()) << "Txns = " << txns.size();
 
         if (txns.size() == limit) {
             LOG(log_.debug()) << "Returning cursor";
+            if (accountTxReadAhead_ and txCache_.isEnabled())
+                readAheadAccountTransactions(account, limit, forward, cursor);
+
             return {txns, cursor};
         }
 
         return {txns, {}};
     }
 
+    void
+    waitForWrites() override
+    {
+        executor_.syncUntil(executor_.writeWatermark());
+    }
+
+    void
+    markLedgerSubmitted(std::uint32_t const ledgerSequence) override
+    {
+        executor_.markLedgerSubmitted(ledgerSequence);
+    }
+
     bool
-    doFinishWrites() override
+    doFinishWrites(std::uint32_t const ledgerSequence) override
     {
-        // wait for other threads to finish their writes
-        executor_.sync();
+        // the writes of the next ledger may already be in flight; only the ones of this ledger are waited for
+        executor_.syncLedger(ledgerSequence);
 
         if (!range) {
-            executor_.writeSync(schema_->updateLedgerRange, ledgerSequence_, false, ledgerSequence_);
+            executor_.writeSync(schema_->updateLedgerRange, ledgerSequence, false, ledgerSequence);
         }
 
-        if (not executeSyncUpdate(schema_->updateLedgerRange.bind(ledgerSequence_, true, ledgerSequence_ - 1))) {
-            LOG(log_.warn()) << "Update failed for ledger " << ledgerSequence_;
+        if (not executeSyncUpdate(
+                schema_->updateLedgerRange.bind(ledgerSequence, true, ledgerSequence - 1), ledgerSequence
+            )) {
+            LOG(log_.warn()) << "Update failed for ledger " << ledgerSequence;
             return false;
         }
 
-        LOG(log_.info()) << "Committed ledger " << ledgerSequence_;
+        LOG(log_.info()) << "Committed ledger " << ledgerSequence;
         return true;
     }
 
@@ -210,8 +198,6 @@ public:
         executor_.write(schema_->insertLedgerHeader, ledgerHeader.seq, std::move(blob));
 
         executor_.write(schema_->insertLedgerHash, ledgerHeader.hash, ledgerHeader.seq);
-
-        ledgerSequence_ = ledgerHeader.seq;
     }
 
     std::optional<std::uint32_t>
@@ -256,6 +242,41 @@ public:
         return std::nullopt;
     }
 
+    std::vector<std::optional<ripple::LedgerHeader>>
+    doFetchLedgerHeaders(std::vector<std::uint32_t> const& sequences, boost::asio::yield_context yield) const override
+    {
+        if (sequences.empty())
+            return {};
+
+        std::vector<Statement> statements;
+        statements.reserve(sequences.size());
+
+        std::transform(
+            std::cbegin(sequences),
+            std::cend(sequences),
+            std::back_inserter(statements),
+            [this](auto const seq) { return schema_->selectLedgerBySeq.bind(seq); }
+        );
+
+        auto const entries = executor_.readEach(yield, statements);
+
+        std::vector<std::optional<ripple::LedgerHeader>> results;
+        results.reserve(sequences.size());
+        std::transform(
+            std::cbegin(entries),
+            std::cend(entries),
+            std::back_inserter(results),
+            [](auto const& res) -> std::optional<ripple::LedgerHeader> {
+                if (auto const maybeValue = res.template get<std::vector<unsigned char>>(); maybeValue)
+                    return util::deserializeHeader(ripple::makeSlice(*maybeValue));
+
+                return std::nullopt;
+            }
+        );
+
+        return results;
+    }
+
     std::optional<ripple::LedgerHeader>
     fetchLedgerByHash(ripple::uint256 const& hash, boost::asio::yield_context yield) const override
     {
@@ -588,10 +609,15 @@ public:
     std::optional<TransactionAndMetadata>
     fetchTransaction(ripple::uint256 const& hash, boost::asio::yield_context yield) const override
     {
+        if (auto cached = txCache_.get(hash); cached)
+            return cached;
+
         if (auto const res = executor_.read(yield, schema_->selectTransaction, hash); res) {
             if (auto const maybeValue = res->template get<Blob, Blob, uint32_t, uint32_t>(); maybeValue) {
                 auto [transaction, meta, seq, date] = *maybeValue;
-                return std::make_optional<TransactionAndMetadata>(transaction, meta, seq, date);
+                auto txn = std::make_optional<TransactionAndMetadata>(transaction, meta, seq, date);
+                txCache_.put(hash, *txn);
+                return txn;
             }
 
             LOG(log_.debug()) << "Could not fetch transaction - no rows";
@@ -628,38 +654,64 @@ public:
             return {};
 
         auto const numHashes = hashes.size();
-        std::vector<TransactionAndMetadata> results;
-        results.reserve(numHashes);
+        std::vector<TransactionAndMetadata> results(numHashes);
 
-        std::vector<Statement> statements;
-        statements.reserve(numHashes);
+        std::vector<std::size_t> misses;
+        for (std::size_t i = 0; i < numHashes; ++i) {
+            if (auto cached = txCache_.get(hashes[i]); cached) {
+                results[i] = std::move(*cached);
+            } else {
+                misses.push_back(i);
+            }
+        }
+
+        if (misses.empty()) {
+            LOG(log_.debug()) << "Fetched " << numHashes << " transactions from cache";
+            return results;
+        }
 
-        auto const timeDiff = util::timed([this, yield, &results, &hashes, &statements]() {
-            // TODO: seems like a job for "hash IN (list of hashes)" instead?
+        auto const timeDiff = util::timed([this, yield, &results, &hashes, &misses]() {
+            std::vector<ripple::uint256> missedHashes;
+            missedHashes.reserve(misses.size());
             std::transform(
-                std::cbegin(hashes),
-                std::cend(hashes),
-                std::back_inserter(statements),
-                [this](auto const& hash) { return schema_->selectTransaction.bind(hash); }
+                std::cbegin(misses),
+                std::cend(misses),
+                std::back_inserter(missedHashes),
+                [&hashes](auto const idx) { return hashes[idx]; }
             );
 
-            auto const entries = executor_.readEach(yield, statements);
+            auto const batches = impl::makeTokenBatches(missedHashes, readBatchSize_);
+            std::vector<Statement> statements;
+            statements.reserve(batches.size());
             std::transform(
-                std::cbegin(entries),
-                std::cend(entries),
-                std::back_inserter(results),
-                [](auto const& res) -> TransactionAndMetadata {
-                    if (auto const maybeRow = res.template get<Blob, Blob, uint32_t, uint32_t>(); maybeRow)
-                        return *maybeRow;
-
-                    return {};
+                std::cbegin(batches),
+                std::cend(batches),
+                std::back_inserter(statements),
+                [this, &missedHashes](auto const& batch) {
+                    return schema_->selectTransactions.bind(keysOfBatch(missedHashes, batch));
                 }
             );
+
+            auto const entries = executor_.readEach(yield, statements, maxReadBatchesInFlight_);
+            ASSERT(entries.size() == batches.size(), "Number of statements and results must match");
+
+            for (std::size_t i = 0; i < batches.size(); ++i) {
+                for (auto [hash, transaction, metadata, ledgerSequence, date] :
+                     extract<ripple::uint256, Blob, Blob, uint32_t, uint32_t>(entries[i])) {
+                    // the same hash may have been requested more than once
+                    for (auto const idx : batches[i]) {
+                        if (missedHashes[idx] != hash)
+                            continue;
+
+                        results[misses[idx]] = TransactionAndMetadata{transaction, metadata, ledgerSequence, date};
+                        txCache_.put(hash, results[misses[idx]]);
+                    }
+                }
+            }
         });
 
-        ASSERT(numHashes == results.size(), "Number of hashes and results must match");
-        LOG(log_.debug()) << "Fetched " << numHashes << " transactions from database in " << timeDiff
-                          << " milliseconds";
+        LOG(log_.debug()) << "Fetched " << misses.size() << " of " << numHashes << " transactions from database in "
+                          << timeDiff << " milliseconds";
         return results;
     }
 
@@ -676,32 +728,34 @@ public:
         auto const numKeys = keys.size();
         LOG(log_.trace()) << "Fetching " << numKeys << " objects";
 
-        std::vector<Blob> results;
-        results.reserve(numKeys);
+        std::vector<Blob> results(numKeys);
 
+        // each statement reads the latest version of a batch of keys; batches are grouped by token so that few
+        // replicas are involved in each of them
+        auto const batches = impl::makeTokenBatches(keys, readBatchSize_);
         std::vector<Statement> statements;
-        statements.reserve(numKeys);
-
-        // TODO: seems like a job for "key IN (list of keys)" instead?
+        statements.reserve(batches.size());
         std::transform(
-            std::cbegin(keys),
-            std::cend(keys),
+            std::cbegin(batches),
+            std::cend(batches),
             std::back_inserter(statements),
-            [this, &sequence](auto const& key) { return schema_->selectObject.bind(key, sequence); }
+            [this, &keys, &sequence](auto const& batch) {
+                return schema_->selectObjects.bind(keysOfBatch(keys, batch), sequence);
+            }
         );
 
-        auto const entries = executor_.readEach(yield, statements);
-        std::transform(
-            std::cbegin(entries),
-            std::cend(entries),
-            std::back_inserter(results),
-            [](auto const& res) -> Blob {
-                if (auto const maybeValue = res.template get<Blob>(); maybeValue)
-                    return *maybeValue;
+        auto const entries = executor_.readEach(yield, statements, maxReadBatchesInFlight_);
+        ASSERT(entries.size() == batches.size(), "Number of statements and results must match");
 
-                return {};
+        for (std::size_t i = 0; i < batches.size(); ++i) {
+            for (auto [key, object] : extract<ripple::uint256, Blob>(entries[i])) {
+                // the same key may have been requested more than once
+                for (auto const idx : batches[i]) {
+                    if (keys[idx] == key)
+                        results[idx] = object;
+                }
             }
-        );
+        }
 
         LOG(log_.trace()) << "Fetched " << numKeys << " objects";
         return results;
@@ -925,8 +979,109 @@ public:
     }
 
 private:
+    std::pair<std::vector<ripple::uint256>, std::optional<TransactionsCursor>>
+    fetchAccountTransactionHashes(
+        ripple::AccountID const& account,
+        std::uint32_t const limit,
+        bool forward,
+        std::optional<TransactionsCursor> const& cursorIn,
+        boost::asio::yield_context yield
+    ) const
+    {
+        auto rng = fetchLedgerRange();
+        if (!rng)
+            return {};
+
+        Statement const statement = [this, forward, &account]() {
+            if (forward)
+                return schema_->selectAccountTxForward.bind(account);
+
+            return schema_->selectAccountTx.bind(account);
+        }();
+
+        auto cursor = cursorIn;
+        if (cursor) {
+            statement.bindAt(1, cursor->asTuple());
+            LOG(log_.debug()) << "account = " << ripple::strHex(account) << " tuple = " << cursor->ledgerSequence
+                              << cursor->transactionIndex;
+        } else {
+            auto const seq = forward ? rng->minSequence : rng->maxSequence;
+            auto const placeHolder = forward ? 0u : std::numeric_limits<std::uint32_t>::max();
+
+            statement.bindAt(1, std::make_tuple(placeHolder, placeHolder));
+            LOG(log_.debug()) << "account = " << ripple::strHex(account) << " idx = " << seq
+                              << " tuple = " << placeHolder;
+        }
+
+        // FIXME: Limit is a hack to support uint32_t properly for the time
+        // being. Should be removed later and schema updated to use proper
+        // types.
+        statement.bindAt(2, Limit{limit});
+        auto const res = executor_.read(yield, statement);
+        auto const& results = res.value();
+        if (not results.hasRows()) {
+            LOG(log_.debug()) << "No rows returned";
+            return {};
+        }
+
+        std::vector<ripple::uint256> hashes = {};
+        auto numRows = results.numRows();
+        LOG(log_.info()) << "num_rows = " << numRows;
+
+        for (auto [hash, data] : extract<ripple::uint256, std::tuple<uint32_t, uint32_t>>(results)) {
+            hashes.push_back(hash);
+            if (--numRows == 0) {
+                LOG(log_.debug()) << "Setting cursor";
+                cursor = data;
+            }
+        }
+
+        return {std::move(hashes), cursor};
+    }
+
+    void
+    readAheadAccountTransactions(
+        ripple::AccountID const& account,
+        std::uint32_t const limit,
+        bool forward,
+        std::optional<TransactionsCursor> const& cursor
+    ) const
+    {
+        if (isTooBusy())
+            return;
+
+        if (readAheadsInFlight_.fetch_add(1) >= maxReadAheadsInFlight_) {
+            --readAheadsInFlight_;
+            return;
+        }
+
+        // the fetched transactions land in the transaction cache where the request for the next page finds them.
+        // the coroutine runs on the executor's own thread which is joined before the backend goes away
+        executor_.spawn([this, account, limit, forward, cursor](boost::asio::yield_context readAheadYield) {
+            try {
+                auto const [hashes, _] = fetchAccountTransactionHashes(account, limit, forward, cursor, readAheadYield);
+                fetchTransactions(hashes, readAheadYield);
+            } catch (std::exception const& e) {
+                LOG(log_.debug()) << "Could not read ahead account transactions: " << e.what();
+            }
+            --readAheadsInFlight_;
+        });
+    }
+
+    static std::vector<ripple::uint256>
+    keysOfBatch(std::vector<ripple::uint256> const& keys, std::vector<std::size_t> const& batch)
+    {
+        std::vector<ripple::uint256> batchKeys;
+        batchKeys.reserve(batch.size());
+        std::transform(std::cbegin(batch), std::cend(batch), std::back_inserter(batchKeys), [&keys](auto const idx) {
+            return keys[idx];
+        });
+
+        return batchKeys;
+    }
+
     bool
-    executeSyncUpdate(Statement statement)
+    executeSyncUpdate(Statement statement, std::uint32_t const ledgerSequence)
     {
         auto const res = executor_.writeSync(statement);
         auto maybeSuccess = res->template get<bool>();
@@ -943,7 +1098,7 @@ private:
             // against what we were trying to write in the first place and
             // use that as the source of truth for the result.
             auto rng = hardFetchLedgerRangeNoThrow();
-            return rng && rng->maxSequence == ledgerSequence_;
+            return rng && rng->maxSequence == ledgerSequence;
         }
 
         return true;
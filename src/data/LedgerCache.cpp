@@ -24,19 +24,32 @@
 
 #include <xrpl/basics/base_uint.h>
 
+#include <algorithm>
+#include <array>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
 #include <mutex>
 #include <optional>
 #include <shared_mutex>
+#include <utility>
 #include <vector>
 
 namespace data {
 
+std::size_t
+LedgerCache::shardIndex(ripple::uint256 const& key)
+{
+    static_assert(NUM_SHARDS == 256, "Shards are selected by the leading byte of the key");
+    return *key.cbegin();
+}
+
 uint32_t
 LedgerCache::latestLedgerSequence() const
 {
-    std::shared_lock const lck{mtx_};
     return latestSeq_;
 }
 
@@ -46,44 +59,245 @@ LedgerCache::waitUntilCacheContainsSeq(uint32_t seq)
     if (disabled_)
         return;
 
-    std::unique_lock lock(mtx_);
+    std::unique_lock lock(seqMtx_);
     cv_.wait(lock, [this, seq] { return latestSeq_ >= seq; });
     return;
 }
 
+bool
+LedgerCache::covers(Shard const& shard, uint32_t seq)
+{
+    return seq >= shard.oldestSeq and seq <= shard.seq;
+}
+
+std::optional<LedgerObject>
+LedgerCache::successorAt(Shard const& shard, std::optional<ripple::uint256> const& key, uint32_t seq)
+{
+    auto current = key ? shard.storage.successor(*key) : shard.storage.first();
+    if (seq == shard.seq)
+        return current;
+
+    // merge the current state with the objects changed after seq
+    auto changed = key ? shard.history.upperBound(*key) : shard.history.begin();
+    while (changed != shard.history.end() and (not current or changed->first <= current->key)) {
+        auto const& changedKey = changed->first;
+        auto const isCurrent = current and current->key == changedKey;
+
+        if (auto const* state = impl::CacheHistory::stateAt(changed, seq); state != nullptr) {
+            if (*state)
+                return LedgerObject{changedKey, **state};
+        } else if (isCurrent) {
+            return current;
+        }
+
+        // the object did not exist as of seq
+        if (isCurrent)
+            current = shard.storage.successor(changedKey);
+        ++changed;
+    }
+
+    return current;
+}
+
+std::optional<LedgerObject>
+LedgerCache::predecessorAt(Shard const& shard, std::optional<ripple::uint256> const& key, uint32_t seq)
+{
+    auto current = key ? shard.storage.predecessor(*key) : shard.storage.last();
+    if (seq == shard.seq)
+        return current;
+
+    // merge the current state with the objects changed after seq
+    auto changed = key ? shard.history.lowerBound(*key) : shard.history.end();
+    while (changed != shard.history.begin() and (not current or std::prev(changed)->first >= current->key)) {
+        --changed;
+        auto const& changedKey = changed->first;
+        auto const isCurrent = current and current->key == changedKey;
+
+        if (auto const* state = impl::CacheHistory::stateAt(changed, seq); state != nullptr) {
+            if (*state)
+                return LedgerObject{changedKey, **state};
+        } else if (isCurrent) {
+            return current;
+        }
+
+        // the object did not exist as of seq
+        if (isCurrent)
+            current = shard.storage.predecessor(changedKey);
+    }
+
+    return current;
+}
+
 void
 LedgerCache::update(std::vector<LedgerObject> const& objs, uint32_t seq, bool isBackground)
 {
     if (disabled_)
         return;
 
-    {
-        std::scoped_lock const lck{mtx_};
-        if (seq > latestSeq_) {
-            ASSERT(
-                seq == latestSeq_ + 1 || latestSeq_ == 0,
-                "New sequense must be either next or first. seq = {}, latestSeq_ = {}",
-                seq,
-                latestSeq_
-            );
-            latestSeq_ = seq;
-        }
-        for (auto const& obj : objs) {
-            if (!obj.blob.empty()) {
-                if (isBackground && deletes_.contains(obj.key))
+    std::scoped_lock const updateLck{updateMtx_};
+
+    auto const latestSeq = latestSeq_.load();
+    if (seq > latestSeq) {
+        ASSERT(
+            seq == latestSeq + 1 || latestSeq == 0,
+            "New sequense must be either next or first. seq = {}, latestSeq_ = {}",
+            seq,
+            latestSeq
+        );
+    }
+
+    std::array<std::vector<LedgerObject const*>, NUM_SHARDS> perShard;
+    for (auto const& obj : objs)
+        perShard[shardIndex(obj.key)].push_back(&obj);
+
+    auto const numRecentLedgers = static_cast<uint32_t>(numRecentLedgers_.load());
+
+    // objects actually stored or erased, in the same state for the order book index
+    std::vector<LedgerObject const*> changed;
+    changed.reserve(objs.size());
+
+    for (std::size_t idx = 0; idx < NUM_SHARDS; ++idx) {
+        auto& shard = shards_[idx];
+        if (perShard[idx].empty() && seq <= shard.seq)
+            continue;
+
+        std::scoped_lock const lck{shard.mtx};
+
+        // history is only complete if all the objects are known, i.e. the cache is full
+        auto const keepHistory = full_ && !isBackground && numRecentLedgers > 0 && seq >= shard.seq;
+
+        for (auto const* obj : perShard[idx]) {
+            if (keepHistory)
+                shard.history.record(obj->key, seq, shard.storage.get(obj->key));
+
+            if (!obj->blob.empty()) {
+                if (isBackground && deletes_.contains(obj->key))
                     continue;
 
-                auto& e = map_[obj.key];
-                if (seq > e.seq) {
-                    e = {seq, obj.blob};
+                if (auto const storedSeq = shard.storage.seqOf(obj->key); !storedSeq || seq > *storedSeq) {
+                    shard.storage.put(obj->key, seq, obj->blob);
+                    changed.push_back(obj);
                 }
             } else {
-                map_.erase(obj.key);
+                shard.storage.erase(obj->key);
+                changed.push_back(obj);
                 if (!full_ && !isBackground)
-                    deletes_.insert(obj.key);
+                    deletes_.insert(obj->key);
             }
         }
-        cv_.notify_all();
+        shard.storage.compactIfNeeded();
+
+        shard.seq = std::max(shard.seq, seq);
+        if (keepHistory) {
+            shard.oldestSeq = std::max(shard.oldestSeq, shard.seq - std::min(shard.seq, numRecentLedgers));
+        } else {
+            shard.oldestSeq = shard.seq;
+        }
+        shard.history.prune(shard.oldestSeq);
+    }
+
+    {
+        std::scoped_lock const lck{booksMtx_};
+        books_.update(changed, seq);
+    }
+
+    updateBytesPerObject();
+
+    {
+        std::scoped_lock const lck{seqMtx_};
+        if (seq > latestSeq_)
+            latestSeq_ = seq;
+    }
+    cv_.notify_all();
+}
+
+void
+LedgerCache::restore(std::vector<VersionedLedgerObject> const& objs, uint32_t seq)
+{
+    if (disabled_)
+        return;
+
+    std::scoped_lock const updateLck{updateMtx_};
+    ASSERT(not full_, "Snapshot can't be restored into a full cache. seq = {}", seq);
+
+    std::array<std::vector<VersionedLedgerObject const*>, NUM_SHARDS> perShard;
+    for (auto const& obj : objs)
+        perShard[shardIndex(obj.object.key)].push_back(&obj);
+
+    std::vector<LedgerObject const*> changed;
+    changed.reserve(objs.size());
+
+    for (std::size_t idx = 0; idx < NUM_SHARDS; ++idx) {
+        auto& shard = shards_[idx];
+        std::scoped_lock const lck{shard.mtx};
+
+        for (auto const* obj : perShard[idx]) {
+            if (auto const storedSeq = shard.storage.seqOf(obj->object.key); !storedSeq || obj->seq > *storedSeq) {
+                shard.storage.put(obj->object.key, obj->seq, obj->object.blob);
+                changed.push_back(&obj->object);
+            }
+        }
+        shard.storage.compactIfNeeded();
+
+        shard.seq = std::max(shard.seq, seq);
+        shard.oldestSeq = shard.seq;
+    }
+
+    {
+        std::scoped_lock const lck{booksMtx_};
+        books_.update(changed, seq);
+    }
+
+    updateBytesPerObject();
+
+    {
+        std::scoped_lock const lck{seqMtx_};
+        if (seq > latestSeq_)
+            latestSeq_ = seq;
+    }
+    cv_.notify_all();
+}
+
+std::pair<uint32_t, uint32_t>
+LedgerCache::forEach(std::function<void(VersionedLedgerObject const&)> const& visitor) const
+{
+    auto oldestSeq = std::numeric_limits<uint32_t>::max();
+    auto latestSeq = uint32_t{0};
+
+    for (auto const& shard : shards_) {
+        std::shared_lock const lck{shard.mtx};
+        oldestSeq = std::min(oldestSeq, shard.seq);
+        latestSeq = std::max(latestSeq, shard.seq);
+
+        shard.storage.forEach([&visitor](ripple::uint256 const& key, uint32_t seq, Blob blob) {
+            visitor(VersionedLedgerObject{{key, std::move(blob)}, seq});
+        });
+    }
+
+    return {oldestSeq, latestSeq};
+}
+
+void
+LedgerCache::forEachInRange(
+    ripple::uint256 const& first,
+    std::optional<ripple::uint256> const& last,
+    std::function<void(LedgerObject const&)> const& visitor
+) const
+{
+    auto endIdx = NUM_SHARDS;
+    if (last) {
+        // a range ending at the first key of a shard has nothing in that shard
+        auto const isShardStart =
+            std::all_of(std::next(last->cbegin()), last->cend(), [](auto byte) { return byte == 0; });
+        endIdx = shardIndex(*last) + (isShardStart ? 0 : 1);
+    }
+
+    for (auto idx = shardIndex(first); idx < endIdx; ++idx) {
+        std::shared_lock const lck{shards_[idx].mtx};
+        shards_[idx].storage.forEach([&](ripple::uint256 const& key, uint32_t, Blob blob) {
+            if (key >= first and (not last or key < *last))
+                visitor(LedgerObject{key, std::move(blob)});
+        });
     }
 }
 
@@ -93,15 +307,26 @@ LedgerCache::getSuccessor(ripple::uint256 const& key, uint32_t seq) const
     if (disabled_ or not full_)
         return {};
 
-    std::shared_lock const lck{mtx_};
     ++successorReqCounter_.get();
-    if (seq != latestSeq_)
-        return {};
-    auto e = map_.upper_bound(key);
-    if (e == map_.end())
+    if (seq > latestSeq_)
         return {};
-    ++successorHitCounter_.get();
-    return {{e->first, e->second.blob}};
+
+    auto const startIdx = shardIndex(key);
+    for (auto idx = startIdx; idx < NUM_SHARDS; ++idx) {
+        auto const& shard = shards_[idx];
+        std::shared_lock const lck{shard.mtx};
+
+        if (not covers(shard, seq))
+            return {};
+
+        auto res = successorAt(shard, idx == startIdx ? std::optional{key} : std::nullopt, seq);
+        if (res) {
+            ++successorHitCounter_.get();
+            return res;
+        }
+    }
+
+    return {};
 }
 
 std::optional<LedgerObject>
@@ -110,14 +335,41 @@ LedgerCache::getPredecessor(ripple::uint256 const& key, uint32_t seq) const
     if (disabled_ or not full_)
         return {};
 
-    std::shared_lock const lck{mtx_};
-    if (seq != latestSeq_)
+    if (seq > latestSeq_)
+        return {};
+
+    auto const startIdx = shardIndex(key);
+    for (auto idx = startIdx + 1; idx-- > 0;) {
+        auto const& shard = shards_[idx];
+        std::shared_lock const lck{shard.mtx};
+
+        if (not covers(shard, seq))
+            return {};
+
+        auto res = predecessorAt(shard, idx == startIdx ? std::optional{key} : std::nullopt, seq);
+        if (res)
+            return res;
+    }
+
+    return {};
+}
+
+std::optional<std::vector<ripple::uint256>>
+LedgerCache::getBookOffers(ripple::uint256 const& book, uint32_t seq, std::uint32_t limit) const
+{
+    if (disabled_ or not full_)
         return {};
-    auto e = map_.lower_bound(key);
-    if (e == map_.begin())
+
+    ++bookOffersReqCounter_.get();
+
+    std::shared_lock const lck{booksMtx_};
+    if (seq != books_.seq())
         return {};
-    --e;
-    return {{e->first, e->second.blob}};
+
+    auto offers = books_.offers(book, limit);
+    if (offers)
+        ++bookOffersHitCounter_.get();
+    return offers;
 }
 
 std::optional<Blob>
@@ -126,17 +378,57 @@ LedgerCache::get(ripple::uint256 const& key, uint32_t seq) const
     if (disabled_)
         return {};
 
-    std::shared_lock const lck{mtx_};
     if (seq > latestSeq_)
         return {};
+
     ++objectReqCounter_.get();
-    auto e = map_.find(key);
-    if (e == map_.end())
-        return {};
-    if (seq < e->second.seq)
-        return {};
-    ++objectHitCounter_.get();
-    return {e->second.blob};
+
+    auto const& shard = shards_[shardIndex(key)];
+    std::shared_lock const lck{shard.mtx};
+
+    if (seq < shard.seq and covers(shard, seq)) {
+        if (auto const* state = shard.history.stateAt(key, seq); state != nullptr) {
+            if (not *state)
+                return {};
+            ++objectHitCounter_.get();
+            return **state;
+        }
+    }
+
+    auto blob = shard.storage.get(key, seq);
+    if (blob)
+        ++objectHitCounter_.get();
+    return blob;
+}
+
+void
+LedgerCache::setMemoryMode(MemoryMode mode)
+{
+    std::scoped_lock const updateLck{updateMtx_};
+
+    // compression state is shared by all shards; that's fine because writers are serialized by updateMtx_
+    auto const compressor = mode == MemoryMode::Compressed ? std::make_shared<impl::BlobCompressor>() : nullptr;
+
+    for (auto& shard : shards_) {
+        std::scoped_lock const lck{shard.mtx};
+        if (mode == MemoryMode::Default) {
+            shard.storage = impl::CacheStorage{};
+        } else {
+            shard.storage = impl::CacheStorage{impl::ArenaBlobStore{compressor}};
+        }
+    }
+
+    {
+        std::scoped_lock const lck{booksMtx_};
+        books_.clear();
+    }
+    updateBytesPerObject();
+}
+
+void
+LedgerCache::setNumRecentLedgers(std::size_t numLedgers)
+{
+    numRecentLedgers_ = numLedgers;
 }
 
 void
@@ -158,7 +450,7 @@ LedgerCache::setFull()
         return;
 
     full_ = true;
-    std::scoped_lock const lck{mtx_};
+    std::scoped_lock const lck{updateMtx_};
     deletes_.clear();
 }
 
@@ -171,8 +463,36 @@ LedgerCache::isFull() const
 size_t
 LedgerCache::size() const
 {
-    std::shared_lock const lck{mtx_};
-    return map_.size();
+    size_t total = 0;
+    for (auto const& shard : shards_) {
+        std::shared_lock const lck{shard.mtx};
+        total += shard.storage.size();
+    }
+    return total;
+}
+
+size_t
+LedgerCache::bytes() const
+{
+    size_t total = 0;
+    for (auto const& shard : shards_) {
+        std::shared_lock const lck{shard.mtx};
+        total += shard.storage.bytes();
+    }
+    return total;
+}
+
+void
+LedgerCache::updateBytesPerObject()
+{
+    // only writers modify shards and they all hold updateMtx_ which the caller holds too
+    size_t objects = 0;
+    size_t bytes = 0;
+    for (auto const& shard : shards_) {
+        objects += shard.storage.size();
+        bytes += shard.storage.bytes();
+    }
+    bytesPerObjectGauge_.get().set(objects == 0 ? 0. : static_cast<double>(bytes) / static_cast<double>(objects));
 }
 
 float
@@ -20,33 +20,65 @@
 #pragma once
 
 #include "data/Types.hpp"
+#include "data/impl/BlobCompressor.hpp"
+#include "data/impl/CacheHistory.hpp"
+#include "data/impl/CacheStorage.hpp"
+#include "data/impl/OrderBookIndex.hpp"
 #include "util/prometheus/Counter.hpp"
+#include "util/prometheus/Gauge.hpp"
 #include "util/prometheus/Label.hpp"
 #include "util/prometheus/Prometheus.hpp"
 
 #include <xrpl/basics/base_uint.h>
 #include <xrpl/basics/hardened_hash.h>
 
+#include <array>
 #include <atomic>
 #include <condition_variable>
 #include <cstddef>
 #include <cstdint>
 #include <functional>
-#include <map>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <shared_mutex>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 namespace data {
 
 /**
  * @brief Cache for an entire ledger.
+ *
+ * The key space is split into shards by the leading byte of the key. Since keys are compared byte by byte, every key
+ * in a shard is less than any key in the next shard which keeps successor and predecessor lookups cheap. Each shard
+ * has its own lock so readers only ever contend with a writer touching the same shard.
+ *
+ * Once the cache is full, the previous state of objects changed in the most recent ledgers is kept as well so that
+ * lookups for any of these ledgers can be served from memory too.
  */
 class LedgerCache {
-    struct CacheEntry {
-        uint32_t seq = 0;
-        Blob blob;
+public:
+    /** @brief How cached objects are kept in memory */
+    enum class MemoryMode {
+        Default,    /**< every object in its own allocation; fastest */
+        Compact,    /**< objects packed into per shard arenas which are compacted periodically */
+        Compressed  /**< same as Compact but objects are also compressed using a shared dictionary */
+    };
+
+    /** @brief Default number of ledgers preceding the latest one that lookups can be served for */
+    static constexpr std::size_t DEFAULT_NUM_RECENT_LEDGERS = 8;
+
+private:
+    static constexpr std::size_t NUM_SHARDS = 256;
+
+    struct alignas(64) Shard {
+        mutable std::shared_mutex mtx;
+        uint32_t seq = 0;        // the latest sequence this shard reflects entirely
+        uint32_t oldestSeq = 0;  // the oldest sequence this shard can reconstruct using history
+        impl::CacheStorage storage;
+        impl::CacheHistory history;
     };
 
     // counters for fetchLedgerObject(s) hit rate
@@ -71,15 +103,40 @@ class LedgerCache {
         util::prometheus::Labels({{"type", "cache_hit"}, {"fetch", "successor_key"}})
     )};
 
-    std::map<ripple::uint256, CacheEntry> map_;
+    // counters for fetchBookOffers hit rate
+    std::reference_wrapper<util::prometheus::CounterInt> bookOffersReqCounter_{PrometheusService::counterInt(
+        "ledger_cache_counter_total_number",
+        util::prometheus::Labels({{"type", "request"}, {"fetch", "book_offers"}})
+    )};
+    std::reference_wrapper<util::prometheus::CounterInt> bookOffersHitCounter_{PrometheusService::counterInt(
+        "ledger_cache_counter_total_number",
+        util::prometheus::Labels({{"type", "cache_hit"}, {"fetch", "book_offers"}})
+    )};
+
+    std::reference_wrapper<util::prometheus::GaugeDouble> bytesPerObjectGauge_{PrometheusService::gaugeDouble(
+        "ledger_cache_bytes_per_object",
+        util::prometheus::Labels{},
+        "Average number of bytes of memory used by the cache per cached object"
+    )};
+
+    std::array<Shard, NUM_SHARDS> shards_;
 
-    mutable std::shared_mutex mtx_;
-    std::condition_variable_any cv_;
-    uint32_t latestSeq_ = 0;
+    // serializes writers; readers never take it
+    mutable std::mutex updateMtx_;
+
+    // the index reflects the latest ledger only; it is updated at once after all the shards
+    mutable std::shared_mutex booksMtx_;
+    impl::OrderBookIndex books_;
+
+    mutable std::mutex seqMtx_;
+    std::condition_variable cv_;
+    std::atomic_uint32_t latestSeq_ = 0;
+    std::atomic_size_t numRecentLedgers_ = DEFAULT_NUM_RECENT_LEDGERS;
     std::atomic_bool full_ = false;
     std::atomic_bool disabled_ = false;
 
     // temporary set to prevent background thread from writing already deleted data. not used when cache is full
+    // guarded by updateMtx_
     std::unordered_set<ripple::uint256, ripple::hardened_hash<>> deletes_;
 
 public:
@@ -93,6 +150,47 @@ public:
     void
     update(std::vector<LedgerObject> const& objs, uint32_t seq, bool isBackground = false);
 
+    /**
+     * @brief Populate the cache with objects restored from a snapshot.
+     *
+     * Unlike @ref update, every object keeps the sequence it was last modified at. Can be called multiple times to
+     * restore a snapshot in batches. The cache is not marked as full.
+     *
+     * @param objs The objects to restore
+     * @param seq The sequence the snapshot was taken at
+     */
+    void
+    restore(std::vector<VersionedLedgerObject> const& objs, uint32_t seq);
+
+    /**
+     * @brief Visit every cached object in key order, one shard at a time.
+     *
+     * Only the shard being visited is locked. Updates of the cache carry on meanwhile, so shards visited later may
+     * reflect a newer ledger than the ones visited before. Lookups are not blocked.
+     *
+     * @param visitor The function to call for every object
+     * @return The oldest and the latest sequence that any of the shards reflected when it was visited
+     */
+    std::pair<uint32_t, uint32_t>
+    forEach(std::function<void(VersionedLedgerObject const&)> const& visitor) const;
+
+    /**
+     * @brief Visit the cached objects of a key range in key order.
+     *
+     * Unlike @ref forEach, updates of the cache are not blocked so that several ranges can be visited concurrently.
+     * Only meant to be used while the cache is not being updated.
+     *
+     * @param first The first key of the range
+     * @param last The key the range ends before; nullopt to visit up to the last key
+     * @param visitor The function to call for every object
+     */
+    void
+    forEachInRange(
+        ripple::uint256 const& first,
+        std::optional<ripple::uint256> const& last,
+        std::function<void(LedgerObject const&)> const& visitor
+    ) const;
+
     /**
      * @brief Fetch a cached object by its key and sequence number.
      *
@@ -106,6 +204,8 @@ public:
     /**
      * @brief Gets a cached successor.
      *
+     * The sequence may be either the latest one or any of the recent ledgers kept by the cache.
+     *
      * Note: This function always returns std::nullopt when @ref isFull() returns false.
      *
      * @param key The key to fetch for
@@ -118,6 +218,8 @@ public:
     /**
      * @brief Gets a cached predcessor.
      *
+     * The sequence may be either the latest one or any of the recent ledgers kept by the cache.
+     *
      * Note: This function always returns std::nullopt when @ref isFull() returns false.
      *
      * @param key The key to fetch for
@@ -127,6 +229,40 @@ public:
     std::optional<LedgerObject>
     getPredecessor(ripple::uint256 const& key, uint32_t seq) const;
 
+    /**
+     * @brief Gets the keys of the best offers of an order book.
+     *
+     * Only the latest ledger is served. Note: This function always returns std::nullopt when @ref isFull() returns
+     * false.
+     *
+     * @param book The book base
+     * @param seq The sequence to fetch for
+     * @param limit The maximum number of offers to return
+     * @return If found in cache, offer keys ordered by quality; otherwise nullopt is returned
+     */
+    std::optional<std::vector<ripple::uint256>>
+    getBookOffers(ripple::uint256 const& book, uint32_t seq, std::uint32_t limit) const;
+
+    /**
+     * @brief Sets the number of ledgers preceding the latest one which lookups can be served for.
+     *
+     * Should be set before the cache is populated. Zero means only the latest ledger is served.
+     *
+     * @param numLedgers The number of recent ledgers to keep
+     */
+    void
+    setNumRecentLedgers(std::size_t numLedgers);
+
+    /**
+     * @brief Sets how cached objects are kept in memory.
+     *
+     * Must be set before the cache is populated; any cached objects are dropped.
+     *
+     * @param mode The memory mode
+     */
+    void
+    setMemoryMode(MemoryMode mode);
+
     /**
      * @brief Disables the cache.
      */
@@ -167,6 +303,12 @@ public:
     size_t
     size() const;
 
+    /**
+     * @return Approximate number of bytes of memory used by the cached objects, not counting the history.
+     */
+    size_t
+    bytes() const;
+
     /**
      * @return A number representing the success rate of hitting an object in the cache versus missing it.
      */
@@ -186,6 +328,22 @@ public:
      */
     void
     waitUntilCacheContainsSeq(uint32_t seq);
+
+private:
+    static std::size_t
+    shardIndex(ripple::uint256 const& key);
+
+    static bool
+    covers(Shard const& shard, uint32_t seq);
+
+    static std::optional<LedgerObject>
+    successorAt(Shard const& shard, std::optional<ripple::uint256> const& key, uint32_t seq);
+
+    static std::optional<LedgerObject>
+    predecessorAt(Shard const& shard, std::optional<ripple::uint256> const& key, uint32_t seq);
+
+    void
+    updateBytesPerObject();
 };
 
 }  // namespace data
@@ -0,0 +1,285 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/LedgerCacheSnapshot.hpp"
+
+#include "data/Types.hpp"
+#include "util/File.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <xrpl/basics/base_uint.h>
+#include <zlib.h>
+
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <expected>
+#include <filesystem>
+#include <functional>
+#include <ios>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+namespace data {
+
+namespace {
+
+constexpr std::array<char, 8> MAGIC = {'C', 'L', 'I', 'O', 'C', 'S', 'N', 'P'};
+constexpr uint32_t BYTE_ORDER_MARK = 0x01020304;
+constexpr std::size_t WRITE_BUFFER_SIZE = 1024 * 1024;
+
+struct Header {
+    std::array<char, 8> magic = MAGIC;
+    uint32_t version = LedgerCacheSnapshot::FORMAT_VERSION;
+    uint32_t byteOrderMark = BYTE_ORDER_MARK;  // snapshots are not portable between architectures
+    uint32_t seq = 0;                          // the oldest ledger any part of the cache was written at
+    uint32_t latestSeq = 0;                    // the latest ledger any part of the cache was written at
+    uint64_t numObjects = 0;
+    uint64_t payloadSize = 0;
+    uint32_t payloadChecksum = 0;
+    uint32_t headerChecksum = 0;  // covers all the fields above
+};
+
+static_assert(std::is_trivially_copyable_v<Header>);
+static_assert(sizeof(Header) == 48);
+
+// key, sequence and size of the blob
+constexpr std::size_t RECORD_HEADER_SIZE = ripple::uint256::size() + sizeof(uint32_t) + sizeof(uint32_t);
+
+uint32_t
+checksum(uint32_t crc, void const* data, std::size_t size)
+{
+    return static_cast<uint32_t>(crc32_z(crc, static_cast<Bytef const*>(data), size));
+}
+
+uint32_t
+headerChecksum(Header const& header)
+{
+    return checksum(0, &header, offsetof(Header, headerChecksum));
+}
+
+template <typename T>
+T
+readAt(unsigned char const* data)
+{
+    T value;
+    std::memcpy(&value, data, sizeof(T));
+    return value;
+}
+
+}  // namespace
+
+namespace impl {
+
+SnapshotWriter::SnapshotWriter(std::filesystem::path path)
+    : path_{std::move(path)}, tmpPath_{path_.string() + ".tmp"}, buffer_(WRITE_BUFFER_SIZE)
+{
+    file_.rdbuf()->pubsetbuf(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+    file_.open(tmpPath_, std::ios::binary | std::ios::trunc);
+
+    Header const placeholder{};
+    file_.write(reinterpret_cast<char const*>(&placeholder), sizeof(placeholder));
+}
+
+void
+SnapshotWriter::add(VersionedLedgerObject const& obj)
+{
+    std::array<unsigned char, RECORD_HEADER_SIZE> record{};
+    auto const size = static_cast<uint32_t>(obj.object.blob.size());
+    std::memcpy(record.data(), obj.object.key.data(), ripple::uint256::size());
+    std::memcpy(record.data() + ripple::uint256::size(), &obj.seq, sizeof(obj.seq));
+    std::memcpy(record.data() + ripple::uint256::size() + sizeof(obj.seq), &size, sizeof(size));
+
+    file_.write(reinterpret_cast<char const*>(record.data()), record.size());
+    file_.write(reinterpret_cast<char const*>(obj.object.blob.data()), size);
+
+    checksum_ = checksum(checksum_, record.data(), record.size());
+    checksum_ = checksum(checksum_, obj.object.blob.data(), size);
+    payloadSize_ += record.size() + size;
+    ++numObjects_;
+}
+
+std::expected<void, std::string>
+SnapshotWriter::finish(uint32_t seq, uint32_t latestSeq)
+{
+    Header header;
+    header.seq = seq;
+    header.latestSeq = latestSeq;
+    header.payloadChecksum = checksum_;
+    header.numObjects = numObjects_;
+    header.payloadSize = payloadSize_;
+    header.headerChecksum = headerChecksum(header);
+
+    file_.seekp(0);
+    file_.write(reinterpret_cast<char const*>(&header), sizeof(header));
+    file_.close();
+
+    std::error_code ec;
+    if (file_.fail()) {
+        std::filesystem::remove(tmpPath_, ec);
+        return std::unexpected{"Failed to write " + tmpPath_.string()};
+    }
+
+    auto res = util::replaceFileDurably(tmpPath_, path_);
+    if (not res.has_value())
+        std::filesystem::remove(tmpPath_, ec);
+
+    return res;
+}
+
+}  // namespace impl
+
+struct LedgerCacheSnapshot::MappedFile {
+    unsigned char const* data = nullptr;
+    std::size_t size = 0;
+
+    MappedFile(unsigned char const* data, std::size_t size) : data{data}, size{size}
+    {
+    }
+
+    ~MappedFile()
+    {
+        munmap(const_cast<unsigned char*>(data), size);  // NOLINT(cppcoreguidelines-pro-type-const-cast)
+    }
+
+    MappedFile(MappedFile const&) = delete;
+    MappedFile&
+    operator=(MappedFile const&) = delete;
+};
+
+LedgerCacheSnapshot::LedgerCacheSnapshot(
+    std::unique_ptr<MappedFile> file,
+    uint32_t seq,
+    uint32_t latestSeq,
+    uint64_t numObjects
+)
+    : file_{std::move(file)}, seq_{seq}, latestSeq_{latestSeq}, numObjects_{numObjects}
+{
+}
+
+LedgerCacheSnapshot::~LedgerCacheSnapshot() = default;
+
+LedgerCacheSnapshot::LedgerCacheSnapshot(LedgerCacheSnapshot&&) noexcept = default;
+
+LedgerCacheSnapshot&
+LedgerCacheSnapshot::operator=(LedgerCacheSnapshot&&) noexcept = default;
+
+std::expected<LedgerCacheSnapshot, std::string>
+LedgerCacheSnapshot::open(std::filesystem::path const& path)
+{
+    auto const fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return std::unexpected{"Can't open " + path.string() + ": " + std::strerror(errno)};
+
+    struct stat st {};
+    if (fstat(fd, &st) != 0 or static_cast<std::size_t>(st.st_size) < sizeof(Header)) {
+        ::close(fd);
+        return std::unexpected{"Snapshot " + path.string() + " is truncated"};
+    }
+
+    auto const size = static_cast<std::size_t>(st.st_size);
+    auto* mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED)
+        return std::unexpected{"Can't map " + path.string() + ": " + std::strerror(errno)};
+
+    madvise(mapped, size, MADV_SEQUENTIAL);
+    auto file = std::make_unique<MappedFile>(static_cast<unsigned char const*>(mapped), size);
+
+    auto const header = readAt<Header>(file->data);
+    if (header.magic != MAGIC)
+        return std::unexpected{path.string() + " is not a cache snapshot"};
+    if (header.version != FORMAT_VERSION or header.byteOrderMark != BYTE_ORDER_MARK)
+        return std::unexpected{"Snapshot " + path.string() + " has incompatible format"};
+    if (header.headerChecksum != headerChecksum(header) or header.payloadSize != size - sizeof(Header) or
+        header.latestSeq < header.seq)
+        return std::unexpected{"Snapshot " + path.string() + " has corrupted header"};
+
+    auto const* payload = file->data + sizeof(Header);
+    if (checksum(0, payload, header.payloadSize) != header.payloadChecksum)
+        return std::unexpected{"Snapshot " + path.string() + " is corrupted"};
+
+    // make sure all records are well formed so restoring can't fail halfway
+    std::size_t offset = 0;
+    uint64_t numObjects = 0;
+    while (offset < header.payloadSize) {
+        if (header.payloadSize - offset < RECORD_HEADER_SIZE)
+            return std::unexpected{"Snapshot " + path.string() + " has malformed records"};
+
+        auto const blobSize = readAt<uint32_t>(payload + offset + RECORD_HEADER_SIZE - sizeof(uint32_t));
+        if (header.payloadSize - offset - RECORD_HEADER_SIZE < blobSize)
+            return std::unexpected{"Snapshot " + path.string() + " has malformed records"};
+
+        offset += RECORD_HEADER_SIZE + blobSize;
+        ++numObjects;
+    }
+
+    if (numObjects != header.numObjects)
+        return std::unexpected{"Snapshot " + path.string() + " has wrong number of objects"};
+
+    return LedgerCacheSnapshot{std::move(file), header.seq, header.latestSeq, header.numObjects};
+}
+
+uint32_t
+LedgerCacheSnapshot::seq() const
+{
+    return seq_;
+}
+
+uint32_t
+LedgerCacheSnapshot::latestSeq() const
+{
+    return latestSeq_;
+}
+
+uint64_t
+LedgerCacheSnapshot::size() const
+{
+    return numObjects_;
+}
+
+void
+LedgerCacheSnapshot::forEach(std::function<void(VersionedLedgerObject)> const& fn) const
+{
+    auto const* it = file_->data + sizeof(Header);
+    auto const* end = file_->data + file_->size;
+
+    while (it < end) {
+        VersionedLedgerObject obj;
+        std::memcpy(obj.object.key.data(), it, ripple::uint256::size());
+        obj.seq = readAt<uint32_t>(it + ripple::uint256::size());
+
+        auto const blobSize = readAt<uint32_t>(it + ripple::uint256::size() + sizeof(uint32_t));
+        it += RECORD_HEADER_SIZE;
+        obj.object.blob.assign(it, it + blobSize);
+        it += blobSize;
+
+        fn(std::move(obj));
+    }
+}
+
+}  // namespace data
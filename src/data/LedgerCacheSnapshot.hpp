@@ -0,0 +1,198 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include "data/Types.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace data {
+
+namespace impl {
+
+/**
+ * @brief Writes the file of a cache snapshot. The file only appears at the given path once it's complete.
+ */
+class SnapshotWriter {
+    std::filesystem::path path_;
+    std::filesystem::path tmpPath_;
+    std::ofstream file_;
+    std::vector<char> buffer_;
+    uint64_t numObjects_ = 0;
+    uint64_t payloadSize_ = 0;
+    uint32_t checksum_ = 0;
+
+public:
+    /**
+     * @brief Construct a new writer and create a temporary file next to the given path.
+     *
+     * @param path The path of the snapshot
+     */
+    explicit SnapshotWriter(std::filesystem::path path);
+
+    /**
+     * @brief Append an object to the snapshot.
+     *
+     * @param obj The object to append
+     */
+    void
+    add(VersionedLedgerObject const& obj);
+
+    /**
+     * @brief Complete the snapshot, sync it to disk and move it to its final path.
+     *
+     * @param seq The oldest sequence any of the added objects was taken at
+     * @param latestSeq The latest sequence any of the added objects was taken at
+     * @return Nothing on success; error message otherwise
+     */
+    std::expected<void, std::string>
+    finish(uint32_t seq, uint32_t latestSeq);
+};
+
+}  // namespace impl
+
+/**
+ * @brief A snapshot of LedgerCache stored on disk.
+ *
+ * Allows to restore a full cache on startup much faster than loading it from the database. The file consists of a
+ * fixed size header followed by the objects in key order. Each object is stored as its key, the sequence it was last
+ * modified at, its size and its data. The header holds the range of ledger sequences the snapshot was taken at and
+ * checksums of itself and of the objects. The file is memory-mapped for reading and is verified in full before
+ * anything is restored from it.
+ *
+ * The cache keeps being updated while the snapshot is written, so parts of it may be taken at different ledgers.
+ * Restoring it at the oldest of them and applying the changes of every later ledger on top brings the whole cache to
+ * the same ledger because applying a change the snapshot already has is a no-op.
+ */
+class LedgerCacheSnapshot {
+public:
+    /** @brief Version of the file format */
+    static constexpr uint32_t FORMAT_VERSION = 2;
+
+private:
+    static constexpr std::size_t RESTORE_BATCH_SIZE = 4096;
+
+    struct MappedFile;
+
+    std::unique_ptr<MappedFile> file_;
+    uint32_t seq_ = 0;
+    uint32_t latestSeq_ = 0;
+    uint64_t numObjects_ = 0;
+
+public:
+    ~LedgerCacheSnapshot();
+
+    LedgerCacheSnapshot(LedgerCacheSnapshot&&) noexcept;
+    LedgerCacheSnapshot&
+    operator=(LedgerCacheSnapshot&&) noexcept;
+
+    /**
+     * @brief Open and verify a snapshot.
+     *
+     * @param path The path of the snapshot
+     * @return The snapshot if it exists and is valid; error message otherwise
+     */
+    [[nodiscard]] static std::expected<LedgerCacheSnapshot, std::string>
+    open(std::filesystem::path const& path);
+
+    /**
+     * @brief Write a snapshot of a full cache, replacing the previous snapshot if any.
+     *
+     * The objects are streamed to disk as the cache is visited; only the part of the cache being written is locked at
+     * any time. The snapshot is synced to disk before this function returns.
+     *
+     * @tparam CacheType The type of the cache
+     * @param cache The cache to write
+     * @param path The path of the snapshot
+     * @return The oldest sequence any part of the snapshot was taken at; error message otherwise
+     */
+    template <typename CacheType>
+    [[nodiscard]] static std::expected<uint32_t, std::string>
+    write(CacheType const& cache, std::filesystem::path const& path)
+    {
+        impl::SnapshotWriter writer{path};
+        auto const [seq, latestSeq] = cache.forEach([&writer](VersionedLedgerObject const& obj) { writer.add(obj); });
+
+        if (auto const res = writer.finish(seq, latestSeq); not res.has_value())
+            return std::unexpected{res.error()};
+
+        return seq;
+    }
+
+    /**
+     * @return The oldest sequence any part of the snapshot was taken at; the cache is restored at this sequence
+     */
+    [[nodiscard]] uint32_t
+    seq() const;
+
+    /**
+     * @return The latest sequence any part of the snapshot was taken at; the snapshot can't be used for earlier ones
+     */
+    [[nodiscard]] uint32_t
+    latestSeq() const;
+
+    /**
+     * @return The number of objects in the snapshot
+     */
+    [[nodiscard]] uint64_t
+    size() const;
+
+    /**
+     * @brief Restore all the objects of the snapshot into an empty cache.
+     *
+     * @tparam CacheType The type of the cache
+     * @param cache The cache to restore into
+     */
+    template <typename CacheType>
+    void
+    restoreInto(CacheType& cache) const
+    {
+        std::vector<VersionedLedgerObject> batch;
+        batch.reserve(RESTORE_BATCH_SIZE);
+
+        forEach([&](VersionedLedgerObject obj) {
+            batch.push_back(std::move(obj));
+            if (batch.size() == RESTORE_BATCH_SIZE) {
+                cache.restore(batch, seq_);
+                batch.clear();
+            }
+        });
+
+        // also marks the sequence as the latest one if the snapshot is empty
+        cache.restore(batch, seq_);
+    }
+
+private:
+    LedgerCacheSnapshot(std::unique_ptr<MappedFile> file, uint32_t seq, uint32_t latestSeq, uint64_t numObjects);
+
+    void
+    forEach(std::function<void(VersionedLedgerObject)> const& fn) const;
+};
+
+}  // namespace data
@@ -0,0 +1,66 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/LedgerHeaderCache.hpp"
+
+#include "util/Assert.hpp"
+
+#include <xrpl/protocol/LedgerHeader.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+
+namespace data {
+
+LedgerHeaderCache::LedgerHeaderCache(std::size_t capacity) : headers_(capacity)
+{
+    ASSERT(capacity != 0, "Ledger header cache capacity must not be zero");
+}
+
+void
+LedgerHeaderCache::put(ripple::LedgerHeader const& header)
+{
+    std::unique_lock const lck{mtx_};
+    auto& slot = headers_[header.seq % headers_.size()];
+    if (not slot.has_value() or slot->seq <= header.seq)
+        slot = header;
+}
+
+std::optional<ripple::LedgerHeader>
+LedgerHeaderCache::get(std::uint32_t seq) const
+{
+    std::shared_lock const lck{mtx_};
+    if (auto const& slot = headers_[seq % headers_.size()]; slot.has_value() and slot->seq == seq)
+        return slot;
+
+    return std::nullopt;
+}
+
+void
+LedgerHeaderCache::clear()
+{
+    std::unique_lock const lck{mtx_};
+    for (auto& slot : headers_)
+        slot.reset();
+}
+
+}  // namespace data
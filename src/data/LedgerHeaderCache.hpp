@@ -0,0 +1,82 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include <xrpl/protocol/LedgerHeader.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <shared_mutex>
+#include <vector>
+
+namespace data {
+
+/**
+ * @brief Cache of the headers of the most recent ledgers.
+ *
+ * Headers are kept in a ring indexed by the ledger sequence so a header of a newer ledger replaces the one of the
+ * ledger it collides with. Used to avoid a database roundtrip per transaction when handlers need the hash and close
+ * time of the ledger a transaction belongs to.
+ */
+class LedgerHeaderCache {
+public:
+    /** @brief Default number of headers kept */
+    static constexpr std::size_t DEFAULT_CAPACITY = 1024;
+
+private:
+    mutable std::shared_mutex mtx_;
+    std::vector<std::optional<ripple::LedgerHeader>> headers_;
+
+public:
+    /**
+     * @brief Construct a new cache
+     *
+     * @param capacity The number of headers to keep; must not be zero
+     */
+    explicit LedgerHeaderCache(std::size_t capacity = DEFAULT_CAPACITY);
+
+    /**
+     * @brief Store a ledger header.
+     *
+     * A header never replaces the header of a newer ledger.
+     *
+     * @param header The header to store
+     */
+    void
+    put(ripple::LedgerHeader const& header);
+
+    /**
+     * @brief Get a cached ledger header.
+     *
+     * @param seq The sequence of the ledger
+     * @return The header if cached; nullopt otherwise
+     */
+    std::optional<ripple::LedgerHeader>
+    get(std::uint32_t seq) const;
+
+    /**
+     * @brief Drop all cached headers.
+     */
+    void
+    clear();
+};
+
+}  // namespace data
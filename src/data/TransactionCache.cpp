@@ -0,0 +1,131 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/TransactionCache.hpp"
+
+#include "data/Types.hpp"
+
+#include <xrpl/basics/base_uint.h>
+
+#include <cstddef>
+#include <mutex>
+#include <optional>
+
+namespace data {
+
+TransactionCache::TransactionCache(std::size_t maxBytes) : maxBytes_{maxBytes}
+{
+}
+
+void
+TransactionCache::setMaxBytes(std::size_t maxBytes)
+{
+    std::scoped_lock const lck{mtx_};
+    maxBytes_ = maxBytes;
+    evict();
+}
+
+void
+TransactionCache::put(ripple::uint256 const& hash, TransactionAndMetadata const& txn)
+{
+    if (txn.transaction.empty())
+        return;
+
+    auto const size = entryBytes(txn);
+
+    std::scoped_lock const lck{mtx_};
+    if (size > maxBytes_)
+        return;
+
+    if (auto const it = index_.find(hash); it != index_.end()) {
+        entries_.splice(entries_.begin(), entries_, it->second);
+        return;
+    }
+
+    entries_.emplace_front(hash, txn);
+    index_.emplace(hash, entries_.begin());
+    bytes_ += size;
+    evict();
+}
+
+std::optional<TransactionAndMetadata>
+TransactionCache::get(ripple::uint256 const& hash) const
+{
+    std::scoped_lock const lck{mtx_};
+    if (maxBytes_ == 0)
+        return std::nullopt;
+
+    ++reqCounter_.get();
+    auto const it = index_.find(hash);
+    if (it == index_.end())
+        return std::nullopt;
+
+    ++hitCounter_.get();
+    entries_.splice(entries_.begin(), entries_, it->second);
+    return it->second->second;
+}
+
+void
+TransactionCache::clear()
+{
+    std::scoped_lock const lck{mtx_};
+    entries_.clear();
+    index_.clear();
+    bytes_ = 0;
+}
+
+bool
+TransactionCache::isEnabled() const
+{
+    std::scoped_lock const lck{mtx_};
+    return maxBytes_ != 0;
+}
+
+std::size_t
+TransactionCache::size() const
+{
+    std::scoped_lock const lck{mtx_};
+    return index_.size();
+}
+
+std::size_t
+TransactionCache::bytes() const
+{
+    std::scoped_lock const lck{mtx_};
+    return bytes_;
+}
+
+std::size_t
+TransactionCache::entryBytes(TransactionAndMetadata const& txn)
+{
+    return txn.transaction.size() + txn.metadata.size() + ENTRY_OVERHEAD;
+}
+
+void
+TransactionCache::evict()
+{
+    while (bytes_ > maxBytes_ and not entries_.empty()) {
+        auto const& [hash, txn] = entries_.back();
+        bytes_ -= entryBytes(txn);
+        index_.erase(hash);
+        entries_.pop_back();
+    }
+}
+
+}  // namespace data
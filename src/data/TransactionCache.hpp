@@ -0,0 +1,146 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include "data/Types.hpp"
+#include "util/prometheus/Counter.hpp"
+#include "util/prometheus/Label.hpp"
+#include "util/prometheus/Prometheus.hpp"
+
+#include <xrpl/basics/base_uint.h>
+#include <xrpl/basics/hardened_hash.h>
+
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+
+namespace data {
+
+/**
+ * @brief Bounded cache of transactions and their metadata keyed by transaction hash.
+ *
+ * The size of the cache is limited by the number of bytes used by the cached transactions. When the limit is reached
+ * the least recently used transactions are evicted, so the cache holds the transactions of the most recent ledgers and
+ * the ones which are looked up often.
+ */
+class TransactionCache {
+public:
+    /** @brief Default maximum number of bytes used by the cached transactions */
+    static constexpr std::size_t DEFAULT_MAX_BYTES = 64 * 1024 * 1024;
+
+private:
+    // rough bookkeeping overhead of a cached transaction besides the blobs
+    static constexpr std::size_t ENTRY_OVERHEAD = 128;
+
+    using Entry = std::pair<ripple::uint256, TransactionAndMetadata>;
+
+    std::reference_wrapper<util::prometheus::CounterInt> reqCounter_{PrometheusService::counterInt(
+        "transaction_cache_counter_total_number",
+        util::prometheus::Labels({{"type", "request"}}),
+        "TransactionCache statistics"
+    )};
+    std::reference_wrapper<util::prometheus::CounterInt> hitCounter_{PrometheusService::counterInt(
+        "transaction_cache_counter_total_number",
+        util::prometheus::Labels({{"type", "cache_hit"}})
+    )};
+
+    mutable std::mutex mtx_;
+    std::size_t maxBytes_;
+    std::size_t bytes_ = 0;
+
+    // most recently used entries first
+    mutable std::list<Entry> entries_;
+    std::unordered_map<ripple::uint256, std::list<Entry>::iterator, ripple::hardened_hash<>> index_;
+
+public:
+    /**
+     * @brief Construct a new cache
+     *
+     * @param maxBytes The maximum number of bytes used by the cached transactions; zero disables the cache
+     */
+    explicit TransactionCache(std::size_t maxBytes = DEFAULT_MAX_BYTES);
+
+    /**
+     * @brief Sets the maximum number of bytes used by the cached transactions.
+     *
+     * Transactions are evicted if the cache is already bigger than that. Zero disables the cache.
+     *
+     * @param maxBytes The maximum number of bytes
+     */
+    void
+    setMaxBytes(std::size_t maxBytes);
+
+    /**
+     * @brief Store a transaction.
+     *
+     * Empty transactions and transactions that are bigger than the whole cache are not stored.
+     *
+     * @param hash The hash of the transaction
+     * @param txn The transaction and its metadata
+     */
+    void
+    put(ripple::uint256 const& hash, TransactionAndMetadata const& txn);
+
+    /**
+     * @brief Get a cached transaction.
+     *
+     * @param hash The hash of the transaction
+     * @return The transaction if cached; nullopt otherwise
+     */
+    std::optional<TransactionAndMetadata>
+    get(ripple::uint256 const& hash) const;
+
+    /**
+     * @brief Drop all cached transactions.
+     */
+    void
+    clear();
+
+    /**
+     * @return true if the cache can hold any transaction; false otherwise
+     */
+    bool
+    isEnabled() const;
+
+    /**
+     * @return The number of cached transactions
+     */
+    std::size_t
+    size() const;
+
+    /**
+     * @return Approximate number of bytes used by the cached transactions
+     */
+    std::size_t
+    bytes() const;
+
+private:
+    static std::size_t
+    entryBytes(TransactionAndMetadata const& txn);
+
+    void
+    evict();
+};
+
+}  // namespace data
@@ -46,6 +46,17 @@ struct LedgerObject {
     operator==(LedgerObject const& other) const = default;
 };
 
+/**
+ * @brief Represents an object in the ledger along with the sequence it was last modified at.
+ */
+struct VersionedLedgerObject {
+    LedgerObject object;
+    std::uint32_t seq = 0;
+
+    bool
+    operator==(VersionedLedgerObject const& other) const = default;
+};
+
 /**
  * @brief Represents a page of LedgerObjects.
  */
@@ -28,6 +28,7 @@
 
 #include <chrono>
 #include <concepts>
+#include <cstddef>
 #include <cstdint>
 #include <optional>
 #include <string>
@@ -62,6 +63,12 @@ concept SomeExecutionStrategy = requires(
 ) {
     { T(settings, handle) };
     { a.sync() } -> std::same_as<void>;
+    { a.writeWatermark() } -> std::same_as<std::uint64_t>;
+    { a.syncUntil(std::uint64_t{}) } -> std::same_as<void>;
+    { a.markLedgerSubmitted(std::uint32_t{}) } -> std::same_as<void>;
+    { a.syncLedger(std::uint32_t{}) } -> std::same_as<void>;
+    { a.stop() } -> std::same_as<void>;
+    { a.spawn([](boost::asio::yield_context) {}) } -> std::same_as<void>;
     { a.isTooBusy() } -> std::same_as<bool>;
     { a.writeSync(statement) } -> std::same_as<ResultOrError>;
     { a.writeSync(prepared) } -> std::same_as<ResultOrError>;
@@ -71,6 +78,7 @@ concept SomeExecutionStrategy = requires(
     { a.read(token, statement) } -> std::same_as<ResultOrError>;
     { a.read(token, statements) } -> std::same_as<ResultOrError>;
     { a.readEach(token, statements) } -> std::same_as<std::vector<Result>>;
+    { a.readEach(token, statements, std::size_t{}) } -> std::same_as<std::vector<Result>>;
     { a.stats() } -> std::same_as<boost::json::object>;
 };
 
@@ -124,6 +124,17 @@ SettingsProvider::parseSettings() const
         config_.valueOr<uint32_t>("core_connections_per_host", settings.coreConnectionsPerHost);
     settings.queueSizeIO = config_.maybeValue<uint32_t>("queue_size_io");
     settings.writeBatchSize = config_.valueOr<std::size_t>("write_batch_size", settings.writeBatchSize);
+    settings.readBatchSize = config_.valueOr<std::size_t>("read_batch_size", settings.readBatchSize);
+    if (settings.readBatchSize == 0)
+        throw std::runtime_error("`read_batch_size` must be greater than 0");
+
+    settings.maxReadBatchesInFlight =
+        config_.valueOr<std::size_t>("max_read_batches_in_flight", settings.maxReadBatchesInFlight);
+    if (settings.maxReadBatchesInFlight == 0)
+        throw std::runtime_error("`max_read_batches_in_flight` must be greater than 0");
+
+    settings.maxReadAheadsInFlight =
+        config_.valueOr<std::size_t>("max_read_aheads_in_flight", settings.maxReadAheadsInFlight);
 
     auto const connectTimeoutSecond = config_.maybeValue<uint32_t>("connect_timeout");
     if (connectTimeoutSecond)
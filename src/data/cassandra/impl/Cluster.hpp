@@ -43,6 +43,9 @@ struct Settings {
     static constexpr uint32_t DEFAULT_MAX_WRITE_REQUESTS_OUTSTANDING = 10'000;
     static constexpr uint32_t DEFAULT_MAX_READ_REQUESTS_OUTSTANDING = 100'000;
     static constexpr std::size_t DEFAULT_BATCH_SIZE = 20;
+    static constexpr std::size_t DEFAULT_READ_BATCH_SIZE = 50;
+    static constexpr std::size_t DEFAULT_MAX_READ_BATCHES_IN_FLIGHT = 16;
+    static constexpr std::size_t DEFAULT_MAX_READ_AHEADS_IN_FLIGHT = 16;
 
     /**
      * @brief Represents the configuration of contact points for cassandra.
@@ -77,7 +80,7 @@ struct Settings {
     /** @brief The maximum number of outstanding write requests at any given moment */
     uint32_t maxWriteRequestsOutstanding = DEFAULT_MAX_WRITE_REQUESTS_OUTSTANDING;
 
-    /** @brief The maximum number of outstanding read requests at any given moment */
+    /** @brief The maximum number of outstanding read requests at any given moment; a multi-key statement counts once */
     uint32_t maxReadRequestsOutstanding = DEFAULT_MAX_READ_REQUESTS_OUTSTANDING;
 
     /** @brief The number of connection per host to always have active */
@@ -86,6 +89,15 @@ struct Settings {
     /** @brief Size of batches when writing */
     std::size_t writeBatchSize = DEFAULT_BATCH_SIZE;
 
+    /** @brief The maximum number of keys read by a single multi-key statement */
+    std::size_t readBatchSize = DEFAULT_READ_BATCH_SIZE;
+
+    /** @brief The maximum number of multi-key statements of a single read that are executed at the same time */
+    std::size_t maxReadBatchesInFlight = DEFAULT_MAX_READ_BATCHES_IN_FLIGHT;
+
+    /** @brief The maximum number of account_tx read-aheads running at the same time; 0 disables read-ahead */
+    std::size_t maxReadAheadsInFlight = DEFAULT_MAX_READ_AHEADS_IN_FLIGHT;
+
     /** @brief Size of the IO queue */
     std::optional<uint32_t> queueSizeIO = std::nullopt;  // NOLINT(readability-redundant-member-init)
 
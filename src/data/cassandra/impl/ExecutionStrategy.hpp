@@ -35,18 +35,22 @@
 #include <boost/asio/spawn.hpp>
 #include <boost/json/object.hpp>
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
 #include <cstddef>
 #include <cstdint>
 #include <functional>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <optional>
+#include <set>
 #include <stdexcept>
 #include <thread>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace data::cassandra::impl {
@@ -77,6 +81,11 @@ class DefaultExecutionStrategy {
     std::mutex syncMutex_;
     std::condition_variable syncCv_;
 
+    // every write gets an increasing id when submitted; all three are guarded by syncMutex_
+    std::uint64_t nextWriteId_ = 0u;
+    std::set<std::uint64_t> pendingWrites_;
+    std::map<std::uint32_t, std::uint64_t> ledgerWatermarks_;
+
     boost::asio::io_context ioc_;
     std::optional<boost::asio::io_service::work> work_;
 
@@ -116,10 +125,34 @@ public:
     }
 
     ~DefaultExecutionStrategy()
+    {
+        stop();
+    }
+
+    /**
+     * @brief Stop the internal io context and join its thread.
+     *
+     * Coroutines started with @ref spawn that did not finish yet are not resumed after this returns.
+     */
+    void
+    stop()
     {
         work_.reset();
         ioc_.stop();
-        thread_.join();
+        if (thread_.joinable())
+            thread_.join();
+    }
+
+    /**
+     * @brief Spawn a coroutine on the internal io context.
+     *
+     * @param fn The coroutine to run; receives a yield_context
+     */
+    template <typename FnType>
+    void
+    spawn(FnType&& fn)
+    {
+        boost::asio::spawn(ioc_, std::forward<FnType>(fn));
     }
 
     /**
@@ -134,6 +167,68 @@ public:
         LOG(log_.debug()) << "Sync done.";
     }
 
+    /**
+     * @return A watermark covering all the writes submitted so far; to be passed to @ref syncUntil
+     */
+    std::uint64_t
+    writeWatermark()
+    {
+        std::lock_guard const lck(syncMutex_);
+        return nextWriteId_;
+    }
+
+    /**
+     * @brief Wait for the writes submitted before the given watermark to finish.
+     *
+     * Unlike @ref sync, writes submitted after the watermark was taken are not waited for.
+     *
+     * @param watermark The watermark obtained from @ref writeWatermark
+     */
+    void
+    syncUntil(std::uint64_t watermark)
+    {
+        LOG(log_.debug()) << "Waiting to sync writes up to " << watermark << "...";
+        std::unique_lock<std::mutex> lck(syncMutex_);
+        syncCv_.wait(lck, [this, watermark]() {
+            return pendingWrites_.empty() or *pendingWrites_.begin() >= watermark;
+        });
+        LOG(log_.debug()) << "Sync done.";
+    }
+
+    /**
+     * @brief Remember that all the writes of the given ledger were submitted.
+     *
+     * @param ledgerSequence The ledger whose writes were all submitted
+     */
+    void
+    markLedgerSubmitted(std::uint32_t ledgerSequence)
+    {
+        std::lock_guard const lck(syncMutex_);
+        ledgerWatermarks_[ledgerSequence] = nextWriteId_;
+    }
+
+    /**
+     * @brief Wait for the writes of the given ledger and of the ones before it to finish.
+     *
+     * Writes of later ledgers are not waited for if the ledger was passed to @ref markLedgerSubmitted; otherwise all
+     * the writes submitted so far are waited for.
+     *
+     * @param ledgerSequence The ledger to wait for
+     */
+    void
+    syncLedger(std::uint32_t ledgerSequence)
+    {
+        auto watermark = std::uint64_t{0u};
+        {
+            std::lock_guard const lck(syncMutex_);
+            auto const it = ledgerWatermarks_.find(ledgerSequence);
+            watermark = it != ledgerWatermarks_.end() ? it->second : nextWriteId_;
+            ledgerWatermarks_.erase(ledgerWatermarks_.begin(), ledgerWatermarks_.upper_bound(ledgerSequence));
+        }
+
+        syncUntil(watermark);
+    }
+
     /**
      * @return true if outstanding read requests allowance is exhausted; false otherwise
      */
@@ -196,7 +291,7 @@ public:
         auto const startTime = std::chrono::steady_clock::now();
 
         auto statement = preparedStatement.bind(std::forward<Args>(args)...);
-        incrementOutstandingRequestCount();
+        auto const writeId = incrementOutstandingRequestCount();
 
         counters_->registerWriteStarted();
         // Note: lifetime is controlled by std::shared_from_this internally
@@ -204,8 +299,8 @@ public:
             ioc_,
             handle_,
             std::move(statement),
-            [this, startTime](auto const&) {
-                decrementOutstandingRequestCount();
+            [this, startTime, writeId](auto const&) {
+                decrementOutstandingRequestCount(writeId);
 
                 counters_->registerWriteFinished(startTime);
             },
@@ -234,7 +329,7 @@ public:
             chunk.reserve(std::distance(begin, end));
             std::move(begin, end, std::back_inserter(chunk));
 
-            incrementOutstandingRequestCount();
+            auto const writeId = incrementOutstandingRequestCount();
             counters_->registerWriteStarted();
 
             // Note: lifetime is controlled by std::shared_from_this internally
@@ -242,8 +337,8 @@ public:
                 ioc_,
                 handle_,
                 std::move(chunk),
-                [this, startTime](auto const&) {
-                    decrementOutstandingRequestCount();
+                [this, startTime, writeId](auto const&) {
+                    decrementOutstandingRequestCount(writeId);
                     counters_->registerWriteFinished(startTime);
                 },
                 [this]() { counters_->registerWriteRetry(); }
@@ -391,22 +486,65 @@ public:
     std::vector<ResultType>
     readEach(CompletionTokenType token, std::vector<StatementType> const& statements)
     {
+        return readEach(token, statements, statements.size());
+    }
+
+    /**
+     * @brief Coroutine-based query execution used for reading data.
+     *
+     * Attempts to execute each statement keeping at most maxInFlight of them executing at the same time. The
+     * coroutine is resumed once when all of the statements completed. On any error the whole vector will be
+     * discarded and exception will be thrown.
+     *
+     * @param token Completion token (yield_context)
+     * @param statements Statements to execute
+     * @param maxInFlight The maximum number of statements executing at the same time
+     * @throw DatabaseTimeout on db error
+     * @return Vector of results
+     */
+    std::vector<ResultType>
+    readEach(CompletionTokenType token, std::vector<StatementType> const& statements, std::size_t maxInFlight)
+    {
+        ASSERT(maxInFlight > 0, "At least one statement must be allowed to execute");
+        if (statements.empty())
+            return {};
+
         auto const startTime = std::chrono::steady_clock::now();
+        auto const numStatements = statements.size();
 
         std::atomic_uint64_t errorsCount = 0u;
-        std::atomic_int numOutstanding = statements.size();
-        numReadRequestsOutstanding_ += statements.size();
+        // every statement is accounted for twice: once its future is stored and once it completed
+        std::atomic_size_t numOutstanding = numStatements * 2;
+        auto const numInitial = std::min(maxInFlight, numStatements);
+        std::atomic_size_t nextStatement = numInitial;
+        numReadRequestsOutstanding_ += numStatements;
 
-        auto futures = std::vector<FutureWithCallbackType>{};
-        futures.reserve(numOutstanding);
-        counters_->registerReadStarted(statements.size());
+        auto futures = std::vector<std::optional<FutureWithCallbackType>>(numStatements);
+        counters_->registerReadStarted(numStatements);
 
-        auto init = [this, &statements, &futures, &errorsCount, &numOutstanding]<typename Self>(Self& self) {
-            auto sself = std::make_shared<Self>(std::move(self));
-            auto executionHandler = [&errorsCount, &numOutstanding, sself](auto const& res) mutable {
-                if (not res)
-                    ++errorsCount;
+        // statements are executed from the completion handlers of the previous ones so these must outlive init
+        std::function<void()> onDone;
+        std::function<void(std::size_t)> execute;
 
+        execute = [this, &statements, &futures, &errorsCount, &nextStatement, &execute, &onDone](std::size_t idx) {
+            futures[idx].emplace(handle_.get().asyncExecute(
+                statements[idx],
+                [&statements, &errorsCount, &nextStatement, &execute, &onDone](auto const& res) {
+                    if (not res)
+                        ++errorsCount;
+
+                    if (auto const next = nextStatement++; next < statements.size())
+                        execute(next);
+
+                    onDone();
+                }
+            ));
+            onDone();
+        };
+
+        auto init = [&onDone, &execute, &numOutstanding, numInitial]<typename Self>(Self& self) {
+            auto sself = std::make_shared<Self>(std::move(self));
+            onDone = [&numOutstanding, sself]() {
                 // when all async operations complete unblock the result
                 if (--numOutstanding == 0) {
                     boost::asio::post(boost::asio::get_associated_executor(*sself), [sself]() mutable {
@@ -415,28 +553,22 @@ public:
                 }
             };
 
-            std::transform(
-                std::cbegin(statements),
-                std::cend(statements),
-                std::back_inserter(futures),
-                [this, &executionHandler](auto const& statement) {
-                    return handle_.get().asyncExecute(statement, executionHandler);
-                }
-            );
+            for (std::size_t idx = 0; idx < numInitial; ++idx)
+                execute(idx);
         };
 
         boost::asio::async_compose<CompletionTokenType, void()>(
             init, token, boost::asio::get_associated_executor(token)
         );
-        numReadRequestsOutstanding_ -= statements.size();
+        numReadRequestsOutstanding_ -= numStatements;
 
         if (errorsCount > 0) {
-            ASSERT(errorsCount <= statements.size(), "Errors number cannot exceed statements number");
+            ASSERT(errorsCount <= numStatements, "Errors number cannot exceed statements number");
             counters_->registerReadError(errorsCount);
-            counters_->registerReadFinished(startTime, statements.size() - errorsCount);
+            counters_->registerReadFinished(startTime, numStatements - errorsCount);
             throw DatabaseTimeout{};
         }
-        counters_->registerReadFinished(startTime, statements.size());
+        counters_->registerReadFinished(startTime, numStatements);
 
         std::vector<ResultType> results;
         results.reserve(futures.size());
@@ -447,23 +579,17 @@ public:
             std::make_move_iterator(std::end(futures)),
             std::back_inserter(results),
             [](auto&& future) {
-                auto entry = future.get();
+                auto entry = future->get();
                 auto&& res = entry.value();
                 return std::move(res);
             }
         );
 
         ASSERT(
-            futures.size() == statements.size(),
-            "Futures size must be equal to statements size. Got {} and {}",
-            futures.size(),
-            statements.size()
-        );
-        ASSERT(
-            results.size() == statements.size(),
+            results.size() == numStatements,
             "Results size must be equal to statements size. Got {} and {}",
             results.size(),
-            statements.size()
+            numStatements
         );
         return results;
     }
@@ -478,7 +604,7 @@ public:
     }
 
 private:
-    void
+    std::uint64_t
     incrementOutstandingRequestCount()
     {
         {
@@ -490,26 +616,35 @@ private:
             }
         }
         ++numWriteRequestsOutstanding_;
+
+        std::lock_guard const lck(syncMutex_);
+        auto const writeId = nextWriteId_++;
+        pendingWrites_.insert(pendingWrites_.end(), writeId);
+        return writeId;
     }
 
     void
-    decrementOutstandingRequestCount()
+    decrementOutstandingRequestCount(std::uint64_t writeId)
     {
         // sanity check
         ASSERT(numWriteRequestsOutstanding_ > 0, "Decrementing num outstanding below 0");
-        size_t const cur = (--numWriteRequestsOutstanding_);
+        --numWriteRequestsOutstanding_;
         {
             // mutex lock required to prevent race condition around spurious
             // wakeup
             std::lock_guard const lck(throttleMutex_);
             throttleCv_.notify_one();
         }
-        if (cur == 0) {
-            // mutex lock required to prevent race condition around spurious
-            // wakeup
-            std::lock_guard const lck(syncMutex_);
-            syncCv_.notify_one();
-        }
+
+        std::lock_guard const lck(syncMutex_);
+        auto const it = pendingWrites_.find(writeId);
+        ASSERT(it != pendingWrites_.end(), "Finished a write that is not pending");
+
+        // only finishing the oldest pending write can complete a sync
+        auto const wasOldest = it == pendingWrites_.begin();
+        pendingWrites_.erase(it);
+        if (wasOldest)
+            syncCv_.notify_all();
     }
 
     bool
@@ -521,7 +656,7 @@ private:
     bool
     finishedAllWriteRequests() const
     {
-        return numWriteRequestsOutstanding_ == 0;
+        return pendingWrites_.empty();
     }
 
     void
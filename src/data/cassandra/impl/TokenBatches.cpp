@@ -0,0 +1,128 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/cassandra/impl/TokenBatches.hpp"
+
+#include "util/Batching.hpp"
+
+#include <xrpl/basics/base_uint.h>
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+namespace {
+
+constexpr std::uint64_t C1 = 0x87c37b91114253d5ULL;
+constexpr std::uint64_t C2 = 0x4cf5ad432745937fULL;
+constexpr std::size_t BLOCK_SIZE = 16u;
+
+std::uint64_t
+readLittleEndian(unsigned char const* data)
+{
+    std::uint64_t result = 0;
+    for (auto i = sizeof(result); i > 0; --i)
+        result = (result << 8u) | data[i - 1];
+    return result;
+}
+
+std::uint64_t
+finalMix(std::uint64_t k)
+{
+    k ^= k >> 33u;
+    k *= 0xff51afd7ed558ccdULL;
+    k ^= k >> 33u;
+    k *= 0xc4ceb9fe1a85ec53ULL;
+    k ^= k >> 33u;
+    return k;
+}
+
+}  // namespace
+
+namespace data::cassandra::impl {
+
+std::int64_t
+murmur3Token(ripple::uint256 const& key)
+{
+    // MurmurHash3_x64_128 with seed 0; the token is the first half of the hash. The key size is a multiple of the
+    // block size so there is no tail to process.
+    static_assert(ripple::uint256::size() % BLOCK_SIZE == 0);
+
+    std::uint64_t h1 = 0;
+    std::uint64_t h2 = 0;
+
+    for (std::size_t offset = 0; offset < key.size(); offset += BLOCK_SIZE) {
+        auto k1 = readLittleEndian(key.data() + offset);
+        auto k2 = readLittleEndian(key.data() + offset + sizeof(k1));
+
+        k1 *= C1;
+        k1 = std::rotl(k1, 31);
+        k1 *= C2;
+        h1 ^= k1;
+        h1 = std::rotl(h1, 27);
+        h1 += h2;
+        h1 = h1 * 5 + 0x52dce729;
+
+        k2 *= C2;
+        k2 = std::rotl(k2, 33);
+        k2 *= C1;
+        h2 ^= k2;
+        h2 = std::rotl(h2, 31);
+        h2 += h1;
+        h2 = h2 * 5 + 0x38495ab5;
+    }
+
+    h1 ^= key.size();
+    h2 ^= key.size();
+    h1 += h2;
+    h2 += h1;
+    h1 = finalMix(h1);
+    h2 = finalMix(h2);
+    h1 += h2;
+
+    // the partitioner reserves the minimum value
+    auto const token = static_cast<std::int64_t>(h1);
+    return token == std::numeric_limits<std::int64_t>::min() ? std::numeric_limits<std::int64_t>::max() : token;
+}
+
+std::vector<std::vector<std::size_t>>
+makeTokenBatches(std::vector<ripple::uint256> const& keys, std::size_t batchSize)
+{
+    std::vector<std::int64_t> tokens;
+    tokens.reserve(keys.size());
+    std::transform(std::cbegin(keys), std::cend(keys), std::back_inserter(tokens), murmur3Token);
+
+    std::vector<std::size_t> order(keys.size());
+    std::iota(std::begin(order), std::end(order), 0u);
+    std::sort(std::begin(order), std::end(order), [&tokens](auto lhs, auto rhs) { return tokens[lhs] < tokens[rhs]; });
+
+    std::vector<std::vector<std::size_t>> batches;
+    batches.reserve((keys.size() + batchSize - 1) / batchSize);
+
+    util::forEachBatch(order, batchSize, [&batches](auto begin, auto end) { batches.emplace_back(begin, end); });
+
+    return batches;
+}
+
+}  // namespace data::cassandra::impl
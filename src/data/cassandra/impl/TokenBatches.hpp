@@ -0,0 +1,54 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include <xrpl/basics/base_uint.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace data::cassandra::impl {
+
+/**
+ * @brief Calculate the token that the Murmur3Partitioner assigns to a partition key.
+ *
+ * Keys with neighbouring tokens are most likely owned by the same replicas.
+ *
+ * @param key The partition key
+ * @return The token of the key
+ */
+std::int64_t
+murmur3Token(ripple::uint256 const& key);
+
+/**
+ * @brief Split keys into batches of keys with neighbouring tokens.
+ *
+ * Used to read many partitions with a few multi-key statements instead of one statement per key. Grouping keys by
+ * token keeps the replicas involved in each statement to a minimum.
+ *
+ * @param keys The keys to split
+ * @param batchSize The maximum number of keys in a batch; must be positive
+ * @return Batches of indices into keys
+ */
+std::vector<std::vector<std::size_t>>
+makeTokenBatches(std::vector<ripple::uint256> const& keys, std::size_t batchSize);
+
+}  // namespace data::cassandra::impl
@@ -0,0 +1,139 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/impl/BlobCompressor.hpp"
+
+#include "data/Types.hpp"
+#include "util/Assert.hpp"
+
+#include <zlib.h>
+
+#include <cstddef>
+#include <optional>
+#include <span>
+
+namespace data::impl {
+
+namespace {
+
+/**
+ * @brief Inflate stream reused by all decompressions on the current thread.
+ */
+class ThreadInflateStream {
+    z_stream stream_{};
+
+public:
+    ThreadInflateStream()
+    {
+        [[maybe_unused]] auto const res = inflateInit2(&stream_, -BlobCompressor::WINDOW_BITS);
+        ASSERT(res == Z_OK, "Failed to initialize inflate stream: {}", res);
+    }
+
+    ~ThreadInflateStream()
+    {
+        inflateEnd(&stream_);
+    }
+
+    ThreadInflateStream(ThreadInflateStream const&) = delete;
+    ThreadInflateStream&
+    operator=(ThreadInflateStream const&) = delete;
+
+    z_stream&
+    get()
+    {
+        inflateReset(&stream_);
+        return stream_;
+    }
+};
+
+}  // namespace
+
+BlobCompressor::~BlobCompressor()
+{
+    if (primed_)
+        deflateEnd(&primedStream_);
+}
+
+std::optional<Blob>
+BlobCompressor::compress(Blob const& blob)
+{
+    if (dictionary_.empty()) {
+        samples_.append(blob.begin(), blob.end());
+        if (samples_.size() < DICTIONARY_SIZE)
+            return std::nullopt;
+
+        // deflate prefers the most common strings at the end of the dictionary, samples are all equally good
+        dictionary_ = samples_.substr(samples_.size() - DICTIONARY_SIZE);
+        samples_.clear();
+        samples_.shrink_to_fit();
+
+        [[maybe_unused]] auto const res = deflateInit2(
+            &primedStream_, Z_BEST_SPEED, Z_DEFLATED, -WINDOW_BITS, MEM_LEVEL, Z_DEFAULT_STRATEGY
+        );
+        ASSERT(res == Z_OK, "Failed to initialize deflate stream: {}", res);
+        deflateSetDictionary(
+            &primedStream_, reinterpret_cast<Bytef const*>(dictionary_.data()), static_cast<uInt>(dictionary_.size())
+        );
+        primed_ = true;
+        return std::nullopt;
+    }
+
+    // copying the primed stream is much cheaper than hashing the dictionary for every blob
+    z_stream stream{};
+    if (deflateCopy(&stream, &primedStream_) != Z_OK)
+        return std::nullopt;
+
+    Blob result(deflateBound(&stream, static_cast<uLong>(blob.size())));
+    stream.next_in = const_cast<Bytef*>(blob.data());  // NOLINT(cppcoreguidelines-pro-type-const-cast)
+    stream.avail_in = static_cast<uInt>(blob.size());
+    stream.next_out = result.data();
+    stream.avail_out = static_cast<uInt>(result.size());
+
+    auto const res = deflate(&stream, Z_FINISH);
+    auto const compressedSize = stream.total_out;
+    deflateEnd(&stream);
+
+    if (res != Z_STREAM_END or compressedSize >= blob.size())
+        return std::nullopt;
+
+    result.resize(compressedSize);
+    return result;
+}
+
+Blob
+BlobCompressor::decompress(std::span<unsigned char const> data, std::size_t size) const
+{
+    thread_local ThreadInflateStream threadStream;
+    auto& stream = threadStream.get();
+
+    Blob result(size);
+    stream.next_in = const_cast<Bytef*>(data.data());  // NOLINT(cppcoreguidelines-pro-type-const-cast)
+    stream.avail_in = static_cast<uInt>(data.size());
+    stream.next_out = result.data();
+    stream.avail_out = static_cast<uInt>(result.size());
+
+    inflateSetDictionary(
+        &stream, reinterpret_cast<Bytef const*>(dictionary_.data()), static_cast<uInt>(dictionary_.size())
+    );
+    auto const res = inflate(&stream, Z_FINISH);
+    ASSERT(res == Z_STREAM_END, "Failed to decompress cached blob: {}", res);
+    return result;
+}
+
+}  // namespace data::impl
@@ -0,0 +1,94 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include "data/Types.hpp"
+
+#include <zlib.h>
+
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <string>
+
+namespace data::impl {
+
+/**
+ * @brief Deflate based compression of ledger object blobs using a preset dictionary.
+ *
+ * Serialized ledger objects are too small to compress well on their own, but they share a lot of structure (field
+ * codes, account IDs, currencies). The dictionary is sampled from the first blobs passed to @ref compress and is fixed
+ * afterwards. Blobs seen before the dictionary is complete are not compressed.
+ *
+ * @note @ref compress must not be called concurrently. @ref decompress is thread safe.
+ */
+class BlobCompressor {
+public:
+    /**
+     * @brief Size of the history window of raw deflate streams.
+     *
+     * Blobs are small so a small window loses next to nothing while it keeps the per blob stream state small.
+     */
+    static constexpr int WINDOW_BITS = 12;
+
+    /** @brief Size of the dictionary. Deflate can't reference data further back than the window anyway */
+    static constexpr std::size_t DICTIONARY_SIZE = std::size_t{1} << WINDOW_BITS;
+
+    /** @brief Memory level of deflate streams. Lower means a smaller hash table to copy for every blob */
+    static constexpr int MEM_LEVEL = 4;
+
+private:
+    std::string samples_;
+    std::string dictionary_;
+    z_stream primedStream_{};  // has the dictionary set but never deflates anything itself
+    bool primed_ = false;
+
+public:
+    BlobCompressor() = default;
+    ~BlobCompressor();
+
+    BlobCompressor(BlobCompressor const&) = delete;
+    BlobCompressor(BlobCompressor&&) = delete;
+    BlobCompressor&
+    operator=(BlobCompressor const&) = delete;
+    BlobCompressor&
+    operator=(BlobCompressor&&) = delete;
+
+    /**
+     * @brief Compress a blob.
+     *
+     * @param blob The blob to compress
+     * @return The compressed data if the dictionary is ready and compression actually saves space; nullopt otherwise
+     */
+    [[nodiscard]] std::optional<Blob>
+    compress(Blob const& blob);
+
+    /**
+     * @brief Decompress data produced by @ref compress.
+     *
+     * @param data The compressed data
+     * @param size The size of the original blob
+     * @return The original blob
+     */
+    [[nodiscard]] Blob
+    decompress(std::span<unsigned char const> data, std::size_t size) const;
+};
+
+}  // namespace data::impl
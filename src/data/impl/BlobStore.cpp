@@ -0,0 +1,132 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/impl/BlobStore.hpp"
+
+#include "data/Types.hpp"
+#include "data/impl/BlobCompressor.hpp"
+#include "util/Assert.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <utility>
+
+namespace data::impl {
+
+ArenaBlobStore::ArenaBlobStore(std::shared_ptr<BlobCompressor> compressor) : compressor_{std::move(compressor)}
+{
+}
+
+ArenaBlobStore::Handle
+ArenaBlobStore::store(Blob const& blob)
+{
+    ASSERT(blob.size() <= SIZE_MASK, "Blob of {} bytes is too large for the cache arena", blob.size());
+
+    if (compressor_) {
+        if (auto const compressed = compressor_->compress(blob); compressed) {
+            Blob record;
+            record.reserve(SIZE_PREFIX_BYTES + compressed->size());
+            for (std::size_t i = 0; i < SIZE_PREFIX_BYTES; ++i)
+                record.push_back(static_cast<unsigned char>(blob.size() >> (8 * i)));
+            record.insert(record.end(), compressed->begin(), compressed->end());
+
+            return append(record.data(), record.size(), true);
+        }
+    }
+
+    return append(blob.data(), blob.size(), false);
+}
+
+ArenaBlobStore::Handle
+ArenaBlobStore::append(unsigned char const* data, std::size_t size, bool compressed)
+{
+    if (chunks_.empty() or chunks_.back().capacity() - chunks_.back().size() < size) {
+        auto const chunkSize = std::max(std::clamp(allocatedBytes_, MIN_CHUNK_SIZE, MAX_CHUNK_SIZE), size);
+        chunks_.emplace_back().reserve(chunkSize);
+        allocatedBytes_ += chunkSize;
+    }
+
+    auto& chunk = chunks_.back();
+    auto const offset = chunk.size();
+    chunk.insert(chunk.end(), data, data + size);
+
+    auto const chunkIndex = static_cast<uint64_t>(chunks_.size() - 1);
+    return (chunkIndex << CHUNK_SHIFT) | (static_cast<uint64_t>(offset) << OFFSET_SHIFT) |
+        (compressed ? COMPRESSED_FLAG : 0) | size;
+}
+
+unsigned char const*
+ArenaBlobStore::dataOf(Handle handle) const
+{
+    return chunks_[handle >> CHUNK_SHIFT].data() + ((handle >> OFFSET_SHIFT) & OFFSET_MASK);
+}
+
+Blob
+ArenaBlobStore::load(Handle const& handle) const
+{
+    auto const size = handle & SIZE_MASK;
+    auto const* data = dataOf(handle);
+
+    if ((handle & COMPRESSED_FLAG) == 0)
+        return Blob(data, data + size);
+
+    std::size_t originalSize = 0;
+    for (std::size_t i = 0; i < SIZE_PREFIX_BYTES; ++i)
+        originalSize |= static_cast<std::size_t>(data[i]) << (8 * i);
+
+    return compressor_->decompress(
+        std::span<unsigned char const>{data + SIZE_PREFIX_BYTES, size - SIZE_PREFIX_BYTES}, originalSize
+    );
+}
+
+void
+ArenaBlobStore::release(Handle& handle)
+{
+    unusedBytes_ += handle & SIZE_MASK;
+    handle = 0;
+}
+
+ArenaBlobStore::Handle
+ArenaBlobStore::moveTo(Handle& handle, ArenaBlobStore& target) const
+{
+    return target.append(dataOf(handle), handle & SIZE_MASK, (handle & COMPRESSED_FLAG) != 0);
+}
+
+ArenaBlobStore
+ArenaBlobStore::makeEmpty() const
+{
+    return ArenaBlobStore{compressor_};
+}
+
+bool
+ArenaBlobStore::needsCompaction() const
+{
+    return allocatedBytes_ > MIN_SIZE_TO_COMPACT and unusedBytes_ * 2 > allocatedBytes_;
+}
+
+std::size_t
+ArenaBlobStore::bytes() const
+{
+    return allocatedBytes_;
+}
+
+}  // namespace data::impl
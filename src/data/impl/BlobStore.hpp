@@ -0,0 +1,212 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include "data/Types.hpp"
+#include "data/impl/BlobCompressor.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace data::impl {
+
+/**
+ * @brief Keeps every blob in its own heap allocation.
+ */
+class HeapBlobStore {
+    // rough per allocation overhead of the general purpose allocator
+    static constexpr std::size_t ALLOCATION_OVERHEAD = 16;
+
+    std::size_t bytes_ = 0;
+
+public:
+    using Handle = Blob;
+
+    /**
+     * @brief Store a blob.
+     *
+     * @param blob The blob to store
+     * @return Handle to the stored blob
+     */
+    [[nodiscard]] Handle
+    store(Blob const& blob)
+    {
+        bytes_ += blob.size() + ALLOCATION_OVERHEAD;
+        return blob;
+    }
+
+    /**
+     * @param handle Handle to a stored blob
+     * @return A copy of the blob
+     */
+    [[nodiscard]] Blob
+    load(Handle const& handle) const
+    {
+        return handle;
+    }
+
+    /**
+     * @brief Release a blob that is no longer used.
+     *
+     * @param handle Handle to the blob
+     */
+    void
+    release(Handle& handle)
+    {
+        bytes_ -= handle.size() + ALLOCATION_OVERHEAD;
+        Blob{}.swap(handle);
+    }
+
+    /**
+     * @brief Move a blob into another store.
+     *
+     * @param handle Handle to the blob
+     * @param target The store to move to
+     * @return Handle to the blob in the target store
+     */
+    [[nodiscard]] Handle
+    moveTo(Handle& handle, HeapBlobStore& target) const
+    {
+        target.bytes_ += handle.size() + ALLOCATION_OVERHEAD;
+        return std::move(handle);
+    }
+
+    /** @return An empty store with the same settings */
+    [[nodiscard]] HeapBlobStore
+    makeEmpty() const
+    {
+        return {};
+    }
+
+    /** @return Always false as there is no unused memory kept by this store */
+    [[nodiscard]] bool
+    needsCompaction() const
+    {
+        return false;
+    }
+
+    /** @return Approximate number of bytes used by the blobs */
+    [[nodiscard]] std::size_t
+    bytes() const
+    {
+        return bytes_;
+    }
+};
+
+/**
+ * @brief Keeps blobs back to back in large chunks of memory.
+ *
+ * Chunks are never reallocated so the arena grows without copying. Released blobs leave holes in the chunks which are
+ * reclaimed by moving all live blobs into a fresh store once more than half of the arena is unused. Optionally blobs
+ * are compressed.
+ */
+class ArenaBlobStore {
+    // chunks grow with the arena until they reach the max size
+    static constexpr std::size_t MIN_CHUNK_SIZE = 4 * 1024;
+    static constexpr std::size_t MAX_CHUNK_SIZE = 64 * 1024;
+
+    // a handle packs the index of the chunk, the offset in the chunk, a compression flag and the stored size
+    static constexpr unsigned SIZE_BITS = 24;
+    static constexpr uint64_t SIZE_MASK = (uint64_t{1} << SIZE_BITS) - 1;
+    static constexpr uint64_t COMPRESSED_FLAG = uint64_t{1} << SIZE_BITS;
+    static constexpr unsigned OFFSET_SHIFT = SIZE_BITS + 1;
+    static constexpr unsigned OFFSET_BITS = 16;
+    static constexpr uint64_t OFFSET_MASK = (uint64_t{1} << OFFSET_BITS) - 1;
+    static constexpr unsigned CHUNK_SHIFT = OFFSET_SHIFT + OFFSET_BITS;
+    static_assert(MAX_CHUNK_SIZE - 1 <= OFFSET_MASK);
+
+    // compressed blobs are prefixed with the size of the original blob
+    static constexpr std::size_t SIZE_PREFIX_BYTES = 3;
+
+    static constexpr std::size_t MIN_SIZE_TO_COMPACT = 64 * 1024;
+
+    std::vector<std::vector<unsigned char>> chunks_;
+    std::size_t allocatedBytes_ = 0;
+    std::size_t unusedBytes_ = 0;
+    std::shared_ptr<BlobCompressor> compressor_;
+
+public:
+    using Handle = uint64_t;
+
+    /**
+     * @brief Construct a new store.
+     *
+     * @param compressor The compressor to use; nullptr to store blobs uncompressed
+     */
+    explicit ArenaBlobStore(std::shared_ptr<BlobCompressor> compressor = nullptr);
+
+    /**
+     * @brief Store a blob.
+     *
+     * @param blob The blob to store
+     * @return Handle to the stored blob
+     */
+    [[nodiscard]] Handle
+    store(Blob const& blob);
+
+    /**
+     * @param handle Handle to a stored blob
+     * @return A copy of the blob
+     */
+    [[nodiscard]] Blob
+    load(Handle const& handle) const;
+
+    /**
+     * @brief Release a blob that is no longer used.
+     *
+     * @param handle Handle to the blob
+     */
+    void
+    release(Handle& handle);
+
+    /**
+     * @brief Copy a blob into another store without recompressing it.
+     *
+     * @param handle Handle to the blob
+     * @param target The store to copy to
+     * @return Handle to the blob in the target store
+     */
+    [[nodiscard]] Handle
+    moveTo(Handle& handle, ArenaBlobStore& target) const;
+
+    /** @return An empty store sharing the compressor of this one */
+    [[nodiscard]] ArenaBlobStore
+    makeEmpty() const;
+
+    /** @return true if more than half of the arena is unused; false otherwise */
+    [[nodiscard]] bool
+    needsCompaction() const;
+
+    /** @return Number of bytes allocated for the chunks */
+    [[nodiscard]] std::size_t
+    bytes() const;
+
+private:
+    [[nodiscard]] Handle
+    append(unsigned char const* data, std::size_t size, bool compressed);
+
+    [[nodiscard]] unsigned char const*
+    dataOf(Handle handle) const;
+};
+
+}  // namespace data::impl
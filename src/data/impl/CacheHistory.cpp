@@ -0,0 +1,125 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/impl/CacheHistory.hpp"
+
+#include "data/Types.hpp"
+
+#include <xrpl/basics/base_uint.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <utility>
+
+namespace data::impl {
+
+void
+CacheHistory::record(ripple::uint256 const& key, uint32_t seq, std::optional<Blob> previous)
+{
+    auto& versions = versions_[key];
+    if (not versions.empty() and versions.back().seq >= seq)
+        return;
+
+    versions.push_back({seq, std::move(previous)});
+    ++numVersions_;
+
+    if (changes_.empty() or changes_.back().first != seq)
+        changes_.emplace_back(seq, std::vector<ripple::uint256>{});
+    changes_.back().second.push_back(key);
+}
+
+void
+CacheHistory::prune(uint32_t seq)
+{
+    while (not changes_.empty() and changes_.front().first <= seq) {
+        for (auto const& key : changes_.front().second) {
+            auto it = versions_.find(key);
+            if (it == versions_.end())
+                continue;
+
+            auto& versions = it->second;
+            auto const firstToKeep =
+                std::find_if(versions.begin(), versions.end(), [seq](Version const& v) { return v.seq > seq; });
+            numVersions_ -= std::distance(versions.begin(), firstToKeep);
+            versions.erase(versions.begin(), firstToKeep);
+
+            if (versions.empty())
+                versions_.erase(it);
+        }
+        changes_.pop_front();
+    }
+}
+
+std::optional<Blob> const*
+CacheHistory::stateAt(ripple::uint256 const& key, uint32_t seq) const
+{
+    auto const it = versions_.find(key);
+    if (it == versions_.end())
+        return nullptr;
+
+    return stateAt(it, seq);
+}
+
+std::optional<Blob> const*
+CacheHistory::stateAt(Iterator it, uint32_t seq)
+{
+    // the first change after seq holds the state as of seq
+    auto const& versions = it->second;
+    auto const change =
+        std::find_if(versions.cbegin(), versions.cend(), [seq](Version const& v) { return v.seq > seq; });
+    if (change == versions.cend())
+        return nullptr;
+
+    return &change->previous;
+}
+
+CacheHistory::Iterator
+CacheHistory::upperBound(ripple::uint256 const& key) const
+{
+    return versions_.upper_bound(key);
+}
+
+CacheHistory::Iterator
+CacheHistory::lowerBound(ripple::uint256 const& key) const
+{
+    return versions_.lower_bound(key);
+}
+
+CacheHistory::Iterator
+CacheHistory::begin() const
+{
+    return versions_.cbegin();
+}
+
+CacheHistory::Iterator
+CacheHistory::end() const
+{
+    return versions_.cend();
+}
+
+std::size_t
+CacheHistory::size() const
+{
+    return numVersions_;
+}
+
+}  // namespace data::impl
@@ -0,0 +1,126 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include "data/Types.hpp"
+
+#include <xrpl/basics/base_uint.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace data::impl {
+
+/**
+ * @brief Keeps the previous state of every object changed in the most recent ledgers.
+ *
+ * Together with the current state of the cache this allows to reconstruct the state of any object as of any ledger
+ * that is still in the history window. Memory usage is proportional to the number of objects changed in the window.
+ *
+ * @note This class is not thread safe. Synchronization is the responsibility of the owner.
+ */
+class CacheHistory {
+public:
+    /** @brief A change of an object */
+    struct Version {
+        uint32_t seq = 0;             /**< the ledger the object was changed in */
+        std::optional<Blob> previous; /**< the object before the change; nullopt if it did not exist */
+    };
+
+private:
+    std::map<ripple::uint256, std::vector<Version>> versions_;              // ordered by seq
+    std::deque<std::pair<uint32_t, std::vector<ripple::uint256>>> changes_;  // keys changed in each ledger
+    std::size_t numVersions_ = 0;
+
+public:
+    using Iterator = std::map<ripple::uint256, std::vector<Version>>::const_iterator;
+
+    /**
+     * @brief Record a change of an object. Only the first change of an object in each ledger is recorded.
+     *
+     * @param key The key of the changed object
+     * @param seq The ledger the object is changed in
+     * @param previous The object before the change; nullopt if it did not exist
+     */
+    void
+    record(ripple::uint256 const& key, uint32_t seq, std::optional<Blob> previous);
+
+    /**
+     * @brief Forget all changes made in ledgers up to and including the given one.
+     *
+     * @param seq The sequence to prune up to
+     */
+    void
+    prune(uint32_t seq);
+
+    /**
+     * @brief Find the state of an object as of the given ledger.
+     *
+     * @param key The key of the object
+     * @param seq The ledger sequence
+     * @return Pointer to the state of the object if it was changed after seq; nullptr if the object was not changed
+     * after seq and its current state is also the state as of seq
+     */
+    [[nodiscard]] std::optional<Blob> const*
+    stateAt(ripple::uint256 const& key, uint32_t seq) const;
+
+    /**
+     * @brief Same as the other overload but for an object pointed to by an iterator.
+     *
+     * @param it Iterator to the object
+     * @param seq The ledger sequence
+     * @return Pointer to the state of the object if it was changed after seq; nullptr otherwise
+     */
+    [[nodiscard]] static std::optional<Blob> const*
+    stateAt(Iterator it, uint32_t seq);
+
+    /**
+     * @param key The key to search from
+     * @return Iterator to the first changed object with a key strictly greater than the given one
+     */
+    [[nodiscard]] Iterator
+    upperBound(ripple::uint256 const& key) const;
+
+    /**
+     * @param key The key to search from
+     * @return Iterator to the first changed object with a key not less than the given one
+     */
+    [[nodiscard]] Iterator
+    lowerBound(ripple::uint256 const& key) const;
+
+    /** @return Iterator to the changed object with the smallest key */
+    [[nodiscard]] Iterator
+    begin() const;
+
+    /** @return Iterator past the changed object with the largest key */
+    [[nodiscard]] Iterator
+    end() const;
+
+    /** @return The number of recorded changes */
+    [[nodiscard]] std::size_t
+    size() const;
+};
+
+}  // namespace data::impl
@@ -0,0 +1,202 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include "data/Types.hpp"
+#include "data/impl/BlobStore.hpp"
+#include "data/impl/FlatCacheStorage.hpp"
+
+#include <xrpl/basics/base_uint.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <utility>
+#include <variant>
+
+namespace data::impl {
+
+/**
+ * @brief Storage of a part of the ledger cache with the blob representation chosen at runtime.
+ *
+ * @note This class is not thread safe. Synchronization is the responsibility of the owner.
+ */
+class CacheStorage {
+    std::variant<FlatCacheStorage<HeapBlobStore>, FlatCacheStorage<ArenaBlobStore>> storage_;
+
+public:
+    /** @brief Construct a storage keeping every blob in its own heap allocation */
+    CacheStorage() = default;
+
+    /**
+     * @brief Construct a storage keeping blobs in an arena.
+     *
+     * @param blobs The arena to use
+     */
+    explicit CacheStorage(ArenaBlobStore blobs) : storage_{FlatCacheStorage<ArenaBlobStore>{std::move(blobs)}}
+    {
+    }
+
+    /**
+     * @brief Get the sequence an object was last modified at.
+     *
+     * @param key The key of the object
+     * @return The sequence if the object exists; nullopt otherwise
+     */
+    [[nodiscard]] std::optional<uint32_t>
+    seqOf(ripple::uint256 const& key) const
+    {
+        return std::visit(
+            [&key](auto const& storage) -> std::optional<uint32_t> {
+                if (auto const* e = storage.find(key); e != nullptr)
+                    return e->seq;
+                return std::nullopt;
+            },
+            storage_
+        );
+    }
+
+    /**
+     * @brief Get an object if it was not modified after the given sequence.
+     *
+     * @param key The key of the object
+     * @param seq The sequence
+     * @return The object if it exists and was last modified at or before seq; nullopt otherwise
+     */
+    [[nodiscard]] std::optional<Blob>
+    get(ripple::uint256 const& key, uint32_t seq) const
+    {
+        return std::visit(
+            [&key, seq](auto const& storage) -> std::optional<Blob> {
+                if (auto const* e = storage.find(key); e != nullptr and e->seq <= seq)
+                    return storage.blob(*e);
+                return std::nullopt;
+            },
+            storage_
+        );
+    }
+
+    /**
+     * @brief Get an object regardless of when it was modified.
+     *
+     * @param key The key of the object
+     * @return The object if it exists; nullopt otherwise
+     */
+    [[nodiscard]] std::optional<Blob>
+    get(ripple::uint256 const& key) const
+    {
+        return get(key, std::numeric_limits<uint32_t>::max());
+    }
+
+    /**
+     * @brief Insert a new object or replace an existing one.
+     *
+     * @param key The key of the object
+     * @param seq The sequence the object was modified at
+     * @param blob The object
+     */
+    void
+    put(ripple::uint256 const& key, uint32_t seq, Blob const& blob)
+    {
+        std::visit([&](auto& storage) { storage.put(key, seq, blob); }, storage_);
+    }
+
+    /**
+     * @brief Remove an object if it exists.
+     *
+     * @param key The key of the object
+     */
+    void
+    erase(ripple::uint256 const& key)
+    {
+        std::visit([&key](auto& storage) { storage.erase(key); }, storage_);
+    }
+
+    /**
+     * @param key The key to search from
+     * @return The first object with a key strictly greater than the given one if any; nullopt otherwise
+     */
+    [[nodiscard]] std::optional<LedgerObject>
+    successor(ripple::uint256 const& key) const
+    {
+        return std::visit([&key](auto const& storage) { return storage.successor(key); }, storage_);
+    }
+
+    /**
+     * @param key The key to search from
+     * @return The last object with a key strictly less than the given one if any; nullopt otherwise
+     */
+    [[nodiscard]] std::optional<LedgerObject>
+    predecessor(ripple::uint256 const& key) const
+    {
+        return std::visit([&key](auto const& storage) { return storage.predecessor(key); }, storage_);
+    }
+
+    /** @return The object with the smallest key if storage is not empty; nullopt otherwise */
+    [[nodiscard]] std::optional<LedgerObject>
+    first() const
+    {
+        return std::visit([](auto const& storage) { return storage.first(); }, storage_);
+    }
+
+    /** @return The object with the largest key if storage is not empty; nullopt otherwise */
+    [[nodiscard]] std::optional<LedgerObject>
+    last() const
+    {
+        return std::visit([](auto const& storage) { return storage.last(); }, storage_);
+    }
+
+    /**
+     * @brief Visit all objects in key order.
+     *
+     * @tparam FnType The type of the visitor
+     * @param fn The visitor; called with the key, the sequence the object was modified at and the object
+     */
+    template <typename FnType>
+    void
+    forEach(FnType&& fn) const
+    {
+        std::visit([&fn](auto const& storage) { storage.forEach(fn); }, storage_);
+    }
+
+    /** @brief Reorganize the storage if it accumulated too much garbage */
+    void
+    compactIfNeeded()
+    {
+        std::visit([](auto& storage) { storage.compactIfNeeded(); }, storage_);
+    }
+
+    /** @return The number of objects in the storage */
+    [[nodiscard]] std::size_t
+    size() const
+    {
+        return std::visit([](auto const& storage) { return storage.size(); }, storage_);
+    }
+
+    /** @return Approximate number of bytes used by the storage including the blobs */
+    [[nodiscard]] std::size_t
+    bytes() const
+    {
+        return std::visit([](auto const& storage) { return storage.bytes(); }, storage_);
+    }
+};
+
+}  // namespace data::impl
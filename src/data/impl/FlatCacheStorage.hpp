@@ -0,0 +1,416 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include "data/Types.hpp"
+#include "data/impl/BlobStore.hpp"
+
+#include <xrpl/basics/base_uint.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace data::impl {
+
+/**
+ * @brief Ordered key-value storage for a part of the ledger cache.
+ *
+ * Objects live in a sorted contiguous array which is cheap to binary search and to scan. Insertions of new keys and
+ * removals of existing ones go to a small ordered overlay first and are merged into the array in bulk once the overlay
+ * grows too large. Modifications of keys already present in the array are done in place.
+ *
+ * @note This class is not thread safe. Synchronization is the responsibility of the owner.
+ *
+ * @tparam BlobStoreType The store that keeps the actual blobs; see @ref HeapBlobStore and @ref ArenaBlobStore
+ */
+template <typename BlobStoreType = HeapBlobStore>
+class FlatCacheStorage {
+public:
+    /** @brief A cached ledger object along with the sequence it was last modified at */
+    struct Entry {
+        uint32_t seq = 0;
+        typename BlobStoreType::Handle blob;
+    };
+
+private:
+    struct Item {
+        ripple::uint256 key;
+        Entry entry;
+    };
+
+    using Overlay = std::map<ripple::uint256, std::optional<Entry>>;
+    using BaseIterator = typename std::vector<Item>::const_iterator;
+    using OverlayIterator = typename Overlay::const_iterator;
+
+    // overlay is merged into base once it holds more than 1/OVERLAY_RATIO of base (but at least MIN_OVERLAY_SIZE)
+    static constexpr std::size_t OVERLAY_RATIO = 8;
+    static constexpr std::size_t MIN_OVERLAY_SIZE = 1024;
+
+    // rough size of a node of std::map on top of its value
+    static constexpr std::size_t MAP_NODE_OVERHEAD = 48;
+
+    std::vector<Item> base_;
+    Overlay overlay_;  // std::nullopt marks a key erased from base_
+    std::size_t size_ = 0;
+    BlobStoreType blobs_;
+
+public:
+    FlatCacheStorage() = default;
+
+    /**
+     * @brief Construct a new storage.
+     *
+     * @param blobs The store to keep blobs in
+     */
+    explicit FlatCacheStorage(BlobStoreType blobs) : blobs_{std::move(blobs)}
+    {
+    }
+
+    /**
+     * @brief Find an object by its key.
+     *
+     * @param key The key to look for
+     * @return Pointer to the entry if found; nullptr otherwise. Invalidated by any modification of the storage
+     */
+    [[nodiscard]] Entry const*
+    find(ripple::uint256 const& key) const
+    {
+        if (auto const it = overlay_.find(key); it != overlay_.end())
+            return it->second ? &*it->second : nullptr;
+
+        if (auto const it = findInBase(key); it != base_.cend())
+            return &it->entry;
+
+        return nullptr;
+    }
+
+    /**
+     * @param entry An entry returned by @ref find
+     * @return A copy of the blob of the entry
+     */
+    [[nodiscard]] Blob
+    blob(Entry const& entry) const
+    {
+        return blobs_.load(entry.blob);
+    }
+
+    /**
+     * @brief Insert a new object or replace an existing one.
+     *
+     * @param key The key of the object
+     * @param seq The sequence the object was modified at
+     * @param blob The object
+     */
+    void
+    put(ripple::uint256 const& key, uint32_t seq, Blob const& blob)
+    {
+        if (auto it = overlay_.find(key); it != overlay_.end()) {
+            if (it->second) {
+                blobs_.release(it->second->blob);
+            } else {
+                ++size_;
+            }
+            it->second = Entry{seq, blobs_.store(blob)};
+            return;
+        }
+
+        if (auto const it = findInBase(key); it != base_.cend()) {
+            auto& entry = base_[std::distance(base_.cbegin(), it)].entry;
+            blobs_.release(entry.blob);
+            entry = Entry{seq, blobs_.store(blob)};
+            return;
+        }
+
+        overlay_.emplace(key, Entry{seq, blobs_.store(blob)});
+        ++size_;
+    }
+
+    /**
+     * @brief Remove an object if it exists.
+     *
+     * @param key The key of the object
+     */
+    void
+    erase(ripple::uint256 const& key)
+    {
+        auto const baseIt = findInBase(key);
+        auto const inBase = baseIt != base_.cend();
+
+        if (auto it = overlay_.find(key); it != overlay_.end()) {
+            if (not it->second)
+                return;
+
+            blobs_.release(it->second->blob);
+            if (inBase) {
+                it->second.reset();
+            } else {
+                overlay_.erase(it);
+            }
+            --size_;
+            return;
+        }
+
+        if (inBase) {
+            blobs_.release(base_[std::distance(base_.cbegin(), baseIt)].entry.blob);
+            overlay_.emplace(key, std::nullopt);
+            --size_;
+        }
+    }
+
+    /**
+     * @brief Get the first object with a key strictly greater than the given one.
+     *
+     * @param key The key to search from
+     * @return The object if found; nullopt otherwise
+     */
+    [[nodiscard]] std::optional<LedgerObject>
+    successor(ripple::uint256 const& key) const
+    {
+        return forwardFrom(upperBoundInBase(key), overlay_.upper_bound(key));
+    }
+
+    /**
+     * @brief Get the last object with a key strictly less than the given one.
+     *
+     * @param key The key to search from
+     * @return The object if found; nullopt otherwise
+     */
+    [[nodiscard]] std::optional<LedgerObject>
+    predecessor(ripple::uint256 const& key) const
+    {
+        return backwardFrom(lowerBoundInBase(key), overlay_.lower_bound(key));
+    }
+
+    /**
+     * @return The object with the smallest key if storage is not empty; nullopt otherwise
+     */
+    [[nodiscard]] std::optional<LedgerObject>
+    first() const
+    {
+        return forwardFrom(base_.cbegin(), overlay_.cbegin());
+    }
+
+    /**
+     * @return The object with the largest key if storage is not empty; nullopt otherwise
+     */
+    [[nodiscard]] std::optional<LedgerObject>
+    last() const
+    {
+        return backwardFrom(base_.cend(), overlay_.cend());
+    }
+
+    /**
+     * @brief Visit all objects in key order.
+     *
+     * @tparam FnType The type of the visitor
+     * @param fn The visitor; called with the key, the sequence the object was modified at and the object
+     */
+    template <typename FnType>
+    void
+    forEach(FnType&& fn) const
+    {
+        auto baseIt = base_.cbegin();
+        auto overlayIt = overlay_.cbegin();
+
+        while (baseIt != base_.cend() or overlayIt != overlay_.cend()) {
+            if (overlayIt == overlay_.cend() or (baseIt != base_.cend() and baseIt->key < overlayIt->first)) {
+                fn(baseIt->key, baseIt->entry.seq, blob(baseIt->entry));
+                ++baseIt;
+                continue;
+            }
+
+            if (baseIt != base_.cend() and baseIt->key == overlayIt->first)
+                ++baseIt;
+
+            if (overlayIt->second)
+                fn(overlayIt->first, overlayIt->second->seq, blob(*overlayIt->second));
+
+            ++overlayIt;
+        }
+    }
+
+    /**
+     * @brief Merge the overlay into the sorted array and compact the blob store if they grew too large.
+     */
+    void
+    compactIfNeeded()
+    {
+        if (overlay_.size() > std::max(MIN_OVERLAY_SIZE, base_.size() / OVERLAY_RATIO))
+            compact();
+
+        if (blobs_.needsCompaction())
+            compactBlobs();
+    }
+
+    /**
+     * @return The number of objects in the storage
+     */
+    [[nodiscard]] std::size_t
+    size() const
+    {
+        return size_;
+    }
+
+    /**
+     * @return Approximate number of bytes used by the storage including the blobs
+     */
+    [[nodiscard]] std::size_t
+    bytes() const
+    {
+        auto const overlayBytes = overlay_.size() * (sizeof(typename Overlay::value_type) + MAP_NODE_OVERHEAD);
+        return base_.capacity() * sizeof(Item) + overlayBytes + blobs_.bytes();
+    }
+
+private:
+    [[nodiscard]] BaseIterator
+    lowerBoundInBase(ripple::uint256 const& key) const
+    {
+        return std::lower_bound(base_.cbegin(), base_.cend(), key, [](Item const& item, ripple::uint256 const& k) {
+            return item.key < k;
+        });
+    }
+
+    [[nodiscard]] BaseIterator
+    upperBoundInBase(ripple::uint256 const& key) const
+    {
+        return std::upper_bound(base_.cbegin(), base_.cend(), key, [](ripple::uint256 const& k, Item const& item) {
+            return k < item.key;
+        });
+    }
+
+    [[nodiscard]] BaseIterator
+    findInBase(ripple::uint256 const& key) const
+    {
+        auto const it = lowerBoundInBase(key);
+        if (it != base_.cend() and it->key == key)
+            return it;
+        return base_.cend();
+    }
+
+    [[nodiscard]] std::optional<LedgerObject>
+    forwardFrom(BaseIterator baseIt, OverlayIterator overlayIt) const
+    {
+        while (true) {
+            auto const hasBase = baseIt != base_.cend();
+            auto const hasOverlay = overlayIt != overlay_.cend();
+
+            if (not hasBase and not hasOverlay)
+                return std::nullopt;
+
+            if (hasOverlay and (not hasBase or overlayIt->first <= baseIt->key)) {
+                // overlay shadows the same key in base
+                if (hasBase and overlayIt->first == baseIt->key)
+                    ++baseIt;
+
+                if (overlayIt->second)
+                    return LedgerObject{overlayIt->first, blob(*overlayIt->second)};
+
+                ++overlayIt;
+                continue;
+            }
+
+            return LedgerObject{baseIt->key, blob(baseIt->entry)};
+        }
+    }
+
+    [[nodiscard]] std::optional<LedgerObject>
+    backwardFrom(BaseIterator baseIt, OverlayIterator overlayIt) const
+    {
+        while (true) {
+            auto const hasBase = baseIt != base_.cbegin();
+            auto const hasOverlay = overlayIt != overlay_.cbegin();
+
+            if (not hasBase and not hasOverlay)
+                return std::nullopt;
+
+            if (hasOverlay and (not hasBase or std::prev(overlayIt)->first >= std::prev(baseIt)->key)) {
+                --overlayIt;
+
+                // overlay shadows the same key in base
+                if (hasBase and overlayIt->first == std::prev(baseIt)->key)
+                    --baseIt;
+
+                if (overlayIt->second)
+                    return LedgerObject{overlayIt->first, blob(*overlayIt->second)};
+
+                continue;
+            }
+
+            --baseIt;
+            return LedgerObject{baseIt->key, blob(baseIt->entry)};
+        }
+    }
+
+    void
+    compact()
+    {
+        std::vector<Item> merged;
+        merged.reserve(size_);
+
+        auto baseIt = base_.begin();
+        auto overlayIt = overlay_.begin();
+
+        while (baseIt != base_.end() or overlayIt != overlay_.end()) {
+            if (overlayIt == overlay_.end() or (baseIt != base_.end() and baseIt->key < overlayIt->first)) {
+                merged.push_back(std::move(*baseIt));
+                ++baseIt;
+                continue;
+            }
+
+            if (baseIt != base_.end() and baseIt->key == overlayIt->first)
+                ++baseIt;
+
+            if (overlayIt->second)
+                merged.push_back({overlayIt->first, std::move(*overlayIt->second)});
+
+            ++overlayIt;
+        }
+
+        base_ = std::move(merged);
+        overlay_.clear();
+    }
+
+    void
+    compactBlobs()
+    {
+        auto fresh = blobs_.makeEmpty();
+
+        for (auto& item : base_) {
+            // base entries shadowed by an erased overlay entry are already released
+            if (auto const it = overlay_.find(item.key); it == overlay_.end())
+                item.entry.blob = blobs_.moveTo(item.entry.blob, fresh);
+        }
+
+        for (auto& [_, entry] : overlay_) {
+            if (entry)
+                entry->blob = blobs_.moveTo(entry->blob, fresh);
+        }
+
+        blobs_ = std::move(fresh);
+    }
+};
+
+}  // namespace data::impl
@@ -0,0 +1,139 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/impl/OrderBookIndex.hpp"
+
+#include "data/Types.hpp"
+
+#include <xrpl/basics/base_uint.h>
+#include <xrpl/protocol/Indexes.h>
+#include <xrpl/protocol/LedgerFormats.h>
+#include <xrpl/protocol/SField.h>
+#include <xrpl/protocol/STLedgerEntry.h>
+#include <xrpl/protocol/Serializer.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace data::impl {
+
+namespace {
+
+// The ledger entry type is the first serialized field of every ledger object. Checking it first avoids parsing
+// objects which are not directories at all.
+bool
+isDirectory(Blob const& blob)
+{
+    static constexpr unsigned char LEDGER_ENTRY_TYPE_FIELD = 0x11;
+
+    return blob.size() > 3 and blob[0] == LEDGER_ENTRY_TYPE_FIELD and
+        ((blob[1] << 8) | blob[2]) == ripple::ltDIR_NODE;
+}
+
+}  // namespace
+
+void
+OrderBookIndex::update(std::vector<LedgerObject const*> const& objs, uint32_t seq)
+{
+    for (auto const* obj : objs) {
+        if (obj->blob.empty() or not isDirectory(obj->blob)) {
+            // nothing but a deletion can turn a book directory page into something else
+            if (auto const it = pages_.find(obj->key); it != pages_.end()) {
+                if (it->second.root == obj->key)
+                    roots_.erase(obj->key);
+                pages_.erase(it);
+            }
+            continue;
+        }
+
+        ripple::STLedgerEntry const sle{ripple::SerialIter{obj->blob.data(), obj->blob.size()}, obj->key};
+
+        // owner directories and the like have no exchange rate
+        if (not sle.isFieldPresent(ripple::sfExchangeRate))
+            continue;
+
+        auto const& indexes = sle.getFieldV256(ripple::sfIndexes);
+        auto const root = sle.getFieldH256(ripple::sfRootIndex);
+        pages_[obj->key] = Page{
+            .root = root,
+            .next = sle.getFieldU64(ripple::sfIndexNext),
+            .offers = std::vector<ripple::uint256>(indexes.begin(), indexes.end())
+        };
+
+        if (root == obj->key)
+            roots_.insert(root);
+    }
+
+    seq_ = std::max(seq_, seq);
+}
+
+std::optional<std::vector<ripple::uint256>>
+OrderBookIndex::offers(ripple::uint256 const& book, std::uint32_t limit) const
+{
+    std::vector<ripple::uint256> keys;
+    auto const bookEnd = ripple::getQualityNext(book);
+
+    for (auto root = roots_.upper_bound(book); root != roots_.end() and *root < bookEnd and keys.size() < limit;
+         ++root) {
+        auto page = pages_.find(*root);
+        while (keys.size() < limit) {
+            if (page == pages_.end())
+                return std::nullopt;
+
+            auto const& offers = page->second.offers;
+            keys.insert(keys.end(), offers.begin(), offers.end());
+
+            if (page->second.next == 0)
+                break;
+
+            page = pages_.find(ripple::keylet::page(*root, page->second.next).key);
+        }
+    }
+
+    if (keys.size() > limit)
+        keys.resize(limit);
+
+    return keys;
+}
+
+uint32_t
+OrderBookIndex::seq() const
+{
+    return seq_;
+}
+
+std::size_t
+OrderBookIndex::size() const
+{
+    return pages_.size();
+}
+
+void
+OrderBookIndex::clear()
+{
+    pages_.clear();
+    roots_.clear();
+    seq_ = 0;
+}
+
+}  // namespace data::impl
@@ -0,0 +1,89 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include "data/Types.hpp"
+
+#include <xrpl/basics/base_uint.h>
+#include <xrpl/basics/hardened_hash.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+namespace data::impl {
+
+/**
+ * @brief Keeps the offers of every order book in the order they are consumed.
+ *
+ * Each order book consists of quality directories whose root page keys share the book base and are ordered by quality.
+ * The index mirrors the pages of these directories so that the best offers of a book are found without walking the
+ * directories in the database.
+ *
+ * @note This class is not thread safe. Synchronization is the responsibility of the owner.
+ */
+class OrderBookIndex {
+    struct Page {
+        ripple::uint256 root;
+        std::uint64_t next = 0;
+        std::vector<ripple::uint256> offers;
+    };
+
+    std::unordered_map<ripple::uint256, Page, ripple::hardened_hash<>> pages_;
+    std::set<ripple::uint256> roots_;  // root pages of all quality directories, ordered by book and quality
+    uint32_t seq_ = 0;
+
+public:
+    /**
+     * @brief Apply changed objects to the index. Objects other than order book directory pages are ignored.
+     *
+     * @param objs The changed objects; an empty blob means the object was deleted
+     * @param seq The sequence the objects were changed in
+     */
+    void
+    update(std::vector<LedgerObject const*> const& objs, uint32_t seq);
+
+    /**
+     * @brief Get the keys of the best offers of an order book.
+     *
+     * @param book The book base
+     * @param limit The maximum number of offers to return
+     * @return Offer keys ordered by quality; nullopt if the directories of the book are not complete
+     */
+    [[nodiscard]] std::optional<std::vector<ripple::uint256>>
+    offers(ripple::uint256 const& book, std::uint32_t limit) const;
+
+    /** @return The latest sequence the index was updated for */
+    [[nodiscard]] uint32_t
+    seq() const;
+
+    /** @return The number of indexed directory pages */
+    [[nodiscard]] std::size_t
+    size() const;
+
+    /** @brief Forget all the indexed directories. */
+    void
+    clear();
+};
+
+}  // namespace data::impl
@@ -20,6 +20,8 @@
 #pragma once
 
 #include "data/BackendInterface.hpp"
+#include "data/LedgerCacheSnapshot.hpp"
+#include "data/Types.hpp"
 #include "etl/CacheLoaderSettings.hpp"
 #include "etl/impl/CacheLoader.hpp"
 #include "etl/impl/CursorFromAccountProvider.hpp"
@@ -29,16 +31,25 @@
 #include "util/async/context/BasicExecutionContext.hpp"
 #include "util/log/Logger.hpp"
 
+#include <boost/asio/spawn.hpp>
+
+#include <chrono>
+#include <condition_variable>
 #include <cstdint>
+#include <exception>
 #include <functional>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 namespace etl {
 
 /**
  * @brief Cache loading interface
  *
- * This class is responsible for loading the cache for a given sequence number.
+ * This class is responsible for loading the cache for a given sequence number. If configured, it also keeps a snapshot
+ * of the cache on disk and loads the cache from it on startup whenever the snapshot is recent enough.
  *
  * @tparam CacheType The type of the cache to load
  * @tparam CursorProviderType The type of the cursor provider to use
@@ -56,6 +67,11 @@ class CacheLoader {
     ExecutionContextType ctx_;
     std::unique_ptr<CacheLoaderType> loader_;
 
+    std::mutex snapshotMtx_;
+    std::condition_variable snapshotCv_;
+    bool stopping_ = false;
+    std::thread snapshotThread_;
+
 public:
     /**
      * @brief Construct a new Cache Loader object
@@ -67,8 +83,21 @@ public:
     CacheLoader(util::Config const& config, std::shared_ptr<BackendInterface> const& backend, CacheType& cache)
         : backend_{backend}, cache_{cache}, settings_{make_CacheLoaderSettings(config)}, ctx_{settings_.numThreads}
     {
+        if (settings_.snapshotPath and settings_.snapshotInterval.count() > 0)
+            snapshotThread_ = std::thread{[this] { runPeriodicSnapshots(); }};
+    }
+
+    ~CacheLoader()
+    {
+        stop();
+        if (snapshotThread_.joinable())
+            snapshotThread_.join();
     }
 
+    CacheLoader(CacheLoader const&) = delete;
+    CacheLoader&
+    operator=(CacheLoader const&) = delete;
+
     /**
      * @brief Load the cache for the given sequence number
      *
@@ -88,6 +117,9 @@ public:
             return;
         }
 
+        if (settings_.snapshotPath and loadFromSnapshot(seq))
+            return;
+
         std::shared_ptr<impl::BaseCursorProvider> provider;
         if (settings_.numCacheCursorsFromDiff != 0) {
             LOG(log_.info()) << "Loading cache with cursor from num_cursors_from_diff="
@@ -126,7 +158,14 @@ public:
     void
     stop() noexcept
     {
-        loader_->stop();
+        {
+            std::scoped_lock const lck{snapshotMtx_};
+            stopping_ = true;
+        }
+        snapshotCv_.notify_all();
+
+        if (loader_)
+            loader_->stop();
     }
 
     /**
@@ -135,7 +174,90 @@ public:
     void
     wait() noexcept
     {
-        loader_->wait();
+        if (loader_)
+            loader_->wait();
+    }
+
+    /**
+     * @brief Writes the snapshot of the cache if snapshots are configured and the cache is full
+     */
+    void
+    saveSnapshot()
+    {
+        if (not settings_.snapshotPath or cache_.get().isDisabled() or not cache_.get().isFull())
+            return;
+
+        auto const start = std::chrono::steady_clock::now();
+        auto const res = data::LedgerCacheSnapshot::write(cache_.get(), *settings_.snapshotPath);
+        if (not res.has_value()) {
+            LOG(log_.error()) << "Failed to write cache snapshot: " << res.error();
+            return;
+        }
+
+        auto const duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start
+        );
+        LOG(log_.info()) << "Wrote cache snapshot of ledger " << *res << " to " << *settings_.snapshotPath << ". Took "
+                         << duration.count() << " ms";
+    }
+
+private:
+    bool
+    loadFromSnapshot(uint32_t const seq)
+    {
+        auto const start = std::chrono::steady_clock::now();
+
+        auto snapshot = data::LedgerCacheSnapshot::open(*settings_.snapshotPath);
+        if (not snapshot.has_value()) {
+            LOG(log_.warn()) << "Not using cache snapshot: " << snapshot.error();
+            return false;
+        }
+
+        // parts of the snapshot taken after the requested ledger would hold objects the ledger doesn't have yet
+        auto const snapshotSeq = snapshot->seq();
+        if (snapshot->latestSeq() > seq or seq - snapshotSeq > settings_.snapshotMaxCatchUpLedgers) {
+            LOG(log_.warn()) << "Not using cache snapshot of ledger " << snapshotSeq << " to load cache for ledger "
+                             << seq;
+            return false;
+        }
+
+        // fetch everything needed to catch up before touching the cache so that it can still be loaded from DB
+        std::vector<std::vector<data::LedgerObject>> diffs;
+        try {
+            diffs = data::synchronousAndRetryOnTimeout([this, snapshotSeq, seq](boost::asio::yield_context yield) {
+                std::vector<std::vector<data::LedgerObject>> result;
+                for (auto diffSeq = snapshotSeq + 1; diffSeq <= seq; ++diffSeq)
+                    result.push_back(backend_->fetchLedgerDiff(diffSeq, yield));
+                return result;
+            });
+        } catch (std::exception const& e) {
+            LOG(log_.warn()) << "Not using cache snapshot, failed to fetch ledger diffs: " << e.what();
+            return false;
+        }
+
+        snapshot->restoreInto(cache_.get());
+        for (auto diffSeq = snapshotSeq + 1; diffSeq <= seq; ++diffSeq)
+            cache_.get().update(diffs[diffSeq - snapshotSeq - 1], diffSeq);
+
+        cache_.get().setFull();
+
+        auto const duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start
+        );
+        LOG(log_.info()) << "Loaded cache from snapshot of ledger " << snapshotSeq << " and caught up to ledger "
+                         << seq << ". Cache size = " << cache_.get().size() << ". Took " << duration.count() << " ms";
+        return true;
+    }
+
+    void
+    runPeriodicSnapshots()
+    {
+        std::unique_lock lck{snapshotMtx_};
+        while (not snapshotCv_.wait_for(lck, settings_.snapshotInterval, [this] { return stopping_; })) {
+            lck.unlock();
+            saveSnapshot();
+            lck.lock();
+        }
     }
 };
 
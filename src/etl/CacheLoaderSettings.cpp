@@ -23,7 +23,9 @@
 
 #include <boost/algorithm/string/predicate.hpp>
 
+#include <chrono>
 #include <cstddef>
+#include <cstdint>
 #include <string>
 
 namespace etl {
@@ -71,6 +73,14 @@ make_CacheLoaderSettings(util::Config const& config)
             if (boost::iequals(*entry, "none") or boost::iequals(*entry, "no"))
                 settings.loadStyle = CacheLoaderSettings::LoadStyle::NONE;
         }
+
+        if (cache.contains("snapshot")) {
+            auto const snapshot = cache.section("snapshot");
+            settings.snapshotPath = snapshot.maybeValue<std::string>("path");
+            settings.snapshotInterval = std::chrono::seconds{snapshot.valueOr<uint32_t>("interval", 0)};
+            settings.snapshotMaxCatchUpLedgers =
+                snapshot.valueOr<size_t>("max_catch_up_ledgers", settings.snapshotMaxCatchUpLedgers);
+        }
     }
     return settings;
 }
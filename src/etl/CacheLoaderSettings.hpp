@@ -21,7 +21,10 @@
 
 #include "util/config/Config.hpp"
 
+#include <chrono>
 #include <cstddef>
+#include <optional>
+#include <string>
 
 namespace etl {
 
@@ -41,6 +44,10 @@ struct CacheLoaderSettings {
 
     LoadStyle loadStyle = LoadStyle::ASYNC; /**< how to load the cache */
 
+    std::optional<std::string> snapshotPath; /**< where to keep the snapshot of the cache; none to not use it */
+    std::chrono::seconds snapshotInterval{0}; /**< how often to write the snapshot; zero for only on shutdown */
+    size_t snapshotMaxCatchUpLedgers = 1024;  /**< max number of ledgers a snapshot may lag behind the DB */
+
     auto
     operator<=>(CacheLoaderSettings const&) const = default;
 
@@ -123,7 +123,10 @@ ETLService::monitor()
                 LOG(log_.info()) << "Waiting for next ledger to be validated by network...";
                 std::optional<uint32_t> mostRecentValidated = networkValidatedLedgers_->getMostRecent();
 
-                if (mostRecentValidated) {
+                if (auto const resumable = loadBalancer_->resumableInitialLedger(); mostRecentValidated and resumable) {
+                    LOG(log_.info()) << "Resuming interrupted download of ledger " << *resumable << "...";
+                    ledger = ledgerLoader_.loadInitialLedger(*resumable);
+                } else if (mostRecentValidated) {
                     LOG(log_.info()) << "Ledger " << *mostRecentValidated << " has been validated. Downloading...";
                     ledger = ledgerLoader_.loadInitialLedger(*mostRecentValidated);
                 } else {
@@ -171,6 +171,9 @@ public:
             worker_.join();
 
         LOG(log_.debug()) << "Joined ETLService worker thread";
+
+        // nothing updates the cache anymore
+        cacheLoader_.saveSnapshot();
     }
 
     /**
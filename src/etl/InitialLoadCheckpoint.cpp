@@ -0,0 +1,188 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "etl/InitialLoadCheckpoint.hpp"
+
+#include "util/File.hpp"
+
+#include <xrpl/basics/base_uint.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace etl {
+
+namespace {
+
+// marks a range nothing was written for yet
+constexpr auto NO_KEY = "-";
+
+}  // namespace
+
+InitialLoadCheckpoint::InitialLoadCheckpoint(
+    std::filesystem::path path,
+    uint32_t seq,
+    std::size_t numRanges,
+    std::chrono::steady_clock::duration saveInterval
+)
+    : path_{std::move(path)}, seq_{seq}, saveInterval_{saveInterval}
+{
+    if (auto keys = read(path_, seq_); keys.has_value() and keys->size() == numRanges)
+        confirmed_ = std::move(*keys);
+
+    confirmed_.resize(numRanges);
+    recorded_ = confirmed_;
+}
+
+std::expected<uint32_t, std::string>
+InitialLoadCheckpoint::readSequence(std::filesystem::path const& path)
+{
+    std::ifstream file{path};
+    if (not file.is_open())
+        return std::unexpected{"Can't open " + path.string()};
+
+    uint32_t seq = 0;
+    if (not(file >> seq))
+        return std::unexpected{"Invalid checkpoint file " + path.string()};
+
+    return seq;
+}
+
+void
+InitialLoadCheckpoint::remove(std::filesystem::path const& path)
+{
+    std::error_code ec;
+    std::filesystem::remove(path, ec);
+}
+
+uint32_t
+InitialLoadCheckpoint::seq() const
+{
+    return seq_;
+}
+
+std::optional<ripple::uint256>
+InitialLoadCheckpoint::writtenUpTo(std::size_t rangeIdx) const
+{
+    std::scoped_lock const lck{mtx_};
+    return confirmed_.at(rangeIdx);
+}
+
+std::expected<void, std::string>
+InitialLoadCheckpoint::record(
+    std::size_t rangeIdx,
+    ripple::uint256 const& key,
+    std::function<void()> const& waitForWrites
+)
+{
+    std::vector<std::optional<ripple::uint256>> keys;
+    std::unique_lock saveLck{saveMtx_, std::defer_lock};
+    {
+        std::scoped_lock const lck{mtx_};
+        recorded_.at(rangeIdx) = key;
+
+        auto const now = std::chrono::steady_clock::now();
+        if (now - lastSave_ < saveInterval_ or not saveLck.try_lock())
+            return {};
+
+        lastSave_ = now;
+        keys = recorded_;
+    }
+
+    // everything recorded so far was submitted before this point
+    waitForWrites();
+    auto res = write(keys);
+
+    if (res.has_value()) {
+        std::scoped_lock const lck{mtx_};
+        confirmed_ = std::move(keys);
+    }
+    return res;
+}
+
+std::expected<std::vector<std::optional<ripple::uint256>>, std::string>
+InitialLoadCheckpoint::read(std::filesystem::path const& path, uint32_t seq)
+{
+    std::ifstream file{path};
+    if (not file.is_open())
+        return std::unexpected{"Can't open " + path.string()};
+
+    uint32_t fileSeq = 0;
+    std::size_t numRanges = 0;
+    if (not(file >> fileSeq >> numRanges) or fileSeq != seq)
+        return std::unexpected{"Checkpoint file " + path.string() + " is not for ledger " + std::to_string(seq)};
+
+    std::vector<std::optional<ripple::uint256>> keys;
+    keys.reserve(numRanges);
+
+    std::string hex;
+    while (keys.size() < numRanges and file >> hex) {
+        if (hex == NO_KEY) {
+            keys.emplace_back();
+            continue;
+        }
+
+        ripple::uint256 key;
+        if (not key.parseHex(hex))
+            return std::unexpected{"Invalid key in checkpoint file " + path.string()};
+        keys.emplace_back(key);
+    }
+
+    if (keys.size() != numRanges)
+        return std::unexpected{"Truncated checkpoint file " + path.string()};
+
+    return keys;
+}
+
+std::expected<void, std::string>
+InitialLoadCheckpoint::write(std::vector<std::optional<ripple::uint256>> const& keys) const
+{
+    // write next to the file and replace it so that the checkpoint is never seen half written, not even after a crash
+    auto tmpPath = path_;
+    tmpPath += ".tmp";
+
+    {
+        std::ofstream file{tmpPath, std::ios::trunc};
+        if (not file.is_open())
+            return std::unexpected{"Can't create " + tmpPath.string()};
+
+        file << seq_ << ' ' << keys.size() << '\n';
+        for (auto const& key : keys)
+            file << (key ? ripple::to_string(*key) : NO_KEY) << '\n';
+
+        file.flush();
+        if (not file)
+            return std::unexpected{"Failed to write " + tmpPath.string()};
+    }
+
+    return util::replaceFileDurably(tmpPath, path_);
+}
+
+}  // namespace etl
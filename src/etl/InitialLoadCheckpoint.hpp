@@ -0,0 +1,135 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include <xrpl/basics/base_uint.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace etl {
+
+/**
+ * @brief Progress of the initial ledger download persisted to a file so that an interrupted download can be resumed.
+ *
+ * For every key range the ledger is downloaded in, the last key submitted for writing to the database is recorded.
+ * Writes are asynchronous, so before the recorded keys are saved the writes submitted so far are waited for. The file
+ * thus only ever holds keys whose writes are confirmed.
+ */
+class InitialLoadCheckpoint {
+public:
+    /** @brief Default minimum time between two saves of the checkpoint file */
+    static constexpr std::chrono::seconds DEFAULT_SAVE_INTERVAL{60};
+
+private:
+    std::filesystem::path path_;
+    uint32_t seq_;
+    std::chrono::steady_clock::duration saveInterval_;
+
+    std::mutex saveMtx_;  // held while saving so that only one thread waits for the writes at a time
+
+    mutable std::mutex mtx_;
+    std::vector<std::optional<ripple::uint256>> recorded_;
+    std::vector<std::optional<ripple::uint256>> confirmed_;  // restored from the file or saved since
+    std::chrono::steady_clock::time_point lastSave_ = std::chrono::steady_clock::now();
+
+public:
+    /**
+     * @brief Construct a checkpoint for downloading a ledger.
+     *
+     * The progress is restored from the file if it belongs to a download of the same ledger in as many ranges.
+     *
+     * @param path The path of the checkpoint file
+     * @param seq The sequence of the ledger being downloaded
+     * @param numRanges The number of key ranges the ledger is downloaded in
+     * @param saveInterval Minimum time between two saves of the checkpoint file
+     */
+    InitialLoadCheckpoint(
+        std::filesystem::path path,
+        uint32_t seq,
+        std::size_t numRanges,
+        std::chrono::steady_clock::duration saveInterval = DEFAULT_SAVE_INTERVAL
+    );
+
+    /**
+     * @brief Read the sequence of the ledger a checkpoint file was written for.
+     *
+     * @param path The path of the checkpoint file
+     * @return The sequence on success; error message otherwise
+     */
+    static std::expected<uint32_t, std::string>
+    readSequence(std::filesystem::path const& path);
+
+    /**
+     * @brief Remove the checkpoint file, if any.
+     *
+     * @param path The path of the checkpoint file
+     */
+    static void
+    remove(std::filesystem::path const& path);
+
+    /**
+     * @return The sequence of the ledger being downloaded
+     */
+    uint32_t
+    seq() const;
+
+    /**
+     * @brief Get the last key known to be written to the database for a range.
+     *
+     * That is the key restored from the file or persisted by the latest save.
+     *
+     * @param rangeIdx The index of the range
+     * @return The key if anything of the range was written; nullopt otherwise
+     */
+    std::optional<ripple::uint256>
+    writtenUpTo(std::size_t rangeIdx) const;
+
+    /**
+     * @brief Record the last key submitted for writing for a range. Saves the checkpoint file if it's due.
+     *
+     * When saving, the keys recorded so far are only persisted after waitForWrites returned. Other threads may keep
+     * recording meanwhile.
+     *
+     * @param rangeIdx The index of the range
+     * @param key The last key submitted for writing
+     * @param waitForWrites Blocks until all the writes submitted so far are finished
+     * @return Nothing on success or if no save was due; error message if saving failed
+     */
+    std::expected<void, std::string>
+    record(std::size_t rangeIdx, ripple::uint256 const& key, std::function<void()> const& waitForWrites);
+
+private:
+    static std::expected<std::vector<std::optional<ripple::uint256>>, std::string>
+    read(std::filesystem::path const& path, uint32_t seq);
+
+    std::expected<void, std::string>
+    write(std::vector<std::optional<ripple::uint256>> const& keys) const;
+};
+
+}  // namespace etl
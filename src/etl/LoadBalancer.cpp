@@ -21,17 +21,22 @@
 
 #include "data/BackendInterface.hpp"
 #include "etl/ETLState.hpp"
+#include "etl/InitialLoadCheckpoint.hpp"
 #include "etl/NetworkValidatedLedgersInterface.hpp"
 #include "etl/Source.hpp"
+#include "etl/impl/SourceStats.hpp"
 #include "feed/SubscriptionManagerInterface.hpp"
 #include "rpc/Errors.hpp"
 #include "util/Assert.hpp"
-#include "util/Random.hpp"
 #include "util/ResponseExpirationCache.hpp"
 #include "util/log/Logger.hpp"
 
+#include <boost/asio/associated_executor.hpp>
+#include <boost/asio/compose.hpp>
 #include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
 #include <boost/asio/spawn.hpp>
+#include <boost/asio/steady_timer.hpp>
 #include <boost/json/array.hpp>
 #include <boost/json/object.hpp>
 #include <boost/json/value.hpp>
@@ -39,15 +44,21 @@
 #include <fmt/core.h>
 
 #include <algorithm>
+#include <array>
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <expected>
+#include <filesystem>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <thread>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -55,6 +66,73 @@ using namespace util;
 
 namespace etl {
 
+namespace {
+
+// commands which can safely be sent to more than one rippled node
+std::unordered_set<std::string> const HEDGED_COMMANDS = {
+    "fee",
+    "ledger_closed",
+    "ledger_current",
+    "manifest",
+    "server_definitions",
+    "server_info",
+    "server_state",
+};
+
+struct HedgeState {
+    std::mutex mtx;
+    std::array<std::optional<std::expected<boost::json::object, rpc::ClioError>>, 2> results;
+    bool hedgeDue = false;
+    std::function<void()> resume;
+
+    void
+    notify()
+    {
+        std::function<void()> resumeWaiter;
+        {
+            std::scoped_lock const lck{mtx};
+            resumeWaiter = std::exchange(resume, nullptr);
+        }
+        if (resumeWaiter)
+            resumeWaiter();
+    }
+
+    // predicate is called with mtx locked
+    template <typename Predicate>
+    void
+    waitUntil(boost::asio::yield_context yield, Predicate const& predicate)
+    {
+        while (true) {
+            auto init = [this, &predicate]<typename Self>(Self& self) {
+                auto sself = std::make_shared<Self>(std::move(self));
+                auto resumeWaiter = [sself]() {
+                    boost::asio::post(boost::asio::get_associated_executor(*sself), [sself]() mutable {
+                        sself->complete();
+                    });
+                };
+
+                std::unique_lock lck{mtx};
+                if (predicate()) {
+                    lck.unlock();
+                    resumeWaiter();
+                } else {
+                    resume = std::move(resumeWaiter);
+                }
+            };
+
+            boost::asio::async_compose<boost::asio::yield_context, void()>(
+                init, yield, boost::asio::get_associated_executor(yield)
+            );
+
+            std::scoped_lock const lck{mtx};
+            if (predicate())
+                return;
+        }
+    }
+};
+
+}  // namespace
+
 std::shared_ptr<LoadBalancer>
 LoadBalancer::make_LoadBalancer(
     Config const& config,
@@ -95,6 +173,9 @@ LoadBalancer::LoadBalancer(
         downloadRanges_ = 4;
     }
 
+    if (auto const path = config.maybeValue<std::string>("initial_load_checkpoint_path"); path)
+        checkpointPath_ = *path;
+
     auto const allowNoEtl = config.valueOr("allow_no_etl", false);
 
     auto const checkOnETLFailure = [this, allowNoEtl](std::string const& log) {
@@ -107,6 +188,9 @@ LoadBalancer::LoadBalancer(
     };
 
     auto const forwardingTimeout = Config::toMilliseconds(config.valueOr<float>("forwarding.request_timeout", 10.));
+    if (auto const hedgeDelay = config.valueOr<float>("forwarding.hedge_delay", 0.f); hedgeDelay > 0.f)
+        hedgeDelay_ = Config::toMilliseconds(hedgeDelay);
+
     for (auto const& entry : config.array("etl_sources")) {
         auto source = sourceFactory(
             entry,
@@ -146,6 +230,7 @@ LoadBalancer::LoadBalancer(
             etlState_ = stateOpt;
         }
 
+        selector_.addSource(std::to_string(sources_.size()));
         sources_.push_back(std::move(source));
         LOG(log_.info()) << "Added etl source - " << sources_.back()->toString();
     }
@@ -171,10 +256,15 @@ LoadBalancer::~LoadBalancer()
 std::vector<std::string>
 LoadBalancer::loadInitialLedger(uint32_t sequence, bool cacheOnly, std::chrono::steady_clock::duration retryAfter)
 {
+    // shared by all the attempts so that a retry on another source doesn't write the same objects again
+    std::shared_ptr<InitialLoadCheckpoint> checkpoint;
+    if (checkpointPath_ and not cacheOnly)
+        checkpoint = std::make_shared<InitialLoadCheckpoint>(*checkpointPath_, sequence, downloadRanges_);
+
     std::vector<std::string> response;
     execute(
-        [this, &response, &sequence, cacheOnly](auto& source) {
-            auto [data, res] = source->loadInitialLedger(sequence, downloadRanges_, cacheOnly);
+        [this, &response, &sequence, cacheOnly, &checkpoint](auto& source) {
+            auto [data, res] = source->loadInitialLedger(sequence, downloadRanges_, cacheOnly, checkpoint);
 
             if (!res) {
                 LOG(log_.error()) << "Failed to download initial ledger."
@@ -186,11 +276,39 @@ LoadBalancer::loadInitialLedger(uint32_t sequence, bool cacheOnly, std::chrono::
             return res;
         },
         sequence,
-        retryAfter
+        retryAfter,
+        false
     );
     return response;
 }
 
+std::optional<std::uint32_t>
+LoadBalancer::resumableInitialLedger() const
+{
+    if (not checkpointPath_ or not std::filesystem::exists(*checkpointPath_))
+        return std::nullopt;
+
+    auto const seq = InitialLoadCheckpoint::readSequence(*checkpointPath_);
+    if (not seq.has_value()) {
+        LOG(log_.warn()) << "Ignoring initial load checkpoint: " << seq.error();
+        return std::nullopt;
+    }
+
+    if (std::ranges::none_of(sources_, [&seq](auto const& source) { return source->hasLedger(*seq); })) {
+        LOG(log_.warn()) << "Can't resume initial load of ledger " << *seq << ": no source has it anymore";
+        return std::nullopt;
+    }
+
+    return *seq;
+}
+
+void
+LoadBalancer::removeInitialLoadCheckpoint() const
+{
+    if (checkpointPath_)
+        InitialLoadCheckpoint::remove(*checkpointPath_);
+}
+
 LoadBalancer::OptionalGetLedgerResponseType
 LoadBalancer::fetchLedger(
     uint32_t ledgerSequence,
@@ -240,24 +358,31 @@ LoadBalancer::forwardToRippled(
     }
 
     ASSERT(not sources_.empty(), "ETL sources must be configured to forward requests.");
-    std::size_t sourceIdx = util::Random::uniform(0ul, sources_.size() - 1);
-
-    auto numAttempts = 0u;
+    auto const order = selector_.order();
 
     auto xUserValue = isAdmin ? ADMIN_FORWARDING_X_USER_VALUE : USER_FORWARDING_X_USER_VALUE;
 
     std::optional<boost::json::object> response;
     rpc::ClioError error = rpc::ClioError::etlCONNECTION_ERROR;
-    while (numAttempts < sources_.size()) {
-        auto res = sources_[sourceIdx]->forwardToRippled(request, clientIp, xUserValue, yield);
+    std::size_t next = 0;
+
+    if (hedgeDelay_.has_value() and order.size() > 1 and HEDGED_COMMANDS.contains(cmd)) {
+        auto res = forwardHedged(order[0], order[1], request, clientIp, xUserValue, yield);
+        if (res) {
+            response = std::move(res).value();
+        } else {
+            error = std::max(error, res.error());
+        }
+        next = 2;
+    }
+
+    for (; not response and next < order.size(); ++next) {
+        auto res = forwardToSource(order[next], request, clientIp, xUserValue, yield);
         if (res) {
             response = std::move(res).value();
             break;
         }
         error = std::max(error, res.error());  // Choose the best result between all sources
-
-        sourceIdx = (sourceIdx + 1) % sources_.size();
-        ++numAttempts;
     }
 
     if (response) {
@@ -269,55 +394,153 @@ LoadBalancer::forwardToRippled(
     return std::unexpected{error};
 }
 
+std::expected<boost::json::object, rpc::ClioError>
+LoadBalancer::forwardToSource(
+    std::size_t sourceIdx,
+    boost::json::object const& request,
+    std::optional<std::string> const& clientIp,
+    std::string_view xUserValue,
+    boost::asio::yield_context yield
+)
+{
+    auto& stats = selector_.stats(sourceIdx);
+    stats.onStart();
+
+    auto const start = std::chrono::steady_clock::now();
+    auto res = sources_[sourceIdx]->forwardToRippled(request, clientIp, xUserValue, yield);
+    if (res) {
+        stats.onSuccess(std::chrono::steady_clock::now() - start);
+    } else {
+        stats.onFailure();
+    }
+    return res;
+}
+
+std::expected<boost::json::object, rpc::ClioError>
+LoadBalancer::forwardHedged(
+    std::size_t primaryIdx,
+    std::size_t secondaryIdx,
+    boost::json::object const& request,
+    std::optional<std::string> const& clientIp,
+    std::string_view xUserValue,
+    boost::asio::yield_context yield
+)
+{
+    auto state = std::make_shared<HedgeState>();
+    auto const launch = [&](std::size_t slot, std::size_t sourceIdx) {
+        boost::asio::spawn(
+            boost::asio::get_associated_executor(yield),
+            [this, state, slot, sourceIdx, request, clientIp, xUserValue](boost::asio::yield_context innerYield) {
+                auto res = forwardToSource(sourceIdx, request, clientIp, xUserValue, innerYield);
+                {
+                    std::scoped_lock const lck{state->mtx};
+                    state->results[slot] = std::move(res);
+                }
+                state->notify();
+            }
+        );
+    };
+    auto const succeeded = [&state](std::size_t slot) {
+        return state->results[slot].has_value() and state->results[slot]->has_value();
+    };
+
+    launch(0, primaryIdx);
+
+    boost::asio::steady_timer timer{boost::asio::get_associated_executor(yield), *hedgeDelay_};
+    timer.async_wait([state](boost::system::error_code const& ec) {
+        if (ec)
+            return;
+        {
+            std::scoped_lock const lck{state->mtx};
+            state->hedgeDue = true;
+        }
+        state->notify();
+    });
+
+    state->waitUntil(yield, [&]() { return state->results[0].has_value() or state->hedgeDue; });
+    timer.cancel();
+
+    {
+        std::scoped_lock const lck{state->mtx};
+        if (succeeded(0))
+            return std::move(*state->results[0]);
+    }
+
+    // the primary source is either too slow or failed so the secondary one is tried as well
+    launch(1, secondaryIdx);
+    state->waitUntil(yield, [&]() {
+        return succeeded(0) or succeeded(1) or (state->results[0].has_value() and state->results[1].has_value());
+    });
+
+    std::scoped_lock const lck{state->mtx};
+    for (std::size_t slot = 0; slot < state->results.size(); ++slot) {
+        if (succeeded(slot))
+            return std::move(*state->results[slot]);
+    }
+    return std::unexpected{std::max(state->results[0]->error(), state->results[1]->error())};
+}
+
 boost::json::value
 LoadBalancer::toJson() const
 {
     boost::json::array ret;
-    for (auto& src : sources_)
-        ret.push_back(src->toJson());
+    for (std::size_t idx = 0; idx < sources_.size(); ++idx) {
+        auto json = sources_[idx]->toJson();
+        json["stats"] = selector_.stats(idx).toJson();
+        ret.push_back(std::move(json));
+    }
 
     return ret;
 }
 
 template <typename Func>
 void
-LoadBalancer::execute(Func f, uint32_t ledgerSequence, std::chrono::steady_clock::duration retryAfter)
+LoadBalancer::execute(
+    Func f,
+    uint32_t ledgerSequence,
+    std::chrono::steady_clock::duration retryAfter,
+    bool recordLatency
+)
 {
     ASSERT(not sources_.empty(), "ETL sources must be configured to execute functions.");
-    size_t sourceIdx = util::Random::uniform(0ul, sources_.size() - 1);
-
-    size_t numAttempts = 0;
 
     while (true) {
-        auto& source = sources_[sourceIdx];
-
-        LOG(log_.debug()) << "Attempting to execute func. ledger sequence = " << ledgerSequence
-                          << " - source = " << source->toString();
-        // Originally, it was (source->hasLedger(ledgerSequence) || true)
-        /* Sometimes rippled has ledger but doesn't actually know. However,
-        but this does NOT happen in the normal case and is safe to remove
-        This || true is only needed when loading full history standalone */
-        if (source->hasLedger(ledgerSequence)) {
-            bool const res = f(source);
-            if (res) {
-                LOG(log_.debug()) << "Successfully executed func at source = " << source->toString()
-                                  << " - ledger sequence = " << ledgerSequence;
-                break;
+        for (auto const sourceIdx : selector_.order()) {
+            auto& source = sources_[sourceIdx];
+
+            LOG(log_.debug()) << "Attempting to execute func. ledger sequence = " << ledgerSequence
+                              << " - source = " << source->toString();
+            // Originally, it was (source->hasLedger(ledgerSequence) || true)
+            /* Sometimes rippled has ledger but doesn't actually know. However,
+            but this does NOT happen in the normal case and is safe to remove
+            This || true is only needed when loading full history standalone */
+            if (source->hasLedger(ledgerSequence)) {
+                auto& stats = selector_.stats(sourceIdx);
+                stats.onStart();
+
+                auto const start = std::chrono::steady_clock::now();
+                bool const res = f(source);
+                if (res) {
+                    stats.onSuccess(
+                        recordLatency ? std::make_optional(std::chrono::steady_clock::now() - start) : std::nullopt
+                    );
+                    LOG(log_.debug()) << "Successfully executed func at source = " << source->toString()
+                                      << " - ledger sequence = " << ledgerSequence;
+                    return;
+                }
+
+                stats.onFailure();
+                LOG(log_.warn()) << "Failed to execute func at source = " << source->toString()
+                                 << " - ledger sequence = " << ledgerSequence;
+            } else {
+                LOG(log_.warn()) << "Ledger not present at source = " << source->toString()
+                                 << " - ledger sequence = " << ledgerSequence;
             }
-
-            LOG(log_.warn()) << "Failed to execute func at source = " << source->toString()
-                             << " - ledger sequence = " << ledgerSequence;
-        } else {
-            LOG(log_.warn()) << "Ledger not present at source = " << source->toString()
-                             << " - ledger sequence = " << ledgerSequence;
-        }
-        sourceIdx = (sourceIdx + 1) % sources_.size();
-        numAttempts++;
-        if (numAttempts % sources_.size() == 0) {
-            LOG(log_.info()) << "Ledger sequence " << ledgerSequence
-                             << " is not yet available from any configured sources. Sleeping and trying again";
-            std::this_thread::sleep_for(retryAfter);
         }
+
+        LOG(log_.info()) << "Ledger sequence " << ledgerSequence
+                         << " is not yet available from any configured sources. Sleeping and trying again";
+        std::this_thread::sleep_for(retryAfter);
     }
 }
 
@@ -21,8 +21,10 @@
 
 #include "data/BackendInterface.hpp"
 #include "etl/ETLState.hpp"
+#include "etl/InitialLoadCheckpoint.hpp"
 #include "etl/NetworkValidatedLedgersInterface.hpp"
 #include "etl/Source.hpp"
+#include "etl/impl/SourceSelector.hpp"
 #include "feed/SubscriptionManagerInterface.hpp"
 #include "util/Mutex.hpp"
 #include "util/ResponseExpirationCache.hpp"
@@ -40,8 +42,10 @@
 #include <xrpl/proto/org/xrpl/rpc/v1/xrp_ledger.grpc.pb.h>
 
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <expected>
+#include <filesystem>
 #include <memory>
 #include <optional>
 #include <string>
@@ -72,9 +76,14 @@ private:
     std::optional<std::string> forwardingXUserValue_;
 
     std::vector<SourcePtr> sources_;
+    impl::SourceSelector selector_;
+
+    // if set, idempotent forwarded requests are also sent to a second source when the first one is this slow
+    std::optional<std::chrono::steady_clock::duration> hedgeDelay_;
     std::optional<ETLState> etlState_;
     std::uint32_t downloadRanges_ =
         DEFAULT_DOWNLOAD_RANGES; /*< The number of markers to use when downloading initial ledger */
+    std::optional<std::filesystem::path> checkpointPath_; /*< Where the progress of the initial download is kept */
 
     // Using mutext instead of atomic_bool because choosing a new source to
     // forward messages should be done with a mutual exclusion otherwise there will be a race condition
@@ -135,6 +144,10 @@ public:
 
     /**
      * @brief Load the initial ledger, writing data to the queue.
+     *
+     * If a checkpoint path is configured, the progress of the download is kept there and a download of the same ledger
+     * resumes from it.
+     *
      * @note This function will retry indefinitely until the ledger is downloaded.
      *
      * @param sequence Sequence of ledger to download
@@ -179,7 +192,10 @@ public:
     toJson() const;
 
     /**
-     * @brief Forward a JSON RPC request to a randomly selected rippled node.
+     * @brief Forward a JSON RPC request to a rippled node.
+     *
+     * The node is chosen by its latency, load and error rate. If hedging is configured, idempotent commands are also
+     * sent to a second node when the first one doesn't reply in time and the first reply is used.
      *
      * @param request JSON-RPC request to forward
      * @param clientIp The IP address of the peer, if known
@@ -202,22 +218,69 @@ public:
     std::optional<ETLState>
     getETLState() noexcept;
 
+    /**
+     * @brief Get the ledger an interrupted initial download can be resumed for.
+     *
+     * @return The sequence of the ledger if there is a checkpoint for it and a source has it; nullopt otherwise
+     */
+    std::optional<std::uint32_t>
+    resumableInitialLedger() const;
+
+    /**
+     * @brief Remove the checkpoint of the initial download once the initial ledger is written entirely.
+     */
+    void
+    removeInitialLoadCheckpoint() const;
+
+    /**
+     * @return The number of key ranges the initial ledger is downloaded in
+     */
+    std::uint32_t
+    numDownloadRanges() const noexcept
+    {
+        return downloadRanges_;
+    }
+
 private:
     /**
-     * @brief Execute a function on a randomly selected source.
+     * @brief Execute a function on the best available source.
      *
      * @note f is a function that takes an Source as an argument and returns a bool.
-     * Attempt to execute f for one randomly chosen Source that has the specified ledger. If f returns false, another
-     * randomly chosen Source is used. The process repeats until f returns true.
+     * Attempt to execute f for the source chosen by the selector that has the specified ledger. If f returns false, the
+     * next best Source is used. The process repeats until f returns true.
      *
      * @param f Function to execute. This function takes the ETL source as an argument, and returns a bool
      * @param ledgerSequence f is executed for each Source that has this ledger
      * @param retryAfter Time to wait between retries (2 seconds by default)
-     * server is shutting down
+     * @param recordLatency Whether the time f takes should count towards the latency of the source
      */
     template <typename Func>
     void
-    execute(Func f, uint32_t ledgerSequence, std::chrono::steady_clock::duration retryAfter = std::chrono::seconds{2});
+    execute(
+        Func f,
+        uint32_t ledgerSequence,
+        std::chrono::steady_clock::duration retryAfter = std::chrono::seconds{2},
+        bool recordLatency = true
+    );
+
+    std::expected<boost::json::object, rpc::ClioError>
+    forwardToSource(
+        std::size_t sourceIdx,
+        boost::json::object const& request,
+        std::optional<std::string> const& clientIp,
+        std::string_view xUserValue,
+        boost::asio::yield_context yield
+    );
+
+    std::expected<boost::json::object, rpc::ClioError>
+    forwardHedged(
+        std::size_t primaryIdx,
+        std::size_t secondaryIdx,
+        boost::json::object const& request,
+        std::optional<std::string> const& clientIp,
+        std::string_view xUserValue,
+        boost::asio::yield_context yield
+    );
 
     /**
      * @brief Choose a new source to forward requests
@@ -31,6 +31,7 @@
 #include <boost/asio/io_context.hpp>
 
 #include <chrono>
+#include <cstddef>
 #include <memory>
 #include <string>
 #include <utility>
@@ -54,8 +55,13 @@ make_Source(
     auto const wsPort = config.valueOr<std::string>("ws_port", {});
     auto const grpcPort = config.valueOr<std::string>("grpc_port", {});
 
-    impl::ForwardingSource forwardingSource{ip, wsPort, forwardingTimeout};
-    impl::GrpcSource grpcSource{ip, grpcPort, std::move(backend)};
+    auto const forwardingPoolSize = config.valueOr<std::size_t>("forwarding_pool_size", 0);
+    auto const loadThreads = config.valueOr<std::size_t>("load_threads", 0);
+
+    impl::ForwardingSource forwardingSource{
+        ip, wsPort, forwardingTimeout, impl::ForwardingSource::CONNECTION_TIMEOUT, forwardingPoolSize
+    };
+    impl::GrpcSource grpcSource{ip, grpcPort, std::move(backend), loadThreads};
     auto subscriptionSource = std::make_unique<impl::SubscriptionSource>(
         ioc,
         ip,
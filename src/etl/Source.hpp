@@ -20,6 +20,7 @@
 #pragma once
 
 #include "data/BackendInterface.hpp"
+#include "etl/InitialLoadCheckpoint.hpp"
 #include "etl/NetworkValidatedLedgersInterface.hpp"
 #include "feed/SubscriptionManagerInterface.hpp"
 #include "rpc/Errors.hpp"
@@ -121,10 +122,16 @@ public:
      * @param sequence Sequence of the ledger to download
      * @param numMarkers Number of markers to generate for async calls
      * @param cacheOnly Only insert into cache, not the DB; defaults to false
+     * @param checkpoint Progress of the download to resume from and record to; none if nullptr
      * @return A std::pair of the data and a bool indicating whether the download was successful
      */
     virtual std::pair<std::vector<std::string>, bool>
-    loadInitialLedger(uint32_t sequence, std::uint32_t numMarkers, bool cacheOnly = false) = 0;
+    loadInitialLedger(
+        uint32_t sequence,
+        std::uint32_t numMarkers,
+        bool cacheOnly = false,
+        std::shared_ptr<InitialLoadCheckpoint> const& checkpoint = nullptr
+    ) = 0;
 
     /**
      * @brief Forward a request to rippled.
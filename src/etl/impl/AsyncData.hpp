@@ -58,6 +58,9 @@ class AsyncCallData {
 
     std::string lastKey_;
 
+    // objects up to this key were already written to the database by an interrupted download
+    std::optional<ripple::uint256> writtenUpTo_;
+
 public:
     AsyncCallData(uint32_t seq, ripple::uint256 const& marker, std::optional<ripple::uint256> const& nextMarker)
     {
@@ -146,10 +149,9 @@ public:
                 if (static_cast<unsigned char>(obj.key()[0]) >= nextPrefix_)
                     continue;
             }
-            cacheUpdates.push_back(
-                {*ripple::uint256::fromVoidChecked(obj.key()), {obj.data().begin(), obj.data().end()}}
-            );
-            if (!cacheOnly) {
+            auto const key = *ripple::uint256::fromVoidChecked(obj.key());
+            cacheUpdates.push_back({key, {obj.data().begin(), obj.data().end()}});
+            if (!cacheOnly && (!writtenUpTo_ || key > *writtenUpTo_)) {
                 if (!lastKey_.empty())
                     backend.writeSuccessor(std::move(lastKey_), request_.ledger().sequence(), std::string{obj.key()});
                 lastKey_ = obj.key();
@@ -193,6 +195,18 @@ public:
     {
         return lastKey_;
     }
+
+    /**
+     * @brief Resume an interrupted download. Objects up to the given key are only added to the cache.
+     *
+     * @param key The last key written to the database by the interrupted download
+     */
+    void
+    resumeAfter(ripple::uint256 const& key)
+    {
+        writtenUpTo_ = key;
+        lastKey_ = std::string{reinterpret_cast<char const*>(key.data()), ripple::uint256::size()};
+    }
 };
 
 inline std::vector<AsyncCallData>
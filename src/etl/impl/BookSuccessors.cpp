@@ -0,0 +1,123 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "etl/impl/BookSuccessors.hpp"
+
+#include "data/BackendInterface.hpp"
+#include "data/DBHelpers.hpp"
+#include "data/Types.hpp"
+#include "util/Assert.hpp"
+#include "util/log/Logger.hpp"
+
+#include <xrpl/basics/base_uint.h>
+#include <xrpl/basics/strHex.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace etl::impl {
+
+RangeSuccessors
+writeBookSuccessors(
+    BackendInterface& backend,
+    ripple::uint256 const& first,
+    std::optional<ripple::uint256> const& last,
+    uint32_t sequence
+)
+{
+    static util::Logger const log{"ETL"};
+
+    RangeSuccessors result;
+    backend.cache().forEachInRange(first, last, [&](data::LedgerObject const& obj) {
+        if (isBookDir(obj.key, obj.blob)) {
+            // the directory is the successor of the base unless the base is an object itself or there is an object in
+            // between
+            auto const base = getBookBase(obj.key);
+            if (base != obj.key and (not result.last or *result.last < base)) {
+                LOG(log.debug()) << "Writing book successor = " << ripple::strHex(base) << " - "
+                                 << ripple::strHex(obj.key);
+
+                backend.writeSuccessor(uint256ToString(base), sequence, uint256ToString(obj.key));
+            }
+
+            ++result.numWrites;
+        }
+
+        if (not result.first)
+            result.first = obj.key;
+        result.last = obj.key;
+    });
+
+    return result;
+}
+
+std::size_t
+writeBookSuccessors(
+    BackendInterface& backend,
+    std::vector<ripple::uint256> const& markers,
+    uint32_t sequence,
+    std::size_t numThreads
+)
+{
+    ASSERT(numThreads > 0, "Number of threads must be greater than 0");
+
+    std::vector<RangeSuccessors> ranges(markers.size());
+    std::atomic_size_t next = 0;
+
+    auto const walkRanges = [&] {
+        for (auto i = next++; i < markers.size(); i = next++) {
+            auto const last = i + 1 < markers.size() ? std::optional{markers[i + 1]} : std::nullopt;
+            ranges[i] = writeBookSuccessors(backend, markers[i], last, sequence);
+        }
+    };
+
+    auto const poolSize = std::min(numThreads, markers.size());
+    std::vector<std::thread> threads;
+    threads.reserve(poolSize);
+    for (std::size_t i = 0; i < poolSize; ++i)
+        threads.emplace_back(walkRanges);
+
+    for (auto& thread : threads)
+        thread.join();
+
+    std::size_t numWrites = 0;
+    ripple::uint256 prev = data::firstKey;
+    for (auto const& range : ranges) {
+        if (not range.first)
+            continue;
+
+        if (prev == data::firstKey)
+            backend.writeSuccessor(uint256ToString(prev), sequence, uint256ToString(*range.first));
+
+        prev = *range.last;
+        numWrites += range.numWrites;
+    }
+
+    backend.writeSuccessor(uint256ToString(prev), sequence, uint256ToString(data::lastKey));
+    ++numWrites;
+
+    return numWrites;
+}
+
+}  // namespace etl::impl
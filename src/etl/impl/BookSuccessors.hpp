@@ -0,0 +1,83 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+/** @file */
+#pragma once
+
+#include "data/BackendInterface.hpp"
+
+#include <xrpl/basics/base_uint.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace etl::impl {
+
+/**
+ * @brief The result of walking a range of keys of the cache for book successors.
+ */
+struct RangeSuccessors {
+    std::optional<ripple::uint256> first;
+    std::optional<ripple::uint256> last;
+    std::size_t numWrites = 0;
+};
+
+/**
+ * @brief Write the successors of the book bases of a key range of the cache.
+ *
+ * A book base shares its leading byte with its directories, so as long as ranges are split by leading byte the base
+ * and the directory are always walked by the same call.
+ *
+ * @param backend The backend to read the cache of and write the successors to
+ * @param first The first key of the range
+ * @param last The key the range ends before; nullopt to walk up to the last key
+ * @param sequence The sequence to write the successors for
+ * @return The first and last keys found in the range and the number of book directories found
+ */
+RangeSuccessors
+writeBookSuccessors(
+    BackendInterface& backend,
+    ripple::uint256 const& first,
+    std::optional<ripple::uint256> const& last,
+    uint32_t sequence
+);
+
+/**
+ * @brief Write the successors of all the book bases of the cache and link the first and last keys to the cache.
+ *
+ * The key ranges starting at the markers are walked concurrently by a fixed number of threads, each of them taking
+ * the next range not walked yet once done with its current one.
+ *
+ * @param backend The backend to read the cache of and write the successors to
+ * @param markers The first keys of the ranges in ascending order; see @ref getMarkers
+ * @param sequence The sequence to write the successors for
+ * @param numThreads The number of threads to walk the ranges with; capped at the number of ranges
+ * @return The number of successors written
+ */
+std::size_t
+writeBookSuccessors(
+    BackendInterface& backend,
+    std::vector<ripple::uint256> const& markers,
+    uint32_t sequence,
+    std::size_t numThreads
+);
+
+}  // namespace etl::impl
@@ -21,9 +21,11 @@
 
 #include "etl/NetworkValidatedLedgersInterface.hpp"
 #include "etl/SystemState.hpp"
+#include "etl/impl/StageMetrics.hpp"
 #include "util/Assert.hpp"
 #include "util/Profiler.hpp"
 #include "util/log/Logger.hpp"
+#include "util/prometheus/Histogram.hpp"
 
 #include <xrpl/beast/core/CurrentThreadName.h>
 
@@ -42,6 +44,8 @@ namespace etl::impl {
  */
 template <typename DataPipeType, typename LedgerFetcherType>
 class Extractor {
+    static constexpr auto MILLISECONDS_PER_SECOND = 1000.0;
+
     util::Logger log_{"ETL"};
 
     std::reference_wrapper<DataPipeType> pipe_;
@@ -50,6 +54,7 @@ class Extractor {
     uint32_t startSequence_;
     std::optional<uint32_t> finishSequence_;
     std::reference_wrapper<SystemState const> state_;  // shared state for ETL
+    std::reference_wrapper<util::prometheus::HistogramInt> extractDuration_{stageDurationHistogram("extract")};
 
     std::thread thread_;
 
@@ -100,6 +105,7 @@ private:
                 return ledgerFetcher_.get().fetchDataAndDiff(currentSequence);
             });
             totalTime += time;
+            extractDuration_.get().observe(static_cast<std::int64_t>(time * MILLISECONDS_PER_SECOND));
 
             // if the fetch is unsuccessful, stop. fetchLedger only returns false if the server is shutting down, or
             // if the ledger was found in the database (which means another process already wrote the ledger that
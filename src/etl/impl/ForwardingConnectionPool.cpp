@@ -0,0 +1,414 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "etl/impl/ForwardingConnectionPool.hpp"
+
+#include "rpc/Errors.hpp"
+#include "util/log/Logger.hpp"
+#include "util/requests/WsConnection.hpp"
+
+#include <boost/asio/any_io_executor.hpp>
+#include <boost/asio/associated_executor.hpp>
+#include <boost/asio/compose.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/spawn.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/strand.hpp>
+#include <boost/json/object.hpp>
+#include <boost/json/parse.hpp>
+#include <boost/json/serialize.hpp>
+#include <boost/json/value.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <expected>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace etl::impl {
+
+std::shared_ptr<ForwardingConnection>
+ForwardingConnection::make(
+    util::requests::WsConnectionPtr ws,
+    boost::asio::any_io_executor executor,
+    std::chrono::steady_clock::duration timeout,
+    std::chrono::steady_clock::duration heartbeatInterval
+)
+{
+    auto connection = std::make_shared<ForwardingConnection>(
+        PrivateTag{}, std::move(ws), std::move(executor), timeout, heartbeatInterval
+    );
+    connection->run();
+    return connection;
+}
+
+ForwardingConnection::ForwardingConnection(
+    PrivateTag,
+    util::requests::WsConnectionPtr ws,
+    boost::asio::any_io_executor executor,
+    std::chrono::steady_clock::duration timeout,
+    std::chrono::steady_clock::duration heartbeatInterval
+)
+    : ws_{std::move(ws)}
+    , strand_{boost::asio::make_strand(std::move(executor))}
+    , timeout_{timeout}
+    , heartbeatInterval_{heartbeatInterval}
+    , wakeup_{strand_}
+    , heartbeat_{strand_}
+{
+}
+
+ForwardingConnection::Response
+ForwardingConnection::request(
+    boost::json::object const& request,
+    boost::asio::yield_context yield,
+    std::chrono::steady_clock::duration timeout
+)
+{
+    std::optional<boost::json::value> originalId;
+    if (auto const* id = request.if_contains("id"); id != nullptr)
+        originalId = *id;
+
+    auto const id = nextId_++;
+    auto message = request;
+    message["id"] = id;
+
+    auto pending = std::make_shared<Pending>();
+    {
+        std::scoped_lock const lck{mtx_};
+        if (not alive_)
+            return std::unexpected{rpc::ClioError::etlCONNECTION_ERROR};
+
+        pending_.emplace(id, pending);
+        outbox_.push_back(boost::json::serialize(message));
+    }
+    boost::asio::post(strand_, [self = shared_from_this()]() { self->wakeup_.cancel(); });
+
+    boost::asio::steady_timer timer{boost::asio::get_associated_executor(yield), timeout};
+    timer.async_wait([weak = weak_from_this(), id](boost::system::error_code const& ec) {
+        if (ec)
+            return;
+        if (auto self = weak.lock(); self)
+            self->complete(id, std::unexpected{rpc::ClioError::etlREQUEST_TIMEOUT});
+    });
+
+    auto init = [this, &pending]<typename Self>(Self& self) {
+        auto sself = std::make_shared<Self>(std::move(self));
+        auto resume = [sself]() {
+            boost::asio::post(boost::asio::get_associated_executor(*sself), [sself]() mutable { sself->complete(); });
+        };
+
+        std::unique_lock lck{mtx_};
+        if (pending->response.has_value()) {
+            lck.unlock();
+            resume();
+        } else {
+            pending->resume = std::move(resume);
+        }
+    };
+
+    boost::asio::async_compose<boost::asio::yield_context, void()>(
+        init, yield, boost::asio::get_associated_executor(yield)
+    );
+    timer.cancel();
+
+    Response response = [&]() {
+        std::scoped_lock const lck{mtx_};
+        return std::move(*pending->response);
+    }();
+
+    if (response.has_value()) {
+        if (originalId.has_value()) {
+            response->insert_or_assign("id", std::move(*originalId));
+        } else {
+            response->erase("id");
+        }
+    }
+    return response;
+}
+
+bool
+ForwardingConnection::isAlive() const
+{
+    return alive_;
+}
+
+std::size_t
+ForwardingConnection::inFlight() const
+{
+    std::scoped_lock const lck{mtx_};
+    return pending_.size();
+}
+
+void
+ForwardingConnection::close()
+{
+    boost::asio::post(strand_, [self = shared_from_this()]() { self->markDead(rpc::ClioError::etlCONNECTION_ERROR); });
+}
+
+void
+ForwardingConnection::run()
+{
+    boost::asio::spawn(strand_, [self = shared_from_this()](boost::asio::yield_context yield) {
+        self->readLoop(yield);
+    });
+    boost::asio::spawn(strand_, [self = shared_from_this()](boost::asio::yield_context yield) {
+        self->writeLoop(yield);
+    });
+    boost::asio::spawn(strand_, [self = shared_from_this()](boost::asio::yield_context yield) {
+        self->heartbeatLoop(yield);
+    });
+}
+
+void
+ForwardingConnection::readLoop(boost::asio::yield_context yield)
+{
+    while (alive_) {
+        auto message = ws_->read(yield);
+        if (not message) {
+            LOG(log_.debug()) << "Forwarding connection read error: " << message.error().message();
+            markDead(rpc::ClioError::etlREQUEST_ERROR);
+            return;
+        }
+        receivedSinceHeartbeat_ = true;
+
+        try {
+            auto const parsed = boost::json::parse(*message);
+            auto const* object = parsed.if_object();
+            auto const* id = object != nullptr ? object->if_contains("id") : nullptr;
+            if (id != nullptr and id->is_int64()) {
+                complete(static_cast<std::uint64_t>(id->as_int64()), *object);
+            } else if (id != nullptr and id->is_uint64()) {
+                complete(id->as_uint64(), *object);
+            } else {
+                LOG(log_.warn()) << "Dropping response from rippled without request id: " << *message;
+            }
+        } catch (std::exception const& e) {
+            LOG(log_.warn()) << "Error parsing response from rippled: " << e.what() << ". Response: " << *message;
+        }
+    }
+}
+
+void
+ForwardingConnection::writeLoop(boost::asio::yield_context yield)
+{
+    while (true) {
+        std::optional<std::string> message;
+        {
+            std::scoped_lock const lck{mtx_};
+            if (not alive_)
+                return;
+
+            if (not outbox_.empty()) {
+                message = std::move(outbox_.front());
+                outbox_.pop_front();
+            }
+        }
+
+        if (not message) {
+            // requests post a cancel of this timer to the strand after queueing a message
+            boost::system::error_code ec;
+            wakeup_.expires_at(std::chrono::steady_clock::time_point::max());
+            wakeup_.async_wait(yield[ec]);
+            continue;
+        }
+
+        if (auto const error = ws_->write(*message, yield, timeout_); error) {
+            LOG(log_.debug()) << "Forwarding connection write error: " << error->message();
+            markDead(rpc::ClioError::etlREQUEST_ERROR);
+            return;
+        }
+    }
+}
+
+void
+ForwardingConnection::heartbeatLoop(boost::asio::yield_context yield)
+{
+    while (alive_) {
+        boost::system::error_code ec;
+        heartbeat_.expires_after(heartbeatInterval_);
+        heartbeat_.async_wait(yield[ec]);
+
+        if (not alive_ or receivedSinceHeartbeat_.exchange(false))
+            continue;
+
+        if (auto const response = request({{"command", "ping"}}, yield, timeout_); not response and alive_) {
+            LOG(log_.info()) << "Forwarding connection didn't answer heartbeat. Closing it";
+            markDead(response.error());
+        }
+    }
+}
+
+void
+ForwardingConnection::complete(std::uint64_t id, Response response)
+{
+    std::function<void()> resume;
+    {
+        std::scoped_lock const lck{mtx_};
+        auto const it = pending_.find(id);
+        if (it == pending_.end())
+            return;
+
+        it->second->response = std::move(response);
+        resume = std::move(it->second->resume);
+        pending_.erase(it);
+    }
+
+    if (resume)
+        resume();
+}
+
+void
+ForwardingConnection::markDead(rpc::ClioError error)
+{
+    std::vector<std::function<void()>> resumes;
+    {
+        std::scoped_lock const lck{mtx_};
+        if (not alive_)
+            return;
+
+        alive_ = false;
+        for (auto& [_, pending] : pending_) {
+            pending->response = std::unexpected{error};
+            if (pending->resume)
+                resumes.push_back(std::move(pending->resume));
+        }
+        pending_.clear();
+        outbox_.clear();
+    }
+
+    wakeup_.cancel();
+    heartbeat_.cancel();
+    for (auto const& resume : resumes)
+        resume();
+
+    boost::asio::spawn(strand_, [self = shared_from_this()](boost::asio::yield_context yield) {
+        self->ws_->close(yield);
+    });
+}
+
+ForwardingConnectionPool::ForwardingConnectionPool(
+    util::requests::WsConnectionBuilder connectionBuilder,
+    std::size_t size,
+    std::chrono::steady_clock::duration forwardingTimeout
+)
+    : log_{"ETL"}
+    , connectionBuilder_{std::move(connectionBuilder)}
+    , size_{size}
+    , forwardingTimeout_{forwardingTimeout}
+{
+}
+
+ForwardingConnectionPool::~ForwardingConnectionPool()
+{
+    std::scoped_lock const lck{mtx_};
+    for (auto const& connection : connections_)
+        connection->close();
+}
+
+ForwardingConnection::Response
+ForwardingConnectionPool::send(boost::json::object const& request, boost::asio::yield_context yield)
+{
+    auto connection = acquire(yield);
+    if (not connection)
+        return std::unexpected{rpc::ClioError::etlCONNECTION_ERROR};
+
+    return connection->request(request, yield, forwardingTimeout_);
+}
+
+std::size_t
+ForwardingConnectionPool::size()
+{
+    std::scoped_lock const lck{mtx_};
+    return static_cast<std::size_t>(
+        std::ranges::count_if(connections_, [](auto const& connection) { return connection->isAlive(); })
+    );
+}
+
+std::shared_ptr<ForwardingConnection>
+ForwardingConnectionPool::acquire(boost::asio::yield_context yield)
+{
+    {
+        std::scoped_lock const lck{mtx_};
+        std::erase_if(connections_, [](auto const& connection) { return not connection->isAlive(); });
+
+        // close the idle connections opened above the size of the pool
+        for (auto it = connections_.begin(); connections_.size() > size_ and it != connections_.end();) {
+            if ((*it)->inFlight() == 0) {
+                (*it)->close();
+                it = connections_.erase(it);
+            } else {
+                ++it;
+            }
+        }
+
+        auto connection = leastBusy();
+        bool const canOpen = connections_.size() + connecting_ < size_;
+        if (connection and (not canOpen or connection->inFlight() == 0))
+            return connection;
+
+        ++connecting_;
+    }
+
+    auto ws = connectionBuilder_.connect(yield);
+
+    std::scoped_lock const lck{mtx_};
+    --connecting_;
+
+    if (not ws) {
+        LOG(log_.debug()) << "Couldn't open forwarding connection to rippled: " << ws.error().message();
+        return leastBusy();
+    }
+
+    auto connection = ForwardingConnection::make(
+        std::move(ws).value(), boost::asio::get_associated_executor(yield), forwardingTimeout_
+    );
+    connections_.push_back(connection);
+    return connection;
+}
+
+std::shared_ptr<ForwardingConnection>
+ForwardingConnectionPool::leastBusy() const
+{
+    std::shared_ptr<ForwardingConnection> result;
+    std::size_t resultInFlight = 0;
+    for (auto const& connection : connections_) {
+        if (not connection->isAlive())
+            continue;
+
+        auto const inFlight = connection->inFlight();
+        if (not result or inFlight < resultInFlight) {
+            result = connection;
+            resultInFlight = inFlight;
+        }
+    }
+    return result;
+}
+
+}  // namespace etl::impl
@@ -0,0 +1,231 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include "rpc/Errors.hpp"
+#include "util/log/Logger.hpp"
+#include "util/requests/WsConnection.hpp"
+
+#include <boost/asio/any_io_executor.hpp>
+#include <boost/asio/spawn.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/strand.hpp>
+#include <boost/json/object.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <expected>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace etl::impl {
+
+/**
+ * @brief A long-lived websocket connection to rippled which can carry many requests at once.
+ *
+ * Every request gets a unique id and the responses are matched to the requests by this id, so rippled is free to
+ * answer them in any order. Reads and writes are done by dedicated coroutines running on the connection's strand. An
+ * idle connection is pinged periodically and is marked dead once it fails to answer.
+ */
+class ForwardingConnection : public std::enable_shared_from_this<ForwardingConnection> {
+public:
+    using Response = std::expected<boost::json::object, rpc::ClioError>;
+
+    static constexpr std::chrono::seconds HEARTBEAT_INTERVAL{30};
+
+private:
+    struct Pending {
+        std::optional<Response> response;
+        std::function<void()> resume;
+    };
+
+    util::Logger log_{"ETL"};
+    util::requests::WsConnectionPtr ws_;
+    boost::asio::strand<boost::asio::any_io_executor> strand_;
+    std::chrono::steady_clock::duration timeout_;
+    std::chrono::steady_clock::duration heartbeatInterval_;
+
+    // both timers are only touched on the strand
+    boost::asio::steady_timer wakeup_;
+    boost::asio::steady_timer heartbeat_;
+
+    mutable std::mutex mtx_;
+    std::unordered_map<std::uint64_t, std::shared_ptr<Pending>> pending_;
+    std::deque<std::string> outbox_;
+
+    std::atomic_bool alive_ = true;
+    std::atomic_uint64_t nextId_ = 1;
+    std::atomic_bool receivedSinceHeartbeat_ = false;
+
+    struct PrivateTag {};
+
+public:
+    /**
+     * @brief Create a connection and start serving requests over it.
+     *
+     * @param ws An established websocket connection to rippled
+     * @param executor The executor to run the connection's coroutines on
+     * @param timeout The timeout for writing a single request and for answering a heartbeat
+     * @param heartbeatInterval How often an idle connection is checked
+     * @return The connection
+     */
+    static std::shared_ptr<ForwardingConnection>
+    make(
+        util::requests::WsConnectionPtr ws,
+        boost::asio::any_io_executor executor,
+        std::chrono::steady_clock::duration timeout,
+        std::chrono::steady_clock::duration heartbeatInterval = HEARTBEAT_INTERVAL
+    );
+
+    ForwardingConnection(
+        PrivateTag,
+        util::requests::WsConnectionPtr ws,
+        boost::asio::any_io_executor executor,
+        std::chrono::steady_clock::duration timeout,
+        std::chrono::steady_clock::duration heartbeatInterval
+    );
+
+    /**
+     * @brief Send a request and wait for its response.
+     *
+     * The id of the request is replaced by the connection's own one. The id of the response is restored to the id of
+     * the original request or removed if there was none.
+     *
+     * @param request The request to send
+     * @param yield The coroutine context
+     * @param timeout The time to wait for the response
+     * @return The response or error
+     */
+    Response
+    request(
+        boost::json::object const& request,
+        boost::asio::yield_context yield,
+        std::chrono::steady_clock::duration timeout
+    );
+
+    /**
+     * @return true if the connection can still be used; false otherwise
+     */
+    bool
+    isAlive() const;
+
+    /**
+     * @return The number of requests waiting for a response
+     */
+    std::size_t
+    inFlight() const;
+
+    /**
+     * @brief Close the connection; all the requests in flight fail.
+     */
+    void
+    close();
+
+private:
+    void
+    run();
+
+    void
+    readLoop(boost::asio::yield_context yield);
+
+    void
+    writeLoop(boost::asio::yield_context yield);
+
+    void
+    heartbeatLoop(boost::asio::yield_context yield);
+
+    void
+    complete(std::uint64_t id, Response response);
+
+    // must be called on the strand
+    void
+    markDead(rpc::ClioError error);
+};
+
+/**
+ * @brief A pool of connections to rippled used to forward requests.
+ *
+ * Connections are opened on demand up to the size of the pool and are reused afterwards. Each request goes to the
+ * alive connection with the fewest requests in flight. Dead connections are dropped and replaced by new ones. The pool
+ * may be exceeded while connections are being opened; the extra connections are closed once they are idle.
+ */
+class ForwardingConnectionPool {
+    util::Logger log_;
+    util::requests::WsConnectionBuilder connectionBuilder_;
+    std::size_t size_;
+    std::chrono::steady_clock::duration forwardingTimeout_;
+
+    std::mutex mtx_;
+    std::vector<std::shared_ptr<ForwardingConnection>> connections_;
+    std::size_t connecting_ = 0;
+
+public:
+    /**
+     * @brief Construct a new pool
+     *
+     * @param connectionBuilder The builder used to open new connections
+     * @param size The number of connections to keep open
+     * @param forwardingTimeout The timeout for a single forwarded request
+     */
+    ForwardingConnectionPool(
+        util::requests::WsConnectionBuilder connectionBuilder,
+        std::size_t size,
+        std::chrono::steady_clock::duration forwardingTimeout
+    );
+
+    ~ForwardingConnectionPool();
+
+    ForwardingConnectionPool(ForwardingConnectionPool const&) = delete;
+    ForwardingConnectionPool&
+    operator=(ForwardingConnectionPool const&) = delete;
+
+    /**
+     * @brief Send a request over one of the pooled connections.
+     *
+     * @param request The request to send
+     * @param yield The coroutine context
+     * @return The response or error
+     */
+    ForwardingConnection::Response
+    send(boost::json::object const& request, boost::asio::yield_context yield);
+
+    /**
+     * @return The number of connections in the pool
+     */
+    std::size_t
+    size();
+
+private:
+    std::shared_ptr<ForwardingConnection>
+    acquire(boost::asio::yield_context yield);
+
+    std::shared_ptr<ForwardingConnection>
+    leastBusy() const;
+};
+
+}  // namespace etl::impl
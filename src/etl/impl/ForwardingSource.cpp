@@ -19,6 +19,7 @@
 
 #include "etl/impl/ForwardingSource.hpp"
 
+#include "etl/impl/ForwardingConnectionPool.hpp"
 #include "rpc/Errors.hpp"
 #include "util/log/Logger.hpp"
 
@@ -31,7 +32,9 @@
 #include <fmt/core.h>
 
 #include <chrono>
+#include <cstddef>
 #include <exception>
+#include <memory>
 #include <optional>
 #include <stdexcept>
 #include <string>
@@ -44,11 +47,13 @@ ForwardingSource::ForwardingSource(
     std::string ip,
     std::string wsPort,
     std::chrono::steady_clock::duration forwardingTimeout,
-    std::chrono::steady_clock::duration connectionTimeout
+    std::chrono::steady_clock::duration connectionTimeout,
+    std::size_t poolSize
 )
     : log_(fmt::format("ForwardingSource[{}:{}]", ip, wsPort))
     , connectionBuilder_(std::move(ip), std::move(wsPort))
     , forwardingTimeout_{forwardingTimeout}
+    , poolSize_{poolSize}
 {
     connectionBuilder_.setConnectionTimeout(connectionTimeout)
         .addHeader(
@@ -63,6 +68,28 @@ ForwardingSource::forwardToRippled(
     std::string_view xUserValue,
     boost::asio::yield_context yield
 ) const
+{
+    if (poolSize_ == 0)
+        return forwardOverNewConnection(request, forwardToRippledClientIp, xUserValue, yield);
+
+    auto response = pool(xUserValue)->send(request, yield);
+    if (not response) {
+        LOG(log_.debug()) << "Error forwarding request to rippled over pooled connection: "
+                          << rpc::getErrorInfo(response.error()).message;
+        return response;
+    }
+
+    response->insert_or_assign("forwarded", true);
+    return response;
+}
+
+std::expected<boost::json::object, rpc::ClioError>
+ForwardingSource::forwardOverNewConnection(
+    boost::json::object const& request,
+    std::optional<std::string> const& forwardToRippledClientIp,
+    std::string_view xUserValue,
+    boost::asio::yield_context yield
+) const
 {
     auto connectionBuilder = connectionBuilder_;
     if (forwardToRippledClientIp) {
@@ -113,4 +140,17 @@ ForwardingSource::forwardToRippled(
     return responseObject;
 }
 
+std::shared_ptr<ForwardingConnectionPool>
+ForwardingSource::pool(std::string_view xUserValue) const
+{
+    auto lock = pools_->lock();
+    auto& pool = lock.get()[std::string{xUserValue}];
+    if (not pool) {
+        auto connectionBuilder = connectionBuilder_;
+        connectionBuilder.addHeader({"X-User", std::string{xUserValue}});
+        pool = std::make_shared<ForwardingConnectionPool>(std::move(connectionBuilder), poolSize_, forwardingTimeout_);
+    }
+    return pool;
+}
+
 }  // namespace etl::impl
@@ -19,7 +19,9 @@
 
 #pragma once
 
+#include "etl/impl/ForwardingConnectionPool.hpp"
 #include "rpc/Errors.hpp"
+#include "util/Mutex.hpp"
 #include "util/log/Logger.hpp"
 #include "util/requests/WsConnection.hpp"
 
@@ -27,10 +29,13 @@
 #include <boost/json/object.hpp>
 
 #include <chrono>
+#include <cstddef>
 #include <expected>
+#include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
+#include <unordered_map>
 
 namespace etl::impl {
 
@@ -38,20 +43,38 @@ class ForwardingSource {
     util::Logger log_;
     util::requests::WsConnectionBuilder connectionBuilder_;
     std::chrono::steady_clock::duration forwardingTimeout_;
+    std::size_t poolSize_;
 
-    static constexpr std::chrono::seconds CONNECTION_TIMEOUT{3};
+    // one pool per X-User value because headers are sent only once per connection
+    using Pools = std::unordered_map<std::string, std::shared_ptr<ForwardingConnectionPool>>;
+    std::unique_ptr<util::Mutex<Pools>> pools_ = std::make_unique<util::Mutex<Pools>>();
 
 public:
+    static constexpr std::chrono::seconds CONNECTION_TIMEOUT{3};
+
+    /**
+     * @brief Construct a new Forwarding Source object
+     *
+     * @param ip The ip of rippled
+     * @param wsPort The websocket port of rippled
+     * @param forwardingTimeout The timeout for a single forwarded request
+     * @param connectionTimeout The timeout for connecting to rippled
+     * @param poolSize The number of persistent connections to keep open; 0 opens a new connection for every request
+     */
     ForwardingSource(
         std::string ip,
         std::string wsPort,
         std::chrono::steady_clock::duration forwardingTimeout,
-        std::chrono::steady_clock::duration connectionTimeout = CONNECTION_TIMEOUT
+        std::chrono::steady_clock::duration connectionTimeout = CONNECTION_TIMEOUT,
+        std::size_t poolSize = 0
     );
 
     /**
      * @brief Forward a request to rippled.
      *
+     * If a pool is configured the request is sent over one of the pooled connections. In that case the client's ip is
+     * not passed to rippled because a connection is shared by many clients.
+     *
      * @param request The request to forward
      * @param forwardToRippledClientIp IP of the client forwarding this request if known
      * @param xUserValue Optional value for X-User header
@@ -65,6 +88,18 @@ public:
         std::string_view xUserValue,
         boost::asio::yield_context yield
     ) const;
+
+private:
+    std::expected<boost::json::object, rpc::ClioError>
+    forwardOverNewConnection(
+        boost::json::object const& request,
+        std::optional<std::string> const& forwardToRippledClientIp,
+        std::string_view xUserValue,
+        boost::asio::yield_context yield
+    ) const;
+
+    std::shared_ptr<ForwardingConnectionPool>
+    pool(std::string_view xUserValue) const;
 };
 
 }  // namespace etl::impl
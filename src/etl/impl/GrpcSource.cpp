@@ -20,6 +20,7 @@
 #include "etl/impl/GrpcSource.hpp"
 
 #include "data/BackendInterface.hpp"
+#include "etl/InitialLoadCheckpoint.hpp"
 #include "etl/impl/AsyncData.hpp"
 #include "util/Assert.hpp"
 #include "util/log/Logger.hpp"
@@ -33,21 +34,34 @@
 #include <grpcpp/support/status.h>
 #include <org/xrpl/rpc/v1/get_ledger.pb.h>
 #include <org/xrpl/rpc/v1/xrp_ledger.grpc.pb.h>
+#include <xrpl/basics/base_uint.h>
+#include <xrpl/basics/strHex.h>
 
+#include <algorithm>
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <exception>
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
 namespace etl::impl {
 
-GrpcSource::GrpcSource(std::string const& ip, std::string const& grpcPort, std::shared_ptr<BackendInterface> backend)
-    : log_(fmt::format("GrpcSource[{}:{}]", ip, grpcPort)), backend_(std::move(backend))
+GrpcSource::GrpcSource(
+    std::string const& ip,
+    std::string const& grpcPort,
+    std::shared_ptr<BackendInterface> backend,
+    std::size_t numLoadThreads
+)
+    : log_(fmt::format("GrpcSource[{}:{}]", ip, grpcPort))
+    , backend_(std::move(backend))
+    , numLoadThreads_(numLoadThreads == 0 ? std::max(std::thread::hardware_concurrency(), 1u) : numLoadThreads)
 {
     try {
         boost::asio::io_context ctx;
@@ -98,58 +112,116 @@ GrpcSource::fetchLedger(uint32_t sequence, bool getObjects, bool getObjectNeighb
 }
 
 std::pair<std::vector<std::string>, bool>
-GrpcSource::loadInitialLedger(uint32_t const sequence, uint32_t const numMarkers, bool const cacheOnly)
+GrpcSource::loadInitialLedger(
+    uint32_t const sequence,
+    uint32_t const numMarkers,
+    bool const cacheOnly,
+    std::shared_ptr<InitialLoadCheckpoint> const& checkpoint
+)
 {
     if (!stub_)
         return {{}, false};
 
     std::vector<etl::impl::AsyncCallData> calls = impl::makeAsyncCallData(sequence, numMarkers);
+    if (checkpoint) {
+        ASSERT(checkpoint->seq() == sequence, "Checkpoint must be for ledger {}. Got {}", sequence, checkpoint->seq());
+        for (size_t i = 0; i < calls.size(); ++i) {
+            if (auto const key = checkpoint->writtenUpTo(i); key) {
+                LOG(log_.info()) << "Range " << i + 1 << " was written up to " << ripple::strHex(*key)
+                                 << " before. Only loading the cache for it.";
+                calls[i].resumeAfter(*key);
+            }
+        }
+    }
 
-    LOG(log_.debug()) << "Starting data download for ledger " << sequence << ".";
+    auto const numThreads = std::min(numLoadThreads_, calls.size());
 
-    grpc::CompletionQueue cq;
-    for (auto& c : calls)
-        c.call(stub_, cq);
+    LOG(log_.debug()) << "Starting data download for ledger " << sequence << " using " << numThreads << " threads.";
 
-    void* tag = nullptr;
-    bool ok = false;
-    size_t numFinished = 0;
-    bool abort = false;
+    std::atomic_bool abort = false;
+    std::atomic_size_t numFinished = 0;
     size_t const incr = 500000;
-    size_t progress = incr;
-    std::vector<std::string> edgeKeys;
+    std::atomic_size_t progress = incr;
 
-    while (numFinished < calls.size() && cq.Next(&tag, &ok)) {
-        ASSERT(tag != nullptr, "Tag can't be null.");
-        auto ptr = static_cast<etl::impl::AsyncCallData*>(tag);
+    std::mutex edgeKeysMtx;
+    std::vector<std::string> edgeKeys;
 
-        if (!ok) {
-            LOG(log_.error()) << "loadInitialLedger - ok is false";
-            return {{}, false};  // handle cancelled
+    // every thread owns a completion queue and handles the ranges whose index modulo the number of threads matches its
+    // own, so that the responses of different ranges are processed in parallel
+    auto const loadRanges = [&](size_t const threadIdx) {
+        grpc::CompletionQueue cq;
+        size_t numCalls = 0;
+        for (size_t i = threadIdx; i < calls.size(); i += numThreads) {
+            calls[i].call(stub_, cq);
+            ++numCalls;
         }
 
-        LOG(log_.trace()) << "Marker prefix = " << ptr->getMarkerPrefix();
-
-        auto result = ptr->process(stub_, cq, *backend_, abort, cacheOnly);
-        if (result != etl::impl::AsyncCallData::CallStatus::MORE) {
-            ++numFinished;
-            LOG(log_.debug()) << "Finished a marker. Current number of finished = " << numFinished;
+        void* tag = nullptr;
+        bool ok = false;
+        size_t numDone = 0;
+
+        while (numDone < numCalls && cq.Next(&tag, &ok)) {
+            ASSERT(tag != nullptr, "Tag can't be null.");
+            auto ptr = static_cast<etl::impl::AsyncCallData*>(tag);
+            auto const rangeIdx = static_cast<size_t>(ptr - calls.data()) + 1;
+
+            if (!ok) {
+                // the call is cancelled and won't be continued; stop all the other ranges too
+                LOG(log_.error()) << "loadInitialLedger - ok is false for range " << rangeIdx;
+                abort = true;
+                ++numDone;
+                ++numFinished;
+                continue;
+            }
+
+            LOG(log_.trace()) << "Marker prefix = " << ptr->getMarkerPrefix();
+
+            auto result = ptr->process(stub_, cq, *backend_, abort.load(), cacheOnly);
+            if (result != etl::impl::AsyncCallData::CallStatus::MORE) {
+                ++numDone;
+                LOG(log_.info()) << "Finished range " << rangeIdx << " of " << calls.size()
+                                 << (result == etl::impl::AsyncCallData::CallStatus::DONE ? "" : " with error")
+                                 << ". Current number of finished = " << ++numFinished;
+
+                if (auto lastKey = ptr->getLastKey(); !lastKey.empty()) {
+                    std::scoped_lock const lck{edgeKeysMtx};
+                    edgeKeys.push_back(std::move(lastKey));
+                }
+            }
+
+            if (result == etl::impl::AsyncCallData::CallStatus::ERRORED) {
+                abort = true;
+            } else if (checkpoint and not cacheOnly) {
+                if (auto const lastKey = ptr->getLastKey(); !lastKey.empty()) {
+                    auto const res = checkpoint->record(
+                        rangeIdx - 1, *ripple::uint256::fromVoidChecked(lastKey), [this] { backend_->waitForWrites(); }
+                    );
+                    if (not res.has_value())
+                        LOG(log_.warn()) << "Failed to save initial load checkpoint: " << res.error();
+                }
+            }
+
+            auto const cacheSize = backend_->cache().size();
+            auto expected = progress.load();
+            if (cacheSize > expected and progress.compare_exchange_strong(expected, expected + incr))
+                LOG(log_.info()) << "Downloaded " << cacheSize << " records from rippled";
+        }
 
-            if (auto lastKey = ptr->getLastKey(); !lastKey.empty())
-                edgeKeys.push_back(std::move(lastKey));
+        cq.Shutdown();
+        while (cq.Next(&tag, &ok)) {
         }
+    };
 
-        if (result == etl::impl::AsyncCallData::CallStatus::ERRORED)
-            abort = true;
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads);
+    for (size_t threadIdx = 0; threadIdx < numThreads; ++threadIdx)
+        threads.emplace_back(loadRanges, threadIdx);
 
-        if (backend_->cache().size() > progress) {
-            LOG(log_.info()) << "Downloaded " << backend_->cache().size() << " records from rippled";
-            progress += incr;
-        }
-    }
+    for (auto& thread : threads)
+        thread.join();
 
-    LOG(log_.info()) << "Finished loadInitialLedger. cache size = " << backend_->cache().size() << ", abort = " << abort
-                     << ".";
+    LOG(log_.info()) << "Finished loadInitialLedger. cache size = " << backend_->cache().size()
+                     << ", abort = " << abort.load() << ".";
     return {std::move(edgeKeys), !abort};
 }
 
@@ -20,12 +20,14 @@
 #pragma once
 
 #include "data/BackendInterface.hpp"
+#include "etl/InitialLoadCheckpoint.hpp"
 #include "util/log/Logger.hpp"
 
 #include <grpcpp/support/status.h>
 #include <org/xrpl/rpc/v1/get_ledger.pb.h>
 #include <xrpl/proto/org/xrpl/rpc/v1/xrp_ledger.grpc.pb.h>
 
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <string>
@@ -37,9 +39,23 @@ class GrpcSource {
     util::Logger log_;
     std::unique_ptr<org::xrpl::rpc::v1::XRPLedgerAPIService::Stub> stub_;
     std::shared_ptr<BackendInterface> backend_;
+    std::size_t numLoadThreads_;
 
 public:
-    GrpcSource(std::string const& ip, std::string const& grpcPort, std::shared_ptr<BackendInterface> backend);
+    /**
+     * @brief Construct a new GrpcSource object
+     *
+     * @param ip The IP address of the source
+     * @param grpcPort The gRPC port of the source
+     * @param backend The backend to write downloaded ledgers to
+     * @param numLoadThreads The number of threads used to download a ledger in full; 0 means one per hardware thread
+     */
+    GrpcSource(
+        std::string const& ip,
+        std::string const& grpcPort,
+        std::shared_ptr<BackendInterface> backend,
+        std::size_t numLoadThreads = 0
+    );
 
     /**
      * @brief Fetch data for a specific ledger.
@@ -58,13 +74,23 @@ public:
     /**
      * @brief Download a ledger in full.
      *
+     * The ledger is split into ranges by markers. The ranges are spread over the load threads, each of which has its
+     * own completion queue and processes the responses of its ranges: deserializing objects, updating the cache and
+     * submitting writes.
+     *
      * @param sequence Sequence of the ledger to download
      * @param numMarkers Number of markers to generate for async calls
      * @param cacheOnly Only insert into cache, not the DB; defaults to false
+     * @param checkpoint Progress of the download to resume from and record to; none if nullptr
      * @return A std::pair of the data and a bool indicating whether the download was successful
      */
     std::pair<std::vector<std::string>, bool>
-    loadInitialLedger(uint32_t sequence, uint32_t numMarkers, bool cacheOnly = false);
+    loadInitialLedger(
+        uint32_t sequence,
+        uint32_t numMarkers,
+        bool cacheOnly = false,
+        std::shared_ptr<InitialLoadCheckpoint> const& checkpoint = nullptr
+    );
 };
 
 }  // namespace etl::impl
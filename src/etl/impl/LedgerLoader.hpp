@@ -22,8 +22,10 @@
 #include "data/BackendInterface.hpp"
 #include "data/DBHelpers.hpp"
 #include "data/Types.hpp"
+#include "etl/ETLHelpers.hpp"
 #include "etl/NFTHelpers.hpp"
 #include "etl/SystemState.hpp"
+#include "etl/impl/BookSuccessors.hpp"
 #include "etl/impl/LedgerFetcher.hpp"
 #include "util/Assert.hpp"
 #include "util/LedgerUtils.hpp"
@@ -38,6 +40,7 @@
 #include <xrpl/protocol/Serializer.h>
 #include <xrpl/protocol/TxMeta.h>
 
+#include <algorithm>
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
@@ -45,6 +48,7 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -198,37 +202,10 @@ public:
                         backend_->writeSuccessor(std::move(key), sequence, uint256ToString(succ->key));
                 }
 
-                ripple::uint256 prev = data::firstKey;
-                while (auto cur = backend_->cache().getSuccessor(prev, sequence)) {
-                    ASSERT(cur.has_value(), "Succesor for key {} must exist", ripple::strHex(prev));
-                    if (prev == data::firstKey)
-                        backend_->writeSuccessor(uint256ToString(prev), sequence, uint256ToString(cur->key));
-
-                    if (isBookDir(cur->key, cur->blob)) {
-                        auto base = getBookBase(cur->key);
-                        // make sure the base is not an actual object
-                        if (!backend_->cache().get(base, sequence)) {
-                            auto succ = backend_->cache().getSuccessor(base, sequence);
-                            ASSERT(succ.has_value(), "Book base {} must have a successor", ripple::strHex(base));
-                            if (succ->key == cur->key) {
-                                LOG(log_.debug()) << "Writing book successor = " << ripple::strHex(base) << " - "
-                                                  << ripple::strHex(cur->key);
-
-                                backend_->writeSuccessor(uint256ToString(base), sequence, uint256ToString(cur->key));
-                            }
-                        }
-
-                        ++numWrites;
-                    }
-
-                    prev = cur->key;
-                    static constexpr std::size_t LOG_INTERVAL = 100000;
-                    if (numWrites % LOG_INTERVAL == 0 && numWrites != 0)
-                        LOG(log_.info()) << "Wrote " << numWrites << " book successors";
-                }
-
-                backend_->writeSuccessor(uint256ToString(prev), sequence, uint256ToString(data::lastKey));
-                ++numWrites;
+                // walk the same key ranges the ledger was downloaded in concurrently
+                auto const markers = getMarkers(loadBalancer_->numDownloadRanges());
+                auto const numThreads = std::max(std::thread::hardware_concurrency(), 1u);
+                numWrites = writeBookSuccessors(*backend_, markers, sequence, numThreads);
             });
 
             LOG(log_.info()) << "Looping through cache and submitting all writes took " << seconds
@@ -242,7 +219,8 @@ public:
                 backend_->writeNFTTransactions(insertTxResult.nfTokenTxData);
             }
 
-            backend_->finishWrites(sequence);
+            if (backend_->finishWrites(sequence))
+                loadBalancer_->removeInitialLoadCheckpoint();
         });
 
         LOG(log_.debug()) << "Time to download and store ledger = " << timeDiff;
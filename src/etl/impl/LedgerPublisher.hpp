@@ -164,6 +164,7 @@ public:
     {
         boost::asio::post(publishStrand_, [this, lgrInfo = lgrInfo]() {
             LOG(log_.info()) << "Publishing ledger " << std::to_string(lgrInfo.seq);
+            backend_->ledgerHeaderCache().put(lgrInfo);
 
             if (!state_.get().isWriting) {
                 LOG(log_.info()) << "Updating ledger range for read node.";
@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include "etl/InitialLoadCheckpoint.hpp"
 #include "etl/Source.hpp"
 #include "etl/impl/ForwardingSource.hpp"
 #include "etl/impl/GrpcSource.hpp"
@@ -193,12 +194,18 @@ public:
      * @param sequence Sequence of the ledger to download
      * @param numMarkers Number of markers to generate for async calls
      * @param cacheOnly Only insert into cache, not the DB; defaults to false
+     * @param checkpoint Progress of the download to resume from and record to; none if nullptr
      * @return A std::pair of the data and a bool indicating whether the download was successful
      */
     std::pair<std::vector<std::string>, bool>
-    loadInitialLedger(uint32_t sequence, std::uint32_t numMarkers, bool cacheOnly = false) final
+    loadInitialLedger(
+        uint32_t sequence,
+        std::uint32_t numMarkers,
+        bool cacheOnly = false,
+        std::shared_ptr<InitialLoadCheckpoint> const& checkpoint = nullptr
+    ) final
     {
-        return grpcSource_.loadInitialLedger(sequence, numMarkers, cacheOnly);
+        return grpcSource_.loadInitialLedger(sequence, numMarkers, cacheOnly, checkpoint);
     }
 
     /**
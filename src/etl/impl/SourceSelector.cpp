@@ -0,0 +1,82 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "etl/impl/SourceSelector.hpp"
+
+#include "etl/impl/SourceStats.hpp"
+#include "util/Assert.hpp"
+#include "util/Random.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace etl::impl {
+
+void
+SourceSelector::addSource(std::string const& name)
+{
+    stats_.push_back(std::make_unique<SourceStats>(name));
+}
+
+std::vector<std::size_t>
+SourceSelector::order() const
+{
+    std::vector<std::size_t> available;
+    std::vector<std::size_t> unavailable;
+    for (std::size_t idx = 0; idx < stats_.size(); ++idx)
+        (stats_[idx]->isAvailable() ? available : unavailable).push_back(idx);
+
+    if (available.empty())
+        std::swap(available, unavailable);
+
+    std::vector<double> scores(stats_.size());
+    for (auto const idx : available)
+        scores[idx] = stats_[idx]->score();
+
+    auto const isBetter = [&scores](std::size_t lhs, std::size_t rhs) {
+        return scores[lhs] < scores[rhs] or (scores[lhs] == scores[rhs] and lhs < rhs);
+    };
+
+    if (available.size() > 1) {
+        auto const first = util::Random::uniform(0ul, available.size() - 1);
+        auto second = util::Random::uniform(0ul, available.size() - 2);
+        if (second >= first)
+            ++second;
+
+        auto const winner = isBetter(available[first], available[second]) ? first : second;
+        std::swap(available[0], available[winner]);
+        std::sort(available.begin() + 1, available.end(), isBetter);
+    }
+
+    available.insert(available.end(), unavailable.begin(), unavailable.end());
+    return available;
+}
+
+SourceStats&
+SourceSelector::stats(std::size_t sourceIdx) const
+{
+    ASSERT(sourceIdx < stats_.size(), "Source index {} is out of range", sourceIdx);
+    return *stats_[sourceIdx];
+}
+
+}  // namespace etl::impl
@@ -0,0 +1,66 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include "etl/impl/SourceStats.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace etl::impl {
+
+/**
+ * @brief Chooses the order in which sources are tried.
+ *
+ * The first source is chosen using the power of two choices: two random sources with closed circuits are compared
+ * and the one with the lower score wins. The other sources follow ordered by their score so that failover goes to the
+ * next best source; sources with open circuits are tried last.
+ */
+class SourceSelector {
+    std::vector<std::unique_ptr<SourceStats>> stats_;
+
+public:
+    /**
+     * @brief Add the stats of the next source.
+     *
+     * @param name The name of the source used to label its metrics
+     */
+    void
+    addSource(std::string const& name);
+
+    /**
+     * @return The indices of all the sources in the order they should be tried
+     */
+    std::vector<std::size_t>
+    order() const;
+
+    /**
+     * @brief Get the stats of a source.
+     *
+     * @param sourceIdx The index of the source
+     * @return The stats
+     */
+    SourceStats&
+    stats(std::size_t sourceIdx) const;
+};
+
+}  // namespace etl::impl
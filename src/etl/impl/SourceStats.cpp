@@ -0,0 +1,152 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "etl/impl/SourceStats.hpp"
+
+#include "util/prometheus/Label.hpp"
+#include "util/prometheus/Prometheus.hpp"
+
+#include <boost/json/object.hpp>
+
+#include <chrono>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+
+namespace etl::impl {
+
+SourceStats::SourceStats(std::string const& name, TimeSource now)
+    : latencyGauge_{PrometheusService::gaugeDouble(
+          "etl_source_latency_milliseconds",
+          util::prometheus::Labels({{"source", name}}),
+          "Moving average of the latency of requests to the source"
+      )}
+    , outstandingGauge_{PrometheusService::gaugeInt(
+          "etl_source_outstanding_requests",
+          util::prometheus::Labels({{"source", name}}),
+          "Number of requests to the source in flight"
+      )}
+    , successCounter_{PrometheusService::counterInt(
+          "etl_source_requests_total_number",
+          util::prometheus::Labels({{"source", name}, {"status", "success"}}),
+          "Total number of requests sent to the source"
+      )}
+    , failureCounter_{PrometheusService::counterInt(
+          "etl_source_requests_total_number",
+          util::prometheus::Labels({{"source", name}, {"status", "failure"}})
+      )}
+    , circuitOpen_{PrometheusService::boolMetric(
+          "etl_source_circuit_open",
+          util::prometheus::Labels({{"source", name}}),
+          "Whether the source is skipped because of consecutive failures"
+      )}
+    , now_{std::move(now)}
+{
+}
+
+void
+SourceStats::onStart()
+{
+    std::scoped_lock const lck{mtx_};
+    ++outstanding_;
+    ++outstandingGauge_.get();
+}
+
+void
+SourceStats::onSuccess(std::optional<std::chrono::steady_clock::duration> latency)
+{
+    std::scoped_lock const lck{mtx_};
+    finish();
+
+    if (latency.has_value()) {
+        auto const sample = std::chrono::duration<double, std::milli>(*latency).count();
+        latencyMs_ =
+            latencyMs_.has_value() ? (LATENCY_WEIGHT * sample) + ((1. - LATENCY_WEIGHT) * *latencyMs_) : sample;
+        latencyGauge_.get().set(*latencyMs_);
+    }
+
+    errorRate_ *= 1. - ERROR_RATE_WEIGHT;
+    consecutiveFailures_ = 0;
+    circuitOpen_ = false;
+    ++successCounter_.get();
+}
+
+void
+SourceStats::onFailure()
+{
+    std::scoped_lock const lck{mtx_};
+    finish();
+
+    errorRate_ = ERROR_RATE_WEIGHT + ((1. - ERROR_RATE_WEIGHT) * errorRate_);
+    if (++consecutiveFailures_ >= FAILURES_TO_OPEN_CIRCUIT) {
+        openUntil_ = now_() + CIRCUIT_OPEN_DURATION;
+        circuitOpen_ = true;
+    }
+    ++failureCounter_.get();
+}
+
+bool
+SourceStats::isAvailable() const
+{
+    std::scoped_lock const lck{mtx_};
+    return not isCircuitOpen();
+}
+
+double
+SourceStats::score() const
+{
+    std::scoped_lock const lck{mtx_};
+    // a source without samples looks fast so that it gets some requests and its latency becomes known
+    return (latencyMs_.value_or(0.) + 1.) * static_cast<double>(outstanding_ + 1) *
+        (1. + (ERROR_RATE_PENALTY * errorRate_));
+}
+
+boost::json::object
+SourceStats::toJson() const
+{
+    std::scoped_lock const lck{mtx_};
+    boost::json::object res;
+    if (latencyMs_.has_value())
+        res["latency_ms"] = *latencyMs_;
+    res["error_rate"] = errorRate_;
+    res["outstanding_requests"] = outstanding_;
+    res["circuit_open"] = isCircuitOpen();
+    return res;
+}
+
+void
+SourceStats::finish()
+{
+    if (outstanding_ > 0) {
+        --outstanding_;
+        --outstandingGauge_.get();
+    }
+}
+
+bool
+SourceStats::isCircuitOpen() const
+{
+    // the circuit closes by itself once it times out so the metric is updated here rather than in onSuccess only
+    auto const open = consecutiveFailures_ >= FAILURES_TO_OPEN_CIRCUIT and now_() < openUntil_;
+    circuitOpen_ = open;
+    return open;
+}
+
+}  // namespace etl::impl
@@ -0,0 +1,127 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include "util/prometheus/Bool.hpp"
+#include "util/prometheus/Counter.hpp"
+#include "util/prometheus/Gauge.hpp"
+
+#include <boost/json/object.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+
+namespace etl::impl {
+
+/**
+ * @brief Tracks how well a source serves requests.
+ *
+ * Keeps exponentially weighted moving averages of the latency and the error rate of a source and the number of its
+ * requests in flight. After a few consecutive failures the circuit of the source opens and the source is not selected
+ * for a while; once this time passes a single successful request closes the circuit again.
+ */
+class SourceStats {
+public:
+    /** @brief Returns the current time; replaceable so that tests don't depend on real time passing */
+    using TimeSource = std::function<std::chrono::steady_clock::time_point()>;
+
+    static constexpr double LATENCY_WEIGHT = 0.2;
+    static constexpr double ERROR_RATE_WEIGHT = 0.1;
+    static constexpr double ERROR_RATE_PENALTY = 10.;
+    static constexpr std::size_t FAILURES_TO_OPEN_CIRCUIT = 3;
+    static constexpr std::chrono::seconds CIRCUIT_OPEN_DURATION{5};
+
+private:
+    mutable std::mutex mtx_;
+    std::optional<double> latencyMs_;
+    double errorRate_ = 0.;
+    std::size_t outstanding_ = 0;
+    std::size_t consecutiveFailures_ = 0;
+    std::chrono::steady_clock::time_point openUntil_;
+
+    std::reference_wrapper<util::prometheus::GaugeDouble> latencyGauge_;
+    std::reference_wrapper<util::prometheus::GaugeInt> outstandingGauge_;
+    std::reference_wrapper<util::prometheus::CounterInt> successCounter_;
+    std::reference_wrapper<util::prometheus::CounterInt> failureCounter_;
+    mutable util::prometheus::Bool circuitOpen_;  // refreshed whenever the circuit is checked
+    TimeSource now_;
+
+public:
+    /**
+     * @brief Construct a new Source Stats object
+     *
+     * @param name The name of the source used to label the metrics
+     * @param now The source of the current time the circuit timeout is measured with
+     */
+    explicit SourceStats(std::string const& name, TimeSource now = std::chrono::steady_clock::now);
+
+    /**
+     * @brief Called when a request is sent to the source.
+     */
+    void
+    onStart();
+
+    /**
+     * @brief Called when the source served a request.
+     *
+     * @param latency The time it took to serve the request; nullopt if it should not affect the latency average
+     */
+    void
+    onSuccess(std::optional<std::chrono::steady_clock::duration> latency);
+
+    /**
+     * @brief Called when the source failed to serve a request.
+     */
+    void
+    onFailure();
+
+    /**
+     * @return true if the circuit of the source is closed so it can be selected; false otherwise
+     */
+    bool
+    isAvailable() const;
+
+    /**
+     * @brief Get the cost of sending a request to the source; lower is better.
+     *
+     * @return The expected latency weighted by the number of requests in flight and the error rate
+     */
+    double
+    score() const;
+
+    /**
+     * @return The stats as a JSON object
+     */
+    boost::json::object
+    toJson() const;
+
+private:
+    void
+    finish();
+
+    bool
+    isCircuitOpen() const;
+};
+
+}  // namespace etl::impl
@@ -0,0 +1,55 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include "util/prometheus/Histogram.hpp"
+#include "util/prometheus/Label.hpp"
+#include "util/prometheus/Prometheus.hpp"
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace etl::impl {
+
+/**
+ * @brief Get the histogram tracking how long the ETL pipeline spends in the given stage for each ledger.
+ *
+ * Stages are "extract", "transform", "write" (submission of the writes) and "finish" (waiting for the writes to be
+ * confirmed and committing the ledger range).
+ *
+ * @param stage The name of the stage
+ * @return A reference to the histogram
+ */
+inline util::prometheus::HistogramInt&
+stageDurationHistogram(std::string stage)
+{
+    static std::vector<std::int64_t> const BUCKETS{1, 2, 5, 10, 20, 50, 100, 200, 500, 1'000, 2'000, 5'000};
+
+    return PrometheusService::histogramInt(
+        "etl_stage_duration_milliseconds_histogram",
+        util::prometheus::Labels({util::prometheus::Label{"stage", std::move(stage)}}),
+        BUCKETS,
+        "The time spent in each stage of the ETL pipeline per ledger"
+    );
+}
+
+}  // namespace etl::impl
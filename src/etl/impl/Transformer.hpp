@@ -22,13 +22,16 @@
 #include "data/BackendInterface.hpp"
 #include "data/DBHelpers.hpp"
 #include "data/Types.hpp"
+#include "etl/ETLHelpers.hpp"
 #include "etl/SystemState.hpp"
 #include "etl/impl/AmendmentBlockHandler.hpp"
 #include "etl/impl/LedgerLoader.hpp"
+#include "etl/impl/StageMetrics.hpp"
 #include "util/Assert.hpp"
 #include "util/LedgerUtils.hpp"
 #include "util/Profiler.hpp"
 #include "util/log/Logger.hpp"
+#include "util/prometheus/Histogram.hpp"
 
 #include <grpcpp/grpcpp.h>
 #include <xrpl/basics/base_uint.h>
@@ -38,6 +41,7 @@
 #include <xrpl/protocol/LedgerHeader.h>
 
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <memory>
@@ -60,7 +64,11 @@ namespace etl::impl {
  */
 
 /**
- * @brief Transformer thread that prepares new ledger out of raw data from GRPC.
+ * @brief Transformer that prepares new ledgers out of raw data from GRPC and loads them into the DB.
+ *
+ * Work is split between two threads: the transform thread builds the next ledger and submits its writes while the
+ * finish thread waits for the writes of the previous ledger to be confirmed, commits it and publishes it. Ledgers are
+ * committed strictly in the order they were transformed so the ledger range is always advanced one ledger at a time.
  */
 template <
     typename DataPipeType,
@@ -71,6 +79,18 @@ class Transformer {
     using GetLedgerResponseType = typename LedgerLoaderType::GetLedgerResponseType;
     using RawLedgerObjectType = typename LedgerLoaderType::RawLedgerObjectType;
 
+    /** @brief A ledger whose writes were submitted and that waits to be committed by the finish thread */
+    struct SubmittedLedger {
+        ripple::LedgerHeader lgrInfo;
+        std::size_t numTxns = 0;
+        std::size_t numObjects = 0;
+        std::chrono::system_clock::time_point start;
+    };
+
+    // the finish queue holds one more ledger than its max size; together with the ledger being committed and the
+    // one being transformed this bounds the number of ledgers with unconfirmed writes to three
+    static constexpr std::uint32_t MAX_FINISH_QUEUE_SIZE = 1u;
+
     util::Logger log_{"ETL"};
 
     std::reference_wrapper<DataPipeType> pipe_;
@@ -82,14 +102,21 @@ class Transformer {
     uint32_t startSequence_;
     std::reference_wrapper<SystemState> state_;  // shared state for ETL
 
+    std::reference_wrapper<util::prometheus::HistogramInt> transformDuration_{stageDurationHistogram("transform")};
+    std::reference_wrapper<util::prometheus::HistogramInt> writeDuration_{stageDurationHistogram("write")};
+    std::reference_wrapper<util::prometheus::HistogramInt> finishDuration_{stageDurationHistogram("finish")};
+
+    ThreadSafeQueue<std::optional<SubmittedLedger>> finishQueue_{MAX_FINISH_QUEUE_SIZE};
+
     std::thread thread_;
+    std::thread finishThread_;
 
 public:
     /**
      * @brief Create an instance of the transformer.
      *
      * This spawns a new thread that reads from the data pipe and writes ledgers to the DB using LedgerLoader and
-     * LedgerPublisher.
+     * another one that commits the written ledgers and publishes them using LedgerPublisher.
      */
     Transformer(
         DataPipeType& pipe,
@@ -108,26 +135,30 @@ public:
         , startSequence_{startSequence}
         , state_{std::ref(state)}
     {
+        finishThread_ = std::thread([this]() { finish(); });
         thread_ = std::thread([this]() { process(); });
     }
 
     /**
-     * @brief Joins the transformer thread.
+     * @brief Joins the transformer threads.
      */
     ~Transformer()
     {
         if (thread_.joinable())
             thread_.join();
+        if (finishThread_.joinable())
+            finishThread_.join();
     }
 
     /**
-     * @brief Block calling thread until transformer thread exits.
+     * @brief Block calling thread until transformer threads exit.
      */
     void
     waitTillFinished()
     {
         ASSERT(thread_.joinable(), "Transformer thread must be joinable");
         thread_.join();
+        finishThread_.join();
     }
 
 private:
@@ -150,77 +181,141 @@ private:
                 continue;
 
             auto const start = std::chrono::system_clock::now();
-            auto [lgrInfo, success] = buildNextLedger(*fetchResponse);
-
-            if (success) {
-                auto const numTxns = fetchResponse->transactions_list().transactions_size();
-                auto const numObjects = fetchResponse->ledger_objects().objects_size();
-                auto const end = std::chrono::system_clock::now();
-                auto const duration = ((end - start).count()) / 1000000000.0;
-
-                LOG(log_.info()) << "Load phase of ETL. Successfully wrote ledger! Ledger info: "
-                                 << util::toString(lgrInfo) << ". txn count = " << numTxns
-                                 << ". object count = " << numObjects << ". load time = " << duration
-                                 << ". load txns per second = " << numTxns / duration
-                                 << ". load objs per second = " << numObjects / duration;
-
-                // success is false if the ledger was already written
-                publisher_.get().publish(lgrInfo);
-            } else {
+            auto const lgrInfo = buildNextLedger(*fetchResponse);
+
+            if (not lgrInfo) {
+                LOG(log_.error()) << "Error building ledger " << currentSequence - 1;
+                setWriteConflict(true);
+                break;
+            }
+
+            finishQueue_.push(SubmittedLedger{
+                .lgrInfo = *lgrInfo,
+                .numTxns = static_cast<std::size_t>(fetchResponse->transactions_list().transactions_size()),
+                .numObjects = static_cast<std::size_t>(fetchResponse->ledger_objects().objects_size()),
+                .start = start
+            });
+        }
+
+        // empty optional hints the finish thread to shut down
+        finishQueue_.push(std::nullopt);
+    }
+
+    /**
+     * @brief Commits the submitted ledgers one by one in order and publishes them.
+     */
+    void
+    finish()
+    {
+        beast::setCurrentThreadName("ETLService finish");
+        auto failed = false;
+
+        while (auto submitted = finishQueue_.pop()) {
+            // ledgers submitted after a ledger that failed to commit must not be committed either
+            if (failed)
+                continue;
+
+            auto const& lgrInfo = submitted->lgrInfo;
+            auto [success, duration] = ::util::timed([&]() { return backend_->finishWrites(lgrInfo.seq); });
+            finishDuration_.get().observe(duration);
+
+            LOG(log_.debug()) << "Finished writes. Total time: " << duration << "ms";
+
+            // success is false if the ledger was already written
+            if (not success) {
                 LOG(log_.error()) << "Error writing ledger. " << util::toString(lgrInfo);
+                failed = true;
+                setWriteConflict(true);
+                continue;
             }
 
-            setWriteConflict(not success);
+            auto const end = std::chrono::system_clock::now();
+            auto const loadTime = std::chrono::duration<double>(end - submitted->start).count();
+            auto const numTxns = submitted->numTxns;
+            auto const numObjects = submitted->numObjects;
+
+            LOG(log_.info()) << "Load phase of ETL. Successfully wrote ledger! Ledger info: "
+                             << util::toString(lgrInfo) << ". txn count = " << numTxns
+                             << ". object count = " << numObjects << ". load time = " << loadTime
+                             << ". load txns per second = " << numTxns / loadTime
+                             << ". load objs per second = " << numObjects / loadTime;
+
+            publisher_.get().publish(lgrInfo);
         }
     }
 
     /**
-     * @brief Build the next ledger using the previous ledger and the extracted data.
+     * @brief Build the next ledger using the previous ledger and the extracted data and submit its writes.
      * @note rawData should be data that corresponds to the ledger immediately following the previous seq.
+     * @note The writes are not waited for; the ledger is committed by the finish thread.
      *
      * @param rawData Data extracted from an ETL source
-     * @return The newly built ledger and data to write to the database
+     * @return The newly built ledger if successful; nullopt otherwise
      */
-    std::pair<ripple::LedgerHeader, bool>
+    std::optional<ripple::LedgerHeader>
     buildNextLedger(GetLedgerResponseType& rawData)
     {
         LOG(log_.debug()) << "Beginning ledger update";
-        ripple::LedgerHeader lgrInfo = ::util::deserializeHeader(ripple::makeSlice(rawData.ledger_header()));
+        ripple::LedgerHeader lgrInfo;
+        auto transformTime = ::util::timed([&]() {
+            lgrInfo = ::util::deserializeHeader(ripple::makeSlice(rawData.ledger_header()));
+        });
 
         LOG(log_.debug()) << "Deserialized ledger header. " << ::util::toString(lgrInfo);
-        backend_->startWrites();
-        backend_->writeLedger(lgrInfo, std::move(*rawData.mutable_ledger_header()));
+        auto writeTime = ::util::timed([&]() {
+            backend_->startWrites();
+            backend_->writeLedger(lgrInfo, std::move(*rawData.mutable_ledger_header()));
+
+            writeSuccessors(lgrInfo, rawData);
+        });
 
-        writeSuccessors(lgrInfo, rawData);
         std::optional<FormattedTransactionsData> insertTxResultOp;
         try {
-            updateCache(lgrInfo, rawData);
-
-            LOG(log_.debug()) << "Inserted/modified/deleted all objects. Number of objects = "
-                              << rawData.ledger_objects().objects_size();
-
-            insertTxResultOp.emplace(loader_.get().insertTransactions(lgrInfo, rawData));
+            transformTime += ::util::timed([&]() {
+                updateCache(lgrInfo, rawData);
+                insertTxResultOp.emplace(loader_.get().insertTransactions(lgrInfo, rawData));
+            });
         } catch (std::runtime_error const& e) {
             LOG(log_.fatal()) << "Failed to build next ledger: " << e.what();
 
             amendmentBlockHandler_.get().onAmendmentBlock();
-            return {ripple::LedgerHeader{}, false};
+            return std::nullopt;
         }
 
         LOG(log_.debug()) << "Inserted all transactions. Number of transactions  = "
                           << rawData.transactions_list().transactions_size();
 
-        backend_->writeAccountTransactions(std::move(insertTxResultOp->accountTxData));
-        backend_->writeNFTs(insertTxResultOp->nfTokensData);
-        backend_->writeNFTTransactions(insertTxResultOp->nfTokenTxData);
+        writeTime += ::util::timed([&]() {
+            writeObjects(lgrInfo, rawData);
+
+            backend_->writeAccountTransactions(std::move(insertTxResultOp->accountTxData));
+            backend_->writeNFTs(insertTxResultOp->nfTokensData);
+            backend_->writeNFTTransactions(insertTxResultOp->nfTokenTxData);
+            backend_->markLedgerSubmitted(lgrInfo.seq);
+        });
 
-        auto [success, duration] =
-            ::util::timed<std::chrono::duration<double>>([&]() { return backend_->finishWrites(lgrInfo.seq); });
+        transformDuration_.get().observe(transformTime);
+        writeDuration_.get().observe(writeTime);
+
+        LOG(log_.debug()) << "Submitted ledger update: " << ::util::toString(lgrInfo);
+        return lgrInfo;
+    }
 
-        LOG(log_.debug()) << "Finished writes. Total time: " << std::to_string(duration);
-        LOG(log_.debug()) << "Finished ledger update: " << ::util::toString(lgrInfo);
+    /**
+     * @brief Write the ledger objects of the new ledger into DB.
+     * @note Must be called after updateCache as the object data is moved out of rawData.
+     *
+     * @param lgrInfo Ledger info
+     * @param rawData Ledger data from GRPC
+     */
+    void
+    writeObjects(ripple::LedgerHeader const& lgrInfo, GetLedgerResponseType& rawData)
+    {
+        for (auto& obj : *(rawData.mutable_ledger_objects()->mutable_objects()))
+            backend_->writeLedgerObject(std::move(*obj.mutable_key()), lgrInfo.seq, std::move(*obj.mutable_data()));
 
-        return {lgrInfo, success};
+        LOG(log_.debug()) << "Inserted/modified/deleted all objects. Number of objects = "
+                          << rawData.ledger_objects().objects_size();
     }
 
     /**
@@ -289,8 +384,6 @@ private:
 
             if (obj.mod_type() == RawLedgerObjectType::MODIFIED)
                 modified.insert(*key);
-
-            backend_->writeLedgerObject(std::move(*obj.mutable_key()), lgrInfo.seq, std::move(*obj.mutable_data()));
         }
 
         backend_->cache().update(cacheUpdates, lgrInfo.seq);
@@ -84,7 +84,9 @@ public:
         util::Logger const logger{"Subscriptions"};
         LOG(logger.info()) << "Starting subscription manager with " << workersNum << " workers";
 
-        return std::make_shared<feed::SubscriptionManager>(util::async::PoolExecutionContext(workersNum), backend);
+        return std::make_shared<feed::SubscriptionManager>(
+            util::async::PoolExecutionContext(workersNum), backend, workersNum
+        );
     }
 
     /**
@@ -92,10 +94,13 @@ public:
      *
      * @param executor The executor to use to publish the feeds
      * @param backend The backend to use
+     * @param numWorkers The number of workers of the executor; transaction subscribers are split into as many shards
+     * which are published to in parallel
      */
     SubscriptionManager(
         util::async::AnyExecutionContext&& executor,
-        std::shared_ptr<data::BackendInterface const> const& backend
+        std::shared_ptr<data::BackendInterface const> const& backend,
+        std::uint64_t numWorkers = 1
     )
         : backend_(backend)
         , ctx_(std::move(executor))
@@ -103,7 +108,7 @@ public:
         , validationsFeed_(ctx_, "validations")
         , ledgerFeed_(ctx_)
         , bookChangesFeed_(ctx_)
-        , transactionFeed_(ctx_)
+        , transactionFeed_(ctx_, numWorkers)
         , proposedTransactionFeed_(ctx_)
     {
     }
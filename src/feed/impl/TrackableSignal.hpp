@@ -19,23 +19,28 @@
 
 #pragma once
 
-#include <boost/signals2.hpp>
-#include <boost/signals2/connection.hpp>
-#include <boost/signals2/variadic_signal.hpp>
-
+#include <algorithm>
+#include <atomic>
 #include <cstddef>
 #include <functional>
+#include <iterator>
 #include <memory>
 #include <mutex>
-#include <unordered_map>
+#include <vector>
 
 namespace feed::impl {
 
 /**
  * @brief A thread-safe class to manage a signal and its tracking connections.
  *
- * @param Session The type of the object that will be tracked, when the object is destroyed, the connection will be
- * removed lazily. The pointer of the session object will also be the key to disconnect.
+ * Slots are kept in an immutable vector which is copied on every connect and disconnect. Emitting only takes a
+ * snapshot of the current vector under the lock and calls the slots without holding it, so publishing never waits for
+ * subscribers coming and going and slots are free to connect or disconnect while being called. A slot is flagged when
+ * disconnected so that emits still holding an older snapshot skip it.
+ *
+ * @param Session The type of the object that will be tracked, when the object is destroyed, the slot is no longer
+ * called but it is removed only when disconnected. The pointer of the session object will also be the key to
+ * disconnect.
  * @param Args The types of the arguments that will be passed to the slot.
  */
 template <typename Session, typename... Args>
@@ -43,20 +48,25 @@ class TrackableSignal {
     using ConnectionPtr = Session*;
     using ConnectionSharedPtr = std::shared_ptr<Session>;
 
-    // map of connection and signal connection, key is the pointer of the connection object
-    // allow disconnect to be called in the destructor of the connection
-    std::unordered_map<ConnectionPtr, boost::signals2::connection> connections_;
-    mutable std::mutex mutex_;
+    struct Slot {
+        ConnectionPtr key;
+        std::weak_ptr<Session> trackable;
+        std::function<void(Args...)> callback;
+        std::atomic_bool connected = true;
+    };
 
-    using SignalType = boost::signals2::signal<void(Args...)>;
-    SignalType signal_;
+    // slots are shared between snapshots so that disconnecting is seen by all of them
+    using Slots = std::vector<std::shared_ptr<Slot>>;
+
+    mutable std::mutex mutex_;
+    std::shared_ptr<Slots const> slots_ = std::make_shared<Slots const>();
 
 public:
     /**
      * @brief Connect a slot to the signal, the slot will be called when the signal is emitted and trackable is still
      * alive.
      *
-     * @param trackable Track this object's lifttime, if the object is destroyed, the connection will be removed lazily.
+     * @param trackable Track this object's lifttime, if the object is destroyed, the slot is no longer called.
      * When the slot is being called, the object is guaranteed to be alive.
      * @param slot The slot connecting to the signal, the slot will be called when the signal is emitted.
      * @return true if the connection is successfully added, false if the connection already exists.
@@ -65,17 +75,18 @@ public:
     connectTrackableSlot(ConnectionSharedPtr const& trackable, std::function<void(Args...)> slot)
     {
         std::scoped_lock const lk(mutex_);
-        if (connections_.contains(trackable.get())) {
+        if (std::ranges::any_of(*slots_, [&](auto const& s) { return s->key == trackable.get(); }))
             return false;
-        }
 
         // This class can't hold the trackable's shared_ptr, because disconnect should be able to be called in the
-        // the trackable's destructor. However, the trackable can not be destroied when the slot is being called
-        // either. track_foreign will hold a weak_ptr to the connection, which makes sure the connection is valid when
-        // the slot is called.
-        connections_.emplace(
-            trackable.get(), signal_.connect(typename SignalType::slot_type(slot).track_foreign(trackable))
-        );
+        // the trackable's destructor. The weak_ptr is locked for the duration of the call instead, which makes sure
+        // the trackable is valid when the slot is called.
+        auto slots = std::make_shared<Slots>();
+        slots->reserve(slots_->size() + 1);
+        std::ranges::copy(*slots_, std::back_inserter(*slots));
+        slots->push_back(std::make_shared<Slot>(trackable.get(), trackable, std::move(slot)));
+
+        slots_ = std::move(slots);
         return true;
     }
 
@@ -83,30 +94,48 @@ public:
      * @brief Disconnect a slot to the signal.
      *
      * @param trackablePtr Disconnect the slot whose trackable is this pointer. Be aware that the pointer is a raw
-     * pointer, allowing disconnect to be called in the destructor of the trackable.
+     * pointer, allowing disconnect to be called in the destructor of the trackable. Once this returns, the slot is not
+     * called anymore, not even by an emit in progress; a call already running is not waited for though.
      * @return true if the connection is successfully disconnected, false if the connection does not exist.
      */
     bool
     disconnect(ConnectionPtr trackablePtr)
     {
         std::scoped_lock const lk(mutex_);
-        if (connections_.contains(trackablePtr)) {
-            connections_[trackablePtr].disconnect();
-            connections_.erase(trackablePtr);
-            return true;
-        }
-        return false;
+        auto const isTrackable = [trackablePtr](auto const& s) { return s->key == trackablePtr; };
+        auto const it = std::ranges::find_if(*slots_, isTrackable);
+        if (it == slots_->end())
+            return false;
+
+        (*it)->connected = false;
+
+        auto slots = std::make_shared<Slots>();
+        slots->reserve(slots_->size() - 1);
+        std::ranges::remove_copy_if(*slots_, std::back_inserter(*slots), isTrackable);
+
+        slots_ = std::move(slots);
+        return true;
     }
 
     /**
      * @brief Calling all slots.
      *
+     * Slots connected while emitting are called from the next emit on. Slots disconnected while emitting are not called
+     * anymore by this emit.
+     *
      * @param args The arguments to pass to the slots.
      */
     void
     emit(Args const&... args) const
     {
-        signal_(args...);
+        auto const slots = snapshot();
+        for (auto const& slot : *slots) {
+            if (not slot->connected)
+                continue;
+
+            if (auto const trackable = slot->trackable.lock(); trackable)
+                slot->callback(args...);
+        }
     }
 
     /**
@@ -114,9 +143,16 @@ public:
      */
     std::size_t
     count() const
+    {
+        return snapshot()->size();
+    }
+
+private:
+    std::shared_ptr<Slots const>
+    snapshot() const
     {
         std::scoped_lock const lk(mutex_);
-        return connections_.size();
+        return slots_;
     }
 };
 }  // namespace feed::impl
@@ -21,13 +21,13 @@
 
 #include "feed/impl/TrackableSignal.hpp"
 
-#include <boost/signals2.hpp>
-
+#include <concepts>
 #include <cstddef>
 #include <functional>
 #include <memory>
 #include <mutex>
 #include <unordered_map>
+#include <utility>
 
 namespace feed::impl {
 
@@ -38,9 +38,12 @@ concept Hashable = requires(T a) {
 
 /**
  * @brief Class to manage a map of key and its associative signal.
+ *
+ * The map lock is only held to look the signal up; the slots are called without holding it.
+ *
  * @param Key The type of the key.
- * @param Session The type of the object that will be tracked, when the object is destroyed, the connection will be
- * removed lazily.
+ * @param Session The type of the object that will be tracked, when the object is destroyed, the slot is no longer
+ * called.
  * @param Args The types of the arguments that will be passed to the slot
  */
 template <Hashable Key, typename Session, typename... Args>
@@ -49,14 +52,14 @@ class TrackableSignalMap {
     using ConnectionSharedPtr = std::shared_ptr<Session>;
 
     mutable std::mutex mutex_;
-    std::unordered_map<Key, TrackableSignal<Session, Args...>> signalsMap_;
+    std::unordered_map<Key, std::shared_ptr<TrackableSignal<Session, Args...>>> signalsMap_;
 
 public:
     /**
      * @brief Connect a slot to the signal, the slot will be called when the signal is emitted and trackable is still
      * alive.
      *
-     * @param trackable Track this object's lifttime, if the object is destroyed, the connection will be removed lazily.
+     * @param trackable Track this object's lifttime, if the object is destroyed, the slot is no longer called.
      * When the slot is being called, the object is guaranteed to be alive.
      * @param key The key to the signal.
      * @param slot The slot connecting to the signal, the slot will be called when the assocaiative signal is emitted.
@@ -66,7 +69,11 @@ public:
     connectTrackableSlot(ConnectionSharedPtr const& trackable, Key const& key, std::function<void(Args...)> slot)
     {
         std::scoped_lock const lk(mutex_);
-        return signalsMap_[key].connectTrackableSlot(trackable, slot);
+        auto& signal = signalsMap_[key];
+        if (signal == nullptr)
+            signal = std::make_shared<TrackableSignal<Session, Args...>>();
+
+        return signal->connectTrackableSlot(trackable, std::move(slot));
     }
 
     /**
@@ -80,13 +87,14 @@ public:
     disconnect(ConnectionPtr trackablePtr, Key const& key)
     {
         std::scoped_lock const lk(mutex_);
-        if (!signalsMap_.contains(key))
+        auto const it = signalsMap_.find(key);
+        if (it == signalsMap_.end())
             return false;
 
-        auto const disconnected = signalsMap_[key].disconnect(trackablePtr);
-        // clean the map if there is no connection left.
-        if (disconnected && signalsMap_[key].count() == 0)
-            signalsMap_.erase(key);
+        auto const disconnected = it->second->disconnect(trackablePtr);
+        // clean the map if there is no connection left. an emit in progress keeps its own reference to the signal
+        if (disconnected && it->second->count() == 0)
+            signalsMap_.erase(it);
 
         return disconnected;
     }
@@ -99,10 +107,43 @@ public:
      */
     void
     emit(Key const& key, Args const&... args)
+    {
+        std::shared_ptr<TrackableSignal<Session, Args...>> signal;
+        {
+            std::scoped_lock const lk(mutex_);
+            auto const it = signalsMap_.find(key);
+            if (it == signalsMap_.end())
+                return;
+
+            signal = it->second;
+        }
+
+        signal->emit(args...);
+    }
+
+    /**
+     * @brief Check whether any slot is connected for a key.
+     *
+     * @param key The key to check
+     * @return true if at least one slot is connected for the key; false otherwise
+     */
+    bool
+    contains(Key const& key) const
+    {
+        std::scoped_lock const lk(mutex_);
+        return signalsMap_.contains(key);
+    }
+
+    /**
+     * @brief Check whether no slot is connected for any key.
+     *
+     * @return true if there are no connected slots; false otherwise
+     */
+    bool
+    empty() const
     {
         std::scoped_lock const lk(mutex_);
-        if (signalsMap_.contains(key))
-            signalsMap_[key].emit(args...);
+        return signalsMap_.empty();
     }
 };
 }  // namespace feed::impl
@@ -41,8 +41,13 @@
 #include <xrpl/protocol/TxFormats.h>
 #include <xrpl/protocol/jss.h>
 
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <unordered_set>
@@ -50,28 +55,36 @@
 
 namespace feed::impl {
 
+std::shared_ptr<std::string> const&
+TransactionFeed::AllVersionTransactionsType::get(std::uint32_t apiVersion) const
+{
+    auto const index = apiVersion < 2u ? 0u : 1u;
+    std::call_once(generated_[index], [this, index] {
+        msgs_[index] = std::make_shared<std::string>(boost::json::serialize(genJsonByVersion_(index + 1u)));
+    });
+
+    return msgs_[index];
+}
+
 void
 TransactionFeed::TransactionSlot::operator()(AllVersionTransactionsType const& allVersionMsgs) const
 {
     if (auto connection = connectionWeakPtr.lock(); connection) {
         // Check if this connection already sent
-        if (feed.get().notified_.contains(connection.get()))
+        if (shard.get().notified.contains(connection.get()))
             return;
 
-        feed.get().notified_.insert(connection.get());
+        shard.get().notified.insert(connection.get());
 
-        if (connection->apiSubVersion < 2u) {
-            connection->send(allVersionMsgs[0]);
-            return;
-        }
-        connection->send(allVersionMsgs[1]);
+        connection->send(allVersionMsgs.get(connection->apiSubVersion));
     }
 }
 
 void
 TransactionFeed::sub(SubscriberSharedPtr const& subscriber)
 {
-    auto const added = signal_.connectTrackableSlot(subscriber, TransactionSlot(*this, subscriber));
+    auto& shard = shardFor(subscriber.get());
+    auto const added = shard.signal.connectTrackableSlot(subscriber, TransactionSlot(shard, subscriber));
     if (added) {
         LOG(logger_.info()) << subscriber->tag() << "Subscribed transactions";
         ++subAllCount_.get();
@@ -82,7 +95,9 @@ TransactionFeed::sub(SubscriberSharedPtr const& subscriber)
 void
 TransactionFeed::sub(ripple::AccountID const& account, SubscriberSharedPtr const& subscriber)
 {
-    auto const added = accountSignal_.connectTrackableSlot(subscriber, account, TransactionSlot(*this, subscriber));
+    auto& shard = shardFor(subscriber.get());
+    auto const added =
+        shard.accountSignal.connectTrackableSlot(subscriber, account, TransactionSlot(shard, subscriber));
     if (added) {
         LOG(logger_.info()) << subscriber->tag() << "Subscribed account " << account;
         ++subAccountCount_.get();
@@ -95,7 +110,8 @@ TransactionFeed::sub(ripple::AccountID const& account, SubscriberSharedPtr const
 void
 TransactionFeed::subProposed(SubscriberSharedPtr const& subscriber)
 {
-    auto const added = txProposedsignal_.connectTrackableSlot(subscriber, TransactionSlot(*this, subscriber));
+    auto& shard = shardFor(subscriber.get());
+    auto const added = shard.txProposedSignal.connectTrackableSlot(subscriber, TransactionSlot(shard, subscriber));
     if (added) {
         subscriber->onDisconnect.connect([this](SubscriberPtr connection) { unsubProposedInternal(connection); });
     }
@@ -104,8 +120,9 @@ TransactionFeed::subProposed(SubscriberSharedPtr const& subscriber)
 void
 TransactionFeed::subProposed(ripple::AccountID const& account, SubscriberSharedPtr const& subscriber)
 {
+    auto& shard = shardFor(subscriber.get());
     auto const added =
-        accountProposedSignal_.connectTrackableSlot(subscriber, account, TransactionSlot(*this, subscriber));
+        shard.accountProposedSignal.connectTrackableSlot(subscriber, account, TransactionSlot(shard, subscriber));
     if (added) {
         subscriber->onDisconnect.connect([this, account](SubscriberPtr connection) {
             unsubProposedInternal(account, connection);
@@ -116,7 +133,8 @@ TransactionFeed::subProposed(ripple::AccountID const& account, SubscriberSharedP
 void
 TransactionFeed::sub(ripple::Book const& book, SubscriberSharedPtr const& subscriber)
 {
-    auto const added = bookSignal_.connectTrackableSlot(subscriber, book, TransactionSlot(*this, subscriber));
+    auto& shard = shardFor(subscriber.get());
+    auto const added = shard.bookSignal.connectTrackableSlot(subscriber, book, TransactionSlot(shard, subscriber));
     if (added) {
         LOG(logger_.info()) << subscriber->tag() << "Subscribed book " << book;
         ++subBookCount_.get();
@@ -179,8 +197,53 @@ TransactionFeed::pub(
     std::shared_ptr<data::BackendInterface const> const& backend
 )
 {
+    if (not hasSubscribers())
+        return;
+
     auto [tx, meta] = rpc::deserializeTxPlusMeta(txMeta, lgrInfo.seq);
 
+    auto const affectedAccountsFlat = meta->getAffectedAccounts();
+    auto affectedAccounts =
+        std::unordered_set<ripple::AccountID>(affectedAccountsFlat.cbegin(), affectedAccountsFlat.cend());
+    std::erase_if(affectedAccounts, [this](ripple::AccountID const& account) { return not isSubscribed(account); });
+
+    std::unordered_set<ripple::Book> affectedBooks;
+
+    for (auto const& node : meta->getNodes()) {
+        if (node.getFieldU16(ripple::sfLedgerEntryType) == ripple::ltOFFER) {
+            ripple::SField const* field = nullptr;
+
+            // We need a field that contains the TakerGets and TakerPays
+            // parameters.
+            if (node.getFName() == ripple::sfModifiedNode) {
+                field = &ripple::sfPreviousFields;
+            } else if (node.getFName() == ripple::sfCreatedNode) {
+                field = &ripple::sfNewFields;
+            } else if (node.getFName() == ripple::sfDeletedNode) {
+                field = &ripple::sfFinalFields;
+            }
+
+            if (field != nullptr) {
+                auto const data = dynamic_cast<ripple::STObject const*>(node.peekAtPField(*field));
+
+                if ((data != nullptr) && data->isFieldPresent(ripple::sfTakerPays) &&
+                    data->isFieldPresent(ripple::sfTakerGets)) {
+                    // determine the OrderBook
+                    ripple::Book const book{
+                        data->getFieldAmount(ripple::sfTakerGets).issue(),
+                        data->getFieldAmount(ripple::sfTakerPays).issue()
+                    };
+                    if (isSubscribed(book))
+                        affectedBooks.insert(book);
+                }
+            }
+        }
+    }
+
+    // nobody would receive this transaction, skip fetching the owner funds and generating the messages
+    if (not hasStreamSubscribers() and affectedAccounts.empty() and affectedBooks.empty())
+        return;
+
     std::optional<ripple::STAmount> ownerFunds;
 
     if (tx->getTxnType() == ripple::ttOFFER_CREATE) {
@@ -196,12 +259,13 @@ TransactionFeed::pub(
         }
     }
 
-    auto const genJsonByVersion = [&, tx, meta](std::uint32_t version) {
+    // captures everything by value as the messages are generated later, on the strands of the shards
+    auto genJsonByVersion = [tx, meta, ownerFunds, lgrInfo, date = txMeta.date](std::uint32_t version) {
         boost::json::object pubObj;
         auto const txKey = version < 2u ? JS(transaction) : JS(tx_json);
         pubObj[txKey] = rpc::toJson(*tx);
         pubObj[JS(meta)] = rpc::toJson(*meta);
-        rpc::insertDeliveredAmount(pubObj[JS(meta)].as_object(), tx, meta, txMeta.date);
+        rpc::insertDeliveredAmount(pubObj[JS(meta)].as_object(), tx, meta, date);
         rpc::insertDeliverMaxAlias(pubObj[txKey].as_object(), version);
 
         pubObj[JS(type)] = "transaction";
@@ -232,79 +296,132 @@ TransactionFeed::pub(
         return pubObj;
     };
 
-    AllVersionTransactionsType allVersionsMsgs{
-        std::make_shared<std::string>(boost::json::serialize(genJsonByVersion(1u))),
-        std::make_shared<std::string>(boost::json::serialize(genJsonByVersion(2u)))
-    };
+    auto const allVersionsMsgs = std::make_shared<AllVersionTransactionsType const>(std::move(genJsonByVersion));
+    auto const accounts = std::make_shared<std::unordered_set<ripple::AccountID> const>(std::move(affectedAccounts));
+    auto const books = std::make_shared<std::unordered_set<ripple::Book> const>(std::move(affectedBooks));
+    auto const publishStart = ledgerPublishStart(lgrInfo.seq);
+
+    for (auto const& shard : shards_) {
+        if (not shard->hasSubscribers(*accounts, *books))
+            continue;
+
+        [[maybe_unused]] auto task =
+            shard->strand.execute([this, &target = *shard, allVersionsMsgs, accounts, books, publishStart]() {
+                target.publish(*allVersionsMsgs, *accounts, *books);
+                publishLag_.get().set(
+                    std::chrono::duration_cast<std::chrono::milliseconds>(
+                        std::chrono::steady_clock::now() - publishStart
+                    )
+                        .count()
+                );
+            });
+    }
+}
 
-    auto const affectedAccountsFlat = meta->getAffectedAccounts();
-    auto affectedAccounts =
-        std::unordered_set<ripple::AccountID>(affectedAccountsFlat.cbegin(), affectedAccountsFlat.cend());
+bool
+TransactionFeed::Shard::hasSubscribers(
+    std::unordered_set<ripple::AccountID> const& accounts,
+    std::unordered_set<ripple::Book> const& books
+) const
+{
+    if (signal.count() != 0 or txProposedSignal.count() != 0)
+        return true;
 
-    std::unordered_set<ripple::Book> affectedBooks;
+    auto const hasAccount = std::ranges::any_of(accounts, [this](ripple::AccountID const& account) {
+        return accountSignal.contains(account) or accountProposedSignal.contains(account);
+    });
+    return hasAccount or std::ranges::any_of(books, [this](ripple::Book const& book) {
+               return bookSignal.contains(book);
+           });
+}
 
-    for (auto const& node : meta->getNodes()) {
-        if (node.getFieldU16(ripple::sfLedgerEntryType) == ripple::ltOFFER) {
-            ripple::SField const* field = nullptr;
+void
+TransactionFeed::Shard::publish(
+    AllVersionTransactionsType const& allVersionsMsgs,
+    std::unordered_set<ripple::AccountID> const& accounts,
+    std::unordered_set<ripple::Book> const& books
+)
+{
+    notified.clear();
+    signal.emit(allVersionsMsgs);
+    // clear the notified set. If the same connection subscribes both transactions + proposed_transactions,
+    // rippled SENDS the same message twice
+    notified.clear();
+    txProposedSignal.emit(allVersionsMsgs);
+    notified.clear();
+    // check duplicate for account and proposed_account, this prevents sending the same message multiple times
+    // if it affects multiple accounts watched by the same connection
+    for (auto const& account : accounts) {
+        accountSignal.emit(account, allVersionsMsgs);
+        accountProposedSignal.emit(account, allVersionsMsgs);
+    }
+    notified.clear();
+    // check duplicate for books, this prevents sending the same message multiple times if it affects multiple
+    // books watched by the same connection
+    for (auto const& book : books) {
+        bookSignal.emit(book, allVersionsMsgs);
+    }
+}
 
-            // We need a field that contains the TakerGets and TakerPays
-            // parameters.
-            if (node.getFName() == ripple::sfModifiedNode) {
-                field = &ripple::sfPreviousFields;
-            } else if (node.getFName() == ripple::sfCreatedNode) {
-                field = &ripple::sfNewFields;
-            } else if (node.getFName() == ripple::sfDeletedNode) {
-                field = &ripple::sfFinalFields;
-            }
+TransactionFeed::Shard&
+TransactionFeed::shardFor(SubscriberPtr subscriber)
+{
+    // sessions are allocated at addresses sharing their lowest bits; multiplying spreads all the bits into the high
+    // ones which are then used to pick the shard
+    static constexpr std::uint64_t GOLDEN_RATIO = 0x9E3779B97F4A7C15ull;
+    static constexpr auto SHIFT = 32u;
 
-            if (field != nullptr) {
-                auto const data = dynamic_cast<ripple::STObject const*>(node.peekAtPField(*field));
+    auto const hash = static_cast<std::uint64_t>(std::hash<SubscriberPtr>{}(subscriber)) * GOLDEN_RATIO;
+    return *shards_[static_cast<std::size_t>(hash >> SHIFT) % shards_.size()];
+}
 
-                if ((data != nullptr) && data->isFieldPresent(ripple::sfTakerPays) &&
-                    data->isFieldPresent(ripple::sfTakerGets)) {
-                    // determine the OrderBook
-                    ripple::Book const book{
-                        data->getFieldAmount(ripple::sfTakerGets).issue(),
-                        data->getFieldAmount(ripple::sfTakerPays).issue()
-                    };
-                    if (affectedBooks.find(book) == affectedBooks.end()) {
-                        affectedBooks.insert(book);
-                    }
-                }
-            }
-        }
-    }
+bool
+TransactionFeed::hasSubscribers() const
+{
+    return hasStreamSubscribers() or std::ranges::any_of(shards_, [](auto const& shard) {
+               return not shard->accountSignal.empty() or not shard->accountProposedSignal.empty() or
+                   not shard->bookSignal.empty();
+           });
+}
 
-    [[maybe_unused]] auto task = strand_.execute([this,
-                                                  allVersionsMsgs = std::move(allVersionsMsgs),
-                                                  affectedAccounts = std::move(affectedAccounts),
-                                                  affectedBooks = std::move(affectedBooks)]() {
-        notified_.clear();
-        signal_.emit(allVersionsMsgs);
-        // clear the notified set. If the same connection subscribes both transactions + proposed_transactions,
-        // rippled SENDS the same message twice
-        notified_.clear();
-        txProposedsignal_.emit(allVersionsMsgs);
-        notified_.clear();
-        // check duplicate for account and proposed_account, this prevents sending the same message multiple times
-        // if it affects multiple accounts watched by the same connection
-        for (auto const& account : affectedAccounts) {
-            accountSignal_.emit(account, allVersionsMsgs);
-            accountProposedSignal_.emit(account, allVersionsMsgs);
-        }
-        notified_.clear();
-        // check duplicate for books, this prevents sending the same message multiple times if it affects multiple
-        // books watched by the same connection
-        for (auto const& book : affectedBooks) {
-            bookSignal_.emit(book, allVersionsMsgs);
-        }
+bool
+TransactionFeed::isSubscribed(ripple::AccountID const& account) const
+{
+    return std::ranges::any_of(shards_, [&account](auto const& shard) {
+        return shard->accountSignal.contains(account) or shard->accountProposedSignal.contains(account);
     });
 }
 
+bool
+TransactionFeed::isSubscribed(ripple::Book const& book) const
+{
+    return std::ranges::any_of(shards_, [&book](auto const& shard) { return shard->bookSignal.contains(book); });
+}
+
+bool
+TransactionFeed::hasStreamSubscribers() const
+{
+    return std::ranges::any_of(shards_, [](auto const& shard) {
+        return shard->signal.count() != 0 or shard->txProposedSignal.count() != 0;
+    });
+}
+
+std::chrono::steady_clock::time_point
+TransactionFeed::ledgerPublishStart(std::uint32_t seq)
+{
+    std::scoped_lock const lk(ledgerMtx_);
+    if (seq != ledgerSeq_) {
+        ledgerSeq_ = seq;
+        ledgerPublishStart_ = std::chrono::steady_clock::now();
+    }
+
+    return ledgerPublishStart_;
+}
+
 void
 TransactionFeed::unsubInternal(SubscriberPtr subscriber)
 {
-    if (signal_.disconnect(subscriber)) {
+    if (shardFor(subscriber).signal.disconnect(subscriber)) {
         LOG(logger_.info()) << subscriber->tag() << "Unsubscribed transactions";
         --subAllCount_.get();
     }
@@ -313,7 +430,7 @@ TransactionFeed::unsubInternal(SubscriberPtr subscriber)
 void
 TransactionFeed::unsubInternal(ripple::AccountID const& account, SubscriberPtr subscriber)
 {
-    if (accountSignal_.disconnect(subscriber, account)) {
+    if (shardFor(subscriber).accountSignal.disconnect(subscriber, account)) {
         LOG(logger_.info()) << subscriber->tag() << "Unsubscribed account " << account;
         --subAccountCount_.get();
     }
@@ -322,19 +439,19 @@ TransactionFeed::unsubInternal(ripple::AccountID const& account, SubscriberPtr s
 void
 TransactionFeed::unsubProposedInternal(SubscriberPtr subscriber)
 {
-    txProposedsignal_.disconnect(subscriber);
+    shardFor(subscriber).txProposedSignal.disconnect(subscriber);
 }
 
 void
 TransactionFeed::unsubProposedInternal(ripple::AccountID const& account, SubscriberPtr subscriber)
 {
-    accountProposedSignal_.disconnect(subscriber, account);
+    shardFor(subscriber).accountProposedSignal.disconnect(subscriber, account);
 }
 
 void
 TransactionFeed::unsubInternal(ripple::Book const& book, SubscriberPtr subscriber)
 {
-    if (bookSignal_.disconnect(subscriber, book)) {
+    if (shardFor(subscriber).bookSignal.disconnect(subscriber, book)) {
         LOG(logger_.info()) << subscriber->tag() << "Unsubscribed book " << book;
         --subBookCount_.get();
     }
@@ -29,33 +29,91 @@
 #include "util/async/AnyStrand.hpp"
 #include "util/log/Logger.hpp"
 #include "util/prometheus/Gauge.hpp"
+#include "util/prometheus/Label.hpp"
+#include "util/prometheus/Prometheus.hpp"
 
 #include <boost/asio/io_context.hpp>
 #include <boost/asio/strand.hpp>
+#include <boost/json/object.hpp>
 #include <fmt/core.h>
 #include <xrpl/protocol/AccountID.h>
 #include <xrpl/protocol/Book.h>
 #include <xrpl/protocol/LedgerHeader.h>
 
+#include <algorithm>
 #include <array>
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
 namespace feed::impl {
 
 class TransactionFeed {
-    // Hold two versions of transaction messages
-    using AllVersionTransactionsType = std::array<std::shared_ptr<std::string>, 2>;
+    // Holds two versions of transaction messages. Each version is generated and serialized once, when the first
+    // subscriber using it is notified, and then shared by all such subscribers in all shards.
+    class AllVersionTransactionsType {
+        std::function<boost::json::object(std::uint32_t)> genJsonByVersion_;
+        mutable std::array<std::once_flag, 2> generated_;
+        mutable std::array<std::shared_ptr<std::string>, 2> msgs_;
+
+    public:
+        explicit AllVersionTransactionsType(std::function<boost::json::object(std::uint32_t)> genJsonByVersion)
+            : genJsonByVersion_(std::move(genJsonByVersion))
+        {
+        }
+
+        std::shared_ptr<std::string> const&
+        get(std::uint32_t apiVersion) const;
+    };
+
+    // Subscribers are split into shards by session. Every shard publishes on its own strand so shards deliver in
+    // parallel while each session still receives the transactions in order.
+    struct Shard {
+        util::async::AnyStrand strand;
+
+        TrackableSignalMap<ripple::AccountID, Subscriber, AllVersionTransactionsType const&> accountSignal;
+        TrackableSignalMap<ripple::Book, Subscriber, AllVersionTransactionsType const&> bookSignal;
+        TrackableSignal<Subscriber, AllVersionTransactionsType const&> signal;
+
+        // Signals for proposed tx subscribers
+        TrackableSignalMap<ripple::AccountID, Subscriber, AllVersionTransactionsType const&> accountProposedSignal;
+        TrackableSignal<Subscriber, AllVersionTransactionsType const&> txProposedSignal;
+
+        // Used by slots to prevent double notifications if tx contains multiple subscribed accounts. Only used on the
+        // strand of the shard
+        std::unordered_set<SubscriberPtr> notified;
+
+        explicit Shard(util::async::AnyExecutionContext& executionCtx) : strand(executionCtx.makeStrand())
+        {
+        }
+
+        bool
+        hasSubscribers(
+            std::unordered_set<ripple::AccountID> const& accounts,
+            std::unordered_set<ripple::Book> const& books
+        ) const;
+
+        void
+        publish(
+            AllVersionTransactionsType const& allVersionsMsgs,
+            std::unordered_set<ripple::AccountID> const& accounts,
+            std::unordered_set<ripple::Book> const& books
+        );
+    };
 
     struct TransactionSlot {
-        std::reference_wrapper<TransactionFeed> feed;
+        std::reference_wrapper<Shard> shard;
         std::weak_ptr<Subscriber> connectionWeakPtr;
 
-        TransactionSlot(TransactionFeed& feed, SubscriberSharedPtr const& connection)
-            : feed(feed), connectionWeakPtr(connection)
+        TransactionSlot(Shard& shard, SubscriberSharedPtr const& connection)
+            : shard(shard), connectionWeakPtr(connection)
         {
         }
 
@@ -65,33 +123,37 @@ class TransactionFeed {
 
     util::Logger logger_{"Subscriptions"};
 
-    util::async::AnyStrand strand_;
     std::reference_wrapper<util::prometheus::GaugeInt> subAllCount_;
     std::reference_wrapper<util::prometheus::GaugeInt> subAccountCount_;
     std::reference_wrapper<util::prometheus::GaugeInt> subBookCount_;
+    std::reference_wrapper<util::prometheus::GaugeInt> publishLag_;
 
-    TrackableSignalMap<ripple::AccountID, Subscriber, AllVersionTransactionsType const&> accountSignal_;
-    TrackableSignalMap<ripple::Book, Subscriber, AllVersionTransactionsType const&> bookSignal_;
-    TrackableSignal<Subscriber, AllVersionTransactionsType const&> signal_;
-
-    // Signals for proposed tx subscribers
-    TrackableSignalMap<ripple::AccountID, Subscriber, AllVersionTransactionsType const&> accountProposedSignal_;
-    TrackableSignal<Subscriber, AllVersionTransactionsType const&> txProposedsignal_;
+    std::vector<std::unique_ptr<Shard>> shards_;
 
-    std::unordered_set<SubscriberPtr>
-        notified_;  // Used by slots to prevent double notifications if tx contains multiple subscribed accounts
+    // when the first transaction of the ledger being published was published
+    std::mutex ledgerMtx_;
+    std::uint32_t ledgerSeq_ = 0;
+    std::chrono::steady_clock::time_point ledgerPublishStart_;
 
 public:
     /**
      * @brief Construct a new Transaction Feed object.
-     * @param executionCtx The actual publish will be called in the strand of this.
+     * @param executionCtx The actual publish will be called in the strands of this.
+     * @param numShards The number of shards to split the subscribers into; at most this many strands publish at once.
      */
-    TransactionFeed(util::async::AnyExecutionContext& executionCtx)
-        : strand_(executionCtx.makeStrand())
-        , subAllCount_(getSubscriptionsGaugeInt("tx"))
+    TransactionFeed(util::async::AnyExecutionContext& executionCtx, std::size_t numShards = 1)
+        : subAllCount_(getSubscriptionsGaugeInt("tx"))
         , subAccountCount_(getSubscriptionsGaugeInt("account"))
         , subBookCount_(getSubscriptionsGaugeInt("book"))
+        , publishLag_(PrometheusService::gaugeInt(
+              "subscriptions_publish_lag_milliseconds",
+              util::prometheus::Labels({util::prometheus::Label{"stream", "tx"}}),
+              "Time from publishing the first transaction of a ledger until its last delivered transaction was "
+              "delivered to all subscribers"
+          ))
     {
+        for (std::size_t i = 0; i < std::max<std::size_t>(numShards, 1); ++i)
+            shards_.push_back(std::make_unique<Shard>(executionCtx));
     }
 
     /**
@@ -173,6 +235,10 @@ public:
 
     /**
      * @brief Publishes the transaction feed.
+     *
+     * Does nothing if no one is subscribed to all transactions or to any of the accounts and books affected by the
+     * transaction.
+     *
      * @param txMeta The transaction and metadata.
      * @param lgrInfo The ledger header.
      * @param backend The backend.
@@ -201,6 +267,24 @@ public:
     bookSubCount() const;
 
 private:
+    Shard&
+    shardFor(SubscriberPtr subscriber);
+
+    bool
+    hasSubscribers() const;
+
+    bool
+    isSubscribed(ripple::AccountID const& account) const;
+
+    bool
+    isSubscribed(ripple::Book const& book) const;
+
+    bool
+    hasStreamSubscribers() const;
+
+    std::chrono::steady_clock::time_point
+    ledgerPublishStart(std::uint32_t seq);
+
     void
     unsubInternal(SubscriberPtr subscriber);
 
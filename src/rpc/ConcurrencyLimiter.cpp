@@ -0,0 +1,73 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "rpc/ConcurrencyLimiter.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <mutex>
+
+namespace rpc {
+
+ConcurrencyLimiter::ConcurrencyLimiter(std::size_t minLimit, std::size_t maxLimit)
+    : minLimit_{std::max<std::size_t>(minLimit, 1)}
+    , maxLimit_{std::max(maxLimit, minLimit_)}
+    , limit_{maxLimit_}
+    , estimatedLimit_{static_cast<double>(maxLimit_)}
+{
+}
+
+std::size_t
+ConcurrencyLimiter::limit() const
+{
+    return limit_;
+}
+
+void
+ConcurrencyLimiter::onSample(std::chrono::microseconds latency, std::size_t inFlight)
+{
+    auto const sample = std::max(static_cast<double>(latency.count()), 1.);
+
+    std::scoped_lock const lck{mtx_};
+
+    shortLatencyUs_ = shortLatencyUs_ ? (*shortLatencyUs_ * (1. - SHORT_WEIGHT)) + (sample * SHORT_WEIGHT) : sample;
+    longLatencyUs_ = longLatencyUs_ ? (*longLatencyUs_ * (1. - LONG_WEIGHT)) + (sample * LONG_WEIGHT) : sample;
+
+    // the load went down a lot; let the baseline catch up faster so that the limit can grow again
+    if (*longLatencyUs_ > 2. * *shortLatencyUs_)
+        *longLatencyUs_ *= 0.95;
+
+    // the limit isn't used; latency observed now says nothing about whether a higher limit would be fine
+    if (static_cast<double>(inFlight) < estimatedLimit_ / 2.)
+        return;
+
+    auto const gradient = std::clamp(TOLERANCE * *longLatencyUs_ / *shortLatencyUs_, MIN_GRADIENT, 1.);
+    auto const newLimit = (estimatedLimit_ * gradient) + std::sqrt(estimatedLimit_);
+
+    estimatedLimit_ = std::clamp(
+        (estimatedLimit_ * (1. - SMOOTHING)) + (newLimit * SMOOTHING),
+        static_cast<double>(minLimit_),
+        static_cast<double>(maxLimit_)
+    );
+    limit_ = static_cast<std::size_t>(estimatedLimit_);
+}
+
+}  // namespace rpc
@@ -0,0 +1,90 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <optional>
+
+namespace rpc {
+
+/**
+ * @brief Adapts the number of requests processed at once to the latency they are processed with.
+ *
+ * Follows the gradient approach of TCP Vegas and Netflix concurrency-limits: a long term average of the latency serves
+ * as the baseline the server achieves when it is not overloaded. Whenever the short term average rises above the
+ * baseline (e.g. because the database slows down) the limit shrinks proportionally; as long as the latency stays close
+ * to the baseline and the limit is actually used the limit grows by its square root on every sample.
+ */
+class ConcurrencyLimiter {
+public:
+    /** @brief The short term latency may exceed the baseline by this factor before the limit shrinks */
+    static constexpr double TOLERANCE = 1.5;
+
+    /** @brief The limit never shrinks by more than this factor at once */
+    static constexpr double MIN_GRADIENT = 0.5;
+
+    /** @brief How fast the limit moves towards the new estimate */
+    static constexpr double SMOOTHING = 0.2;
+
+    /** @brief Weight of a sample in the short term average of the latency */
+    static constexpr double SHORT_WEIGHT = 0.1;
+
+    /** @brief Weight of a sample in the long term average of the latency */
+    static constexpr double LONG_WEIGHT = 1. / 600.;
+
+private:
+    std::size_t minLimit_;
+    std::size_t maxLimit_;
+    std::atomic_size_t limit_;
+
+    std::mutex mtx_;
+    double estimatedLimit_;
+    std::optional<double> shortLatencyUs_;
+    std::optional<double> longLatencyUs_;
+
+public:
+    /**
+     * @brief Construct a new limiter starting at the maximum limit
+     *
+     * @param minLimit The limit never goes below this
+     * @param maxLimit The limit never goes above this
+     */
+    ConcurrencyLimiter(std::size_t minLimit, std::size_t maxLimit);
+
+    /**
+     * @return The current limit
+     */
+    std::size_t
+    limit() const;
+
+    /**
+     * @brief Update the limit with the latency of a request which just completed.
+     *
+     * @param latency How long it took to process the request
+     * @param inFlight The number of requests being processed when the request completed, including itself
+     */
+    void
+    onSample(std::chrono::microseconds latency, std::size_t inFlight);
+};
+
+}  // namespace rpc
@@ -0,0 +1,133 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "rpc/LedgerResponseCache.hpp"
+
+#include "rpc/RequestKey.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <utility>
+
+namespace rpc {
+
+LedgerResponseCache::LedgerResponseCache(std::unordered_set<std::string> methods, std::size_t maxBytes)
+    : methods_{std::move(methods)}, maxBytes_{maxBytes}
+{
+}
+
+bool
+LedgerResponseCache::shouldCache(std::string const& method) const
+{
+    return maxBytes_ != 0 and methods_.contains(method);
+}
+
+std::shared_ptr<std::string const>
+LedgerResponseCache::get(RequestKey const& key, std::uint32_t latestSeq)
+{
+    std::scoped_lock const lck{mtx_};
+    advanceLatestSeq(latestSeq);
+
+    ++reqCounter_.get();
+    auto const it = index_.find(key.key);
+    if (it == index_.end())
+        return nullptr;
+
+    ++hitCounter_.get();
+    entries_.splice(entries_.begin(), entries_, it->second);
+    return it->second->response;
+}
+
+void
+LedgerResponseCache::put(RequestKey const& key, std::uint32_t latestSeq, std::shared_ptr<std::string const> response)
+{
+    std::scoped_lock const lck{mtx_};
+    advanceLatestSeq(latestSeq);
+
+    // the latest ledger changed while the request was executed
+    if (key.isLatestLedger and latestSeq != latestSeq_)
+        return;
+
+    if (auto const it = index_.find(key.key); it != index_.end())
+        erase(it->second);
+
+    Entry entry{.key = key.key, .response = std::move(response), .isLatestLedger = key.isLatestLedger};
+    auto const size = entryBytes(entry);
+    if (size > maxBytes_)
+        return;
+
+    entries_.push_front(std::move(entry));
+    index_.emplace(entries_.front().key, entries_.begin());
+    bytes_ += size;
+
+    while (bytes_ > maxBytes_)
+        erase(std::prev(entries_.end()));
+}
+
+std::size_t
+LedgerResponseCache::size() const
+{
+    std::scoped_lock const lck{mtx_};
+    return index_.size();
+}
+
+std::size_t
+LedgerResponseCache::bytes() const
+{
+    std::scoped_lock const lck{mtx_};
+    return bytes_;
+}
+
+std::size_t
+LedgerResponseCache::entryBytes(Entry const& entry)
+{
+    // the key is stored twice
+    return 2 * entry.key.size() + entry.response->size();
+}
+
+void
+LedgerResponseCache::advanceLatestSeq(std::uint32_t latestSeq)
+{
+    if (latestSeq <= latestSeq_)
+        return;
+
+    latestSeq_ = latestSeq;
+    for (auto it = entries_.begin(); it != entries_.end();) {
+        auto const next = std::next(it);
+        if (it->isLatestLedger)
+            erase(it);
+        it = next;
+    }
+}
+
+void
+LedgerResponseCache::erase(std::list<Entry>::iterator it)
+{
+    bytes_ -= entryBytes(*it);
+    index_.erase(it->key);
+    entries_.erase(it);
+}
+
+}  // namespace rpc
@@ -0,0 +1,137 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include "rpc/RequestKey.hpp"
+#include "util/prometheus/Counter.hpp"
+#include "util/prometheus/Label.hpp"
+#include "util/prometheus/Prometheus.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace rpc {
+
+/**
+ * @brief Size bounded LRU cache of serialized responses of requests pinned to a ledger.
+ *
+ * Responses for a specific ledger never change so they stay cached until evicted. Responses of requests asking for the
+ * latest ledger are dropped as soon as a newer ledger becomes the latest one.
+ */
+class LedgerResponseCache {
+public:
+    /** @brief Default maximum number of bytes used by the cached responses */
+    static constexpr std::size_t DEFAULT_MAX_BYTES = 64 * 1024 * 1024;
+
+private:
+    struct Entry {
+        std::string key;
+        std::shared_ptr<std::string const> response;
+        bool isLatestLedger;
+    };
+
+    std::reference_wrapper<util::prometheus::CounterInt> reqCounter_{PrometheusService::counterInt(
+        "rpc_response_cache_counter_total_number",
+        util::prometheus::Labels({{"type", "request"}}),
+        "Ledger response cache statistics"
+    )};
+    std::reference_wrapper<util::prometheus::CounterInt> hitCounter_{PrometheusService::counterInt(
+        "rpc_response_cache_counter_total_number",
+        util::prometheus::Labels({{"type", "cache_hit"}})
+    )};
+
+    std::unordered_set<std::string> methods_;
+    std::size_t maxBytes_;
+
+    mutable std::mutex mtx_;
+    std::size_t bytes_ = 0;
+    std::uint32_t latestSeq_ = 0;
+
+    // most recently used entries first
+    std::list<Entry> entries_;
+    std::unordered_map<std::string, std::list<Entry>::iterator> index_;
+
+public:
+    /**
+     * @brief Construct a new cache
+     *
+     * @param methods The methods whose responses are cached
+     * @param maxBytes The maximum number of bytes used by the cached responses
+     */
+    LedgerResponseCache(std::unordered_set<std::string> methods, std::size_t maxBytes = DEFAULT_MAX_BYTES);
+
+    /**
+     * @param method The method of a request
+     * @return true if responses of the method are cached; false otherwise
+     */
+    bool
+    shouldCache(std::string const& method) const;
+
+    /**
+     * @brief Get a cached response.
+     *
+     * @param key The key of the request
+     * @param latestSeq The sequence of the latest ledger
+     * @return The serialized response if cached; nullptr otherwise
+     */
+    std::shared_ptr<std::string const>
+    get(RequestKey const& key, std::uint32_t latestSeq);
+
+    /**
+     * @brief Store a response.
+     *
+     * @param key The key of the request
+     * @param latestSeq The sequence of the latest ledger the request was executed for
+     * @param response The serialized response
+     */
+    void
+    put(RequestKey const& key, std::uint32_t latestSeq, std::shared_ptr<std::string const> response);
+
+    /**
+     * @return The number of cached responses
+     */
+    std::size_t
+    size() const;
+
+    /**
+     * @return Approximate number of bytes used by the cached responses
+     */
+    std::size_t
+    bytes() const;
+
+private:
+    static std::size_t
+    entryBytes(Entry const& entry);
+
+    void
+    advanceLatestSeq(std::uint32_t latestSeq);
+
+    void
+    erase(std::list<Entry>::iterator it);
+};
+
+}  // namespace rpc
@@ -21,8 +21,13 @@
 
 #include "data/BackendInterface.hpp"
 #include "rpc/Errors.hpp"
+#include "rpc/JS.hpp"
+#include "rpc/LedgerResponseCache.hpp"
 #include "rpc/RPCHelpers.hpp"
+#include "rpc/RequestCoalescer.hpp"
+#include "rpc/RequestKey.hpp"
 #include "rpc/WorkQueue.hpp"
+#include "rpc/common/AnyHandler.hpp"
 #include "rpc/common/HandlerProvider.hpp"
 #include "rpc/common/Types.hpp"
 #include "rpc/common/impl/ForwardingProxy.hpp"
@@ -36,9 +41,12 @@
 #include <boost/json.hpp>
 #include <fmt/core.h>
 #include <fmt/format.h>
+#include <fmt/ranges.h>
 #include <xrpl/protocol/ErrorCodes.h>
 
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <exception>
 #include <functional>
 #include <memory>
@@ -46,6 +54,7 @@
 #include <string>
 #include <unordered_set>
 #include <utility>
+#include <variant>
 
 /**
  * @brief This namespace contains all the RPC logic and handlers.
@@ -70,6 +79,8 @@ class RPCEngine {
     impl::ForwardingProxy<LoadBalancerType, CountersType, HandlerProvider> forwardingProxy_;
 
     std::optional<util::ResponseExpirationCache> responseCache_;
+    std::optional<RequestCoalescer> coalescer_;
+    std::optional<LedgerResponseCache> ledgerResponseCache_;
 
 public:
     /**
@@ -109,6 +120,30 @@ public:
                 util::Config::toMilliseconds(cacheTimeout), std::unordered_set<std::string>{"server_info"}
             );
         }
+
+        auto const cachedMethods = config.arrayOr("rpc.response_cache.methods", {});
+        if (not cachedMethods.empty()) {
+            auto const transform = [](auto const& elem) { return elem.template value<std::string>(); };
+            std::unordered_set<std::string> methods{
+                boost::transform_iterator(std::begin(cachedMethods), transform),
+                boost::transform_iterator(std::end(cachedMethods), transform)
+            };
+
+            static constexpr std::size_t BYTES_IN_MB = 1024 * 1024;
+            auto const maxSizeMb = config.valueOr<std::size_t>(
+                "rpc.response_cache.max_size_mb", LedgerResponseCache::DEFAULT_MAX_BYTES / BYTES_IN_MB
+            );
+
+            LOG(log_.info()) << fmt::format(
+                "Init RPC response cache of {} MB for methods: {}", maxSizeMb, fmt::join(methods, ", ")
+            );
+            ledgerResponseCache_.emplace(std::move(methods), maxSizeMb * BYTES_IN_MB);
+        }
+
+        if (config.valueOr("rpc.coalesce_requests", false)) {
+            LOG(log_.info()) << "Coalescing identical concurrent requests";
+            coalescer_.emplace();
+        }
     }
 
     /**
@@ -171,47 +206,75 @@ public:
             return Result{Status{RippledError::rpcUNKNOWN_COMMAND}};
         }
 
-        try {
-            LOG(perfLog_.debug()) << ctx.tag() << " start executing rpc `" << ctx.method << '`';
+        auto const range = backend_->fetchLedgerRange();
+        auto const cacheKey = [&]() -> std::optional<RequestKey> {
+            if (ctx.isAdmin or not range or not ledgerResponseCache_ or
+                not ledgerResponseCache_->shouldCache(ctx.method))
+                return std::nullopt;
 
-            auto const context = Context{ctx.yield, ctx.session, ctx.isAdmin, ctx.clientIp, ctx.apiVersion};
-            auto v = (*method).process(ctx.params, context);
-
-            LOG(perfLog_.debug()) << ctx.tag() << " finish executing rpc `" << ctx.method << '`';
+            return makeRequestKey(ctx.method, ctx.params, ctx.apiVersion, range->maxSequence);
+        }();
 
-            if (not v) {
-                notifyErrored(ctx.method);
-            } else if (not ctx.isAdmin and responseCache_) {
-                responseCache_->put(ctx.method, v.result->as_object());
-            }
-
-            return Result{std::move(v)};
-        } catch (data::DatabaseTimeout const& t) {
-            LOG(log_.error()) << "Database timeout";
-            notifyTooBusy();
-
-            return Result{Status{RippledError::rpcTOO_BUSY}};
-        } catch (std::exception const& ex) {
-            LOG(log_.error()) << ctx.tag() << "Caught exception: " << ex.what();
-            notifyInternalError();
+        if (cacheKey) {
+            if (auto response = ledgerResponseCache_->get(*cacheKey, range->maxSequence); response)
+                return Result{std::move(response)};
+        }
 
-            return Result{Status{RippledError::rpcINTERNAL}};
+        // requests sharing a key run against the ledger the key is pinned to even if a newer one is published
+        // meanwhile. methods not taking a ledger are run with the parameters they were given
+        auto const executeRequest = [&](bool isShared) {
+            auto const pin = isShared and method->acceptsField(JS(ledger_index), ctx.apiVersion);
+            auto result = pin ? execute(*method, ctx, pinToLatestLedger(ctx.params, range->maxSequence))
+                              : execute(*method, ctx, ctx.params);
+            if (cacheKey)
+                cacheResponse(result, *cacheKey, range->maxSequence);
+
+            return result;
+        };
+
+        // only requests pinned to a ledger are coalesced as their responses can't differ
+        if (not ctx.isAdmin and coalescer_ and range) {
+            if (auto const key = coalescer_->makeKey(ctx.method, ctx.params, ctx.apiVersion, range->maxSequence); key)
+                return coalescer_->run(ctx.method, *key, ctx.yield, [&] { return executeRequest(true); });
         }
+
+        return executeRequest(cacheKey.has_value());
     }
 
     /**
      * @brief Used to schedule request processing onto the work queue.
      *
+     * Requests of admins and whitelisted clients skip the queue; other requests wait in the lane of their method's cost
+     * where clients take turns.
+     *
      * @tparam FnType The type of function
      * @param func The lambda to execute when this request is handled
      * @param ip The ip address for which this request is being executed
+     * @param method The method of the request
+     * @param isAdmin Whether the request comes from an admin
+     * @param onExpired Called instead of func if the request waited in the queue for too long
      * @return true if the request was successfully scheduled; false otherwise
      */
     template <typename FnType>
     bool
-    post(FnType&& func, std::string const& ip)
+    post(
+        FnType&& func,
+        std::string const& ip,
+        std::string const& method = {},
+        bool isAdmin = false,
+        std::function<void()> onExpired = {}
+    )
     {
-        return workQueue_.get().postCoro(std::forward<FnType>(func), dosGuard_.get().isWhiteListed(ip));
+        auto const lane = [&] {
+            if (isAdmin or dosGuard_.get().isWhiteListed(ip))
+                return WorkQueue::Lane::Privileged;
+            return handlerProvider_->isExpensive(method) ? WorkQueue::Lane::Expensive : WorkQueue::Lane::Cheap;
+        }();
+
+        return workQueue_.get().postCoro(
+            std::forward<FnType>(func),
+            WorkQueue::JobInfo{.lane = lane, .client = ip, .onExpired = std::move(onExpired)}
+        );
     }
 
     /**
@@ -304,6 +367,50 @@ public:
     }
 
 private:
+    Result
+    execute(AnyHandler const& handler, web::Context const& ctx, boost::json::object const& params)
+    {
+        try {
+            LOG(perfLog_.debug()) << ctx.tag() << " start executing rpc `" << ctx.method << '`';
+
+            auto const context = Context{ctx.yield, ctx.session, ctx.isAdmin, ctx.clientIp, ctx.apiVersion};
+            auto v = handler.process(params, context);
+
+            LOG(perfLog_.debug()) << ctx.tag() << " finish executing rpc `" << ctx.method << '`';
+
+            if (not v) {
+                notifyErrored(ctx.method);
+            } else if (not ctx.isAdmin and responseCache_) {
+                responseCache_->put(ctx.method, v.result->as_object());
+            }
+
+            return Result{std::move(v)};
+        } catch (data::DatabaseTimeout const& t) {
+            LOG(log_.error()) << "Database timeout";
+            notifyTooBusy();
+
+            return Result{Status{RippledError::rpcTOO_BUSY}};
+        } catch (std::exception const& ex) {
+            LOG(log_.error()) << ctx.tag() << "Caught exception: " << ex.what();
+            notifyInternalError();
+
+            return Result{Status{RippledError::rpcINTERNAL}};
+        }
+    }
+
+    void
+    cacheResponse(Result& result, RequestKey const& key, std::uint32_t latestSeq)
+    {
+        // responses with warnings would need the warnings cached too and are rare enough to not bother
+        auto const* response = std::get_if<boost::json::object>(&result.response);
+        if (response == nullptr or not result.warnings.empty() or response->contains(JS(error)) or
+            response->contains(JS(status)))
+            return;
+
+        result.serializedResponse = std::make_shared<std::string const>(boost::json::serialize(*response));
+        ledgerResponseCache_->put(key, latestSeq, result.serializedResponse);
+    }
+
     bool
     validHandler(std::string const& method) const
     {
@@ -61,6 +61,7 @@
 #include <xrpl/protocol/LedgerFormats.h>
 #include <xrpl/protocol/LedgerHeader.h>
 #include <xrpl/protocol/NFTSyntheticSerializer.h>
+#include <xrpl/protocol/Protocol.h>
 #include <xrpl/protocol/PublicKey.h>
 #include <xrpl/protocol/Rate.h>
 #include <xrpl/protocol/SField.h>
@@ -625,6 +626,73 @@ traverseOwnedNodes(
     );
 }
 
+namespace {
+
+// Fetches a directory page together with the pages likely following it, which are stored in prefetchedPages, and the
+// objects of the keys collected so far, which are appended to objects. All of them are requested in one batch.
+std::optional<data::Blob>
+fetchDirectoryPages(
+    BackendInterface const& backend,
+    ripple::Keylet const& root,
+    std::uint64_t const page,
+    std::optional<std::uint64_t>& lastPage,
+    std::uint32_t const limit,
+    std::vector<ripple::uint256> const& keys,
+    std::vector<data::Blob>& objects,
+    std::map<std::uint64_t, data::Blob>& prefetchedPages,
+    std::uint32_t const sequence,
+    boost::asio::yield_context yield
+)
+{
+    static std::uint64_t constexpr MAX_PREFETCHED_PAGES = 32;
+
+    // pages may be partially filled, but there is no point in prefetching more than a full directory would need
+    auto numPages = std::min(
+        MAX_PREFETCHED_PAGES,
+        (std::uint64_t{limit} + ripple::dirNodeMaxEntries - 1) / ripple::dirNodeMaxEntries
+    );
+    if (lastPage)
+        numPages = *lastPage >= page ? std::min(numPages, *lastPage - page + 1) : 1;
+
+    if (numPages == 1 and lastPage)
+        return backend.fetchLedgerObject(ripple::keylet::page(root, page).key, sequence, yield);
+
+    std::vector<ripple::uint256> batch;
+    batch.reserve(numPages + 1 + keys.size() - objects.size());
+    for (auto i = 0u; i < numPages; ++i)
+        batch.push_back(ripple::keylet::page(root, page + i).key);
+
+    // started from a hint; the root page tells where the directory ends
+    if (!lastPage)
+        batch.push_back(root.key);
+
+    batch.insert(batch.end(), keys.begin() + objects.size(), keys.end());
+
+    auto blobs = backend.fetchLedgerObjects(batch, sequence, yield);
+    auto blob = blobs.begin();
+    for (auto i = 0u; i < numPages; ++i)
+        prefetchedPages.emplace(page + i, std::move(*blob++));
+
+    if (!lastPage) {
+        lastPage = 0;
+        if (!blob->empty()) {
+            ripple::SerialIter rootIt{blob->data(), blob->size()};
+            lastPage = ripple::SLE{rootIt, root.key}.getFieldU64(ripple::sfIndexPrevious);
+        }
+        ++blob;
+    }
+
+    objects.insert(objects.end(), std::make_move_iterator(blob), std::make_move_iterator(blobs.end()));
+
+    auto requested = prefetchedPages.extract(page);
+    if (requested.mapped().empty())
+        return std::nullopt;
+
+    return std::move(requested.mapped());
+}
+
+}  // namespace
+
 std::variant<Status, AccountCursor>
 traverseOwnedNodes(
     BackendInterface const& backend,
@@ -651,6 +719,9 @@ traverseOwnedNodes(
     static std::uint32_t constexpr MIN_NODES = 2048;
     keys.reserve(std::min(MIN_NODES, limit));
 
+    // objects of the first keys, fetched together with the directory pages
+    std::vector<data::Blob> objects;
+
     auto start = std::chrono::system_clock::now();
 
     // If startAfter is not zero try jumping to that page using the hint
@@ -671,70 +742,64 @@ traverseOwnedNodes(
         }
 
         currentIndex = hintIndex;
-        bool found = false;
-        for (;;) {
-            auto const ownerDir = backend.fetchLedgerObject(currentIndex.key, sequence, yield);
-
-            if (!ownerDir)
-                return Status(ripple::rpcINVALID_PARAMS, "Owner directory not found.");
-
-            ripple::SerialIter ownedDirIt{ownerDir->data(), ownerDir->size()};
-            ripple::SLE const ownedDirSle{ownedDirIt, currentIndex.key};
-
-            for (auto const& key : ownedDirSle.getFieldV256(ripple::sfIndexes)) {
-                if (!found) {
-                    if (key == hexMarker)
-                        found = true;
-                } else {
-                    keys.push_back(key);
-
-                    if (--limit == 0) {
-                        break;
-                    }
-                }
-            }
+    }
 
-            if (limit == 0) {
-                cursor = AccountCursor({keys.back(), currentPage});
-                break;
-            }
-            // the next page
-            auto const uNodeNext = ownedDirSle.getFieldU64(ripple::sfIndexNext);
-            if (uNodeNext == 0)
-                break;
+    // New pages are always appended after the last one, so page numbers are mostly dense and the pages following the
+    // current one can be requested together. The root page knows the number of the last page which bounds how many.
+    std::optional<std::uint64_t> lastPage;
+    std::map<std::uint64_t, data::Blob> prefetchedPages;
+    bool found = hexMarker.isZero();
 
-            currentIndex = ripple::keylet::page(rootIndex, uNodeNext);
-            currentPage = uNodeNext;
+    auto ownerDir = backend.fetchLedgerObject(currentIndex.key, sequence, yield);
+    for (;;) {
+        if (!ownerDir) {
+            if (hexMarker.isNonZero())
+                return Status(ripple::rpcINVALID_PARAMS, "Owner directory not found.");
+            break;
         }
-    } else {
-        for (;;) {
-            auto const ownerDir = backend.fetchLedgerObject(currentIndex.key, sequence, yield);
 
-            if (!ownerDir)
-                break;
+        ripple::SerialIter ownedDirIt{ownerDir->data(), ownerDir->size()};
+        ripple::SLE const ownedDirSle{ownedDirIt, currentIndex.key};
 
-            ripple::SerialIter ownedDirIt{ownerDir->data(), ownerDir->size()};
-            ripple::SLE const ownedDirSle{ownedDirIt, currentIndex.key};
+        if (currentIndex.key == rootIndex.key)
+            lastPage = ownedDirSle.getFieldU64(ripple::sfIndexPrevious);
 
-            for (auto const& key : ownedDirSle.getFieldV256(ripple::sfIndexes)) {
+        for (auto const& key : ownedDirSle.getFieldV256(ripple::sfIndexes)) {
+            if (!found) {
+                if (key == hexMarker)
+                    found = true;
+            } else {
                 keys.push_back(key);
 
                 if (--limit == 0)
                     break;
             }
+        }
 
-            if (limit == 0) {
-                cursor = AccountCursor({keys.back(), currentPage});
-                break;
-            }
+        if (limit == 0) {
+            cursor = AccountCursor({keys.back(), currentPage});
+            break;
+        }
 
-            auto const uNodeNext = ownedDirSle.getFieldU64(ripple::sfIndexNext);
-            if (uNodeNext == 0)
-                break;
+        // the next page
+        auto const uNodeNext = ownedDirSle.getFieldU64(ripple::sfIndexNext);
+        if (uNodeNext == 0)
+            break;
 
-            currentIndex = ripple::keylet::page(rootIndex, uNodeNext);
-            currentPage = uNodeNext;
+        currentIndex = ripple::keylet::page(rootIndex, uNodeNext);
+        currentPage = uNodeNext;
+
+        if (auto page = prefetchedPages.extract(uNodeNext); !page.empty()) {
+            ownerDir.reset();
+            if (!page.mapped().empty())
+                ownerDir = std::move(page.mapped());
+            continue;
         }
+
+        prefetchedPages.clear();
+        ownerDir = fetchDirectoryPages(
+            backend, rootIndex, uNodeNext, lastPage, limit, keys, objects, prefetchedPages, sequence, yield
+        );
     }
     auto end = std::chrono::system_clock::now();
 
@@ -744,7 +809,12 @@ traverseOwnedNodes(
         keys.size()
     );
 
-    auto [objects, timeDiff] = util::timed([&]() { return backend.fetchLedgerObjects(keys, sequence, yield); });
+    auto [remaining, timeDiff] = util::timed([&]() {
+        return backend.fetchLedgerObjects(
+            std::vector<ripple::uint256>{keys.begin() + objects.size(), keys.end()}, sequence, yield
+        );
+    });
+    objects.insert(objects.end(), std::make_move_iterator(remaining.begin()), std::make_move_iterator(remaining.end()));
 
     LOG(gLog.debug()) << "Time loading owned entries: " << timeDiff << " milliseconds";
 
@@ -289,6 +289,9 @@ getLedgerHeaderFromHashOrSeq(
 /**
  * @brief Traverse nodes owned by an account
  *
+ * Directory pages following the current one are fetched speculatively in batches, together with the nodes found on
+ * the pages already traversed, so that large directories need only a few round trips to the database.
+ *
  * @param backend The backend to use
  * @param owner The keylet of the owner
  * @param hexMarker The marker
@@ -0,0 +1,138 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "rpc/RequestCoalescer.hpp"
+
+#include "rpc/RequestKey.hpp"
+#include "rpc/common/Types.hpp"
+#include "util/prometheus/Label.hpp"
+#include "util/prometheus/Prometheus.hpp"
+
+#include <boost/asio/associated_executor.hpp>
+#include <boost/asio/compose.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/spawn.hpp>
+#include <boost/json/object.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace rpc {
+
+RequestCoalescer::RequestCoalescer(std::unordered_set<std::string> methods) : methods_{std::move(methods)}
+{
+}
+
+std::unordered_set<std::string>
+RequestCoalescer::defaultMethods()
+{
+    return {
+        "account_currencies",
+        "account_info",
+        "account_lines",
+        "account_objects",
+        "amm_info",
+        "book_offers",
+        "gateway_balances",
+        "ledger",
+        "ledger_entry",
+        "nft_buy_offers",
+        "nft_sell_offers",
+    };
+}
+
+std::optional<std::string>
+RequestCoalescer::makeKey(
+    std::string const& method,
+    boost::json::object const& params,
+    std::uint32_t apiVersion,
+    std::uint32_t latestSeq
+) const
+{
+    if (not methods_.contains(method))
+        return std::nullopt;
+
+    if (auto key = makeRequestKey(method, params, apiVersion, latestSeq); key)
+        return std::move(key)->key;
+
+    return std::nullopt;
+}
+
+void
+RequestCoalescer::finish(std::string const& key, std::shared_ptr<Flight> const& flight, Result const& result)
+{
+    {
+        std::scoped_lock const lck{mtx_};
+        flights_.erase(key);
+    }
+
+    std::vector<std::function<void()>> waiters;
+    {
+        std::scoped_lock const lck{flight->mtx};
+        flight->result = result;
+        waiters = std::move(flight->waiters);
+    }
+
+    for (auto const& waiter : waiters)
+        waiter();
+}
+
+Result
+RequestCoalescer::wait(std::shared_ptr<Flight> const& flight, boost::asio::yield_context yield)
+{
+    auto init = [&flight]<typename Self>(Self& self) {
+        auto sself = std::make_shared<Self>(std::move(self));
+        auto resume = [sself]() {
+            boost::asio::post(boost::asio::get_associated_executor(*sself), [sself]() mutable { sself->complete(); });
+        };
+
+        std::scoped_lock const lck{flight->mtx};
+        if (flight->result.has_value()) {
+            resume();
+        } else {
+            flight->waiters.push_back(std::move(resume));
+        }
+    };
+
+    boost::asio::async_compose<boost::asio::yield_context, void()>(
+        init, yield, boost::asio::get_associated_executor(yield)
+    );
+
+    std::scoped_lock const lck{flight->mtx};
+    return *flight->result;
+}
+
+void
+RequestCoalescer::onCoalesced(std::string const& method)
+{
+    ++PrometheusService::counterInt(
+        "rpc_coalesced_total_number",
+        util::prometheus::Labels({util::prometheus::Label{"method", method}}),
+        "Total number of requests that got the response of an identical request executed concurrently"
+    );
+}
+
+}  // namespace rpc
@@ -0,0 +1,150 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include "rpc/Errors.hpp"
+#include "rpc/common/Types.hpp"
+
+#include <boost/asio/spawn.hpp>
+#include <boost/json/object.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace rpc {
+
+/**
+ * @brief Coalesces identical concurrent requests so that only one of them is executed.
+ *
+ * Requests are identified by a key built from the method, the normalized parameters, the API version and the ledger
+ * the request is pinned to. While a request is executed, identical requests wait for its result instead of executing
+ * the handler again. Only methods whose response depends solely on the parameters and the ledger are coalesced.
+ */
+class RequestCoalescer {
+    struct Flight {
+        std::mutex mtx;
+        std::optional<Result> result;
+        std::vector<std::function<void()>> waiters;
+    };
+
+    std::mutex mtx_;
+    std::unordered_map<std::string, std::shared_ptr<Flight>> flights_;
+    std::unordered_set<std::string> methods_;
+
+public:
+    /**
+     * @brief Construct a new coalescer
+     *
+     * @param methods The methods that can be coalesced
+     */
+    explicit RequestCoalescer(std::unordered_set<std::string> methods = defaultMethods());
+
+    /**
+     * @return The methods which are coalesced by default
+     */
+    static std::unordered_set<std::string>
+    defaultMethods();
+
+    /**
+     * @brief Build the key identifying a request.
+     *
+     * A request that does not specify a ledger or asks for the validated ledger is pinned to the latest ledger.
+     *
+     * @param method The method of the request
+     * @param params The parameters of the request
+     * @param apiVersion The API version of the request
+     * @param latestSeq The sequence of the latest ledger
+     * @return The key if the request can be coalesced; nullopt otherwise
+     */
+    std::optional<std::string>
+    makeKey(
+        std::string const& method,
+        boost::json::object const& params,
+        std::uint32_t apiVersion,
+        std::uint32_t latestSeq
+    ) const;
+
+    /**
+     * @brief Execute a request unless an identical request is being executed already.
+     *
+     * @tparam FnType The type of the function executing the request
+     * @param method The method of the request
+     * @param key The key of the request as returned by @ref makeKey
+     * @param yield The coroutine context
+     * @param fn The function executing the request
+     * @return The result of the request or of the identical request that was executing
+     */
+    template <typename FnType>
+    Result
+    run(std::string const& method, std::string const& key, boost::asio::yield_context yield, FnType&& fn)
+    {
+        std::shared_ptr<Flight> flight;
+        bool isLeader = false;
+        {
+            std::scoped_lock const lck{mtx_};
+            auto [it, inserted] = flights_.try_emplace(key);
+            if (inserted)
+                it->second = std::make_shared<Flight>();
+
+            flight = it->second;
+            isLeader = inserted;
+        }
+
+        if (isLeader)
+            return lead(key, flight, std::forward<FnType>(fn));
+
+        onCoalesced(method);
+        return wait(flight, yield);
+    }
+
+private:
+    template <typename FnType>
+    Result
+    lead(std::string const& key, std::shared_ptr<Flight> const& flight, FnType&& fn)
+    {
+        try {
+            auto result = fn();
+            finish(key, flight, result);
+            return result;
+        } catch (...) {
+            finish(key, flight, Result{Status{RippledError::rpcINTERNAL}});
+            throw;
+        }
+    }
+
+    void
+    finish(std::string const& key, std::shared_ptr<Flight> const& flight, Result const& result);
+
+    static Result
+    wait(std::shared_ptr<Flight> const& flight, boost::asio::yield_context yield);
+
+    static void
+    onCoalesced(std::string const& method);
+};
+
+}  // namespace rpc
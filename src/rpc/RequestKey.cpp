@@ -0,0 +1,127 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "rpc/RequestKey.hpp"
+
+#include "rpc/JS.hpp"
+
+#include <boost/json/object.hpp>
+#include <boost/json/serialize.hpp>
+#include <boost/json/value.hpp>
+#include <fmt/core.h>
+#include <xrpl/protocol/jss.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace rpc {
+
+namespace {
+
+// serializes the value with the keys of all objects sorted so that equal requests produce equal strings
+void
+appendNormalized(std::string& out, boost::json::value const& value)
+{
+    if (not value.is_object()) {
+        if (value.is_array()) {
+            out += '[';
+            for (auto const& item : value.as_array()) {
+                appendNormalized(out, item);
+                out += ',';
+            }
+            out += ']';
+        } else {
+            out += boost::json::serialize(value);
+        }
+        return;
+    }
+
+    auto const& obj = value.as_object();
+    std::vector<boost::json::key_value_pair const*> members;
+    members.reserve(obj.size());
+    for (auto const& member : obj)
+        members.push_back(&member);
+
+    std::ranges::sort(members, {}, [](auto const* member) { return member->key(); });
+
+    out += '{';
+    for (auto const* member : members) {
+        out += boost::json::serialize(boost::json::value{member->key()});
+        out += ':';
+        appendNormalized(out, member->value());
+        out += ',';
+    }
+    out += '}';
+}
+
+bool
+asksForLatestLedger(boost::json::object const& params)
+{
+    if (params.contains(JS(ledger_hash)))
+        return false;
+
+    if (not params.contains(JS(ledger_index)))
+        return true;
+
+    auto const& index = params.at(JS(ledger_index));
+    return index.is_string() and index.as_string() == "validated";
+}
+
+}  // namespace
+
+std::optional<RequestKey>
+makeRequestKey(
+    std::string const& method,
+    boost::json::object const& params,
+    std::uint32_t apiVersion,
+    std::uint32_t latestSeq
+)
+{
+    auto const isLatestLedger = asksForLatestLedger(params);
+
+    if (not isLatestLedger and not params.contains(JS(ledger_hash))) {
+        if (auto const& index = params.at(JS(ledger_index)); index.is_string()) {
+            auto const& str = index.as_string();
+            auto const isNumber =
+                not str.empty() and std::ranges::all_of(str, [](char c) { return c >= '0' and c <= '9'; });
+            if (not isNumber)
+                return std::nullopt;
+        } else if (not index.is_uint64() and not index.is_int64()) {
+            return std::nullopt;
+        }
+    }
+
+    RequestKey result{.key = fmt::format("{}|{}|", method, apiVersion), .isLatestLedger = isLatestLedger};
+    appendNormalized(result.key, pinToLatestLedger(params, latestSeq));
+    return result;
+}
+
+boost::json::object
+pinToLatestLedger(boost::json::object params, std::uint32_t latestSeq)
+{
+    if (asksForLatestLedger(params))
+        params[JS(ledger_index)] = latestSeq;
+
+    return params;
+}
+
+}  // namespace rpc
@@ -0,0 +1,73 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include <boost/json/object.hpp>
+
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace rpc {
+
+/**
+ * @brief Identifies requests that produce the same response.
+ */
+struct RequestKey {
+    std::string key;
+    bool isLatestLedger = false; /**< the request asked for the latest ledger rather than a specific one */
+};
+
+/**
+ * @brief Build the key identifying a request that is pinned to a ledger.
+ *
+ * The key is built from the method, the API version and the parameters serialized with sorted keys. A request that
+ * does not specify a ledger or asks for the validated ledger is pinned to the latest ledger, which is made explicit in
+ * the key.
+ *
+ * @param method The method of the request
+ * @param params The parameters of the request
+ * @param apiVersion The API version of the request
+ * @param latestSeq The sequence of the latest ledger
+ * @return The key if the request is pinned to a ledger; nullopt otherwise
+ */
+std::optional<RequestKey>
+makeRequestKey(
+    std::string const& method,
+    boost::json::object const& params,
+    std::uint32_t apiVersion,
+    std::uint32_t latestSeq
+);
+
+/**
+ * @brief Pin a request that does not specify a ledger or asks for the validated ledger to the latest ledger.
+ *
+ * Requests sharing a key built by @ref makeRequestKey must be executed with these parameters if their method takes
+ * ledger_index, so that a ledger published after the key was built can't end up in the response shared under the key.
+ *
+ * @param params The parameters of the request
+ * @param latestSeq The sequence of the latest ledger
+ * @return The parameters with ledger_index set to latestSeq if the request asks for the latest ledger; the parameters
+ * unchanged otherwise
+ */
+boost::json::object
+pinToLatestLedger(boost::json::object params, std::uint32_t latestSeq);
+
+}  // namespace rpc
@@ -19,21 +19,51 @@
 
 #include "rpc/WorkQueue.hpp"
 
+#include "rpc/ConcurrencyLimiter.hpp"
+#include "util/Assert.hpp"
 #include "util/config/Config.hpp"
 #include "util/log/Logger.hpp"
 #include "util/prometheus/Label.hpp"
 #include "util/prometheus/Prometheus.hpp"
 
+#include <boost/asio/post.hpp>
+#include <boost/asio/spawn.hpp>
 #include <boost/json/object.hpp>
 
+#include <algorithm>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <functional>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <string>
 #include <thread>
 #include <utility>
+#include <vector>
 
 namespace rpc {
 
+namespace {
+
+std::vector<std::int64_t> const WAIT_DURATION_BUCKETS_US{
+    100, 1'000, 10'000, 100'000, 1'000'000, 10'000'000
+};
+
+util::prometheus::HistogramInt&
+waitDurationHistogram(std::string lane)
+{
+    return PrometheusService::histogramInt(
+        "work_queue_wait_duration_microseconds_histogram",
+        util::prometheus::Labels({util::prometheus::Label{"lane", std::move(lane)}}),
+        WAIT_DURATION_BUCKETS_US,
+        "The time tasks were waiting in the queue before being executed"
+    );
+}
+
+}  // namespace
+
 void
 WorkQueue::OneTimeCallable::setCallable(std::function<void()> func)
 {
@@ -53,26 +83,45 @@ WorkQueue::OneTimeCallable::operator bool() const
     return func_.operator bool();
 }
 
-WorkQueue::WorkQueue(std::uint32_t numWorkers, uint32_t maxSize)
+WorkQueue::WorkQueue(
+    std::uint32_t numWorkers,
+    uint32_t maxSize,
+    std::uint32_t maxRunning,
+    std::chrono::milliseconds maxQueueWait,
+    bool adaptiveLimit
+)
     : queued_{PrometheusService::counterInt(
           "work_queue_queued_total_number",
           util::prometheus::Labels(),
           "The total number of tasks queued for processing"
       )}
-    , durationUs_{PrometheusService::counterInt(
-          "work_queue_cumulitive_tasks_duration_us",
+    , expired_{PrometheusService::counterInt(
+          "work_queue_expired_total_number",
           util::prometheus::Labels(),
-          "The total number of microseconds tasks were waiting to be executed"
+          "The total number of tasks dropped because they were waiting in the queue for too long"
       )}
+    , waitDurationUs_{
+          waitDurationHistogram("privileged"), waitDurationHistogram("cheap"), waitDurationHistogram("expensive")
+      }
     , curSize_{PrometheusService::gaugeInt(
           "work_queue_current_size",
           util::prometheus::Labels(),
           "The current number of tasks in the queue"
       )}
+    , runningLimit_{PrometheusService::gaugeInt(
+          "work_queue_running_limit",
+          util::prometheus::Labels(),
+          "The current maximum number of tasks running at once"
+      )}
+    , maxRunning_{maxRunning != 0 ? maxRunning : numWorkers * DEFAULT_MAX_RUNNING_PER_WORKER}
+    , maxQueueWait_{maxQueueWait}
+    , limiter_{adaptiveLimit ? std::make_unique<ConcurrencyLimiter>(numWorkers, maxRunning_) : nullptr}
     , ioc_{numWorkers}
 {
     if (maxSize != 0)
         maxSize_ = maxSize;
+
+    runningLimit_.get().set(static_cast<std::int64_t>(runningLimit()));
 }
 
 WorkQueue::~WorkQueue()
@@ -98,9 +147,16 @@ WorkQueue::make_WorkQueue(util::Config const& config)
     auto const serverConfig = config.section("server");
     auto const numThreads = config.valueOr<uint32_t>("workers", std::thread::hardware_concurrency());
     auto const maxQueueSize = serverConfig.valueOr<uint32_t>("max_queue_size", 0);  // 0 is no limit
+    auto const maxRunning = serverConfig.valueOr<uint32_t>("max_running_requests", 0);
+    auto const maxQueueWait = std::chrono::milliseconds{
+        serverConfig.valueOr<uint32_t>("max_queue_wait_ms", DEFAULT_MAX_QUEUE_WAIT.count())
+    };
+    auto const adaptiveLimit = serverConfig.valueOr("adaptive_concurrency_limit", false);
 
-    LOG(log.info()) << "Number of workers = " << numThreads << ". Max queue size = " << maxQueueSize;
-    return WorkQueue{numThreads, maxQueueSize};
+    LOG(log.info()) << "Number of workers = " << numThreads << ". Max queue size = " << maxQueueSize
+                    << ". Max running requests = " << maxRunning << ". Max queue wait = " << maxQueueWait.count()
+                    << " ms. Adaptive concurrency limit = " << adaptiveLimit;
+    return WorkQueue{numThreads, maxQueueSize, maxRunning, maxQueueWait, adaptiveLimit};
 }
 
 boost::json::object
@@ -109,9 +165,12 @@ WorkQueue::report() const
     auto obj = boost::json::object{};
 
     obj["queued"] = queued_.get().value();
-    obj["queued_duration_us"] = durationUs_.get().value();
+    obj["queued_duration_us"] = totalWaitDurationUs_.load();
+    obj["expired"] = expired_.get().value();
     obj["current_queue_size"] = curSize_.get().value();
     obj["max_queue_size"] = maxSize_;
+    obj["running"] = state_.lock()->running;
+    obj["max_running"] = runningLimit();
 
     return obj;
 }
@@ -128,4 +187,167 @@ WorkQueue::size() const
     return curSize_.get().value();
 }
 
+std::uint32_t
+WorkQueue::capacity() const
+{
+    // an explicit max_queue_size is honoured as is; otherwise the queue is capped only while the limiter backs off
+    if (not limiter_ or maxSize_ != std::numeric_limits<std::uint32_t>::max())
+        return maxSize_;
+
+    auto const limit = limiter_->limit();
+    if (limit >= maxRunning_)
+        return maxSize_;
+
+    return static_cast<std::uint32_t>(
+        std::min<std::size_t>(ADAPTIVE_CAPACITY_FACTOR * limit, std::numeric_limits<std::uint32_t>::max())
+    );
+}
+
+std::size_t
+WorkQueue::runningLimit() const
+{
+    return limiter_ ? limiter_->limit() : maxRunning_;
+}
+
+void
+WorkQueue::enqueue(Job job, std::string client)
+{
+    std::vector<Job> toStart;
+    std::vector<Job> expired;
+
+    {
+        auto state = state_.lock();
+        if (job.lane == Lane::Privileged) {
+            ++state->running;
+            toStart.push_back(std::move(job));
+        } else {
+            auto& lane = state->lanes[laneIndex(job.lane)];
+            auto& jobs = lane.jobsByClient[client];
+            if (jobs.empty())
+                lane.turns.push_back(std::move(client));
+            jobs.push_back(std::move(job));
+        }
+
+        pickJobs(*state, toStart, expired);
+    }
+
+    for (auto& expiredJob : expired)
+        expire(std::move(expiredJob));
+    for (auto& jobToStart : toStart)
+        start(std::move(jobToStart));
+}
+
+void
+WorkQueue::pickJobs(State& state, std::vector<Job>& toStart, std::vector<Job>& expired) const
+{
+    auto const now = std::chrono::steady_clock::now();
+
+    auto const popFrom = [&state](Lane laneType) {
+        auto& lane = state.lanes[laneIndex(laneType)];
+        auto client = std::move(lane.turns.front());
+        lane.turns.pop_front();
+
+        auto const it = lane.jobsByClient.find(client);
+        auto job = std::move(it->second.front());
+        it->second.pop_front();
+
+        if (it->second.empty()) {
+            lane.jobsByClient.erase(it);
+        } else {
+            lane.turns.push_back(std::move(client));
+        }
+        return job;
+    };
+
+    auto const hasJobs = [&state](Lane laneType) { return not state.lanes[laneIndex(laneType)].turns.empty(); };
+
+    auto const limit = runningLimit();
+    while (state.running < limit and (hasJobs(Lane::Cheap) or hasJobs(Lane::Expensive))) {
+        auto const takeCheap = hasJobs(Lane::Cheap) and
+            (not hasJobs(Lane::Expensive) or state.cheapInARow < CHEAP_JOBS_PER_EXPENSIVE_JOB);
+        state.cheapInARow = takeCheap ? state.cheapInARow + 1 : 0;
+
+        auto job = popFrom(takeCheap ? Lane::Cheap : Lane::Expensive);
+        if (maxQueueWait_.count() != 0 and now - job.queuedAt > maxQueueWait_) {
+            expired.push_back(std::move(job));
+            continue;
+        }
+
+        ++state.running;
+        toStart.push_back(std::move(job));
+    }
+}
+
+void
+WorkQueue::start(Job job)
+{
+    boost::asio::spawn(ioc_, [this, job = std::move(job)](auto yield) mutable {
+        auto const wait =
+            std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - job.queuedAt)
+                .count();
+
+        ++queued_.get();
+        waitDurationUs_[laneIndex(job.lane)].get().observe(wait);
+        totalWaitDurationUs_ += wait;
+        LOG(log_.info()) << "WorkQueue wait time = " << wait << " queue size = " << curSize_.get().value();
+
+        auto const started = std::chrono::steady_clock::now();
+        job.func(yield);
+        auto const runtime =
+            std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - started);
+
+        std::vector<Job> toStart;
+        std::vector<Job> expired;
+        {
+            auto state = state_.lock();
+            if (limiter_) {
+                auto const oldLimit = limiter_->limit();
+                limiter_->onSample(runtime, state->running);
+                if (auto const newLimit = limiter_->limit(); newLimit != oldLimit)
+                    runningLimit_.get().set(static_cast<std::int64_t>(newLimit));
+            }
+
+            --state->running;
+            pickJobs(*state, toStart, expired);
+        }
+
+        for (auto& expiredJob : expired)
+            expire(std::move(expiredJob));
+        for (auto& jobToStart : toStart)
+            start(std::move(jobToStart));
+
+        onJobDone();
+    });
+}
+
+void
+WorkQueue::expire(Job job)
+{
+    ++expired_.get();
+    LOG(log_.warn()) << "Dropping job which was waiting in the queue for too long";
+
+    boost::asio::post(ioc_, [this, onExpired = std::move(job.onExpired)]() {
+        if (onExpired)
+            onExpired();
+        onJobDone();
+    });
+}
+
+void
+WorkQueue::onJobDone()
+{
+    --curSize_.get();
+    if (curSize_.get().value() == 0 && stopping_) {
+        auto onTasksComplete = onQueueEmpty_.lock();
+        ASSERT(onTasksComplete->operator bool(), "onTasksComplete must be set when stopping is true.");
+        onTasksComplete->operator()();
+    }
+}
+
+std::size_t
+WorkQueue::laneIndex(Lane lane)
+{
+    return static_cast<std::size_t>(lane);
+}
+
 }  // namespace rpc
@@ -19,12 +19,13 @@
 
 #pragma once
 
-#include "util/Assert.hpp"
+#include "rpc/ConcurrencyLimiter.hpp"
 #include "util/Mutex.hpp"
 #include "util/config/Config.hpp"
 #include "util/log/Logger.hpp"
 #include "util/prometheus/Counter.hpp"
 #include "util/prometheus/Gauge.hpp"
+#include "util/prometheus/Histogram.hpp"
 
 #include <boost/asio.hpp>
 #include <boost/asio/spawn.hpp>
@@ -32,30 +33,95 @@
 #include <boost/json.hpp>
 #include <boost/json/object.hpp>
 
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <deque>
 #include <functional>
 #include <limits>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace rpc {
 
 /**
  * @brief An asynchronous, thread-safe queue for RPC requests.
+ *
+ * At most a limited number of jobs run at once; the rest wait in one of the lanes of the queue. Cheap jobs get several
+ * turns for every turn of expensive ones and within a lane the clients take turns so that a few clients queueing
+ * expensive requests can't starve everybody else. Privileged jobs (admin and whitelisted clients) start right away.
+ * Jobs which waited longer than the configured limit are dropped instead of being run.
+ *
+ * The number of running jobs can be adapted to the latency of the jobs. If no maximum size of the queue is configured,
+ * jobs are rejected as soon as twice as many jobs as are allowed to run are in the queue while the limit is lowered
+ * below its maximum, so that clients learn the server is too busy early. A healthy server is not capped.
  */
 class WorkQueue {
+public:
+    /** @brief The lane a job waits in */
+    enum class Lane : std::uint8_t { Privileged, Cheap, Expensive };
+
+    /** @brief Describes how a job is scheduled */
+    struct JobInfo {
+        Lane lane = Lane::Cheap;              /**< The lane to queue the job in */
+        std::string client = {};              /**< Jobs of the same client wait for their turn behind each other */
+        std::function<void()> onExpired = {}; /**< Called instead of the job if it waited for too long */
+    };
+
+    /** @brief Default number of running jobs per worker thread */
+    static constexpr std::uint32_t DEFAULT_MAX_RUNNING_PER_WORKER = 32;
+
+    /** @brief Default time a job may wait in the queue before it is dropped */
+    static constexpr std::chrono::milliseconds DEFAULT_MAX_QUEUE_WAIT{10'000};
+
+private:
+    static constexpr std::size_t NUM_LANES = 3;
+    static constexpr std::size_t CHEAP_JOBS_PER_EXPENSIVE_JOB = 4;
+    static constexpr std::size_t ADAPTIVE_CAPACITY_FACTOR = 2;
+
+    struct Job {
+        std::function<void(boost::asio::yield_context)> func;
+        std::function<void()> onExpired;
+        std::chrono::steady_clock::time_point queuedAt;
+        Lane lane;
+    };
+
+    // the jobs waiting in one lane; clients take turns in the order they queued their first waiting job
+    struct LaneQueue {
+        std::unordered_map<std::string, std::deque<Job>> jobsByClient;
+        std::deque<std::string> turns;
+    };
+
+    struct State {
+        std::array<LaneQueue, NUM_LANES> lanes;
+        std::size_t running = 0;
+        std::size_t cheapInARow = 0;
+    };
+
     // these are cumulative for the lifetime of the process
     std::reference_wrapper<util::prometheus::CounterInt> queued_;
-    std::reference_wrapper<util::prometheus::CounterInt> durationUs_;
+    std::reference_wrapper<util::prometheus::CounterInt> expired_;
+    std::array<std::reference_wrapper<util::prometheus::HistogramInt>, NUM_LANES> waitDurationUs_;
+    std::atomic_uint64_t totalWaitDurationUs_ = 0;
 
     std::reference_wrapper<util::prometheus::GaugeInt> curSize_;
+    std::reference_wrapper<util::prometheus::GaugeInt> runningLimit_;
     uint32_t maxSize_ = std::numeric_limits<uint32_t>::max();
+    std::size_t maxRunning_;
+    std::chrono::milliseconds maxQueueWait_;
+    std::unique_ptr<ConcurrencyLimiter> limiter_;
 
     util::Logger log_{"RPC"};
     boost::asio::thread_pool ioc_;
 
     std::atomic_bool stopping_;
+    util::Mutex<State> state_;
 
     class OneTimeCallable {
         std::function<void()> func_;
@@ -78,8 +144,19 @@ public:
      *
      * @param numWorkers The amount of threads to spawn in the pool
      * @param maxSize The maximum capacity of the queue; 0 means unlimited
+     * @param maxRunning The maximum number of jobs running at once; 0 means @ref DEFAULT_MAX_RUNNING_PER_WORKER per
+     * worker
+     * @param maxQueueWait The time a job may wait before it is dropped; 0 means jobs are never dropped
+     * @param adaptiveLimit Whether to adapt the number of running jobs between numWorkers and maxRunning to the latency
+     * of the jobs
      */
-    WorkQueue(std::uint32_t numWorkers, uint32_t maxSize = 0);
+    WorkQueue(
+        std::uint32_t numWorkers,
+        uint32_t maxSize = 0,
+        std::uint32_t maxRunning = 0,
+        std::chrono::milliseconds maxQueueWait = std::chrono::milliseconds{0},
+        bool adaptiveLimit = false
+    );
     ~WorkQueue();
 
     /**
@@ -112,40 +189,45 @@ public:
     template <typename FnType>
     bool
     postCoro(FnType&& func, bool isWhiteListed)
+    {
+        return postCoro(std::forward<FnType>(func), JobInfo{.lane = isWhiteListed ? Lane::Privileged : Lane::Cheap});
+    }
+
+    /**
+     * @brief Submit a job to the work queue.
+     *
+     * The job will be rejected if it is not privileged and the current size of the queue reached capacity.
+     *
+     * @tparam FnType The function object type
+     * @param func The function object to queue as a job
+     * @param info How to schedule the job
+     * @return true if the job was successfully queued; false otherwise
+     */
+    template <typename FnType>
+    bool
+    postCoro(FnType&& func, JobInfo info)
     {
         if (stopping_) {
             LOG(log_.warn()) << "Queue is stopping, rejecting incoming task.";
             return false;
         }
 
-        if (curSize_.get().value() >= maxSize_ && !isWhiteListed) {
+        if (info.lane != Lane::Privileged && curSize_.get().value() >= capacity()) {
             LOG(log_.warn()) << "Queue is full. rejecting job. current size = " << curSize_.get().value()
-                             << "; max size = " << maxSize_;
+                             << "; max size = " << capacity();
             return false;
         }
 
         ++curSize_.get();
 
-        // Each time we enqueue a job, we want to post a symmetrical job that will dequeue and run the job at the front
-        // of the job queue.
-        boost::asio::spawn(
-            ioc_,
-            [this, func = std::forward<FnType>(func), start = std::chrono::system_clock::now()](auto yield) mutable {
-                auto const run = std::chrono::system_clock::now();
-                auto const wait = std::chrono::duration_cast<std::chrono::microseconds>(run - start).count();
-
-                ++queued_.get();
-                durationUs_.get() += wait;
-                LOG(log_.info()) << "WorkQueue wait time = " << wait << " queue size = " << curSize_.get().value();
-
-                func(yield);
-                --curSize_.get();
-                if (curSize_.get().value() == 0 && stopping_) {
-                    auto onTasksComplete = onQueueEmpty_.lock();
-                    ASSERT(onTasksComplete->operator bool(), "onTasksComplete must be set when stopping is true.");
-                    onTasksComplete->operator()();
-                }
-            }
+        // std::function needs a copyable target
+        auto shared = std::make_shared<std::decay_t<FnType>>(std::forward<FnType>(func));
+        enqueue(
+            Job{.func = [shared](boost::asio::yield_context yield) { (*shared)(yield); },
+                .onExpired = std::move(info.onExpired),
+                .queuedAt = std::chrono::steady_clock::now(),
+                .lane = info.lane},
+            std::move(info.client)
         );
 
         return true;
@@ -168,10 +250,36 @@ public:
     /**
      * @brief Get the size of the queue.
      *
-     * @return The numver of jobs in the queue.
+     * @return The numver of jobs in the queue including the running ones.
      */
     size_t
     size() const;
+
+private:
+    std::uint32_t
+    capacity() const;
+
+    std::size_t
+    runningLimit() const;
+
+    void
+    enqueue(Job job, std::string client);
+
+    // picks the jobs to start now; expired jobs are moved to the second vector
+    void
+    pickJobs(State& state, std::vector<Job>& toStart, std::vector<Job>& expired) const;
+
+    void
+    start(Job job);
+
+    void
+    expire(Job job);
+
+    void
+    onJobDone();
+
+    static std::size_t
+    laneIndex(Lane lane);
 };
 
 }  // namespace rpc
@@ -20,12 +20,15 @@
 #pragma once
 
 #include "rpc/common/Concepts.hpp"
+#include "rpc/common/Specs.hpp"
 #include "rpc/common/Types.hpp"
 #include "rpc/common/impl/Processors.hpp"
 
 #include <boost/json/value.hpp>
 
+#include <cstdint>
 #include <memory>
+#include <string_view>
 
 namespace rpc {
 
@@ -83,6 +86,19 @@ public:
         return pimpl_->process(value, ctx);
     }
 
+    /**
+     * @brief Check whether the stored handler takes a field.
+     *
+     * @param key The key of the field
+     * @param apiVersion The API version of the request
+     * @return true if the spec of the handler for the API version has the field; false otherwise
+     */
+    [[nodiscard]] bool
+    acceptsField(std::string_view key, std::uint32_t apiVersion) const
+    {
+        return pimpl_->acceptsField(key, apiVersion);
+    }
+
 private:
     struct Concept {
         virtual ~Concept() = default;
@@ -90,6 +106,9 @@ private:
         [[nodiscard]] virtual ReturnType
         process(boost::json::value const& value, Context const& ctx) const = 0;
 
+        [[nodiscard]] virtual bool
+        acceptsField(std::string_view key, std::uint32_t apiVersion) const = 0;
+
         [[nodiscard]] virtual std::unique_ptr<Concept>
         clone() const = 0;
     };
@@ -109,6 +128,16 @@ private:
             return processor(handler, value, ctx);
         }
 
+        [[nodiscard]] bool
+        acceptsField(std::string_view key, std::uint32_t apiVersion) const override
+        {
+            if constexpr (SomeHandlerWithInput<HandlerType>) {
+                return handler.spec(apiVersion).hasField(key);
+            } else {
+                return false;
+            }
+        }
+
         [[nodiscard]] std::unique_ptr<Concept>
         clone() const override
         {
@@ -59,6 +59,15 @@ public:
      */
     virtual bool
     isClioOnly(std::string const& command) const = 0;
+
+    /**
+     * @brief Check if a given method is expensive to handle, e.g. scans many ledger objects or transactions
+     *
+     * @param command The method to check
+     * @return true if the method is expensive, false otherwise
+     */
+    virtual bool
+    isExpensive(std::string const& command) const = 0;
 };
 
 }  // namespace rpc
@@ -26,7 +26,9 @@
 #include <boost/json/array.hpp>
 #include <boost/json/value.hpp>
 
+#include <algorithm>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -45,6 +47,12 @@ FieldSpec::check(boost::json::value const& value) const
     return checker_(value);
 }
 
+[[nodiscard]] std::string const&
+FieldSpec::key() const
+{
+    return key_;
+}
+
 [[nodiscard]] MaybeError
 RpcSpec::process(boost::json::value& value) const
 {
@@ -79,4 +87,10 @@ RpcSpec::check(boost::json::value const& value) const
     return result;
 }
 
+[[nodiscard]] bool
+RpcSpec::hasField(std::string_view key) const
+{
+    return std::ranges::any_of(fields_, [key](FieldSpec const& field) { return field.key() == key; });
+}
+
 }  // namespace rpc
@@ -29,6 +29,7 @@
 
 #include <initializer_list>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -47,7 +48,8 @@ struct FieldSpec final {
      */
     template <SomeProcessor... Processors>
     FieldSpec(std::string const& key, Processors&&... processors)
-        : processor_{impl::makeFieldProcessor<Processors...>(key, std::forward<Processors>(processors)...)}
+        : key_{key}
+        , processor_{impl::makeFieldProcessor<Processors...>(key, std::forward<Processors>(processors)...)}
         , checker_{impl::EMPTY_FIELD_CHECKER}
     {
     }
@@ -61,7 +63,8 @@ struct FieldSpec final {
      */
     template <SomeCheck... Checks>
     FieldSpec(std::string const& key, Checks&&... checks)
-        : processor_{impl::EMPTY_FIELD_PROCESSOR}
+        : key_{key}
+        , processor_{impl::EMPTY_FIELD_PROCESSOR}
         , checker_{impl::makeFieldChecker<Checks...>(key, std::forward<Checks>(checks)...)}
     {
     }
@@ -84,7 +87,14 @@ struct FieldSpec final {
     [[nodiscard]] check::Warnings
     check(boost::json::value const& value) const;
 
+    /**
+     * @return The key in a JSON object that the field validates
+     */
+    [[nodiscard]] std::string const&
+    key() const;
+
 private:
+    std::string key_;
     impl::FieldSpecProcessor processor_;
     impl::FieldChecker checker_;
 };
@@ -135,6 +145,15 @@ struct RpcSpec final {
     [[nodiscard]] boost::json::array
     check(boost::json::value const& value) const;
 
+    /**
+     * @brief Check whether the specification has a field with the given key.
+     *
+     * @param key The key of the field
+     * @return true if any of the field specs validates the key; false otherwise
+     */
+    [[nodiscard]] bool
+    hasField(std::string_view key) const;
+
 private:
     std::vector<FieldSpec> fields_;
 };
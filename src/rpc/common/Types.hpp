@@ -160,8 +160,19 @@ struct Result {
     {
     }
 
+    /**
+     * @brief Construct a new Result object from an already serialized response object
+     *
+     * @param serializedResponse The serialized response to construct the result from
+     */
+    explicit Result(std::shared_ptr<std::string const> serializedResponse)
+        : response{boost::json::object{}}, serializedResponse{std::move(serializedResponse)}
+    {
+    }
+
     std::variant<Status, boost::json::object> response;
     boost::json::array warnings;
+    std::shared_ptr<std::string const> serializedResponse;  // if set, used instead of the response object
 };
 
 /**
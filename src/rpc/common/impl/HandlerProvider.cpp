@@ -77,32 +77,32 @@ ProductionHandlerProvider::ProductionHandlerProvider(
     Counters const& counters
 )
     : handlerMap_{
-          {"account_channels", {AccountChannelsHandler{backend}}},
+          {"account_channels", {AccountChannelsHandler{backend}, false, true}},  // expensive
           {"account_currencies", {AccountCurrenciesHandler{backend}}},
           {"account_info", {AccountInfoHandler{backend, amendmentCenter}}},
-          {"account_lines", {AccountLinesHandler{backend}}},
-          {"account_nfts", {AccountNFTsHandler{backend}}},
-          {"account_objects", {AccountObjectsHandler{backend}}},
-          {"account_offers", {AccountOffersHandler{backend}}},
-          {"account_tx", {AccountTxHandler{backend}}},
+          {"account_lines", {AccountLinesHandler{backend}, false, true}},      // expensive
+          {"account_nfts", {AccountNFTsHandler{backend}, false, true}},        // expensive
+          {"account_objects", {AccountObjectsHandler{backend}, false, true}},  // expensive
+          {"account_offers", {AccountOffersHandler{backend}, false, true}},    // expensive
+          {"account_tx", {AccountTxHandler{backend}, false, true}},            // expensive
           {"amm_info", {AMMInfoHandler{backend}}},
-          {"book_changes", {BookChangesHandler{backend}}},
-          {"book_offers", {BookOffersHandler{backend}}},
+          {"book_changes", {BookChangesHandler{backend}, false, true}},  // expensive
+          {"book_offers", {BookOffersHandler{backend}, false, true}},    // expensive
           {"deposit_authorized", {DepositAuthorizedHandler{backend}}},
           {"feature", {FeatureHandler{backend, amendmentCenter}}},
-          {"gateway_balances", {GatewayBalancesHandler{backend}}},
+          {"gateway_balances", {GatewayBalancesHandler{backend}, false, true}},  // expensive
           {"get_aggregate_price", {GetAggregatePriceHandler{backend}}},
-          {"ledger", {LedgerHandler{backend}}},
-          {"ledger_data", {LedgerDataHandler{backend}}},
+          {"ledger", {LedgerHandler{backend}, false, true}},           // expensive
+          {"ledger_data", {LedgerDataHandler{backend}, false, true}},  // expensive
           {"ledger_entry", {LedgerEntryHandler{backend}}},
           {"ledger_index", {LedgerIndexHandler{backend}, true}},  // clio only
           {"ledger_range", {LedgerRangeHandler{backend}}},
-          {"nfts_by_issuer", {NFTsByIssuerHandler{backend}, true}},  // clio only
-          {"nft_history", {NFTHistoryHandler{backend}, true}},       // clio only
+          {"nfts_by_issuer", {NFTsByIssuerHandler{backend}, true, true}},  // clio only, expensive
+          {"nft_history", {NFTHistoryHandler{backend}, true, true}},       // clio only, expensive
           {"nft_buy_offers", {NFTBuyOffersHandler{backend}}},
           {"nft_info", {NFTInfoHandler{backend}, true}},  // clio only
           {"nft_sell_offers", {NFTSellOffersHandler{backend}}},
-          {"noripple_check", {NoRippleCheckHandler{backend}}},
+          {"noripple_check", {NoRippleCheckHandler{backend}, false, true}},  // expensive
           {"ping", {PingHandler{}}},
           {"random", {RandomHandler{}}},
           {"server_info", {ServerInfoHandler{backend, subscriptionManager, balancer, etl, counters}}},
@@ -136,4 +136,10 @@ ProductionHandlerProvider::isClioOnly(std::string const& command) const
     return handlerMap_.contains(command) && handlerMap_.at(command).isClioOnly;
 }
 
+bool
+ProductionHandlerProvider::isExpensive(std::string const& command) const
+{
+    return handlerMap_.contains(command) && handlerMap_.at(command).isExpensive;
+}
+
 }  // namespace rpc::impl
@@ -46,6 +46,7 @@ class ProductionHandlerProvider final : public HandlerProvider {
     struct Handler {
         AnyHandler handler;
         bool isClioOnly = false;
+        bool isExpensive = false;
     };
 
     std::unordered_map<std::string, Handler> handlerMap_;
@@ -69,6 +70,9 @@ public:
 
     bool
     isClioOnly(std::string const& command) const override;
+
+    bool
+    isExpensive(std::string const& command) const override;
 };
 
 }  // namespace rpc::impl
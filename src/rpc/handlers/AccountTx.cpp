@@ -40,12 +40,14 @@
 #include <xrpl/protocol/LedgerHeader.h>
 #include <xrpl/protocol/jss.h>
 
+#include <cstddef>
 #include <cstdint>
 #include <limits>
 #include <optional>
 #include <string>
 #include <utility>
 #include <variant>
+#include <vector>
 
 namespace rpc {
 
@@ -131,6 +133,9 @@ AccountTxHandler::process(AccountTxHandler::Input input, Context const& ctx) con
     if (retCursor)
         response.marker = {retCursor->ledgerSequence, retCursor->transactionIndex};
 
+    // index of the transaction and sequence of the ledger whose hash and close time the transaction needs
+    std::vector<std::pair<std::size_t, std::uint32_t>> ledgerHeaderRequests;
+
     for (auto const& txnPlusMeta : blobs) {
         // over the range
         if ((txnPlusMeta.ledgerSequence < minIndex && !input.forward) ||
@@ -163,20 +168,16 @@ AccountTxHandler::process(AccountTxHandler::Input input, Context const& ctx) con
 
                 if (ctx.apiVersion < 2u) {
                     obj[txKey].as_object()[JS(inLedger)] = txnPlusMeta.ledgerSequence;
+                    obj[JS(validated)] = true;
                 } else {
                     obj[JS(ledger_index)] = txnPlusMeta.ledgerSequence;
                     if (obj[txKey].as_object().contains(JS(hash))) {
                         obj[JS(hash)] = obj[txKey].as_object()[JS(hash)];
                         obj[txKey].as_object().erase(JS(hash));
                     }
-                    if (auto const ledgerHeader =
-                            sharedPtrBackend_->fetchLedgerBySequence(txnPlusMeta.ledgerSequence, ctx.yield);
-                        ledgerHeader) {
-                        obj[JS(ledger_hash)] = ripple::strHex(ledgerHeader->hash);
-                        obj[JS(close_time_iso)] = ripple::to_string_iso(ledgerHeader->closeTime);
-                    }
+                    // the ledger fields and validated are added once all the headers are fetched, in the same order
+                    ledgerHeaderRequests.emplace_back(response.transactions.size(), txnPlusMeta.ledgerSequence);
                 }
-                obj[JS(validated)] = true;
                 response.transactions.push_back(std::move(obj));
                 continue;
             }
@@ -188,6 +189,23 @@ AccountTxHandler::process(AccountTxHandler::Input input, Context const& ctx) con
         response.transactions.push_back(std::move(obj));
     }
 
+    if (not ledgerHeaderRequests.empty()) {
+        std::vector<std::uint32_t> sequences;
+        sequences.reserve(ledgerHeaderRequests.size());
+        for (auto const& [_, seq] : ledgerHeaderRequests)
+            sequences.push_back(seq);
+
+        auto const ledgerHeaders = sharedPtrBackend_->fetchLedgerHeaders(sequences, ctx.yield);
+        for (std::size_t i = 0; i < ledgerHeaderRequests.size(); ++i) {
+            auto& obj = response.transactions[ledgerHeaderRequests[i].first].as_object();
+            if (auto const& ledgerHeader = ledgerHeaders[i]; ledgerHeader) {
+                obj[JS(ledger_hash)] = ripple::strHex(ledgerHeader->hash);
+                obj[JS(close_time_iso)] = ripple::to_string_iso(ledgerHeader->closeTime);
+            }
+            obj[JS(validated)] = true;
+        }
+    }
+
     response.limit = input.limit;
     response.account = ripple::to_string(*accountID);
     response.ledgerIndexMin = minIndex;
@@ -38,12 +38,14 @@
 #include <xrpl/protocol/LedgerHeader.h>
 #include <xrpl/protocol/jss.h>
 
+#include <cstddef>
 #include <cstdint>
 #include <limits>
 #include <optional>
 #include <string>
 #include <utility>
 #include <variant>
+#include <vector>
 
 namespace rpc {
 
@@ -114,6 +116,9 @@ NFTHistoryHandler::process(NFTHistoryHandler::Input input, Context const& ctx) c
     if (retCursor)
         response.marker = {retCursor->ledgerSequence, retCursor->transactionIndex};
 
+    // index of the transaction and sequence of the ledger whose hash and close time the transaction needs
+    std::vector<std::pair<std::size_t, std::uint32_t>> ledgerHeaderRequests;
+
     for (auto const& txnPlusMeta : blobs) {
         // over the range
         if ((txnPlusMeta.ledgerSequence < minIndex && !input.forward) ||
@@ -141,12 +146,10 @@ NFTHistoryHandler::process(NFTHistoryHandler::Input input, Context const& ctx) c
                     obj[JS(hash)] = obj[txKey].at(JS(hash));
                     obj[txKey].as_object().erase(JS(hash));
                 }
-                if (auto const lgrInfo =
-                        sharedPtrBackend_->fetchLedgerBySequence(txnPlusMeta.ledgerSequence, ctx.yield);
-                    lgrInfo) {
-                    obj[JS(close_time_iso)] = ripple::to_string_iso(lgrInfo->closeTime);
-                    obj[JS(ledger_hash)] = ripple::strHex(lgrInfo->hash);
-                }
+                // the ledger fields and validated are added once all the headers are fetched, in the same order
+                ledgerHeaderRequests.emplace_back(response.transactions.size(), txnPlusMeta.ledgerSequence);
+                response.transactions.push_back(obj);
+                continue;
             }
         } else {
             obj = toJsonWithBinaryTx(txnPlusMeta, ctx.apiVersion);
@@ -158,6 +161,23 @@ NFTHistoryHandler::process(NFTHistoryHandler::Input input, Context const& ctx) c
         response.transactions.push_back(obj);
     }
 
+    if (not ledgerHeaderRequests.empty()) {
+        std::vector<std::uint32_t> sequences;
+        sequences.reserve(ledgerHeaderRequests.size());
+        for (auto const& [_, seq] : ledgerHeaderRequests)
+            sequences.push_back(seq);
+
+        auto const ledgerHeaders = sharedPtrBackend_->fetchLedgerHeaders(sequences, ctx.yield);
+        for (std::size_t i = 0; i < ledgerHeaderRequests.size(); ++i) {
+            auto& obj = response.transactions[ledgerHeaderRequests[i].first].as_object();
+            if (auto const& ledgerHeader = ledgerHeaders[i]; ledgerHeader) {
+                obj[JS(close_time_iso)] = ripple::to_string_iso(ledgerHeader->closeTime);
+                obj[JS(ledger_hash)] = ripple::strHex(ledgerHeader->hash);
+            }
+            obj[JS(validated)] = true;
+        }
+    }
+
     response.limit = input.limit;
     response.nftID = ripple::to_string(tokenID);
     response.ledgerIndexMin = minIndex;
@@ -0,0 +1,71 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "util/File.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <expected>
+#include <filesystem>
+#include <string>
+#include <system_error>
+
+namespace util {
+
+namespace {
+
+// flushes the file or directory at the given path to disk
+std::expected<void, std::string>
+syncToDisk(std::filesystem::path const& path, int flags)
+{
+    auto const fd = ::open(path.c_str(), flags | O_CLOEXEC);
+    if (fd < 0)
+        return std::unexpected{"Can't open " + path.string() + ": " + std::strerror(errno)};
+
+    auto const res = ::fsync(fd);
+    auto const error = errno;
+    ::close(fd);
+    if (res != 0)
+        return std::unexpected{"Can't sync " + path.string() + ": " + std::strerror(error)};
+
+    return {};
+}
+
+}  // namespace
+
+std::expected<void, std::string>
+replaceFileDurably(std::filesystem::path const& from, std::filesystem::path const& to)
+{
+    // the data must be on disk before the rename is, otherwise a crash could leave an incomplete file behind
+    if (auto const res = syncToDisk(from, O_WRONLY); not res.has_value())
+        return res;
+
+    std::error_code ec;
+    std::filesystem::rename(from, to, ec);
+    if (ec)
+        return std::unexpected{"Failed to move " + from.string() + " to " + to.string() + ": " + ec.message()};
+
+    auto const dir = to.has_parent_path() ? to.parent_path() : std::filesystem::path{"."};
+    return syncToDisk(dir, O_RDONLY | O_DIRECTORY);
+}
+
+}  // namespace util
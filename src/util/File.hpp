@@ -0,0 +1,41 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include <expected>
+#include <filesystem>
+#include <string>
+
+namespace util {
+
+/**
+ * @brief Replace a file with another one so that the replacement survives a crash.
+ *
+ * Flushes the new file to disk, renames it over the old one and flushes the directory holding it. After a crash the
+ * destination is either the old file or the complete new one.
+ *
+ * @param from The new file; it must be completely written and closed
+ * @param to The file to replace
+ * @return Nothing on success; an error message otherwise
+ */
+[[nodiscard]] std::expected<void, std::string>
+replaceFileDurably(std::filesystem::path const& from, std::filesystem::path const& to);
+
+}  // namespace util
@@ -74,6 +74,23 @@ static constexpr std::array<char const*, 3> LOAD_CACHE_MODE = {
     "none",
 };
 
+/**
+ * @brief specific values that are accepted for cache memory mode in config.
+ */
+static constexpr std::array<char const*, 3> CACHE_MEMORY_MODE = {
+    "default",
+    "compact",
+    "compressed",
+};
+
+/**
+ * @brief specific values that are accepted for websocket sending queue overflow policy in config.
+ */
+static constexpr std::array<char const*, 2> WS_OVERFLOW_POLICY = {
+    "drop_oldest",
+    "disconnect",
+};
+
 /**
  * @brief specific values that are accepted for database type in config.
  */
@@ -345,7 +362,9 @@ static constinit OneOf validateChannelName{"channel", Logger::CHANNELS};
 static constinit OneOf validateLogLevelName{"log_level", LOG_LEVELS};
 static constinit OneOf validateCassandraName{"database.type", DATABASE_TYPE};
 static constinit OneOf validateLoadMode{"cache.load", LOAD_CACHE_MODE};
+static constinit OneOf validateCacheMemoryMode{"cache.memory_mode", CACHE_MEMORY_MODE};
 static constinit OneOf validateLogTag{"log_tag_style", LOG_TAGS};
+static constinit OneOf validateWsOverflowPolicy{"server.ws_queue_overflow", WS_OVERFLOW_POLICY};
 
 static constinit PositiveDouble validatePositiveDouble{};
 
@@ -353,6 +372,7 @@ static constinit NumberValueConstraint<uint16_t> validateUint16{
     std::numeric_limits<uint16_t>::min(),
     std::numeric_limits<uint16_t>::max()
 };
+static constinit NumberValueConstraint<uint16_t> validatePositiveUint16{1, std::numeric_limits<uint16_t>::max()};
 static constinit NumberValueConstraint<uint32_t> validateUint32{
     std::numeric_limits<uint32_t>::min(),
     std::numeric_limits<uint32_t>::max()
@@ -72,9 +72,20 @@ static ClioConfigDefinition ClioConfig = ClioConfigDefinition{
      {"database.cassandra.queue_size_io", ConfigValue{ConfigType::Integer}.optional().withConstraint(validateUint16)},
      {"database.cassandra.write_batch_size",
       ConfigValue{ConfigType::Integer}.defaultValue(20).withConstraint(validateUint16)},
+     {"database.cassandra.read_batch_size",
+      ConfigValue{ConfigType::Integer}.defaultValue(50).withConstraint(validatePositiveUint16)},
+     {"database.cassandra.max_read_batches_in_flight",
+      ConfigValue{ConfigType::Integer}.defaultValue(16).withConstraint(validatePositiveUint16)},
+     {"database.cassandra.max_read_aheads_in_flight",
+      ConfigValue{ConfigType::Integer}.defaultValue(16).withConstraint(validateUint16)},
      {"etl_source.[].ip", Array{ConfigValue{ConfigType::String}.withConstraint(validateIP)}},
      {"etl_source.[].ws_port", Array{ConfigValue{ConfigType::String}.withConstraint(validatePort)}},
      {"etl_source.[].grpc_port", Array{ConfigValue{ConfigType::String}.withConstraint(validatePort)}},
+     {"etl_source.[].forwarding_pool_size",
+      Array{ConfigValue{ConfigType::Integer}.optional().withConstraint(validateUint16)}},
+     {"etl_source.[].load_threads", Array{ConfigValue{ConfigType::Integer}.optional().withConstraint(validateUint16)}},
+     {"forwarding.hedge_delay",
+      ConfigValue{ConfigType::Double}.defaultValue(0.0).withConstraint(validatePositiveDouble)},
      {"forwarding.cache_timeout",
       ConfigValue{ConfigType::Double}.defaultValue(0.0).withConstraint(validatePositiveDouble)},
      {"forwarding.request_timeout",
@@ -91,6 +102,15 @@ static ClioConfigDefinition ClioConfig = ClioConfigDefinition{
      {"server.port", ConfigValue{ConfigType::Integer}.withConstraint(validatePort)},
      {"server.workers", ConfigValue{ConfigType::Integer}.withConstraint(validateUint32)},
      {"server.max_queue_size", ConfigValue{ConfigType::Integer}.defaultValue(0).withConstraint(validateUint32)},
+     {"server.max_running_requests", ConfigValue{ConfigType::Integer}.defaultValue(0).withConstraint(validateUint32)},
+     {"server.max_queue_wait_ms", ConfigValue{ConfigType::Integer}.defaultValue(10'000).withConstraint(validateUint32)},
+     {"server.adaptive_concurrency_limit", ConfigValue{ConfigType::Boolean}.defaultValue(false)},
+     {"server.ws_max_requests_in_flight",
+      ConfigValue{ConfigType::Integer}.defaultValue(16).withConstraint(validateUint32)},
+     {"server.ws_max_sending_queue_size",
+      ConfigValue{ConfigType::Integer}.defaultValue(1500).withConstraint(validateUint32)},
+     {"server.ws_queue_overflow",
+      ConfigValue{ConfigType::String}.defaultValue("drop_oldest").withConstraint(validateWsOverflowPolicy)},
      {"server.local_admin", ConfigValue{ConfigType::Boolean}.optional()},
      {"server.admin_password", ConfigValue{ConfigType::String}.optional()},
      {"prometheus.enabled", ConfigValue{ConfigType::Boolean}.defaultValue(true)},
@@ -103,6 +123,16 @@ static ClioConfigDefinition ClioConfig = ClioConfigDefinition{
      },
      {"cache.page_fetch_size", ConfigValue{ConfigType::Integer}.defaultValue(512).withConstraint(validateUint16)},
      {"cache.load", ConfigValue{ConfigType::String}.defaultValue("async").withConstraint(validateLoadMode)},
+     {"cache.num_recent_ledgers", ConfigValue{ConfigType::Integer}.defaultValue(8).withConstraint(validateUint16)},
+     {"cache.memory_mode",
+      ConfigValue{ConfigType::String}.defaultValue("default").withConstraint(validateCacheMemoryMode)},
+     {"cache.snapshot.path", ConfigValue{ConfigType::String}.optional()},
+     {"cache.snapshot.interval", ConfigValue{ConfigType::Integer}.defaultValue(0).withConstraint(validateUint32)},
+     {"cache.snapshot.max_catch_up_ledgers",
+      ConfigValue{ConfigType::Integer}.defaultValue(1024).withConstraint(validateUint32)},
+     {"cache.transactions.max_size_mb",
+      ConfigValue{ConfigType::Integer}.defaultValue(64).withConstraint(validateUint32)},
+     {"cache.transactions.account_tx_read_ahead", ConfigValue{ConfigType::Boolean}.defaultValue(false)},
      {"log_channels.[].channel", Array{ConfigValue{ConfigType::String}.optional().withConstraint(validateChannelName)}},
      {"log_channels.[].log_level",
       Array{ConfigValue{ConfigType::String}.optional().withConstraint(validateLogLevelName)}},
@@ -123,6 +153,7 @@ static ClioConfigDefinition ClioConfig = ClioConfigDefinition{
      {"txn_threshold", ConfigValue{ConfigType::Integer}.defaultValue(0).withConstraint(validateUint16)},
      {"start_sequence", ConfigValue{ConfigType::Integer}.optional().withConstraint(validateUint32)},
      {"finish_sequence", ConfigValue{ConfigType::Integer}.optional().withConstraint(validateUint32)},
+     {"initial_load_checkpoint_path", ConfigValue{ConfigType::String}.optional()},
      {"ssl_cert_file", ConfigValue{ConfigType::String}.optional()},
      {"ssl_key_file", ConfigValue{ConfigType::String}.optional()},
      {"api_version.min", ConfigValue{ConfigType::Integer}},
@@ -70,26 +70,51 @@ private:
         KV{"database.cassandra.replication_factor", "Number of replicated nodes for Scylladb."},
         KV{"database.cassandra.table_prefix", "Prefix for Cassandra table names."},
         KV{"database.cassandra.max_write_requests_outstanding", "Maximum number of outstanding write requests."},
-        KV{"database.cassandra.max_read_requests_outstanding", "Maximum number of outstanding read requests."},
+        KV{"database.cassandra.max_read_requests_outstanding",
+           "Maximum number of outstanding read requests; a multi-key statement counts as one request."},
         KV{"database.cassandra.threads", "Number of threads for Cassandra operations."},
         KV{"database.cassandra.core_connections_per_host", "Number of core connections per host for Cassandra."},
         KV{"database.cassandra.queue_size_io", "Queue size for I/O operations in Cassandra."},
         KV{"database.cassandra.write_batch_size", "Batch size for write operations in Cassandra."},
+        KV{"database.cassandra.read_batch_size",
+           "Maximum number of keys read by a single multi-key statement; must be at least 1."},
+        KV{"database.cassandra.max_read_batches_in_flight",
+           "Maximum number of multi-key statements of a single read executed at the same time; must be at least 1."},
+        KV{"database.cassandra.max_read_aheads_in_flight",
+           "Maximum number of account_tx read-aheads running at the same time; 0 disables read-ahead."},
         KV{"etl_source.[].ip", "IP address of the ETL source."},
         KV{"etl_source.[].ws_port", "WebSocket port of the ETL source."},
         KV{"etl_source.[].grpc_port", "gRPC port of the ETL source."},
+        KV{"etl_source.[].forwarding_pool_size",
+           "Number of persistent connections used to forward requests to the ETL source; 0 disables pooling."},
+        KV{"etl_source.[].load_threads",
+           "Number of threads used to download the initial ledger from the ETL source; 0 means one per CPU core."},
         KV{"forwarding.cache_timeout", "Timeout duration for the forwarding cache used in Rippled communication."},
         KV{"forwarding.request_timeout", "Timeout duration for the forwarding request used in Rippled communication."},
+        KV{"forwarding.hedge_delay",
+           "Delay after which idempotent forwarded requests are also sent to a second source; 0 disables hedging."},
         KV{"dos_guard.[].whitelist", "List of IP addresses to whitelist for DOS protection."},
         KV{"dos_guard.max_fetches", "Maximum number of fetch operations allowed by DOS guard."},
         KV{"dos_guard.max_connections", "Maximum number of concurrent connections allowed by DOS guard."},
         KV{"dos_guard.max_requests", "Maximum number of requests allowed by DOS guard."},
-        KV{"dos_guard.sweep_interval", "Interval in seconds for DOS guard to sweep/clear its state."},
+        KV{"dos_guard.sweep_interval", "Interval in seconds over which DOS guard limits are refilled."},
         KV{"cache.peers.[].ip", "IP address of peer nodes to cache."},
         KV{"cache.peers.[].port", "Port number of peer nodes to cache."},
         KV{"server.ip", "IP address of the Clio HTTP server."},
         KV{"server.port", "Port number of the Clio HTTP server."},
         KV{"server.max_queue_size", "Maximum size of the server's request queue."},
+        KV{"server.max_running_requests",
+           "Maximum number of requests processed at once; 0 means 32 per worker thread. The rest wait in the queue."},
+        KV{"server.max_queue_wait_ms",
+           "Time in milliseconds a request may wait in the queue before it is rejected; 0 disables the limit."},
+        KV{"server.adaptive_concurrency_limit",
+           "Adapt the number of requests processed at once to their latency, up to max_running_requests."},
+        KV{"server.ws_max_requests_in_flight",
+           "Maximum number of requests of a websocket client processed at once; 0 disables the limit."},
+        KV{"server.ws_max_sending_queue_size",
+           "Maximum number of messages queued for sending to a websocket client; 0 disables the limit."},
+        KV{"server.ws_queue_overflow",
+           "What to do when the sending queue of a websocket client is full: drop_oldest or disconnect."},
         KV{"server.workers", "Maximum number of threads for server to run with."},
         KV{"server.local_admin", "Indicates if the server should run with admin privileges."},
         KV{"server.admin_password", "Password for Clio admin-only APIs."},
@@ -117,6 +142,8 @@ private:
         KV{"txn_threshold", "Transaction threshold value."},
         KV{"start_sequence", "Starting ledger index."},
         KV{"finish_sequence", "Ending ledger index."},
+        KV{"initial_load_checkpoint_path",
+           "File to keep the progress of the initial ledger download in so that an interrupted download resumes."},
         KV{"ssl_cert_file", "Path to the SSL certificate file."},
         KV{"ssl_key_file", "Path to the SSL key file."},
         KV{"api_version.min", "Minimum API version."},
@@ -40,6 +40,7 @@
 #include <boost/json/parse.hpp>
 #include <boost/json/serialize.hpp>
 #include <boost/system/system_error.hpp>
+#include <fmt/core.h>
 #include <xrpl/protocol/jss.h>
 
 #include <chrono>
@@ -49,6 +50,7 @@
 #include <ratio>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <utility>
 
 namespace web {
@@ -108,11 +110,18 @@ public:
             if (not connection->upgraded and shouldReplaceParams(req))
                 req[JS(params)] = boost::json::array({boost::json::object{}});
 
+            auto const method = methodOf(req);
             if (!rpcEngine_->post(
                     [this, request = std::move(req), connection](boost::asio::yield_context yield) mutable {
                         handleRequest(yield, std::move(request), connection);
                     },
-                    connection->clientIp
+                    connection->clientIp,
+                    method,
+                    connection->isAdmin(),
+                    [this, connection]() {
+                        rpcEngine_->notifyTooBusy();
+                        web::impl::ErrorHelper(connection).sendTooBusyError();
+                    }
                 )) {
                 rpcEngine_->notifyTooBusy();
                 web::impl::ErrorHelper(connection).sendTooBusyError();
@@ -135,6 +144,17 @@ public:
     }
 
 private:
+    // only used to schedule the request; the context validates the method properly later
+    static std::string
+    methodOf(boost::json::object const& request)
+    {
+        for (auto const* field : {"method", "command"}) {
+            if (auto const* value = request.if_contains(field); value != nullptr and value->is_string())
+                return std::string{value->as_string()};
+        }
+        return {};
+    }
+
     void
     handleRequest(
         boost::asio::yield_context yield,
@@ -197,6 +217,14 @@ private:
             auto us = std::chrono::duration<int, std::milli>(timeDiff);
             rpc::logDuration(*context, us);
 
+            if (result.serializedResponse) {
+                rpcEngine_->notifyComplete(context->method, us);
+                connection->send(composeSerializedResponse(
+                    *result.serializedResponse, std::move(result.warnings), request, *connection
+                ));
+                return;
+            }
+
             boost::json::object response;
 
             if (auto const status = std::get_if<rpc::Status>(&result.response)) {
@@ -272,6 +300,43 @@ private:
         }
     }
 
+    // same as the response composed from a response object but without serializing the result again
+    std::string
+    composeSerializedResponse(
+        std::string const& result,
+        boost::json::array warnings,
+        boost::json::object const& request,
+        web::ConnectionBase const& connection
+    ) const
+    {
+        boost::json::object response;
+        std::string_view resultPrefix = "{";
+
+        if (connection.upgraded) {
+            for (auto const& field : {JS(id), JS(api_version)}) {
+                if (request.contains(field) and not request.at(field).is_null())
+                    response[field] = request.at(field);
+            }
+
+            response[JS(status)] = JS(success);
+            response[JS(type)] = JS(response);
+        } else {
+            resultPrefix = result == "{}" ? R"({"status":"success")" : R"({"status":"success",)";
+        }
+
+        warnings.emplace_back(rpc::makeWarning(rpc::warnRPC_CLIO));
+        if (etl_->lastCloseAgeSeconds() >= 60)
+            warnings.emplace_back(rpc::makeWarning(rpc::warnRPC_OUTDATED));
+
+        response["warnings"] = std::move(warnings);
+
+        // both the result and the rest of the response are objects so their opening braces are dropped
+        auto const rest = boost::json::serialize(response);
+        return fmt::format(
+            R"({{"result":{}{},{})", resultPrefix, std::string_view{result}.substr(1), std::string_view{rest}.substr(1)
+        );
+    }
+
     bool
     shouldReplaceParams(boost::json::object const& req) const
     {
@@ -25,6 +25,7 @@
 #include "web/SslHttpSession.hpp"
 #include "web/dosguard/DOSGuardInterface.hpp"
 #include "web/impl/ServerSslContext.hpp"
+#include "web/impl/WsBase.hpp"
 #include "web/interface/Concepts.hpp"
 
 #include <boost/asio/io_context.hpp>
@@ -41,6 +42,7 @@
 #include <fmt/core.h>
 
 #include <chrono>
+#include <cstddef>
 #include <exception>
 #include <functional>
 #include <memory>
@@ -93,6 +95,7 @@ class Detector : public std::enable_shared_from_this<Detector<PlainSessionType,
     std::shared_ptr<HandlerType> const handler_;
     boost::beast::flat_buffer buffer_;
     std::shared_ptr<impl::AdminVerificationStrategy> const adminVerification_;
+    impl::WsSettings const wsSettings_;
 
 public:
     /**
@@ -104,6 +107,7 @@ public:
      * @param dosGuard The denial of service guard to use
      * @param handler The server handler to use
      * @param adminVerification The admin verification strategy to use
+     * @param wsSettings The limits to apply to websocket sessions
      */
     Detector(
         tcp::socket&& socket,
@@ -111,7 +115,8 @@ public:
         std::reference_wrapper<util::TagDecoratorFactory const> tagFactory,
         std::reference_wrapper<dosguard::DOSGuardInterface> dosGuard,
         std::shared_ptr<HandlerType> handler,
-        std::shared_ptr<impl::AdminVerificationStrategy> adminVerification
+        std::shared_ptr<impl::AdminVerificationStrategy> adminVerification,
+        impl::WsSettings wsSettings
     )
         : stream_(std::move(socket))
         , ctx_(ctx)
@@ -119,6 +124,7 @@ public:
         , dosGuard_(dosGuard)
         , handler_(std::move(handler))
         , adminVerification_(std::move(adminVerification))
+        , wsSettings_(wsSettings)
     {
     }
 
@@ -176,14 +182,22 @@ public:
                 tagFactory_,
                 dosGuard_,
                 handler_,
-                std::move(buffer_)
+                std::move(buffer_),
+                wsSettings_
             )
                 ->run();
             return;
         }
 
         std::make_shared<PlainSessionType<HandlerType>>(
-            stream_.release_socket(), ip, adminVerification_, tagFactory_, dosGuard_, handler_, std::move(buffer_)
+            stream_.release_socket(),
+            ip,
+            adminVerification_,
+            tagFactory_,
+            dosGuard_,
+            handler_,
+            std::move(buffer_),
+            wsSettings_
         )
             ->run();
     }
@@ -213,6 +227,7 @@ class Server : public std::enable_shared_from_this<Server<PlainSessionType, SslS
     std::shared_ptr<HandlerType> handler_;
     tcp::acceptor acceptor_;
     std::shared_ptr<impl::AdminVerificationStrategy> adminVerification_;
+    impl::WsSettings wsSettings_;
 
 public:
     /**
@@ -225,6 +240,7 @@ public:
      * @param dosGuard The denial of service guard to use
      * @param handler The server handler to use
      * @param adminPassword The optional password to verify admin role in requests
+     * @param wsSettings The limits to apply to websocket sessions
      */
     Server(
         boost::asio::io_context& ioc,
@@ -233,7 +249,8 @@ public:
         util::TagDecoratorFactory tagFactory,
         dosguard::DOSGuardInterface& dosGuard,
         std::shared_ptr<HandlerType> handler,
-        std::optional<std::string> adminPassword
+        std::optional<std::string> adminPassword,
+        impl::WsSettings wsSettings
     )
         : ioc_(std::ref(ioc))
         , ctx_(std::move(ctx))
@@ -242,6 +259,7 @@ public:
         , handler_(std::move(handler))
         , acceptor_(boost::asio::make_strand(ioc))
         , adminVerification_(impl::make_AdminVerificationStrategy(std::move(adminPassword)))
+        , wsSettings_(wsSettings)
     {
         boost::beast::error_code ec;
 
@@ -295,7 +313,7 @@ private:
                 ctx_ ? std::optional<std::reference_wrapper<boost::asio::ssl::context>>{ctx_.value()} : std::nullopt;
 
             std::make_shared<Detector<PlainSessionType, SslSessionType, HandlerType>>(
-                std::move(socket), ctxRef, std::cref(tagFactory_), dosGuard_, handler_, adminVerification_
+                std::move(socket), ctxRef, std::cref(tagFactory_), dosGuard_, handler_, adminVerification_, wsSettings_
             )
                 ->run();
         }
@@ -357,6 +375,23 @@ make_HttpServer(
         throw std::logic_error("Admin config error, one method must be specified to authorize admin.");
     }
 
+    auto const wsQueueOverflow = serverConfig.valueOr<std::string>("ws_queue_overflow", "drop_oldest");
+    if (wsQueueOverflow != "drop_oldest" and wsQueueOverflow != "disconnect") {
+        LOG(log.error()) << "Invalid ws_queue_overflow: " << wsQueueOverflow;
+        throw std::logic_error("Websocket config error, ws_queue_overflow must be either drop_oldest or disconnect.");
+    }
+
+    auto const wsSettings = impl::WsSettings{
+        .maxRequestsInFlight = serverConfig.valueOr<std::size_t>(
+            "ws_max_requests_in_flight", impl::WsSettings::DEFAULT_MAX_REQUESTS_IN_FLIGHT
+        ),
+        .maxSendingQueueSize = serverConfig.valueOr<std::size_t>(
+            "ws_max_sending_queue_size", impl::WsSettings::DEFAULT_MAX_SENDING_QUEUE_SIZE
+        ),
+        .overflowPolicy =
+            wsQueueOverflow == "disconnect" ? impl::WsOverflowPolicy::Disconnect : impl::WsOverflowPolicy::DropOldest
+    };
+
     auto server = std::make_shared<HttpServer<HandlerType>>(
         ioc,
         std::move(expectedSslContext).value(),
@@ -364,7 +399,8 @@ make_HttpServer(
         util::TagDecoratorFactory(config),
         dosGuard,
         handler,
-        std::move(adminPassword)
+        std::move(adminPassword),
+        wsSettings
     );
 
     server->run();
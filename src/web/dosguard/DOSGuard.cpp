@@ -24,22 +24,43 @@
 #include "util/log/Logger.hpp"
 #include "web/dosguard/WhitelistHandlerInterface.hpp"
 
+#include <boost/asio/ip/address.hpp>
+#include <boost/asio/ip/address_v6.hpp>
 #include <boost/iterator/transform_iterator.hpp>
+#include <boost/system/error_code.hpp>
 
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <functional>
 #include <mutex>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <unordered_set>
+#include <utility>
 
 namespace web::dosguard {
 
-DOSGuard::DOSGuard(util::Config const& config, WhitelistHandlerInterface const& whitelistHandler)
+std::size_t
+DOSGuard::IpKeyHash::operator()(IpKey const& key) const noexcept
+{
+    std::uint64_t high = 0;
+    std::uint64_t low = 0;
+    std::memcpy(&high, key.data(), sizeof(high));
+    std::memcpy(&low, key.data() + sizeof(high), sizeof(low));
+    return std::hash<std::uint64_t>{}(high ^ (low * 0x9E3779B97F4A7C15ull));
+}
+
+DOSGuard::DOSGuard(util::Config const& config, WhitelistHandlerInterface const& whitelistHandler, TimeSource now)
     : whitelistHandler_{std::cref(whitelistHandler)}
     , maxFetches_{config.valueOr("dos_guard.max_fetches", DEFAULT_MAX_FETCHES)}
     , maxConnCount_{config.valueOr("dos_guard.max_connections", DEFAULT_MAX_CONNECTIONS)}
     , maxRequestCount_{config.valueOr("dos_guard.max_requests", DEFAULT_MAX_REQUESTS)}
+    , refillInterval_{std::max(0.001, config.valueOr("dos_guard.sweep_interval", DEFAULT_SWEEP_INTERVAL))}
+    , now_{std::move(now)}
 {
 }
 
@@ -52,85 +73,96 @@ DOSGuard::isWhiteListed(std::string_view const ip) const noexcept
 [[nodiscard]] bool
 DOSGuard::isOk(std::string const& ip) const noexcept
 {
-    if (whitelistHandler_.get().isWhiteListed(ip))
+    auto const key = makeKey(ip);
+    if (not key)
         return true;
 
-    {
-        std::scoped_lock const lck(mtx_);
-        if (ipState_.find(ip) != ipState_.end()) {
-            auto [transferedByte, requests] = ipState_.at(ip);
-            if (transferedByte > maxFetches_ || requests > maxRequestCount_) {
-                LOG(log_.warn()) << "Dosguard: Client surpassed the rate limit. ip = " << ip
-                                 << " Transfered Byte: " << transferedByte << "; Requests: " << requests;
-                return false;
-            }
-        }
-        auto it = ipConnCount_.find(ip);
-        if (it != ipConnCount_.end()) {
-            if (it->second > maxConnCount_) {
-                LOG(log_.warn()) << "Dosguard: Client surpassed the rate limit. ip = " << ip
-                                 << " Concurrent connection: " << it->second;
-                return false;
-            }
-        }
-    }
-    return true;
+    auto& shard = shardFor(*key);
+
+    std::scoped_lock const lck(shard.mtx);
+    auto const it = shard.clients.find(*key);
+    if (it == shard.clients.end())
+        return true;
+
+    auto state = it->second;
+    refill(state, now_());
+    return isOk(ip, state);
 }
 
 void
 DOSGuard::increment(std::string const& ip) noexcept
 {
-    if (whitelistHandler_.get().isWhiteListed(ip))
+    auto const key = makeKey(ip);
+    if (not key)
         return;
-    std::scoped_lock const lck{mtx_};
-    ipConnCount_[ip]++;
+
+    auto& shard = shardFor(*key);
+
+    std::scoped_lock const lck{shard.mtx};
+    auto [it, inserted] = shard.clients.try_emplace(*key);
+    if (inserted)
+        refill(it->second, now_());
+    ++it->second.connections;
 }
 
 void
 DOSGuard::decrement(std::string const& ip) noexcept
 {
-    if (whitelistHandler_.get().isWhiteListed(ip))
+    auto const key = makeKey(ip);
+    if (not key)
         return;
-    std::scoped_lock const lck{mtx_};
-    ASSERT(ipConnCount_[ip] > 0, "Connection count for ip {} can't be 0", ip);
-    ipConnCount_[ip]--;
-    if (ipConnCount_[ip] == 0)
-        ipConnCount_.erase(ip);
+
+    auto& shard = shardFor(*key);
+
+    std::scoped_lock const lck{shard.mtx};
+    auto const it = shard.clients.find(*key);
+    ASSERT(it != shard.clients.end() and it->second.connections > 0, "Connection count for ip {} can't be 0", ip);
+    --it->second.connections;
 }
 
 [[maybe_unused]] bool
 DOSGuard::add(std::string const& ip, uint32_t numObjects) noexcept
 {
-    if (whitelistHandler_.get().isWhiteListed(ip))
+    auto const key = makeKey(ip);
+    if (not key)
         return true;
 
-    {
-        std::scoped_lock const lck(mtx_);
-        ipState_[ip].transferedByte += numObjects;
-    }
+    auto& shard = shardFor(*key);
 
-    return isOk(ip);
+    std::scoped_lock const lck{shard.mtx};
+    auto& state = shard.clients[*key];
+    refill(state, now_());
+    state.fetchTokens = std::max(state.fetchTokens - numObjects, -static_cast<double>(maxFetches_));
+    return isOk(ip, state);
 }
 
 [[maybe_unused]] bool
 DOSGuard::request(std::string const& ip) noexcept
 {
-    if (whitelistHandler_.get().isWhiteListed(ip))
+    auto const key = makeKey(ip);
+    if (not key)
         return true;
 
-    {
-        std::scoped_lock const lck(mtx_);
-        ipState_[ip].requestsCount++;
-    }
+    auto& shard = shardFor(*key);
 
-    return isOk(ip);
+    std::scoped_lock const lck{shard.mtx};
+    auto& state = shard.clients[*key];
+    refill(state, now_());
+    state.requestTokens = std::max(state.requestTokens - 1., -static_cast<double>(maxRequestCount_));
+    return isOk(ip, state);
 }
 
 void
 DOSGuard::clear() noexcept
 {
-    std::scoped_lock const lck(mtx_);
-    ipState_.clear();
+    auto const now = now_();
+    for (auto& shard : shards_) {
+        std::scoped_lock const lck(shard.mtx);
+        std::erase_if(shard.clients, [&](auto& entry) {
+            refill(entry.second, now);
+            return entry.second.connections == 0 and isFull(entry.second);
+        });
+    }
 }
 
 [[nodiscard]] std::unordered_set<std::string>
@@ -145,4 +177,80 @@ DOSGuard::getWhitelist(util::Config const& config)
     };
 }
 
+std::optional<DOSGuard::IpKey>
+DOSGuard::makeKey(std::string const& ip) const
+{
+    IpKey key{};
+
+    boost::system::error_code ec;
+    auto const address = boost::asio::ip::make_address(ip, ec);
+    if (not ec) {
+        if (whitelistHandler_.get().isWhiteListed(address))
+            return std::nullopt;
+
+        auto const v6 = address.is_v4()
+            ? boost::asio::ip::make_address_v6(boost::asio::ip::v4_mapped, address.to_v4())
+            : address.to_v6();
+        auto const bytes = v6.to_bytes();
+        std::ranges::copy(bytes, key.begin());
+        return key;
+    }
+
+    // not an address; use a key from the reserved 0100::/64 discard prefix so it can't clash with a real client
+    key[0] = 0x01;
+    auto const hash = std::hash<std::string>{}(ip);
+    std::memcpy(key.data() + (key.size() - sizeof(hash)), &hash, sizeof(hash));
+    return key;
+}
+
+DOSGuard::Shard&
+DOSGuard::shardFor(IpKey const& key) const
+{
+    return shards_[IpKeyHash{}(key) % NUM_SHARDS];
+}
+
+void
+DOSGuard::refill(ClientState& state, std::chrono::steady_clock::time_point now) const
+{
+    if (state.lastRefill == std::chrono::steady_clock::time_point{}) {
+        state.fetchTokens = maxFetches_;
+        state.requestTokens = maxRequestCount_;
+        state.lastRefill = now;
+        return;
+    }
+
+    auto const elapsed = std::chrono::duration<double>(now - state.lastRefill) / refillInterval_;
+    if (elapsed <= 0.)
+        return;
+
+    state.fetchTokens = std::min<double>(state.fetchTokens + (elapsed * maxFetches_), maxFetches_);
+    state.requestTokens = std::min<double>(state.requestTokens + (elapsed * maxRequestCount_), maxRequestCount_);
+    state.lastRefill = now;
+}
+
+bool
+DOSGuard::isOk(std::string const& ip, ClientState const& state) const
+{
+    if (state.fetchTokens < 0. or state.requestTokens < 0.) {
+        LOG(log_.warn()) << "Dosguard: Client surpassed the rate limit. ip = " << ip
+                         << " Transfered Byte: " << (maxFetches_ - state.fetchTokens)
+                         << "; Requests: " << (maxRequestCount_ - state.requestTokens);
+        return false;
+    }
+
+    if (state.connections > maxConnCount_) {
+        LOG(log_.warn()) << "Dosguard: Client surpassed the rate limit. ip = " << ip
+                         << " Concurrent connection: " << state.connections;
+        return false;
+    }
+
+    return true;
+}
+
+bool
+DOSGuard::isFull(ClientState const& state) const
+{
+    return state.fetchTokens >= maxFetches_ and state.requestTokens >= maxRequestCount_;
+}
+
 }  // namespace web::dosguard
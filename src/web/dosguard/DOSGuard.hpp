@@ -28,9 +28,13 @@
 #include <boost/iterator/transform_iterator.hpp>
 #include <boost/system/error_code.hpp>
 
+#include <array>
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <mutex>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <unordered_map>
@@ -39,41 +43,72 @@
 namespace web::dosguard {
 
 /**
- * @brief A simple denial of service guard used for rate limiting.
+ * @brief A denial of service guard used for rate limiting.
  *
- * @tparam WhitelistHandlerType The type of the whitelist handler
+ * Every client gets two token buckets, one for requests and one for transferred bytes, which are refilled
+ * continuously at the rate of their maximum per sweep interval. A client may go into debt of up to one full bucket.
+ * Clients are keyed by their binary address and spread over shards with their own locks. Whitelisted clients never
+ * touch the shards.
  */
 class DOSGuard : public DOSGuardInterface {
+public:
+    /** @brief Returns the current time; replaceable so that tests don't depend on real time passing */
+    using TimeSource = std::function<std::chrono::steady_clock::time_point()>;
+
+private:
+    static constexpr std::size_t NUM_SHARDS = 64;
+
+    /** @brief IPv4 addresses are mapped to IPv6; anything that isn't an address is hashed */
+    using IpKey = std::array<std::uint8_t, 16>;
+
+    struct IpKeyHash {
+        std::size_t
+        operator()(IpKey const& key) const noexcept;
+    };
+
     /**
-     * @brief Accumulated state per IP, state will be reset accordingly
+     * @brief Rate limiting state per IP
      */
     struct ClientState {
-        std::uint32_t transferedByte = 0; /**< Accumulated transferred byte */
-        std::uint32_t requestsCount = 0;  /**< Accumulated served requests count */
+        double fetchTokens = 0.;   /**< Bytes the client may still transfer; negative if in debt */
+        double requestTokens = 0.; /**< Requests the client may still make; negative if in debt */
+        std::chrono::steady_clock::time_point lastRefill;
+        std::uint32_t connections = 0; /**< Concurrent connections */
+    };
+
+    struct alignas(64) Shard {
+        std::mutex mtx;
+        std::unordered_map<IpKey, ClientState, IpKeyHash> clients;
     };
 
-    mutable std::mutex mtx_;
-    std::unordered_map<std::string, ClientState> ipState_;
-    std::unordered_map<std::string, std::uint32_t> ipConnCount_;
+    mutable std::array<Shard, NUM_SHARDS> shards_;
     std::reference_wrapper<WhitelistHandlerInterface const> whitelistHandler_;
 
     std::uint32_t const maxFetches_;
     std::uint32_t const maxConnCount_;
     std::uint32_t const maxRequestCount_;
+    std::chrono::duration<double> const refillInterval_;
+    TimeSource now_;
     util::Logger log_{"RPC"};
 
 public:
     static constexpr std::uint32_t DEFAULT_MAX_FETCHES = 1000'000u; /**< Default maximum fetches per sweep */
     static constexpr std::uint32_t DEFAULT_MAX_CONNECTIONS = 20u;   /**< Default maximum concurrent connections */
     static constexpr std::uint32_t DEFAULT_MAX_REQUESTS = 20u;      /**< Default maximum requests per sweep */
+    static constexpr double DEFAULT_SWEEP_INTERVAL = 1.0;          /**< Default sweep interval in seconds */
 
     /**
      * @brief Constructs a new DOS guard.
      *
      * @param config Clio config
      * @param whitelistHandler Whitelist handler that checks whitelist for IP addresses
+     * @param now The source of the current time the buckets are refilled by
      */
-    DOSGuard(util::Config const& config, WhitelistHandlerInterface const& whitelistHandler);
+    DOSGuard(
+        util::Config const& config,
+        WhitelistHandlerInterface const& whitelistHandler,
+        TimeSource now = std::chrono::steady_clock::now
+    );
 
     /**
      * @brief Check whether an ip address is in the whitelist or not.
@@ -114,9 +149,8 @@ public:
     /**
      * @brief Adds numObjects of usage for the given ip address.
      *
-     * If the total sums up to a value equal or larger than maxFetches_
-     * the operation is no longer allowed and false is returned; true is
-     * returned otherwise.
+     * If the client used more than maxFetches_ per sweep interval the operation is no longer allowed and false is
+     * returned; true is returned otherwise.
      *
      * @param ip
      * @param numObjects
@@ -129,9 +163,8 @@ public:
     /**
      * @brief Adds one request for the given ip address.
      *
-     * If the total sums up to a value equal or larger than maxRequestCount_
-     * the operation is no longer allowed and false is returned; true is
-     * returned otherwise.
+     * If the client made more than maxRequestCount_ requests per sweep interval the operation is no longer allowed and
+     * false is returned; true is returned otherwise.
      *
      * @param ip
      * @return true
@@ -141,7 +174,9 @@ public:
     request(std::string const& ip) noexcept override;
 
     /**
-     * @brief Instantly clears all fetch counters added by @see add(std::string const&, uint32_t).
+     * @brief Forgets the clients which have no connections and whose buckets are full again.
+     *
+     * Buckets are refilled continuously so this only keeps the memory used by the guard bounded.
      */
     void
     clear() noexcept override;
@@ -149,6 +184,22 @@ public:
 private:
     [[nodiscard]] static std::unordered_set<std::string>
     getWhitelist(util::Config const& config);
+
+    /** @brief Parses the ip once for both the whitelist check and the key; nullopt if the ip is whitelisted */
+    std::optional<IpKey>
+    makeKey(std::string const& ip) const;
+
+    Shard&
+    shardFor(IpKey const& key) const;
+
+    void
+    refill(ClientState& state, std::chrono::steady_clock::time_point now) const;
+
+    bool
+    isOk(std::string const& ip, ClientState const& state) const;
+
+    bool
+    isFull(ClientState const& state) const;
 };
 
 }  // namespace web::dosguard
@@ -22,17 +22,16 @@
 #include <boost/asio/ip/address.hpp>
 #include <boost/asio/ip/network_v4.hpp>
 #include <boost/asio/ip/network_v6.hpp>
+#include <boost/system/error_code.hpp>
 #include <fmt/core.h>
 
 #include <algorithm>
-#include <functional>
+#include <cstddef>
+#include <cstdint>
 #include <regex>
 #include <stdexcept>
 #include <string>
 #include <string_view>
-#include <unordered_map>
-#include <unordered_set>
-#include <vector>
 
 namespace web::dosguard {
 
@@ -42,55 +41,87 @@ Whitelist::add(std::string_view net)
     using namespace boost::asio;
 
     if (not isMask(net)) {
-        ips_.push_back(ip::make_address(net));
+        insert(toKey(ip::make_address(net)), KEY_BITS);
         return;
     }
 
     if (isV4(net)) {
-        subnetsV4_.push_back(ip::make_network_v4(net));
+        auto const network = ip::make_network_v4(net);
+        insert(toKey(ip::address{network.network()}), V4_MAPPED_PREFIX_BITS + network.prefix_length());
     } else if (isV6(net)) {
-        subnetsV6_.push_back(ip::make_network_v6(net));
+        auto const network = ip::make_network_v6(net);
+        insert(toKey(ip::address{network.network()}), network.prefix_length());
     } else {
         throw std::runtime_error(fmt::format("malformed network: {}", net.data()));
     }
 }
 
 bool
-Whitelist::isWhiteListed(std::string_view ip) const
+Whitelist::isWhiteListed(std::string_view ip) const noexcept
 {
-    using namespace boost::asio;
+    boost::system::error_code ec;
+    auto const addr = boost::asio::ip::make_address(ip, ec);
+    return not ec and isWhiteListed(addr);
+}
+
+bool
+Whitelist::isWhiteListed(boost::asio::ip::address const& ip) const noexcept
+{
+    auto const key = toKey(ip);
 
-    auto const addr = ip::make_address(ip);
-    if (std::find(std::begin(ips_), std::end(ips_), addr) != std::end(ips_))
-        return true;
+    std::size_t node = 0;
+    for (std::size_t i = 0; i < KEY_BITS; ++i) {
+        if (nodes_[node].whitelisted)
+            return true;
 
-    if (addr.is_v4()) {
-        return std::find_if(
-                   std::begin(subnetsV4_), std::end(subnetsV4_), std::bind_front(&isInV4Subnet, std::cref(addr))
-               ) != std::end(subnetsV4_);
+        node = nodes_[node].children[bitAt(key, i)];
+        if (node == 0)
+            return false;
     }
 
-    if (addr.is_v6()) {
-        return std::find_if(
-                   std::begin(subnetsV6_), std::end(subnetsV6_), std::bind_front(&isInV6Subnet, std::cref(addr))
-               ) != std::end(subnetsV6_);
+    return nodes_[node].whitelisted;
+}
+
+void
+Whitelist::insert(Key const& key, std::size_t prefixLength)
+{
+    std::size_t node = 0;
+    for (std::size_t i = 0; i < prefixLength; ++i) {
+        if (nodes_[node].whitelisted)
+            return;  // a shorter prefix already covers this network
+
+        auto const bit = bitAt(key, i);
+        if (nodes_[node].children[bit] == 0) {
+            nodes_[node].children[bit] = static_cast<std::uint32_t>(nodes_.size());
+            nodes_.emplace_back();
+        }
+        node = nodes_[node].children[bit];
     }
 
-    return false;
+    // longer prefixes below this node are covered now; their nodes are just never reached again
+    nodes_[node].whitelisted = true;
+    nodes_[node].children = {};
 }
 
-bool
-Whitelist::isInV4Subnet(boost::asio::ip::address const& addr, boost::asio::ip::network_v4 const& subnet)
+Whitelist::Key
+Whitelist::toKey(boost::asio::ip::address const& addr) noexcept
 {
-    auto const range = subnet.hosts();
-    return range.find(addr.to_v4()) != range.end();
+    Key key{};
+    if (addr.is_v4()) {
+        // ::ffff:a.b.c.d
+        key[10] = 0xFF;
+        key[11] = 0xFF;
+        std::ranges::copy(addr.to_v4().to_bytes(), key.begin() + 12);
+    } else {
+        std::ranges::copy(addr.to_v6().to_bytes(), key.begin());
+    }
+    return key;
 }
 
-bool
-Whitelist::isInV6Subnet(boost::asio::ip::address const& addr, boost::asio::ip::network_v6 const& subnet)
+std::size_t
+Whitelist::bitAt(Key const& key, std::size_t index) noexcept
 {
-    auto const range = subnet.hosts();
-    return range.find(addr.to_v6()) != range.end();
+    return (key[index / 8] >> (7 - (index % 8))) & 1u;
 }
 
 bool
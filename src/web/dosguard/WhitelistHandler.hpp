@@ -30,23 +30,37 @@
 #include <boost/iterator/transform_iterator.hpp>
 #include <fmt/core.h>
 
-#include <algorithm>
-#include <regex>
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <string_view>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 namespace web::dosguard {
 
 /**
  * @brief A whitelist to remove rate limits of certain IP addresses.
+ *
+ * Addresses and networks are compiled into a binary prefix trie over 128 bit keys; IPv4 is mapped to IPv6. Checking an
+ * address walks at most one node per bit of the longest whitelisted prefix and never allocates, no matter how many
+ * networks are whitelisted.
  */
 class Whitelist {
-    std::vector<boost::asio::ip::network_v4> subnetsV4_;
-    std::vector<boost::asio::ip::network_v6> subnetsV6_;
-    std::vector<boost::asio::ip::address> ips_;
+    static constexpr std::size_t KEY_BITS = 128;
+    static constexpr std::size_t V4_MAPPED_PREFIX_BITS = 96;
+
+    using Key = std::array<std::uint8_t, KEY_BITS / 8>;
+
+    struct Node {
+        std::array<std::uint32_t, 2> children{};  // index into nodes_; 0 (the root) means there is no child
+        bool whitelisted = false;                 // every address having the prefix of this node is whitelisted
+    };
+
+    std::vector<Node> nodes_{1};
 
 public:
     /**
@@ -62,18 +76,29 @@ public:
      * @brief Checks to see if ip address is whitelisted.
      *
      * @param ip IP address
-     * @throws std::runtime::error when the network address is not valid
+     * @return true if the given IP is whitelisted; false otherwise or if it is not a valid IP address
+     */
+    bool
+    isWhiteListed(std::string_view ip) const noexcept;
+
+    /**
+     * @brief Checks to see if an already parsed ip address is whitelisted.
+     *
+     * @param ip IP address
      * @return true if the given IP is whitelisted; false otherwise
      */
     bool
-    isWhiteListed(std::string_view ip) const;
+    isWhiteListed(boost::asio::ip::address const& ip) const noexcept;
 
 private:
-    static bool
-    isInV4Subnet(boost::asio::ip::address const& addr, boost::asio::ip::network_v4 const& subnet);
+    void
+    insert(Key const& key, std::size_t prefixLength);
 
-    static bool
-    isInV6Subnet(boost::asio::ip::address const& addr, boost::asio::ip::network_v6 const& subnet);
+    static Key
+    toKey(boost::asio::ip::address const& addr) noexcept;
+
+    static std::size_t
+    bitAt(Key const& key, std::size_t index) noexcept;
 
     static bool
     isV4(std::string_view net);
@@ -118,6 +143,18 @@ public:
         return whitelist_.isWhiteListed(ip);
     }
 
+    /**
+     * @brief Checks to see if the given already parsed IP is whitelisted
+     *
+     * @param ip The IP to check
+     * @return true if the given IP is whitelisted; false otherwise
+     */
+    bool
+    isWhiteListed(boost::asio::ip::address const& ip) const override
+    {
+        return whitelist_.isWhiteListed(ip);
+    }
+
 private:
     template <SomeResolver HostnameResolverType>
     [[nodiscard]] static std::unordered_set<std::string>
@@ -19,6 +19,8 @@
 
 #pragma once
 
+#include <boost/asio/ip/address.hpp>
+
 #include <string_view>
 
 namespace web::dosguard {
@@ -39,6 +41,15 @@ public:
      */
     [[nodiscard]] virtual bool
     isWhiteListed(std::string_view ip) const = 0;
+
+    /**
+     * @brief Checks to see if the given already parsed IP is whitelisted
+     *
+     * @param ip The IP to check
+     * @return true if the given IP is whitelisted; false otherwise
+     */
+    [[nodiscard]] virtual bool
+    isWhiteListed(boost::asio::ip::address const& ip) const = 0;
 };
 
 }  // namespace web::dosguard
@@ -23,6 +23,7 @@
 #include "rpc/common/Types.hpp"
 #include "util/Taggable.hpp"
 #include "util/log/Logger.hpp"
+#include "util/prometheus/Counter.hpp"
 #include "util/prometheus/Gauge.hpp"
 #include "util/prometheus/Label.hpp"
 #include "util/prometheus/Prometheus.hpp"
@@ -49,16 +50,34 @@
 #include <boost/json/serialize.hpp>
 #include <xrpl/protocol/ErrorCodes.h>
 
+#include <algorithm>
 #include <cstddef>
+#include <deque>
 #include <exception>
 #include <functional>
+#include <iterator>
 #include <memory>
-#include <queue>
 #include <string>
 #include <utility>
 
 namespace web::impl {
 
+/** @brief What to do when the sending queue of a websocket session is full */
+enum class WsOverflowPolicy {
+    DropOldest, /**< drop the oldest queued subscription message; responses to requests are never dropped */
+    Disconnect  /**< close the connection */
+};
+
+/** @brief Limits applied to every websocket session */
+struct WsSettings {
+    static constexpr std::size_t DEFAULT_MAX_REQUESTS_IN_FLIGHT = 16;
+    static constexpr std::size_t DEFAULT_MAX_SENDING_QUEUE_SIZE = 1500;
+
+    std::size_t maxRequestsInFlight = DEFAULT_MAX_REQUESTS_IN_FLIGHT;  // 0 means unlimited
+    std::size_t maxSendingQueueSize = DEFAULT_MAX_SENDING_QUEUE_SIZE;  // 0 means unlimited
+    WsOverflowPolicy overflowPolicy = WsOverflowPolicy::DropOldest;
+};
+
 /**
  * @brief Web socket implementation. This class is the base class of the web socket session, it will handle the read and
  * write operations.
@@ -67,6 +86,11 @@ namespace web::impl {
  * The write operation also supports shared_ptr of string, so the caller can keep the string alive until it is sent.
  * It is useful when we have multiple sessions sending the same content.
  *
+ * Requests are read and handed to the handler without waiting for the responses, up to a limit of requests in flight.
+ * Once the limit is reached, reading stops until one of the requests is answered. The sending queue is bounded as well;
+ * when a client doesn't keep up with the messages it is sent, either its oldest subscription messages are dropped or it
+ * is disconnected, depending on the settings.
+ *
  * @tparam Derived The derived class
  * @tparam HandlerType The handler type, will be called when a request is received.
  */
@@ -74,12 +98,21 @@ template <template <typename> typename Derived, SomeServerHandler HandlerType>
 class WsBase : public ConnectionBase, public std::enable_shared_from_this<WsBase<Derived, HandlerType>> {
     using std::enable_shared_from_this<WsBase<Derived, HandlerType>>::shared_from_this;
 
+    struct Message {
+        std::shared_ptr<std::string> payload;
+        bool isResponse = false;  // responses to requests are never dropped
+    };
+
     std::reference_wrapper<util::prometheus::GaugeInt> messagesLength_;
+    std::reference_wrapper<util::prometheus::CounterInt> droppedMessages_;
 
     boost::beast::flat_buffer buffer_;
     std::reference_wrapper<dosguard::DOSGuardInterface> dosGuard_;
+    WsSettings const settings_;
     bool sending_ = false;
-    std::queue<std::shared_ptr<std::string>> messages_;
+    bool readPaused_ = false;
+    std::size_t requestsInFlight_ = 0;
+    std::deque<Message> messages_;
     std::shared_ptr<HandlerType> const handler_;
 
 protected:
@@ -106,7 +139,8 @@ public:
         std::reference_wrapper<util::TagDecoratorFactory const> tagFactory,
         std::reference_wrapper<dosguard::DOSGuardInterface> dosGuard,
         std::shared_ptr<HandlerType> const& handler,
-        boost::beast::flat_buffer&& buffer
+        boost::beast::flat_buffer&& buffer,
+        WsSettings settings
     )
         : ConnectionBase(tagFactory, ip)
         , messagesLength_(PrometheusService::gaugeInt(
@@ -114,8 +148,14 @@ public:
               util::prometheus::Labels(),
               "The total length of messages in the queue"
           ))
+        , droppedMessages_(PrometheusService::counterInt(
+              "ws_dropped_messages_total_number",
+              util::prometheus::Labels(),
+              "The total number of subscription messages dropped because the client didn't keep up"
+          ))
         , buffer_(std::move(buffer))
         , dosGuard_(dosGuard)
+        , settings_(settings)
         , handler_(handler)
     {
         upgraded = true;  // NOLINT (cppcoreguidelines-pro-type-member-init)
@@ -141,8 +181,9 @@ public:
     doWrite()
     {
         sending_ = true;
+        auto const& payload = messages_.front().payload;
         derived().ws().async_write(
-            boost::asio::buffer(messages_.front()->data(), messages_.front()->size()),
+            boost::asio::buffer(payload->data(), payload->size()),
             boost::beast::bind_front_handler(&WsBase::onWrite, derived().shared_from_this())
         );
     }
@@ -150,7 +191,7 @@ public:
     void
     onWrite(boost::system::error_code ec, std::size_t)
     {
-        messages_.pop();
+        messages_.pop_front();
         --messagesLength_.get();
         sending_ = false;
         if (ec) {
@@ -178,14 +219,7 @@ public:
     void
     send(std::shared_ptr<std::string> msg) override
     {
-        boost::asio::dispatch(
-            derived().ws().get_executor(),
-            [this, self = derived().shared_from_this(), msg = std::move(msg)]() {
-                messages_.push(msg);
-                ++messagesLength_.get();
-                maybeSendNext();
-            }
-        );
+        enqueue(std::move(msg), false);
     }
 
     /**
@@ -210,8 +244,7 @@ public:
             // Reserialize when we need to include this warning
             msg = boost::json::serialize(jsonResponse);
         }
-        auto sharedMsg = std::make_shared<std::string>(std::move(msg));
-        send(std::move(sharedMsg));
+        enqueue(std::make_shared<std::string>(std::move(msg)), true);
     }
 
     /**
@@ -277,11 +310,14 @@ public:
                 e["request"] = std::move(requestStr);
             }
 
-            this->send(std::make_shared<std::string>(boost::json::serialize(e)));
+            enqueue(std::make_shared<std::string>(boost::json::serialize(e)), true);
         };
 
         std::string requestStr{static_cast<char const*>(buffer_.data().data()), buffer_.size()};
 
+        // every request is answered exactly once, either here or by the handler
+        ++requestsInFlight_;
+
         // dosGuard served request++ and check ip address
         if (!dosGuard_.get().request(clientIp)) {
             // TODO: could be useful to count in counters in the future too
@@ -294,7 +330,79 @@ public:
             }
         }
 
+        if (tooManyRequestsInFlight()) {
+            LOG(log_.debug()) << tag() << "Too many requests in flight, pausing reading";
+            readPaused_ = true;
+            return;
+        }
+
         doRead();
     }
+
+private:
+    void
+    enqueue(std::shared_ptr<std::string> msg, bool isResponse)
+    {
+        boost::asio::dispatch(
+            derived().ws().get_executor(),
+            [this, self = derived().shared_from_this(), msg = std::move(msg), isResponse]() mutable {
+                if (isResponse)
+                    onResponse();
+
+                if (dead())
+                    return;
+
+                messages_.push_back({.payload = std::move(msg), .isResponse = isResponse});
+                ++messagesLength_.get();
+
+                handleOverflow();
+                maybeSendNext();
+            }
+        );
+    }
+
+    void
+    onResponse()
+    {
+        if (requestsInFlight_ > 0)
+            --requestsInFlight_;
+
+        if (readPaused_ and not tooManyRequestsInFlight()) {
+            readPaused_ = false;
+            doRead();
+        }
+    }
+
+    bool
+    tooManyRequestsInFlight() const
+    {
+        return settings_.maxRequestsInFlight != 0 and requestsInFlight_ >= settings_.maxRequestsInFlight;
+    }
+
+    void
+    handleOverflow()
+    {
+        if (settings_.maxSendingQueueSize == 0 or messages_.size() <= settings_.maxSendingQueueSize)
+            return;
+
+        if (settings_.overflowPolicy == WsOverflowPolicy::Disconnect) {
+            LOG(log_.warn()) << tag() << "Sending queue is full, disconnecting client " << clientIp;
+            wsFail(boost::asio::error::no_buffer_space, "Sending queue is full");
+            return;
+        }
+
+        // the message being written must stay in the queue until the write completes
+        auto const first = std::next(messages_.begin(), sending_ ? 1 : 0);
+        auto const oldest =
+            std::find_if(first, messages_.end(), [](Message const& message) { return not message.isResponse; });
+
+        // if only responses are queued the queue can't grow much further because of the limit of requests in flight
+        if (oldest == messages_.end())
+            return;
+
+        messages_.erase(oldest);
+        --messagesLength_.get();
+        ++droppedMessages_.get();
+    }
 };
 }  // namespace web::impl
@@ -204,5 +204,9 @@ struct MockBackend : public BackendInterface {
 
     MOCK_METHOD(void, doWriteLedgerObject, (std::string&&, std::uint32_t const, std::string&&), (override));
 
-    MOCK_METHOD(bool, doFinishWrites, (), (override));
+    MOCK_METHOD(void, markLedgerSubmitted, (std::uint32_t), (override));
+
+    MOCK_METHOD(bool, doFinishWrites, (std::uint32_t), (override));
+
+    MOCK_METHOD(void, waitForWrites, (), (override));
 };
@@ -26,7 +26,9 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <optional>
+#include <utility>
 #include <vector>
 
 struct MockCache {
@@ -40,12 +42,28 @@ struct MockCache {
         updateImp(a, b, c);
     }
 
+    MOCK_METHOD(void, restore, (std::vector<data::VersionedLedgerObject> const& a, uint32_t b), ());
+
+    MOCK_METHOD(
+        (std::pair<uint32_t, uint32_t>),
+        forEach,
+        (std::function<void(data::VersionedLedgerObject const&)> const& a),
+        (const)
+    );
+
     MOCK_METHOD(std::optional<data::Blob>, get, (ripple::uint256 const& a, uint32_t b), (const));
 
     MOCK_METHOD(std::optional<data::LedgerObject>, getSuccessor, (ripple::uint256 const& a, uint32_t b), (const));
 
     MOCK_METHOD(std::optional<data::LedgerObject>, getPredecessor, (ripple::uint256 const& a, uint32_t b), (const));
 
+    MOCK_METHOD(
+        std::optional<std::vector<ripple::uint256>>,
+        getBookOffers,
+        (ripple::uint256 const& a, uint32_t b, std::uint32_t c),
+        (const)
+    );
+
     MOCK_METHOD(void, setDisabled, (), ());
 
     MOCK_METHOD(bool, isDisabled, (), (const));
@@ -19,6 +19,7 @@
 #pragma once
 
 #include "data/BackendInterface.hpp"
+#include "etl/InitialLoadCheckpoint.hpp"
 #include "etl/NetworkValidatedLedgersInterface.hpp"
 #include "etl/Source.hpp"
 #include "feed/SubscriptionManagerInterface.hpp"
@@ -59,7 +60,12 @@ struct MockSource : etl::SourceBase {
         (uint32_t, bool, bool),
         (override)
     );
-    MOCK_METHOD((std::pair<std::vector<std::string>, bool>), loadInitialLedger, (uint32_t, uint32_t, bool), (override));
+    MOCK_METHOD(
+        (std::pair<std::vector<std::string>, bool>),
+        loadInitialLedger,
+        (uint32_t, uint32_t, bool, std::shared_ptr<etl::InitialLoadCheckpoint> const&),
+        (override)
+    );
 
     using ForwardToRippledReturnType = std::expected<boost::json::object, rpc::ClioError>;
     MOCK_METHOD(
@@ -125,9 +131,14 @@ public:
     }
 
     std::pair<std::vector<std::string>, bool>
-    loadInitialLedger(uint32_t sequence, uint32_t maxLedger, bool getObjects) override
+    loadInitialLedger(
+        uint32_t sequence,
+        uint32_t maxLedger,
+        bool getObjects,
+        std::shared_ptr<etl::InitialLoadCheckpoint> const& checkpoint
+    ) override
     {
-        return mock_->loadInitialLedger(sequence, maxLedger, getObjects);
+        return mock_->loadInitialLedger(sequence, maxLedger, getObjects, checkpoint);
     }
 
     std::expected<boost::json::object, rpc::ClioError>
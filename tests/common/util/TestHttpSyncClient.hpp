@@ -167,9 +167,20 @@ public:
     std::string
     syncPost(std::string const& body)
     {
-        boost::beast::flat_buffer buffer;
+        write(body);
+        return read();
+    }
 
+    void
+    write(std::string const& body)
+    {
         ws_.write(net::buffer(std::string(body)));
+    }
+
+    std::string
+    read()
+    {
+        boost::beast::flat_buffer buffer;
         ws_.read(buffer);
 
         return boost::beast::buffers_to_string(buffer.data());
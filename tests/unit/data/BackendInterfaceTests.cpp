@@ -30,8 +30,11 @@
 #include <xrpl/basics/XRPAmount.h>
 #include <xrpl/basics/base_uint.h>
 #include <xrpl/protocol/Indexes.h>
+#include <xrpl/protocol/SField.h>
 
+#include <cstdint>
 #include <optional>
+#include <utility>
 #include <vector>
 
 using namespace data;
@@ -137,3 +140,102 @@ TEST_F(BackendInterfaceTest, FetchLedgerPageWithoutCorruptionDetectorDoesNotDisa
     runSpawn([this](auto yield) { backend->fetchLedgerPage(std::nullopt, MAXSEQ, 10, false, yield); });
     EXPECT_FALSE(backend->cache().isDisabled());
 }
+
+namespace {
+
+constexpr auto BOOK = "3B95C29205977C2136BBC70F21895F8C8F471C8522BF446E0000000000000000";
+
+std::pair<ripple::uint256, Blob>
+makeBookDirPage(ripple::uint256 const& root, std::uint64_t page, std::vector<ripple::uint256> const& offers)
+{
+    auto dir = CreateOwnerDirLedgerObject(offers, ripple::to_string(root));
+    dir.setFieldU64(ripple::sfExchangeRate, ripple::getQuality(root));
+    return {page == 0 ? root : ripple::keylet::page(root, page).key, dir.getSerializer().peekData()};
+}
+
+}  // namespace
+
+TEST_F(BackendInterfaceTest, FetchBookOffersFromOrderBookIndex)
+{
+    backend->setRange(MINSEQ, MAXSEQ);
+
+    auto const quality = ripple::getQualityIndex(ripple::uint256{BOOK}, 1);
+    auto const [dirKey, dirBlob] = makeBookDirPage(quality, 0, {ripple::uint256{1}, ripple::uint256{2}});
+    backend->cache().update(
+        {{dirKey, dirBlob}, {ripple::uint256{1}, Blob{'a'}}, {ripple::uint256{2}, Blob{'b'}}}, MAXSEQ
+    );
+    backend->cache().setFull();
+
+    EXPECT_CALL(*backend, doFetchSuccessorKey).Times(0);
+    EXPECT_CALL(*backend, doFetchLedgerObject).Times(0);
+    EXPECT_CALL(*backend, doFetchLedgerObjects).Times(0);
+
+    runSpawn([this](auto yield) {
+        auto const page = backend->fetchBookOffers(ripple::uint256{BOOK}, MAXSEQ, 10, yield);
+        ASSERT_EQ(page.offers.size(), 2u);
+        EXPECT_EQ(page.offers[0].key, ripple::uint256{1});
+        EXPECT_EQ(page.offers[0].blob, Blob{'a'});
+        EXPECT_EQ(page.offers[1].key, ripple::uint256{2});
+    });
+}
+
+TEST_F(BackendInterfaceTest, FetchBookOffersFetchesDirectoryPagesInOneBatch)
+{
+    backend->setRange(MINSEQ, MAXSEQ);
+
+    auto const quality = ripple::getQualityIndex(ripple::uint256{BOOK}, 1);
+    auto root = CreateOwnerDirLedgerObject({ripple::uint256{1}}, ripple::to_string(quality));
+    root.setFieldU64(ripple::sfExchangeRate, 1);
+    root.setFieldU64(ripple::sfIndexNext, 1);
+    root.setFieldU64(ripple::sfIndexPrevious, 2);
+
+    auto page1 = CreateOwnerDirLedgerObject({ripple::uint256{2}}, ripple::to_string(quality));
+    page1.setFieldU64(ripple::sfExchangeRate, 1);
+    page1.setFieldU64(ripple::sfIndexNext, 2);
+    auto const [page2Key, page2Blob] = makeBookDirPage(quality, 2, {ripple::uint256{3}});
+    auto const page1Key = ripple::keylet::page(quality, 1).key;
+
+    EXPECT_CALL(*backend, doFetchSuccessorKey(ripple::uint256{BOOK}, MAXSEQ, _)).WillOnce(Return(quality));
+    EXPECT_CALL(*backend, doFetchSuccessorKey(quality, MAXSEQ, _)).WillOnce(Return(std::nullopt));
+    EXPECT_CALL(*backend, doFetchLedgerObject(quality, MAXSEQ, _)).WillOnce(Return(root.getSerializer().peekData()));
+    EXPECT_CALL(*backend, doFetchLedgerObjects(std::vector{page1Key, page2Key}, MAXSEQ, _))
+        .WillOnce(Return(std::vector<Blob>{page1.getSerializer().peekData(), page2Blob}));
+    EXPECT_CALL(
+        *backend,
+        doFetchLedgerObjects(std::vector{ripple::uint256{1}, ripple::uint256{2}, ripple::uint256{3}}, MAXSEQ, _)
+    )
+        .WillOnce(Return(std::vector<Blob>{{'a'}, {'b'}, {'c'}}));
+
+    runSpawn([this](auto yield) {
+        auto const page = backend->fetchBookOffers(ripple::uint256{BOOK}, MAXSEQ, 100, yield);
+        ASSERT_EQ(page.offers.size(), 3u);
+        EXPECT_EQ(page.offers[2].key, ripple::uint256{3});
+        EXPECT_EQ(page.offers[2].blob, Blob{'c'});
+    });
+}
+
+TEST_F(BackendInterfaceTest, FetchLedgerHeadersUsesCacheAndFetchesEachMissOnce)
+{
+    auto constexpr LEDGERHASH = "4BC50C9B0D8515D3EAAE1E74B29A95804346C491EE1A95BF25E4AAB854A6A652";
+    backend->setRange(MINSEQ, MAXSEQ);
+    backend->ledgerHeaderCache().put(CreateLedgerHeader(LEDGERHASH, MAXSEQ));
+
+    EXPECT_CALL(*backend, fetchLedgerBySequence(MINSEQ, _))
+        .WillOnce(Return(CreateLedgerHeader(LEDGERHASH, MINSEQ)));
+    EXPECT_CALL(*backend, fetchLedgerBySequence(MINSEQ + 1, _)).WillOnce(Return(std::nullopt));
+
+    runSpawn([this](auto yield) {
+        auto const headers = backend->fetchLedgerHeaders({MAXSEQ, MINSEQ + 1, MINSEQ, MAXSEQ, MINSEQ}, yield);
+
+        ASSERT_EQ(headers.size(), 5u);
+        ASSERT_TRUE(headers[0].has_value());
+        EXPECT_EQ(headers[0]->seq, MAXSEQ);
+        EXPECT_FALSE(headers[1].has_value());
+        ASSERT_TRUE(headers[2].has_value());
+        EXPECT_EQ(headers[2]->seq, MINSEQ);
+        ASSERT_TRUE(headers[3].has_value());
+        EXPECT_EQ(headers[3]->seq, MAXSEQ);
+        ASSERT_TRUE(headers[4].has_value());
+        EXPECT_EQ(headers[4]->seq, MINSEQ);
+    });
+}
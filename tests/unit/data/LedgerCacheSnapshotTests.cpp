@@ -0,0 +1,226 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/LedgerCache.hpp"
+#include "data/LedgerCacheSnapshot.hpp"
+#include "data/Types.hpp"
+#include "util/MockPrometheus.hpp"
+#include "util/TmpFile.hpp"
+
+#include <gtest/gtest.h>
+#include <xrpl/basics/base_uint.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <ios>
+#include <utility>
+#include <vector>
+
+using namespace data;
+
+namespace {
+
+constexpr auto KEY1 = "1B8590C01B0006EFFF0000000000000000000000000000000000000000000001";
+constexpr auto KEY2 = "7E8590C01B0006EFFF0000000000000000000000000000000000000000000002";
+constexpr auto KEY3 = "E08590C01B0006EFFF0000000000000000000000000000000000000000000003";
+
+// checks that the objects are written to disk while the cache is being visited rather than buffered
+struct DiskCheckingCache {
+    LedgerCache const& cache;
+    std::filesystem::path tmpPath;
+
+    std::pair<uint32_t, uint32_t>
+    forEach(std::function<void(VersionedLedgerObject const&)> const& visitor) const
+    {
+        return cache.forEach([this, &visitor](VersionedLedgerObject const& obj) {
+            EXPECT_TRUE(std::filesystem::exists(tmpPath));
+            visitor(obj);
+        });
+    }
+};
+
+// a cache whose shards were visited at different ledgers
+struct FixedCache {
+    std::vector<VersionedLedgerObject> objects;
+    uint32_t seq = 0;
+    uint32_t latestSeq = 0;
+
+    std::pair<uint32_t, uint32_t>
+    forEach(std::function<void(VersionedLedgerObject const&)> const& visitor) const
+    {
+        for (auto const& obj : objects)
+            visitor(obj);
+        return {seq, latestSeq};
+    }
+};
+
+}  // namespace
+
+struct LedgerCacheSnapshotTests : util::prometheus::WithPrometheus {
+    TmpFile const file{""};
+    LedgerCache cache;
+
+    LedgerCacheSnapshotTests()
+    {
+        cache.update({{ripple::uint256{KEY1}, {'a'}}, {ripple::uint256{KEY2}, {'b', 'b'}}}, 1);
+        cache.update({{ripple::uint256{KEY2}, {'c'}}, {ripple::uint256{KEY3}, {'d', 'd', 'd'}}}, 2);
+        cache.setFull();
+    }
+
+    void
+    corruptByteAt(std::size_t offset) const
+    {
+        std::fstream stream{file.path, std::ios::in | std::ios::out | std::ios::binary};
+        stream.seekg(static_cast<std::streamoff>(offset));
+        auto const byte = static_cast<char>(stream.get());
+        stream.seekp(static_cast<std::streamoff>(offset));
+        stream.put(static_cast<char>(byte ^ 1));
+    }
+};
+
+TEST_F(LedgerCacheSnapshotTests, WriteAndRestore)
+{
+    auto const written = LedgerCacheSnapshot::write(cache, file.path);
+    ASSERT_TRUE(written.has_value()) << written.error();
+    EXPECT_EQ(*written, 2u);
+
+    auto const snapshot = LedgerCacheSnapshot::open(file.path);
+    ASSERT_TRUE(snapshot.has_value()) << snapshot.error();
+    EXPECT_EQ(snapshot->seq(), 2u);
+    EXPECT_EQ(snapshot->latestSeq(), 2u);
+    EXPECT_EQ(snapshot->size(), 3u);
+
+    LedgerCache restored;
+    snapshot->restoreInto(restored);
+    restored.setFull();
+
+    EXPECT_EQ(restored.size(), 3u);
+    EXPECT_EQ(restored.latestLedgerSequence(), 2u);
+    EXPECT_EQ(restored.get(ripple::uint256{KEY1}, 1), Blob{'a'});
+    EXPECT_EQ(restored.get(ripple::uint256{KEY2}, 2), Blob{'c'});
+    EXPECT_FALSE(restored.get(ripple::uint256{KEY3}, 1));
+    EXPECT_EQ(restored.get(ripple::uint256{KEY3}, 2), (Blob{'d', 'd', 'd'}));
+    EXPECT_EQ(restored.getSuccessor(ripple::uint256{KEY1}, 2), (LedgerObject{ripple::uint256{KEY2}, {'c'}}));
+
+    // the restored cache keeps receiving updates as usual
+    restored.update({{ripple::uint256{KEY1}, {}}}, 3);
+    EXPECT_FALSE(restored.get(ripple::uint256{KEY1}, 3));
+    EXPECT_EQ(restored.get(ripple::uint256{KEY1}, 2), Blob{'a'});
+}
+
+TEST_F(LedgerCacheSnapshotTests, WritesWhileVisitingCache)
+{
+    DiskCheckingCache const checking{.cache = cache, .tmpPath = file.path + ".tmp"};
+    auto const written = LedgerCacheSnapshot::write(checking, file.path);
+    ASSERT_TRUE(written.has_value()) << written.error();
+    EXPECT_EQ(*written, 2u);
+    EXPECT_FALSE(std::filesystem::exists(file.path + ".tmp"));
+
+    auto const snapshot = LedgerCacheSnapshot::open(file.path);
+    ASSERT_TRUE(snapshot.has_value()) << snapshot.error();
+    EXPECT_EQ(snapshot->size(), 3u);
+}
+
+TEST_F(LedgerCacheSnapshotTests, CatchingUpFromOldestShardRestoresLatestLedger)
+{
+    // KEY1 is deleted and KEY3 is modified in ledger 2; the shard of KEY1 was visited before that ledger and the shard
+    // of KEY3 after it
+    FixedCache const fixed{
+        .objects = {{{ripple::uint256{KEY1}, {'a'}}, 1}, {{ripple::uint256{KEY3}, {'y'}}, 2}},
+        .seq = 1,
+        .latestSeq = 2
+    };
+    auto const written = LedgerCacheSnapshot::write(fixed, file.path);
+    ASSERT_TRUE(written.has_value()) << written.error();
+    EXPECT_EQ(*written, 1u);
+
+    auto const snapshot = LedgerCacheSnapshot::open(file.path);
+    ASSERT_TRUE(snapshot.has_value()) << snapshot.error();
+    EXPECT_EQ(snapshot->seq(), 1u);
+    EXPECT_EQ(snapshot->latestSeq(), 2u);
+
+    LedgerCache restored;
+    snapshot->restoreInto(restored);
+    EXPECT_EQ(restored.latestLedgerSequence(), 1u);
+
+    restored.update({{ripple::uint256{KEY1}, {}}, {ripple::uint256{KEY3}, {'y'}}}, 2);
+    restored.setFull();
+
+    EXPECT_EQ(restored.size(), 1u);
+    EXPECT_FALSE(restored.get(ripple::uint256{KEY1}, 2));
+    EXPECT_EQ(restored.get(ripple::uint256{KEY3}, 2), Blob{'y'});
+}
+
+TEST_F(LedgerCacheSnapshotTests, EmptyCache)
+{
+    LedgerCache empty;
+    empty.update({}, 5);
+    empty.setFull();
+    ASSERT_TRUE(LedgerCacheSnapshot::write(empty, file.path).has_value());
+
+    auto const snapshot = LedgerCacheSnapshot::open(file.path);
+    ASSERT_TRUE(snapshot.has_value()) << snapshot.error();
+    EXPECT_EQ(snapshot->size(), 0u);
+
+    LedgerCache restored;
+    snapshot->restoreInto(restored);
+    EXPECT_EQ(restored.size(), 0u);
+    EXPECT_EQ(restored.latestLedgerSequence(), 5u);
+}
+
+TEST_F(LedgerCacheSnapshotTests, MissingFile)
+{
+    std::filesystem::remove(file.path);
+    EXPECT_FALSE(LedgerCacheSnapshot::open(file.path).has_value());
+}
+
+TEST_F(LedgerCacheSnapshotTests, NotASnapshot)
+{
+    std::ofstream{file.path} << "definitely not a snapshot of the ledger cache, but long enough to have a header";
+    EXPECT_FALSE(LedgerCacheSnapshot::open(file.path).has_value());
+}
+
+TEST_F(LedgerCacheSnapshotTests, CorruptedHeader)
+{
+    ASSERT_TRUE(LedgerCacheSnapshot::write(cache, file.path).has_value());
+    corruptByteAt(16);
+    EXPECT_FALSE(LedgerCacheSnapshot::open(file.path).has_value());
+}
+
+TEST_F(LedgerCacheSnapshotTests, CorruptedObjects)
+{
+    ASSERT_TRUE(LedgerCacheSnapshot::write(cache, file.path).has_value());
+    corruptByteAt(std::filesystem::file_size(file.path) - 1);
+    EXPECT_FALSE(LedgerCacheSnapshot::open(file.path).has_value());
+}
+
+TEST_F(LedgerCacheSnapshotTests, Truncated)
+{
+    ASSERT_TRUE(LedgerCacheSnapshot::write(cache, file.path).has_value());
+    std::filesystem::resize_file(file.path, std::filesystem::file_size(file.path) - 1);
+    EXPECT_FALSE(LedgerCacheSnapshot::open(file.path).has_value());
+}
+
+TEST_F(LedgerCacheSnapshotTests, WriteToMissingDirectoryFails)
+{
+    EXPECT_FALSE(LedgerCacheSnapshot::write(cache, file.path + "/missing/snapshot").has_value());
+}
@@ -0,0 +1,350 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/LedgerCache.hpp"
+#include "data/Types.hpp"
+#include "util/MockPrometheus.hpp"
+
+#include <gtest/gtest.h>
+#include <xrpl/basics/base_uint.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace data;
+
+namespace {
+
+constexpr auto KEY1 = "1B8590C01B0006EFFF0000000000000000000000000000000000000000000001";
+constexpr auto KEY2 = "1B8590C01B0006EFFF0000000000000000000000000000000000000000000002";
+constexpr auto KEY3 = "7E8590C01B0006EFFF0000000000000000000000000000000000000000000003";
+constexpr auto KEY4 = "E08590C01B0006EFFF0000000000000000000000000000000000000000000004";
+
+}  // namespace
+
+struct LedgerCacheTests : util::prometheus::WithPrometheus {
+    LedgerCache cache;
+};
+
+TEST_F(LedgerCacheTests, EmptyByDefault)
+{
+    EXPECT_EQ(cache.size(), 0u);
+    EXPECT_EQ(cache.latestLedgerSequence(), 0u);
+    EXPECT_FALSE(cache.isFull());
+    EXPECT_FALSE(cache.get(ripple::uint256{KEY1}, 0));
+}
+
+TEST_F(LedgerCacheTests, UpdateAndGet)
+{
+    cache.update({{ripple::uint256{KEY1}, {'a'}}, {ripple::uint256{KEY3}, {'b'}}}, 1);
+
+    EXPECT_EQ(cache.size(), 2u);
+    EXPECT_EQ(cache.latestLedgerSequence(), 1u);
+    EXPECT_EQ(cache.get(ripple::uint256{KEY1}, 1), Blob{'a'});
+    EXPECT_EQ(cache.get(ripple::uint256{KEY3}, 1), Blob{'b'});
+    EXPECT_FALSE(cache.get(ripple::uint256{KEY2}, 1));
+    EXPECT_FALSE(cache.get(ripple::uint256{KEY1}, 2));
+
+    cache.update({{ripple::uint256{KEY1}, {'c'}}, {ripple::uint256{KEY3}, {}}}, 2);
+
+    EXPECT_EQ(cache.size(), 1u);
+    EXPECT_EQ(cache.get(ripple::uint256{KEY1}, 2), Blob{'c'});
+    EXPECT_FALSE(cache.get(ripple::uint256{KEY1}, 1));
+    EXPECT_FALSE(cache.get(ripple::uint256{KEY3}, 2));
+}
+
+TEST_F(LedgerCacheTests, SuccessorAndPredecessorRequireFullCache)
+{
+    cache.update({{ripple::uint256{KEY1}, {'a'}}, {ripple::uint256{KEY3}, {'b'}}}, 1);
+    EXPECT_FALSE(cache.getSuccessor(ripple::uint256{KEY1}, 1));
+    EXPECT_FALSE(cache.getPredecessor(ripple::uint256{KEY3}, 1));
+
+    cache.setFull();
+    EXPECT_TRUE(cache.getSuccessor(ripple::uint256{KEY1}, 1));
+    EXPECT_TRUE(cache.getPredecessor(ripple::uint256{KEY3}, 1));
+}
+
+TEST_F(LedgerCacheTests, SuccessorAndPredecessorCrossShards)
+{
+    cache.update(
+        {{ripple::uint256{KEY1}, {'a'}},
+         {ripple::uint256{KEY2}, {'b'}},
+         {ripple::uint256{KEY3}, {'c'}},
+         {ripple::uint256{KEY4}, {'d'}}},
+        1
+    );
+    cache.setFull();
+
+    EXPECT_EQ(cache.getSuccessor(firstKey, 1), (LedgerObject{ripple::uint256{KEY1}, {'a'}}));
+    EXPECT_EQ(cache.getSuccessor(ripple::uint256{KEY1}, 1), (LedgerObject{ripple::uint256{KEY2}, {'b'}}));
+    EXPECT_EQ(cache.getSuccessor(ripple::uint256{KEY2}, 1), (LedgerObject{ripple::uint256{KEY3}, {'c'}}));
+    EXPECT_EQ(cache.getSuccessor(ripple::uint256{KEY3}, 1), (LedgerObject{ripple::uint256{KEY4}, {'d'}}));
+    EXPECT_FALSE(cache.getSuccessor(ripple::uint256{KEY4}, 1));
+
+    EXPECT_EQ(cache.getPredecessor(lastKey, 1), (LedgerObject{ripple::uint256{KEY4}, {'d'}}));
+    EXPECT_EQ(cache.getPredecessor(ripple::uint256{KEY4}, 1), (LedgerObject{ripple::uint256{KEY3}, {'c'}}));
+    EXPECT_EQ(cache.getPredecessor(ripple::uint256{KEY3}, 1), (LedgerObject{ripple::uint256{KEY2}, {'b'}}));
+    EXPECT_FALSE(cache.getPredecessor(ripple::uint256{KEY1}, 1));
+
+    cache.update({{ripple::uint256{KEY3}, {}}}, 2);
+    EXPECT_EQ(cache.getSuccessor(ripple::uint256{KEY2}, 1), (LedgerObject{ripple::uint256{KEY3}, {'c'}}));
+    EXPECT_EQ(cache.getSuccessor(ripple::uint256{KEY2}, 2), (LedgerObject{ripple::uint256{KEY4}, {'d'}}));
+}
+
+TEST_F(LedgerCacheTests, ForEachInRangeVisitsOnlyKeysOfRange)
+{
+    cache.update(
+        {{ripple::uint256{KEY4}, {'d'}},
+         {ripple::uint256{KEY2}, {'b'}},
+         {ripple::uint256{KEY3}, {'c'}},
+         {ripple::uint256{KEY1}, {'a'}}},
+        1
+    );
+
+    auto const collect = [this](ripple::uint256 const& first, std::optional<ripple::uint256> const& last) {
+        std::vector<LedgerObject> objs;
+        cache.forEachInRange(first, last, [&objs](LedgerObject const& obj) { objs.push_back(obj); });
+        return objs;
+    };
+
+    EXPECT_EQ(
+        collect(firstKey, std::nullopt),
+        (std::vector<LedgerObject>{
+            {ripple::uint256{KEY1}, {'a'}},
+            {ripple::uint256{KEY2}, {'b'}},
+            {ripple::uint256{KEY3}, {'c'}},
+            {ripple::uint256{KEY4}, {'d'}}
+        })
+    );
+    EXPECT_EQ(
+        collect(ripple::uint256{KEY2}, ripple::uint256{KEY4}),
+        (std::vector<LedgerObject>{{ripple::uint256{KEY2}, {'b'}}, {ripple::uint256{KEY3}, {'c'}}})
+    );
+    EXPECT_EQ(
+        collect(ripple::uint256{KEY4}, std::nullopt), (std::vector<LedgerObject>{{ripple::uint256{KEY4}, {'d'}}})
+    );
+    EXPECT_TRUE(collect(ripple::uint256{KEY2}, ripple::uint256{KEY2}).empty());
+
+    // ranges split by leading byte end at the first key of a shard
+    auto const shardStart = [](unsigned char leadingByte) {
+        ripple::uint256 key;
+        key.data()[0] = leadingByte;
+        return key;
+    };
+    EXPECT_EQ(
+        collect(firstKey, shardStart(0x7E)),
+        (std::vector<LedgerObject>{{ripple::uint256{KEY1}, {'a'}}, {ripple::uint256{KEY2}, {'b'}}})
+    );
+    EXPECT_EQ(
+        collect(shardStart(0x7E), shardStart(0xE0)), (std::vector<LedgerObject>{{ripple::uint256{KEY3}, {'c'}}})
+    );
+    EXPECT_TRUE(collect(firstKey, firstKey).empty());
+}
+
+TEST_F(LedgerCacheTests, ForEachVisitsAllObjectsInKeyOrder)
+{
+    cache.update({{ripple::uint256{KEY4}, {'d'}}, {ripple::uint256{KEY1}, {'a'}}}, 1);
+    cache.update({{ripple::uint256{KEY3}, {'c'}}}, 2);
+
+    std::vector<VersionedLedgerObject> objs;
+    auto const [oldestSeq, latestSeq] = cache.forEach([&objs](VersionedLedgerObject const& obj) {
+        objs.push_back(obj);
+    });
+
+    EXPECT_EQ(
+        objs,
+        (std::vector<VersionedLedgerObject>{
+            {{ripple::uint256{KEY1}, {'a'}}, 1},
+            {{ripple::uint256{KEY3}, {'c'}}, 2},
+            {{ripple::uint256{KEY4}, {'d'}}, 1}
+        })
+    );
+    EXPECT_EQ(oldestSeq, 2u);
+    EXPECT_EQ(latestSeq, 2u);
+}
+
+TEST_F(LedgerCacheTests, BackgroundUpdateDoesNotResurrectDeleted)
+{
+    cache.update({{ripple::uint256{KEY1}, {'a'}}}, 1);
+    cache.update({{ripple::uint256{KEY1}, {}}}, 2);
+    cache.update({{ripple::uint256{KEY1}, {'b'}}}, 1, true);
+
+    EXPECT_FALSE(cache.get(ripple::uint256{KEY1}, 2));
+    EXPECT_EQ(cache.size(), 0u);
+}
+
+TEST_F(LedgerCacheTests, DisabledCacheIgnoresUpdates)
+{
+    cache.setDisabled();
+    cache.update({{ripple::uint256{KEY1}, {'a'}}}, 1);
+
+    EXPECT_TRUE(cache.isDisabled());
+    EXPECT_EQ(cache.size(), 0u);
+    EXPECT_FALSE(cache.get(ripple::uint256{KEY1}, 1));
+}
+
+TEST_F(LedgerCacheTests, WaitUntilCacheContainsSeq)
+{
+    cache.update({{ripple::uint256{KEY1}, {'a'}}}, 1);
+
+    std::thread writer{[this] { cache.update({{ripple::uint256{KEY2}, {'b'}}}, 2); }};
+    cache.waitUntilCacheContainsSeq(2);
+    writer.join();
+
+    EXPECT_EQ(cache.latestLedgerSequence(), 2u);
+}
+
+TEST_F(LedgerCacheTests, ServesRecentLedgersOnceFull)
+{
+    cache.setNumRecentLedgers(2);
+    cache.update({{ripple::uint256{KEY1}, {'a'}}, {ripple::uint256{KEY3}, {'c'}}}, 1);
+    cache.setFull();
+
+    cache.update({{ripple::uint256{KEY1}, {'b'}}, {ripple::uint256{KEY2}, {'x'}}, {ripple::uint256{KEY3}, {}}}, 2);
+    cache.update({{ripple::uint256{KEY4}, {'d'}}}, 3);
+
+    EXPECT_EQ(cache.get(ripple::uint256{KEY1}, 1), Blob{'a'});
+    EXPECT_EQ(cache.get(ripple::uint256{KEY1}, 2), Blob{'b'});
+    EXPECT_EQ(cache.get(ripple::uint256{KEY3}, 1), Blob{'c'});
+    EXPECT_FALSE(cache.get(ripple::uint256{KEY3}, 2));
+    EXPECT_FALSE(cache.get(ripple::uint256{KEY4}, 2));
+
+    EXPECT_EQ(cache.getSuccessor(ripple::uint256{KEY1}, 1), (LedgerObject{ripple::uint256{KEY3}, {'c'}}));
+    EXPECT_EQ(cache.getSuccessor(ripple::uint256{KEY1}, 2), (LedgerObject{ripple::uint256{KEY2}, {'x'}}));
+    EXPECT_FALSE(cache.getSuccessor(ripple::uint256{KEY2}, 2));
+    EXPECT_EQ(cache.getSuccessor(ripple::uint256{KEY2}, 3), (LedgerObject{ripple::uint256{KEY4}, {'d'}}));
+
+    EXPECT_EQ(cache.getPredecessor(lastKey, 1), (LedgerObject{ripple::uint256{KEY3}, {'c'}}));
+    EXPECT_EQ(cache.getPredecessor(lastKey, 2), (LedgerObject{ripple::uint256{KEY2}, {'x'}}));
+    EXPECT_EQ(cache.getPredecessor(ripple::uint256{KEY2}, 1), (LedgerObject{ripple::uint256{KEY1}, {'a'}}));
+}
+
+TEST_F(LedgerCacheTests, DoesNotServeLedgersOutsideOfWindow)
+{
+    cache.setNumRecentLedgers(1);
+    cache.update({{ripple::uint256{KEY1}, {'a'}}}, 1);
+    cache.setFull();
+    cache.update({{ripple::uint256{KEY1}, {'b'}}}, 2);
+    cache.update({{ripple::uint256{KEY1}, {'c'}}}, 3);
+
+    EXPECT_EQ(cache.get(ripple::uint256{KEY1}, 2), Blob{'b'});
+    EXPECT_FALSE(cache.get(ripple::uint256{KEY1}, 1));
+    EXPECT_FALSE(cache.getSuccessor(firstKey, 1));
+    EXPECT_TRUE(cache.getSuccessor(firstKey, 2));
+}
+
+TEST_F(LedgerCacheTests, RecentLedgersAreNotServedWhileLoading)
+{
+    cache.update({{ripple::uint256{KEY1}, {'a'}}}, 1);
+    cache.update({{ripple::uint256{KEY1}, {'b'}}}, 2);
+    cache.setFull();
+
+    EXPECT_FALSE(cache.get(ripple::uint256{KEY1}, 1));
+    EXPECT_FALSE(cache.getSuccessor(firstKey, 1));
+    EXPECT_TRUE(cache.getSuccessor(firstKey, 2));
+}
+
+struct LedgerCacheMemoryModeTests : util::prometheus::WithPrometheus,
+                                    ::testing::WithParamInterface<LedgerCache::MemoryMode> {
+    static constexpr std::size_t NUM_OBJECTS = 5'000;
+
+    LedgerCache cache;
+
+    // objects sharing most of their content, much like serialized ledger entries do
+    static std::vector<LedgerObject>
+    makeObjects(uint32_t seq, std::size_t step, bool singleShard = false)
+    {
+        std::vector<LedgerObject> objs;
+        for (std::size_t i = 0; i < NUM_OBJECTS; i += step) {
+            ripple::uint256 key{static_cast<uint64_t>(i)};
+            if (not singleShard)
+                *key.begin() = static_cast<unsigned char>(i);
+
+            Blob blob(100, 'x');
+            blob[i % blob.size()] = static_cast<unsigned char>(seq);
+            objs.push_back({key, std::move(blob)});
+        }
+        return objs;
+    }
+};
+
+INSTANTIATE_TEST_SUITE_P(
+    LedgerCacheMemoryModeTestsGroup,
+    LedgerCacheMemoryModeTests,
+    ::testing::Values(
+        LedgerCache::MemoryMode::Default,
+        LedgerCache::MemoryMode::Compact,
+        LedgerCache::MemoryMode::Compressed
+    )
+);
+
+TEST_P(LedgerCacheMemoryModeTests, ServesSameDataInEveryMode)
+{
+    std::map<ripple::uint256, Blob> expected;
+    for (auto const& obj : makeObjects(1, 1))
+        expected[obj.key] = obj.blob;
+
+    cache.setMemoryMode(GetParam());
+    cache.update(makeObjects(1, 1), 1);
+    cache.setFull();
+
+    for (uint32_t seq = 2; seq <= 10; ++seq)
+        cache.update(makeObjects(seq, 2), seq);
+
+    auto const previous = makeObjects(9, 2);
+    for (auto const& obj : makeObjects(10, 2))
+        expected[obj.key] = obj.blob;
+
+    EXPECT_EQ(cache.size(), NUM_OBJECTS);
+    EXPECT_GT(cache.bytes(), 0u);
+    EXPECT_EQ(cache.get(previous.front().key, 9), previous.front().blob);
+
+    for (auto it = expected.begin(); std::next(it) != expected.end(); ++it) {
+        EXPECT_EQ(cache.get(it->first, 10), it->second);
+
+        auto const succ = cache.getSuccessor(it->first, 10);
+        ASSERT_TRUE(succ);
+        EXPECT_EQ(succ->key, std::next(it)->first);
+        EXPECT_EQ(succ->blob, std::next(it)->second);
+    }
+}
+
+TEST_F(LedgerCacheTests, CompactModesUseLessMemory)
+{
+    // all in one shard so that the arena of the shard is much larger than its last partially filled chunk
+    auto const objs = LedgerCacheMemoryModeTests::makeObjects(1, 1, true);
+    cache.update(objs, 1);
+
+    LedgerCache compact;
+    compact.setMemoryMode(LedgerCache::MemoryMode::Compact);
+    compact.update(objs, 1);
+
+    LedgerCache compressed;
+    compressed.setMemoryMode(LedgerCache::MemoryMode::Compressed);
+    compressed.update(objs, 1);
+
+    EXPECT_LT(compact.bytes(), cache.bytes());
+    EXPECT_LT(compressed.bytes(), compact.bytes());
+}
@@ -0,0 +1,84 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/LedgerHeaderCache.hpp"
+#include "util/TestObject.hpp"
+
+#include <gtest/gtest.h>
+#include <xrpl/basics/strHex.h>
+
+#include <cstdint>
+
+using namespace data;
+
+namespace {
+
+constexpr auto LEDGERHASH = "4BC50C9B0D8515D3EAAE1E74B29A95804346C491EE1A95BF25E4AAB854A6A652";
+
+}  // namespace
+
+TEST(LedgerHeaderCacheTest, GetReturnsNulloptWhenEmpty)
+{
+    LedgerHeaderCache const cache{4};
+    EXPECT_FALSE(cache.get(1).has_value());
+}
+
+TEST(LedgerHeaderCacheTest, GetReturnsStoredHeader)
+{
+    LedgerHeaderCache cache{4};
+    cache.put(CreateLedgerHeader(LEDGERHASH, 10));
+
+    auto const header = cache.get(10);
+    ASSERT_TRUE(header.has_value());
+    EXPECT_EQ(header->seq, 10u);
+    EXPECT_EQ(ripple::strHex(header->hash), LEDGERHASH);
+
+    EXPECT_FALSE(cache.get(11).has_value());
+}
+
+TEST(LedgerHeaderCacheTest, NewerHeaderReplacesCollidingOne)
+{
+    LedgerHeaderCache cache{4};
+    cache.put(CreateLedgerHeader(LEDGERHASH, 10));
+    cache.put(CreateLedgerHeader(LEDGERHASH, 14));
+
+    EXPECT_FALSE(cache.get(10).has_value());
+    ASSERT_TRUE(cache.get(14).has_value());
+}
+
+TEST(LedgerHeaderCacheTest, OlderHeaderDoesNotReplaceCollidingOne)
+{
+    LedgerHeaderCache cache{4};
+    cache.put(CreateLedgerHeader(LEDGERHASH, 14));
+    cache.put(CreateLedgerHeader(LEDGERHASH, 10));
+
+    EXPECT_FALSE(cache.get(10).has_value());
+    ASSERT_TRUE(cache.get(14).has_value());
+}
+
+TEST(LedgerHeaderCacheTest, Clear)
+{
+    LedgerHeaderCache cache{4};
+    for (std::uint32_t seq = 10; seq < 14; ++seq)
+        cache.put(CreateLedgerHeader(LEDGERHASH, seq));
+
+    cache.clear();
+    for (std::uint32_t seq = 10; seq < 14; ++seq)
+        EXPECT_FALSE(cache.get(seq).has_value());
+}
@@ -0,0 +1,121 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/TransactionCache.hpp"
+#include "data/Types.hpp"
+#include "util/MockPrometheus.hpp"
+
+#include <gtest/gtest.h>
+#include <xrpl/basics/base_uint.h>
+
+#include <cstddef>
+#include <cstdint>
+
+using namespace data;
+
+namespace {
+
+TransactionAndMetadata
+makeTransaction(std::size_t size, std::uint32_t seq)
+{
+    return TransactionAndMetadata{Blob(size, 't'), Blob(size, 'm'), seq, seq};
+}
+
+}  // namespace
+
+struct TransactionCacheTests : util::prometheus::WithPrometheus {
+    static constexpr std::size_t TXN_SIZE = 100;
+    // room for exactly three transactions of TXN_SIZE
+    TransactionCache cache{3 * (2 * TXN_SIZE + 128)};
+};
+
+TEST_F(TransactionCacheTests, GetReturnsStoredTransaction)
+{
+    auto const txn = makeTransaction(TXN_SIZE, 1);
+    cache.put(ripple::uint256{1}, txn);
+
+    EXPECT_EQ(cache.get(ripple::uint256{1}), txn);
+    EXPECT_FALSE(cache.get(ripple::uint256{2}).has_value());
+    EXPECT_EQ(cache.size(), 1u);
+}
+
+TEST_F(TransactionCacheTests, EmptyTransactionIsNotStored)
+{
+    cache.put(ripple::uint256{1}, TransactionAndMetadata{});
+
+    EXPECT_FALSE(cache.get(ripple::uint256{1}).has_value());
+    EXPECT_EQ(cache.size(), 0u);
+}
+
+TEST_F(TransactionCacheTests, EvictsLeastRecentlyUsed)
+{
+    for (std::uint32_t i = 1; i <= 3; ++i)
+        cache.put(ripple::uint256{i}, makeTransaction(TXN_SIZE, i));
+
+    // makes the first one the most recently used
+    EXPECT_TRUE(cache.get(ripple::uint256{1}).has_value());
+
+    cache.put(ripple::uint256{4}, makeTransaction(TXN_SIZE, 4));
+
+    EXPECT_EQ(cache.size(), 3u);
+    EXPECT_TRUE(cache.get(ripple::uint256{1}).has_value());
+    EXPECT_FALSE(cache.get(ripple::uint256{2}).has_value());
+    EXPECT_TRUE(cache.get(ripple::uint256{3}).has_value());
+    EXPECT_TRUE(cache.get(ripple::uint256{4}).has_value());
+}
+
+TEST_F(TransactionCacheTests, TransactionBiggerThanCacheIsNotStored)
+{
+    cache.put(ripple::uint256{1}, makeTransaction(TXN_SIZE, 1));
+    cache.put(ripple::uint256{2}, makeTransaction(10 * TXN_SIZE, 2));
+
+    EXPECT_TRUE(cache.get(ripple::uint256{1}).has_value());
+    EXPECT_FALSE(cache.get(ripple::uint256{2}).has_value());
+}
+
+TEST_F(TransactionCacheTests, ShrinkingEvicts)
+{
+    for (std::uint32_t i = 1; i <= 3; ++i)
+        cache.put(ripple::uint256{i}, makeTransaction(TXN_SIZE, i));
+
+    cache.setMaxBytes(2 * TXN_SIZE + 128);
+
+    EXPECT_EQ(cache.size(), 1u);
+    EXPECT_TRUE(cache.get(ripple::uint256{3}).has_value());
+}
+
+TEST_F(TransactionCacheTests, DisabledWhenMaxBytesIsZero)
+{
+    cache.setMaxBytes(0);
+    EXPECT_FALSE(cache.isEnabled());
+
+    cache.put(ripple::uint256{1}, makeTransaction(TXN_SIZE, 1));
+    EXPECT_FALSE(cache.get(ripple::uint256{1}).has_value());
+    EXPECT_EQ(cache.bytes(), 0u);
+}
+
+TEST_F(TransactionCacheTests, Clear)
+{
+    cache.put(ripple::uint256{1}, makeTransaction(TXN_SIZE, 1));
+    cache.clear();
+
+    EXPECT_FALSE(cache.get(ripple::uint256{1}).has_value());
+    EXPECT_EQ(cache.size(), 0u);
+    EXPECT_EQ(cache.bytes(), 0u);
+}
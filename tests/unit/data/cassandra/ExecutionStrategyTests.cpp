@@ -24,7 +24,9 @@
 #include "util/AsioContextTestFixture.hpp"
 
 #include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
 #include <boost/asio/spawn.hpp>
+#include <boost/asio/thread_pool.hpp>
 #include <boost/json/object.hpp>
 #include <cassandra.h>
 #include <gmock/gmock.h>
@@ -34,6 +36,7 @@
 #include <chrono>
 #include <cstdint>
 #include <functional>
+#include <future>
 #include <memory>
 #include <optional>
 #include <stdexcept>
@@ -335,6 +338,72 @@ TEST_F(BackendCassandraExecutionStrategyTest, ReadEachInCoroutineThrowsOnFailure
     });
 }
 
+TEST_F(BackendCassandraExecutionStrategyTest, ReadEachWithLimitKeepsAtMostLimitInFlight)
+{
+    static constexpr auto NUM_MANY_STATEMENTS = 20u;
+    static constexpr auto MAX_IN_FLIGHT = 3u;
+
+    auto strat = makeStrategy();
+    auto pool = boost::asio::thread_pool{4};
+    auto inFlight = std::atomic_uint{0};
+    auto maxSeenInFlight = std::atomic_uint{0};
+
+    ON_CALL(handle, asyncExecute(A<FakeStatement const&>(), A<std::function<void(FakeResultOrError)>&&>()))
+        .WillByDefault([&](auto const&, auto&& cb) {
+            auto const current = ++inFlight;
+            auto seen = maxSeenInFlight.load();
+            while (seen < current and not maxSeenInFlight.compare_exchange_weak(seen, current)) {
+            }
+
+            boost::asio::post(pool, [&inFlight, cb = std::move(cb)]() {
+                std::this_thread::sleep_for(std::chrono::milliseconds{1});
+                --inFlight;
+                cb({});  // pretend we got data
+            });
+            return FakeFutureWithCallback{};
+        });
+    EXPECT_CALL(handle, asyncExecute(A<FakeStatement const&>(), A<std::function<void(FakeResultOrError)>&&>()))
+        .Times(NUM_MANY_STATEMENTS);
+    EXPECT_CALL(*counters, registerReadStartedImpl(NUM_MANY_STATEMENTS));
+    EXPECT_CALL(*counters, registerReadFinishedImpl(testing::_, NUM_MANY_STATEMENTS));
+
+    runSpawn([&strat](boost::asio::yield_context yield) {
+        auto statements = std::vector<FakeStatement>(NUM_MANY_STATEMENTS);
+        auto res = strat.readEach(yield, statements, MAX_IN_FLIGHT);
+        EXPECT_EQ(res.size(), statements.size());
+    });
+    pool.join();
+
+    EXPECT_LE(maxSeenInFlight, MAX_IN_FLIGHT);
+    EXPECT_GT(maxSeenInFlight, 1u);
+}
+
+TEST_F(BackendCassandraExecutionStrategyTest, ReadEachWithLimitThrowsOnFailure)
+{
+    auto strat = makeStrategy();
+    auto callCount = std::atomic_int{0};
+
+    ON_CALL(handle, asyncExecute(A<FakeStatement const&>(), A<std::function<void(FakeResultOrError)>&&>()))
+        .WillByDefault([&callCount](auto const&, auto&& cb) {
+            if (callCount++ == 1) {  // error happens on one of the entries
+                cb({CassandraError{"invalid data", CASS_ERROR_LIB_INVALID_DATA}});
+            } else {
+                cb({});  // pretend we got data
+            }
+            return FakeFutureWithCallback{};
+        });
+    EXPECT_CALL(handle, asyncExecute(A<FakeStatement const&>(), A<std::function<void(FakeResultOrError)>&&>()))
+        .Times(NUM_STATEMENTS);  // remaining statements are still executed
+    EXPECT_CALL(*counters, registerReadStartedImpl(NUM_STATEMENTS));
+    EXPECT_CALL(*counters, registerReadErrorImpl(1));
+    EXPECT_CALL(*counters, registerReadFinishedImpl(testing::_, 2));
+
+    runSpawn([&strat](boost::asio::yield_context yield) {
+        auto statements = std::vector<FakeStatement>(NUM_STATEMENTS);
+        EXPECT_THROW(strat.readEach(yield, statements, 1), data::DatabaseTimeout);
+    });
+}
+
 TEST_F(BackendCassandraExecutionStrategyTest, WriteSyncFirstTrySuccessful)
 {
     auto strat = makeStrategy();
@@ -405,6 +474,86 @@ TEST_F(BackendCassandraExecutionStrategyTest, WriteMultipleAndCallSyncSucceeds)
     thread.join();
 }
 
+TEST_F(BackendCassandraExecutionStrategyTest, SyncUntilWatermarkDoesNotWaitForLaterWrites)
+{
+    auto strat = makeStrategy();
+    auto callbacks = std::vector<std::function<void(FakeResultOrError)>>{};
+
+    ON_CALL(handle, asyncExecute(A<std::vector<FakeStatement> const&>(), A<std::function<void(FakeResultOrError)>&&>()))
+        .WillByDefault([&callbacks](auto const&, auto&& cb) {
+            callbacks.push_back(std::forward<decltype(cb)>(cb));
+            return FakeFutureWithCallback{};
+        });
+    EXPECT_CALL(
+        handle,
+        asyncExecute(
+            A<std::vector<FakeStatement> const&>(),
+            A<std::function<void(FakeResultOrError)>&&>()
+        )
+    )
+        .Times(2);
+    EXPECT_CALL(*counters, registerWriteStarted()).Times(2);
+    EXPECT_CALL(*counters, registerWriteFinished(testing::_)).Times(2);
+
+    strat.write(std::vector<FakeStatement>(1));
+    auto const watermark = strat.writeWatermark();
+    strat.write(std::vector<FakeStatement>(1));
+    ASSERT_EQ(callbacks.size(), 2u);
+
+    auto synced = std::async(std::launch::async, [&strat, watermark] { strat.syncUntil(watermark); });
+    EXPECT_EQ(synced.wait_for(std::chrono::milliseconds{10}), std::future_status::timeout);
+
+    callbacks[0]({});
+    EXPECT_EQ(synced.wait_for(std::chrono::seconds{1}), std::future_status::ready);  // the later write is still pending
+
+    callbacks[1]({});
+    strat.sync();
+}
+
+TEST_F(BackendCassandraExecutionStrategyTest, SyncLedgerDoesNotWaitForWritesOfNextLedger)
+{
+    auto strat = makeStrategy();
+    auto callbacks = std::vector<std::function<void(FakeResultOrError)>>{};
+    static constexpr auto LEDGER_SEQ = 30u;
+
+    ON_CALL(handle, asyncExecute(A<std::vector<FakeStatement> const&>(), A<std::function<void(FakeResultOrError)>&&>()))
+        .WillByDefault([&callbacks](auto const&, auto&& cb) {
+            callbacks.push_back(std::forward<decltype(cb)>(cb));
+            return FakeFutureWithCallback{};
+        });
+    EXPECT_CALL(
+        handle,
+        asyncExecute(
+            A<std::vector<FakeStatement> const&>(),
+            A<std::function<void(FakeResultOrError)>&&>()
+        )
+    )
+        .Times(4);
+    EXPECT_CALL(*counters, registerWriteStarted()).Times(4);
+    EXPECT_CALL(*counters, registerWriteFinished(testing::_)).Times(4);
+
+    strat.write(std::vector<FakeStatement>(1));
+    strat.write(std::vector<FakeStatement>(1));
+    strat.markLedgerSubmitted(LEDGER_SEQ);
+    strat.write(std::vector<FakeStatement>(1));
+    strat.write(std::vector<FakeStatement>(1));
+    strat.markLedgerSubmitted(LEDGER_SEQ + 1);
+    ASSERT_EQ(callbacks.size(), 4u);
+
+    auto synced = std::async(std::launch::async, [&strat] { strat.syncLedger(LEDGER_SEQ); });
+
+    callbacks[1]({});
+    EXPECT_EQ(synced.wait_for(std::chrono::milliseconds{10}), std::future_status::timeout);
+
+    callbacks[0]({});
+    EXPECT_EQ(synced.wait_for(std::chrono::seconds{1}), std::future_status::ready);  // next ledger's writes pending
+
+    synced = std::async(std::launch::async, [&strat] { strat.syncLedger(LEDGER_SEQ + 1); });
+    callbacks[2]({});
+    callbacks[3]({});
+    EXPECT_EQ(synced.wait_for(std::chrono::seconds{1}), std::future_status::ready);
+}
+
 TEST_F(BackendCassandraExecutionStrategyTest, StatsCallsCountersReport)
 {
     auto strat = makeStrategy();
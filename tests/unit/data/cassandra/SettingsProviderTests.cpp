@@ -29,6 +29,7 @@
 
 #include <chrono>
 #include <optional>
+#include <stdexcept>
 #include <thread>
 #include <variant>
 
@@ -58,6 +59,9 @@ TEST_F(SettingsProviderTest, Defaults)
     EXPECT_EQ(settings.username, std::nullopt);
     EXPECT_EQ(settings.password, std::nullopt);
     EXPECT_EQ(settings.queueSizeIO, std::nullopt);
+    EXPECT_EQ(settings.readBatchSize, 50);
+    EXPECT_EQ(settings.maxReadBatchesInFlight, 16);
+    EXPECT_EQ(settings.maxReadAheadsInFlight, 16);
 
     auto const* cp = std::get_if<Settings::ContactPoints>(&settings.connectionInfo);
     ASSERT_TRUE(cp != nullptr);
@@ -106,6 +110,34 @@ TEST_F(SettingsProviderTest, DriverOptionalOptionsSpecified)
     EXPECT_EQ(settings.queueSizeIO, 2);
 }
 
+TEST_F(SettingsProviderTest, ReadBatchingConfig)
+{
+    Config const cfg{json::parse(R"({
+        "contact_points": "123.123.123.123",
+        "read_batch_size": 10,
+        "max_read_batches_in_flight": 4,
+        "max_read_aheads_in_flight": 0
+    })")};
+    SettingsProvider const provider{cfg};
+
+    auto const settings = provider.getSettings();
+    EXPECT_EQ(settings.readBatchSize, 10);
+    EXPECT_EQ(settings.maxReadBatchesInFlight, 4);
+    EXPECT_EQ(settings.maxReadAheadsInFlight, 0);
+}
+
+TEST_F(SettingsProviderTest, ReadBatchingConfigRejectsZero)
+{
+    EXPECT_THROW(
+        SettingsProvider{Config{json::parse(R"({"contact_points": "127.0.0.1", "read_batch_size": 0})")}},
+        std::runtime_error
+    );
+    EXPECT_THROW(
+        SettingsProvider{Config{json::parse(R"({"contact_points": "127.0.0.1", "max_read_batches_in_flight": 0})")}},
+        std::runtime_error
+    );
+}
+
 TEST_F(SettingsProviderTest, SecureBundleConfig)
 {
     Config const cfg{json::parse(R"({"secure_connect_bundle": "bundleData"})")};
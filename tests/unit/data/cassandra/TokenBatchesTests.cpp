@@ -0,0 +1,90 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/cassandra/impl/TokenBatches.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <xrpl/basics/base_uint.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <vector>
+
+using namespace data::cassandra::impl;
+using namespace testing;
+
+namespace {
+
+ripple::uint256
+keyWithFirstByte(unsigned char value)
+{
+    ripple::uint256 key;
+    *key.begin() = value;
+    return key;
+}
+
+}  // namespace
+
+TEST(BackendCassandraTokenBatchesTest, Murmur3TokenMatchesPartitioner)
+{
+    ripple::uint256 sequentialBytes;
+    std::iota(sequentialBytes.begin(), sequentialBytes.end(), 0u);
+
+    EXPECT_EQ(murmur3Token(ripple::uint256{}), 3562976398955928784);
+    EXPECT_EQ(murmur3Token(sequentialBytes), -4148501202978516977);
+}
+
+TEST(BackendCassandraTokenBatchesTest, EmptyKeys)
+{
+    EXPECT_TRUE(makeTokenBatches({}, 2).empty());
+}
+
+TEST(BackendCassandraTokenBatchesTest, BatchesAreOrderedByToken)
+{
+    // tokens of these keys in ascending order belong to keys 2, 0, 3, 4, 1
+    std::vector<ripple::uint256> keys;
+    for (unsigned char i = 0; i < 5; ++i)
+        keys.push_back(keyWithFirstByte(i));
+
+    auto const batches = makeTokenBatches(keys, 2);
+
+    EXPECT_THAT(batches, ElementsAre(ElementsAre(2u, 0u), ElementsAre(3u, 4u), ElementsAre(1u)));
+}
+
+TEST(BackendCassandraTokenBatchesTest, EveryKeyIsInExactlyOneBatch)
+{
+    std::vector<ripple::uint256> keys;
+    for (unsigned char i = 0; i < 100; ++i)
+        keys.push_back(keyWithFirstByte(i));
+
+    auto const batches = makeTokenBatches(keys, 7);
+    std::vector<std::size_t> indices;
+    for (auto const& batch : batches) {
+        EXPECT_LE(batch.size(), 7u);
+        indices.insert(indices.end(), batch.begin(), batch.end());
+    }
+
+    std::ranges::sort(indices);
+    std::vector<std::size_t> expected(keys.size());
+    std::iota(expected.begin(), expected.end(), 0u);
+    EXPECT_EQ(indices, expected);
+    EXPECT_EQ(batches.size(), 15u);
+}
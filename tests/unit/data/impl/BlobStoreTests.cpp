@@ -0,0 +1,125 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/Types.hpp"
+#include "data/impl/BlobCompressor.hpp"
+#include "data/impl/BlobStore.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+using namespace data;
+using namespace data::impl;
+
+namespace {
+
+Blob
+makeBlob(std::size_t size, unsigned char value)
+{
+    Blob blob(size, 'x');
+    blob[value % size] = value;
+    return blob;
+}
+
+}  // namespace
+
+TEST(ArenaBlobStoreTests, StoreLoadAndRelease)
+{
+    ArenaBlobStore store;
+    auto first = store.store(makeBlob(10, 1));
+    auto const second = store.store(makeBlob(20, 2));
+
+    EXPECT_EQ(store.load(first), makeBlob(10, 1));
+    EXPECT_EQ(store.load(second), makeBlob(20, 2));
+    EXPECT_FALSE(store.needsCompaction());
+
+    store.release(first);
+    EXPECT_EQ(store.load(second), makeBlob(20, 2));
+}
+
+TEST(ArenaBlobStoreTests, CompactionKeepsLiveBlobs)
+{
+    static constexpr std::size_t NUM_BLOBS = 2'000;
+
+    ArenaBlobStore store;
+    std::vector<ArenaBlobStore::Handle> handles;
+    for (std::size_t i = 0; i < NUM_BLOBS; ++i)
+        handles.push_back(store.store(makeBlob(100, static_cast<unsigned char>(i))));
+
+    for (std::size_t i = 0; i < NUM_BLOBS; i += 4)
+        store.release(handles[i]);
+    EXPECT_FALSE(store.needsCompaction());
+
+    for (std::size_t i = 1; i < NUM_BLOBS; i += 2)
+        store.release(handles[i]);
+    ASSERT_TRUE(store.needsCompaction());
+
+    auto const bytesBefore = store.bytes();
+    auto fresh = store.makeEmpty();
+    for (std::size_t i = 2; i < NUM_BLOBS; i += 4)
+        handles[i] = store.moveTo(handles[i], fresh);
+
+    EXPECT_LT(fresh.bytes(), bytesBefore);
+    EXPECT_FALSE(fresh.needsCompaction());
+    for (std::size_t i = 2; i < NUM_BLOBS; i += 4)
+        EXPECT_EQ(fresh.load(handles[i]), makeBlob(100, static_cast<unsigned char>(i)));
+}
+
+TEST(ArenaBlobStoreTests, CompressedBlobsRoundTrip)
+{
+    static constexpr std::size_t NUM_BLOBS = 3'000;
+
+    auto const compressor = std::make_shared<BlobCompressor>();
+    ArenaBlobStore store{compressor};
+    ArenaBlobStore plain;
+
+    std::vector<ArenaBlobStore::Handle> handles;
+    for (std::size_t i = 0; i < NUM_BLOBS; ++i) {
+        auto const blob = makeBlob(100, static_cast<unsigned char>(i));
+        handles.push_back(store.store(blob));
+        [[maybe_unused]] auto const _ = plain.store(blob);
+    }
+
+    // blobs stored once the dictionary was sampled take much less space
+    EXPECT_LT(store.bytes(), plain.bytes() / 2);
+
+    auto fresh = store.makeEmpty();
+    for (std::size_t i = 0; i < NUM_BLOBS; ++i) {
+        EXPECT_EQ(store.load(handles[i]), makeBlob(100, static_cast<unsigned char>(i)));
+        auto const moved = store.moveTo(handles[i], fresh);
+        EXPECT_EQ(fresh.load(moved), makeBlob(100, static_cast<unsigned char>(i)));
+    }
+}
+
+TEST(BlobCompressorTests, NothingIsCompressedUntilDictionaryIsReady)
+{
+    BlobCompressor compressor;
+    auto const blob = makeBlob(1'000, 1);
+
+    for (std::size_t sampled = 0; sampled < BlobCompressor::DICTIONARY_SIZE; sampled += blob.size())
+        EXPECT_FALSE(compressor.compress(blob));
+
+    auto const compressed = compressor.compress(blob);
+    ASSERT_TRUE(compressed);
+    EXPECT_LT(compressed->size(), blob.size());
+    EXPECT_EQ(compressor.decompress(*compressed, blob.size()), blob);
+}
@@ -0,0 +1,87 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/Types.hpp"
+#include "data/impl/CacheHistory.hpp"
+
+#include <gtest/gtest.h>
+#include <xrpl/basics/base_uint.h>
+
+#include <iterator>
+#include <optional>
+
+using namespace data;
+using namespace data::impl;
+
+struct CacheHistoryTests : ::testing::Test {
+    CacheHistory history;
+    ripple::uint256 const key1{1};
+    ripple::uint256 const key2{2};
+};
+
+TEST_F(CacheHistoryTests, UnchangedObject)
+{
+    history.record(key1, 5, Blob{'a'});
+
+    EXPECT_EQ(history.stateAt(key2, 1), nullptr);
+    EXPECT_EQ(history.stateAt(key1, 5), nullptr);
+    EXPECT_EQ(history.stateAt(key1, 6), nullptr);
+}
+
+TEST_F(CacheHistoryTests, StateAtIsTakenFromFirstChangeAfterSequence)
+{
+    history.record(key1, 5, std::nullopt);
+    history.record(key1, 7, Blob{'a'});
+    history.record(key1, 9, Blob{'b'});
+
+    ASSERT_NE(history.stateAt(key1, 4), nullptr);
+    EXPECT_EQ(*history.stateAt(key1, 4), std::nullopt);
+    EXPECT_EQ(*history.stateAt(key1, 5), Blob{'a'});
+    EXPECT_EQ(*history.stateAt(key1, 6), Blob{'a'});
+    EXPECT_EQ(*history.stateAt(key1, 8), Blob{'b'});
+    EXPECT_EQ(history.stateAt(key1, 9), nullptr);
+    EXPECT_EQ(history.size(), 3u);
+}
+
+TEST_F(CacheHistoryTests, OnlyFirstChangeInLedgerIsRecorded)
+{
+    history.record(key1, 5, Blob{'a'});
+    history.record(key1, 5, Blob{'b'});
+
+    EXPECT_EQ(*history.stateAt(key1, 4), Blob{'a'});
+    EXPECT_EQ(history.size(), 1u);
+}
+
+TEST_F(CacheHistoryTests, Prune)
+{
+    history.record(key1, 5, Blob{'a'});
+    history.record(key2, 5, Blob{'b'});
+    history.record(key1, 6, Blob{'c'});
+
+    history.prune(5);
+
+    EXPECT_EQ(history.size(), 1u);
+    EXPECT_EQ(history.stateAt(key2, 4), nullptr);
+    EXPECT_EQ(*history.stateAt(key1, 5), Blob{'c'});
+    EXPECT_EQ(std::distance(history.begin(), history.end()), 1);
+
+    history.prune(6);
+    EXPECT_EQ(history.size(), 0u);
+    EXPECT_EQ(history.begin(), history.end());
+}
@@ -0,0 +1,156 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/Types.hpp"
+#include "data/impl/BlobStore.hpp"
+#include "data/impl/FlatCacheStorage.hpp"
+
+#include <gtest/gtest.h>
+#include <xrpl/basics/base_uint.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <random>
+
+using namespace data;
+using namespace data::impl;
+
+namespace {
+
+ripple::uint256
+makeKey(uint64_t value)
+{
+    return ripple::uint256{value};
+}
+
+}  // namespace
+
+template <typename BlobStoreType>
+struct FlatCacheStorageTests : ::testing::Test {
+    FlatCacheStorage<BlobStoreType> storage;
+
+    Blob
+    blobOf(ripple::uint256 const& key) const
+    {
+        auto const* e = storage.find(key);
+        return e != nullptr ? storage.blob(*e) : Blob{};
+    }
+};
+
+using BlobStoreTypes = ::testing::Types<HeapBlobStore, ArenaBlobStore>;
+TYPED_TEST_CASE(FlatCacheStorageTests, BlobStoreTypes);
+
+TYPED_TEST(FlatCacheStorageTests, EmptyByDefault)
+{
+    EXPECT_EQ(this->storage.size(), 0u);
+    EXPECT_EQ(this->storage.find(makeKey(1)), nullptr);
+    EXPECT_FALSE(this->storage.successor(makeKey(1)));
+    EXPECT_FALSE(this->storage.predecessor(makeKey(1)));
+    EXPECT_FALSE(this->storage.first());
+    EXPECT_FALSE(this->storage.last());
+}
+
+TYPED_TEST(FlatCacheStorageTests, PutFindAndErase)
+{
+    this->storage.put(makeKey(1), 1, {'a'});
+    this->storage.put(makeKey(2), 1, {'b'});
+    EXPECT_EQ(this->storage.size(), 2u);
+
+    ASSERT_NE(this->storage.find(makeKey(1)), nullptr);
+    EXPECT_EQ(this->blobOf(makeKey(1)), Blob{'a'});
+
+    this->storage.put(makeKey(1), 2, {'c'});
+    EXPECT_EQ(this->storage.size(), 2u);
+    EXPECT_EQ(this->storage.find(makeKey(1))->seq, 2u);
+    EXPECT_EQ(this->blobOf(makeKey(1)), Blob{'c'});
+
+    this->storage.erase(makeKey(1));
+    this->storage.erase(makeKey(3));
+    EXPECT_EQ(this->storage.size(), 1u);
+    EXPECT_EQ(this->storage.find(makeKey(1)), nullptr);
+}
+
+TYPED_TEST(FlatCacheStorageTests, SuccessorAndPredecessorSkipErased)
+{
+    for (uint64_t i = 1; i <= 5; ++i)
+        this->storage.put(makeKey(i * 10), 1, {static_cast<unsigned char>(i)});
+    this->storage.erase(makeKey(20));
+    this->storage.erase(makeKey(30));
+
+    auto const succ = this->storage.successor(makeKey(10));
+    ASSERT_TRUE(succ);
+    EXPECT_EQ(succ->key, makeKey(40));
+
+    auto const pred = this->storage.predecessor(makeKey(40));
+    ASSERT_TRUE(pred);
+    EXPECT_EQ(pred->key, makeKey(10));
+
+    EXPECT_EQ(this->storage.first()->key, makeKey(10));
+    EXPECT_EQ(this->storage.last()->key, makeKey(50));
+    EXPECT_FALSE(this->storage.successor(makeKey(50)));
+    EXPECT_FALSE(this->storage.predecessor(makeKey(10)));
+}
+
+TYPED_TEST(FlatCacheStorageTests, MatchesMapAcrossCompactions)
+{
+    static constexpr std::size_t NUM_OPERATIONS = 100'000;
+    static constexpr uint64_t NUM_KEYS = 5'000;
+
+    std::mt19937 gen{42};  // NOLINT(cert-msc32-c,cert-msc51-cpp)
+    std::uniform_int_distribution<uint64_t> keyDist{0, NUM_KEYS};
+    std::uniform_int_distribution<int> opDist{0, 9};
+    std::uniform_int_distribution<std::size_t> sizeDist{1, 64};
+    std::map<ripple::uint256, Blob> expected;
+
+    for (std::size_t i = 0; i < NUM_OPERATIONS; ++i) {
+        auto const key = makeKey(keyDist(gen));
+        auto const op = opDist(gen);
+
+        if (op < 5) {
+            Blob const blob(sizeDist(gen), static_cast<unsigned char>(i));
+            this->storage.put(key, 1, blob);
+            expected[key] = blob;
+        } else if (op < 7) {
+            this->storage.erase(key);
+            expected.erase(key);
+        } else if (op < 8) {
+            auto const res = this->storage.successor(key);
+            auto const it = expected.upper_bound(key);
+            ASSERT_EQ(res.has_value(), it != expected.end());
+            if (res)
+                EXPECT_EQ(*res, (LedgerObject{it->first, it->second}));
+        } else if (op < 9) {
+            auto const res = this->storage.predecessor(key);
+            auto it = expected.lower_bound(key);
+            ASSERT_EQ(res.has_value(), it != expected.begin());
+            if (res) {
+                --it;
+                EXPECT_EQ(*res, (LedgerObject{it->first, it->second}));
+            }
+        } else {
+            this->storage.compactIfNeeded();
+
+            auto const it = expected.find(key);
+            EXPECT_EQ(this->blobOf(key), it != expected.end() ? it->second : Blob{});
+        }
+
+        ASSERT_EQ(this->storage.size(), expected.size());
+    }
+}
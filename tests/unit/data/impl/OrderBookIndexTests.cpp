@@ -0,0 +1,156 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/Types.hpp"
+#include "data/impl/OrderBookIndex.hpp"
+#include "util/TestObject.hpp"
+
+#include <gtest/gtest.h>
+#include <xrpl/basics/base_uint.h>
+#include <xrpl/protocol/Indexes.h>
+#include <xrpl/protocol/SField.h>
+#include <xrpl/protocol/STObject.h>
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+using namespace data;
+using namespace data::impl;
+
+namespace {
+
+constexpr auto BOOK = "3B95C29205977C2136BBC70F21895F8C8F471C8522BF446E0000000000000000";
+constexpr auto OTHER_BOOK = "3B95C29205977C2136BBC70F21895F8C8F471C8522BF446F0000000000000000";
+
+LedgerObject
+makeBookDirPage(
+    ripple::uint256 const& root,
+    std::uint64_t page,
+    std::vector<ripple::uint256> const& offers,
+    std::uint64_t next = 0
+)
+{
+    auto dir = CreateOwnerDirLedgerObject(offers, ripple::to_string(root));
+    dir.setFieldU64(ripple::sfExchangeRate, ripple::getQuality(root));
+    dir.setFieldU64(ripple::sfIndexNext, next);
+
+    auto const key = page == 0 ? root : ripple::keylet::page(root, page).key;
+    return {key, dir.getSerializer().peekData()};
+}
+
+}  // namespace
+
+struct OrderBookIndexTests : ::testing::Test {
+    OrderBookIndex index;
+    ripple::uint256 const book{BOOK};
+    ripple::uint256 const quality1 = ripple::getQualityIndex(book, 1);
+    ripple::uint256 const quality2 = ripple::getQualityIndex(book, 2);
+    ripple::uint256 const offer1{1};
+    ripple::uint256 const offer2{2};
+    ripple::uint256 const offer3{3};
+
+    void
+    update(std::vector<LedgerObject> const& objs, uint32_t seq)
+    {
+        std::vector<LedgerObject const*> ptrs;
+        for (auto const& obj : objs)
+            ptrs.push_back(&obj);
+        index.update(ptrs, seq);
+    }
+};
+
+TEST_F(OrderBookIndexTests, EmptyBook)
+{
+    auto const offers = index.offers(book, 10);
+    ASSERT_TRUE(offers.has_value());
+    EXPECT_TRUE(offers->empty());
+    EXPECT_EQ(index.seq(), 0u);
+}
+
+TEST_F(OrderBookIndexTests, OffersAreOrderedByQuality)
+{
+    update({makeBookDirPage(quality2, 0, {offer3}), makeBookDirPage(quality1, 0, {offer1, offer2})}, 5);
+
+    EXPECT_EQ(index.offers(book, 10), (std::vector{offer1, offer2, offer3}));
+    EXPECT_EQ(index.offers(book, 2), (std::vector{offer1, offer2}));
+    EXPECT_EQ(index.seq(), 5u);
+    EXPECT_EQ(index.size(), 2u);
+}
+
+TEST_F(OrderBookIndexTests, PagesAreFollowed)
+{
+    update(
+        {makeBookDirPage(quality1, 0, {offer1}, 3),
+         makeBookDirPage(quality1, 3, {offer2}),
+         makeBookDirPage(quality2, 0, {offer3})},
+        5
+    );
+
+    EXPECT_EQ(index.offers(book, 10), (std::vector{offer1, offer2, offer3}));
+}
+
+TEST_F(OrderBookIndexTests, MissingPageMakesBookIncomplete)
+{
+    update({makeBookDirPage(quality1, 0, {offer1}, 1)}, 5);
+    EXPECT_FALSE(index.offers(book, 10).has_value());
+
+    // the offers of the root page are enough
+    EXPECT_EQ(index.offers(book, 1), (std::vector{offer1}));
+}
+
+TEST_F(OrderBookIndexTests, OtherBooksAreNotIncluded)
+{
+    auto const other = ripple::getQualityIndex(ripple::uint256{OTHER_BOOK}, 1);
+    update({makeBookDirPage(quality1, 0, {offer1}), makeBookDirPage(other, 0, {offer2})}, 5);
+
+    EXPECT_EQ(index.offers(book, 10), (std::vector{offer1}));
+    EXPECT_EQ(index.offers(ripple::uint256{OTHER_BOOK}, 10), (std::vector{offer2}));
+}
+
+TEST_F(OrderBookIndexTests, DeletedDirectoriesAreRemoved)
+{
+    update({makeBookDirPage(quality1, 0, {offer1}, 1), makeBookDirPage(quality1, 1, {offer2})}, 5);
+    update({makeBookDirPage(quality1, 0, {offer1}), LedgerObject{ripple::keylet::page(quality1, 1).key, {}}}, 6);
+    EXPECT_EQ(index.offers(book, 10), (std::vector{offer1}));
+    EXPECT_EQ(index.size(), 1u);
+
+    update({LedgerObject{quality1, {}}}, 7);
+    EXPECT_EQ(index.offers(book, 10), std::vector<ripple::uint256>{});
+    EXPECT_EQ(index.size(), 0u);
+    EXPECT_EQ(index.seq(), 7u);
+}
+
+TEST_F(OrderBookIndexTests, OtherObjectsAreIgnored)
+{
+    auto const ownerDir = CreateOwnerDirLedgerObject({offer1}, ripple::to_string(quality1));
+    update({{quality1, ownerDir.getSerializer().peekData()}, {quality2, Blob{'a'}}}, 5);
+
+    EXPECT_EQ(index.size(), 0u);
+    EXPECT_EQ(index.offers(book, 10), std::vector<ripple::uint256>{});
+}
+
+TEST_F(OrderBookIndexTests, Clear)
+{
+    update({makeBookDirPage(quality1, 0, {offer1})}, 5);
+    index.clear();
+
+    EXPECT_EQ(index.size(), 0u);
+    EXPECT_EQ(index.seq(), 0u);
+}
@@ -0,0 +1,129 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/DBHelpers.hpp"
+#include "data/Types.hpp"
+#include "etl/ETLHelpers.hpp"
+#include "etl/impl/BookSuccessors.hpp"
+#include "util/MockBackendTestFixture.hpp"
+#include "util/MockPrometheus.hpp"
+#include "util/TestObject.hpp"
+
+#include <fmt/core.h>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <xrpl/basics/Blob.h>
+#include <xrpl/basics/base_uint.h>
+#include <xrpl/protocol/Indexes.h>
+#include <xrpl/protocol/SField.h>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+using namespace etl::impl;
+using namespace data;
+using namespace testing;
+
+namespace {
+
+constexpr auto SEQ = 30;
+constexpr std::size_t NUM_RANGES = 4;
+constexpr auto ACCOUNT_KEY = "1000000000000000000000000000000000000000000000000000000000000001";
+constexpr auto BOOK1 = "8B95C29205977C2136BBC70F21895F8C8F471C8522BF446E0000000000000000";
+constexpr auto BOOK2 = "CB95C29205977C2136BBC70F21895F8C8F471C8522BF446E0000000000000000";
+
+ripple::Blob
+makeBookDir(ripple::uint256 const& key)
+{
+    auto dir = CreateOwnerDirLedgerObject({ripple::uint256{1}}, ripple::to_string(key));
+    dir.setFieldU64(ripple::sfExchangeRate, ripple::getQuality(key));
+    return dir.getSerializer().peekData();
+}
+
+struct BookSuccessorsTest : util::prometheus::WithPrometheus, MockBackendTestStrict, WithParamInterface<std::size_t> {
+    std::vector<ripple::uint256> markers = etl::getMarkers(NUM_RANGES);
+
+    void
+    expectSuccessor(ripple::uint256 const& key, ripple::uint256 const& successor)
+    {
+        EXPECT_CALL(*backend, writeSuccessor(uint256ToString(key), SEQ, uint256ToString(successor)));
+    }
+};
+
+}  // namespace
+
+INSTANTIATE_TEST_CASE_P(
+    BookSuccessorsTestGroup,
+    BookSuccessorsTest,
+    Values(1, 2, NUM_RANGES, 2 * NUM_RANGES),
+    [](auto const& info) { return fmt::format("{}Threads", info.param); }
+);
+
+TEST_P(BookSuccessorsTest, EmptyCacheLinksFirstKeyToLastKey)
+{
+    expectSuccessor(firstKey, lastKey);
+
+    EXPECT_EQ(writeBookSuccessors(*backend, markers, SEQ, GetParam()), 1u);
+}
+
+TEST_P(BookSuccessorsTest, BookWithPredecessorInPreviousRange)
+{
+    // the object preceding the book directory is in the first range while the book is in the third one
+    auto const accountKey = ripple::uint256{ACCOUNT_KEY};
+    auto const dirKey = ripple::getQualityIndex(ripple::uint256{BOOK1}, 1);
+    ASSERT_EQ(getBookBase(dirKey), ripple::uint256{BOOK1});
+
+    backend->cache().update({{accountKey, {'a', 'b', 'c'}}, {dirKey, makeBookDir(dirKey)}}, SEQ);
+
+    expectSuccessor(firstKey, accountKey);
+    expectSuccessor(ripple::uint256{BOOK1}, dirKey);
+    expectSuccessor(dirKey, lastKey);
+
+    EXPECT_EQ(writeBookSuccessors(*backend, markers, SEQ, GetParam()), 2u);
+}
+
+TEST_P(BookSuccessorsTest, BookWithObjectBetweenBaseAndDirectory)
+{
+    auto const objectKey = ripple::getQualityIndex(ripple::uint256{BOOK2}, 1);
+    auto const dirKey = ripple::getQualityIndex(ripple::uint256{BOOK2}, 5);
+    ASSERT_LT(objectKey, dirKey);
+
+    backend->cache().update({{objectKey, {'a', 'b', 'c'}}, {dirKey, makeBookDir(dirKey)}}, SEQ);
+
+    expectSuccessor(firstKey, objectKey);
+    expectSuccessor(dirKey, lastKey);
+
+    EXPECT_EQ(writeBookSuccessors(*backend, markers, SEQ, GetParam()), 2u);
+}
+
+TEST_P(BookSuccessorsTest, BooksInSeveralRanges)
+{
+    auto const dirKey1 = ripple::getQualityIndex(ripple::uint256{BOOK1}, 1);
+    auto const dirKey2 = ripple::getQualityIndex(ripple::uint256{BOOK2}, 1);
+
+    backend->cache().update({{dirKey1, makeBookDir(dirKey1)}, {dirKey2, makeBookDir(dirKey2)}}, SEQ);
+
+    expectSuccessor(firstKey, dirKey1);
+    expectSuccessor(ripple::uint256{BOOK1}, dirKey1);
+    expectSuccessor(ripple::uint256{BOOK2}, dirKey2);
+    expectSuccessor(dirKey2, lastKey);
+
+    EXPECT_EQ(writeBookSuccessors(*backend, markers, SEQ, GetParam()), 3u);
+}
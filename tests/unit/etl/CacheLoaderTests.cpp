@@ -17,6 +17,8 @@
 */
 //==============================================================================
 
+#include "data/LedgerCache.hpp"
+#include "data/LedgerCacheSnapshot.hpp"
 #include "data/Types.hpp"
 #include "etl/CacheLoader.hpp"
 #include "etl/CacheLoaderSettings.hpp"
@@ -25,13 +27,19 @@
 #include "util/MockBackendTestFixture.hpp"
 #include "util/MockCache.hpp"
 #include "util/MockPrometheus.hpp"
+#include "util/TmpFile.hpp"
 #include "util/async/context/BasicExecutionContext.hpp"
 #include "util/config/Config.hpp"
 
 #include <boost/json/parse.hpp>
+#include <fmt/core.h>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include <xrpl/basics/base_uint.h>
 
+#include <cstdint>
+#include <filesystem>
+#include <utility>
 #include <vector>
 
 namespace json = boost::json;
@@ -241,3 +249,156 @@ TEST_F(CacheLoaderTest, DisabledCacheLoaderDoesNotLoadCache)
 
     loader.load(SEQ);
 }
+
+TEST_F(CacheLoaderTest, LoadsFromSnapshotAndCatchesUp)
+{
+    TmpFile const file{""};
+    {
+        LedgerCache source;
+        source.update({{ripple::uint256{1}, {'a'}}, {ripple::uint256{2}, {'b'}}}, SEQ - 2);
+        source.setFull();
+        ASSERT_TRUE(LedgerCacheSnapshot::write(source, file.path).has_value());
+    }
+
+    auto const cfg =
+        util::Config(json::parse(fmt::format(R"({{"cache": {{"snapshot": {{"path": "{}"}}}}}})", file.path)));
+    CacheLoader loader{cfg, backend, cache};
+
+    auto const diffs = diffProvider.getLatestDiff();
+    EXPECT_CALL(*backend, fetchLedgerDiff(SEQ - 1, _)).WillOnce(Return(diffs));
+    EXPECT_CALL(*backend, fetchLedgerDiff(SEQ, _)).WillOnce(Return(diffs));
+    EXPECT_CALL(*backend, doFetchLedgerObjects).Times(0);
+
+    EXPECT_CALL(cache, isDisabled).WillRepeatedly(Return(false));
+    EXPECT_CALL(cache, isFull).WillRepeatedly(Return(false));
+    EXPECT_CALL(
+        cache,
+        restore(
+            std::vector<VersionedLedgerObject>{
+                {{ripple::uint256{1}, {'a'}}, SEQ - 2}, {{ripple::uint256{2}, {'b'}}, SEQ - 2}
+            },
+            SEQ - 2
+        )
+    );
+    EXPECT_CALL(cache, updateImp(diffs, SEQ - 1, false));
+    EXPECT_CALL(cache, updateImp(diffs, SEQ, false));
+    EXPECT_CALL(cache, setFull);
+
+    loader.load(SEQ);
+}
+
+TEST_F(CacheLoaderTest, FallsBackToDatabaseWhenSnapshotIsTooOld)
+{
+    TmpFile const file{""};
+    {
+        LedgerCache source;
+        source.update({{ripple::uint256{1}, {'a'}}}, SEQ - 2);
+        source.setFull();
+        ASSERT_TRUE(LedgerCacheSnapshot::write(source, file.path).has_value());
+    }
+
+    auto const cfg = util::Config(json::parse(fmt::format(
+        R"({{"cache": {{"load": "sync", "snapshot": {{"path": "{}", "max_catch_up_ledgers": 1}}}}}})", file.path
+    )));
+    CacheLoader loader{cfg, backend, cache};
+
+    auto const diffs = diffProvider.getLatestDiff();
+    auto const loops = diffs.size() + 1;
+    auto const keysSize = 14;
+
+    EXPECT_CALL(*backend, fetchLedgerDiff(_, _)).Times(32).WillRepeatedly(Return(diffs));
+    EXPECT_CALL(*backend, doFetchSuccessorKey).Times(keysSize * loops).WillRepeatedly([this]() {
+        return diffProvider.nextKey(keysSize);
+    });
+
+    EXPECT_CALL(*backend, doFetchLedgerObjects(_, SEQ, _))
+        .Times(loops)
+        .WillRepeatedly(Return(std::vector<Blob>{keysSize - 1, Blob{'s'}}));
+
+    EXPECT_CALL(cache, isDisabled).WillRepeatedly(Return(false));
+    EXPECT_CALL(cache, restore).Times(0);
+    EXPECT_CALL(cache, updateImp).Times(loops);
+    EXPECT_CALL(cache, isFull).WillOnce(Return(false)).WillRepeatedly(Return(true));
+    EXPECT_CALL(cache, setFull).Times(1);
+
+    loader.load(SEQ);
+}
+
+TEST_F(CacheLoaderTest, FallsBackToDatabaseWhenPartOfSnapshotIsNewer)
+{
+    TmpFile const file{""};
+    {
+        MockCache source;
+        EXPECT_CALL(source, forEach).WillOnce([](auto const& visitor) {
+            visitor(VersionedLedgerObject{{ripple::uint256{1}, {'a'}}, SEQ + 1});
+            return std::pair<uint32_t, uint32_t>{SEQ - 1, SEQ + 1};
+        });
+        ASSERT_TRUE(LedgerCacheSnapshot::write(source, file.path).has_value());
+    }
+
+    auto const cfg = util::Config(
+        json::parse(fmt::format(R"({{"cache": {{"load": "sync", "snapshot": {{"path": "{}"}}}}}})", file.path))
+    );
+    CacheLoader loader{cfg, backend, cache};
+
+    auto const diffs = diffProvider.getLatestDiff();
+    auto const loops = diffs.size() + 1;
+    auto const keysSize = 14;
+
+    EXPECT_CALL(*backend, fetchLedgerDiff(_, _)).Times(32).WillRepeatedly(Return(diffs));
+    EXPECT_CALL(*backend, doFetchSuccessorKey).Times(keysSize * loops).WillRepeatedly([this]() {
+        return diffProvider.nextKey(keysSize);
+    });
+
+    EXPECT_CALL(*backend, doFetchLedgerObjects(_, SEQ, _))
+        .Times(loops)
+        .WillRepeatedly(Return(std::vector<Blob>{keysSize - 1, Blob{'s'}}));
+
+    EXPECT_CALL(cache, isDisabled).WillRepeatedly(Return(false));
+    EXPECT_CALL(cache, restore).Times(0);
+    EXPECT_CALL(cache, updateImp).Times(loops);
+    EXPECT_CALL(cache, isFull).WillOnce(Return(false)).WillRepeatedly(Return(true));
+    EXPECT_CALL(cache, setFull).Times(1);
+
+    loader.load(SEQ);
+}
+
+TEST_F(CacheLoaderTest, SavesSnapshotOfFullCache)
+{
+    TmpFile const file{""};
+    auto const cfg =
+        util::Config(json::parse(fmt::format(R"({{"cache": {{"snapshot": {{"path": "{}"}}}}}})", file.path)));
+    CacheLoader loader{cfg, backend, cache};
+
+    EXPECT_CALL(cache, isDisabled).WillRepeatedly(Return(false));
+    EXPECT_CALL(cache, isFull).WillOnce(Return(true));
+    EXPECT_CALL(cache, forEach).WillOnce([](auto const& visitor) {
+        visitor(VersionedLedgerObject{{ripple::uint256{1}, {'a'}}, SEQ - 1});
+        visitor(VersionedLedgerObject{{ripple::uint256{2}, {'b'}}, SEQ});
+        return std::pair<uint32_t, uint32_t>{SEQ - 1, SEQ};
+    });
+
+    loader.saveSnapshot();
+
+    auto const snapshot = LedgerCacheSnapshot::open(file.path);
+    ASSERT_TRUE(snapshot.has_value()) << snapshot.error();
+    EXPECT_EQ(snapshot->seq(), SEQ - 1);
+    EXPECT_EQ(snapshot->latestSeq(), SEQ);
+    EXPECT_EQ(snapshot->size(), 2u);
+}
+
+TEST_F(CacheLoaderTest, DoesNotSaveSnapshotOfIncompleteCache)
+{
+    TmpFile const file{""};
+    std::filesystem::remove(file.path);
+    auto const cfg =
+        util::Config(json::parse(fmt::format(R"({{"cache": {{"snapshot": {{"path": "{}"}}}}}})", file.path)));
+    CacheLoader loader{cfg, backend, cache};
+
+    EXPECT_CALL(cache, isDisabled).WillRepeatedly(Return(false));
+    EXPECT_CALL(cache, isFull).WillOnce(Return(false));
+    EXPECT_CALL(cache, forEach).Times(0);
+
+    loader.saveSnapshot();
+    EXPECT_FALSE(std::filesystem::exists(file.path));
+}
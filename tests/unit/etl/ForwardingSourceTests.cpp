@@ -17,6 +17,7 @@
 */
 //==============================================================================
 
+#include "etl/impl/ForwardingConnectionPool.hpp"
 #include "etl/impl/ForwardingSource.hpp"
 #include "rpc/Errors.hpp"
 #include "util/AsioContextTestFixture.hpp"
@@ -191,3 +192,105 @@ TEST_F(ForwardingSourceOperationsTests, Success)
         EXPECT_EQ(*result, expectedReply) << *result;
     });
 }
+
+struct ForwardingSourcePoolTests : SyncAsioContextTest {
+    TestWsServer server_{ctx, "0.0.0.0"};
+    ForwardingSource forwardingSource{"127.0.0.1", server_.port(), std::chrono::seconds{1}, std::chrono::seconds{1}, 1};
+
+    TestWsConnection
+    serverConnection(boost::asio::yield_context yield)
+    {
+        // First connection attempt is SSL handshake so it will fail
+        auto failedConnection = server_.acceptConnection(yield);
+        [&]() { ASSERT_FALSE(failedConnection); }();
+
+        auto connection = server_.acceptConnection(yield);
+        [&]() { ASSERT_TRUE(connection) << connection.error().message(); }();
+        return std::move(connection).value();
+    }
+
+    static boost::json::object
+    receiveRequest(TestWsConnection& connection, boost::asio::yield_context yield)
+    {
+        auto receivedMessage = connection.receive(yield);
+        [&]() { ASSERT_TRUE(receivedMessage); }();
+        return boost::json::parse(receivedMessage.value_or("{}")).as_object();
+    }
+
+    static void
+    reply(TestWsConnection& connection, boost::json::object const& request, boost::asio::yield_context yield)
+    {
+        boost::json::object const response{{"id", request.at("id")}, {"result", request.at("command")}};
+        auto sendError = connection.send(boost::json::serialize(response), yield);
+        [&]() { ASSERT_FALSE(sendError) << *sendError; }();
+    }
+};
+
+TEST_F(ForwardingSourcePoolTests, ReusesConnectionAndRestoresRequestId)
+{
+    boost::asio::spawn(ctx, [&](boost::asio::yield_context yield) {
+        auto connection = serverConnection(yield);
+        for (auto i = 0; i < 2; ++i)
+            reply(connection, receiveRequest(connection, yield), yield);
+        connection.close(yield);
+    });
+
+    runSpawn([&](boost::asio::yield_context yield) {
+        auto first = forwardingSource.forwardToRippled({{"command", "fee"}}, "some_ip", {}, yield);
+        [&]() { ASSERT_TRUE(first); }();
+        EXPECT_EQ(*first, (boost::json::object{{"result", "fee"}, {"forwarded", true}})) << *first;
+
+        auto second = forwardingSource.forwardToRippled({{"command", "fee"}, {"id", "client_id"}}, {}, {}, yield);
+        [&]() { ASSERT_TRUE(second); }();
+        EXPECT_EQ(*second, (boost::json::object{{"result", "fee"}, {"id", "client_id"}, {"forwarded", true}}))
+            << *second;
+    });
+}
+
+TEST_F(ForwardingSourcePoolTests, MatchesResponsesAnsweredOutOfOrder)
+{
+    boost::asio::spawn(ctx, [&](boost::asio::yield_context yield) {
+        auto connection = serverConnection(yield);
+        reply(connection, receiveRequest(connection, yield), yield);
+
+        auto const first = receiveRequest(connection, yield);
+        auto const second = receiveRequest(connection, yield);
+        reply(connection, second, yield);
+        reply(connection, first, yield);
+        connection.close(yield);
+    });
+
+    std::optional<ForwardingConnection::Response> concurrentResponse;
+    runSpawn([&](boost::asio::yield_context yield) {
+        // the first request opens the connection so that the next ones share it
+        auto warmUp = forwardingSource.forwardToRippled({{"command", "server_state"}}, {}, {}, yield);
+        [&]() { ASSERT_TRUE(warmUp); }();
+
+        boost::asio::spawn(ctx, [&](boost::asio::yield_context yield) {
+            concurrentResponse = forwardingSource.forwardToRippled({{"command", "submit"}}, {}, {}, yield);
+        });
+
+        auto response = forwardingSource.forwardToRippled({{"command", "fee"}}, {}, {}, yield);
+        [&]() { ASSERT_TRUE(response); }();
+        EXPECT_EQ(response->at("result"), "fee");
+    });
+
+    ASSERT_TRUE(concurrentResponse.has_value());
+    ASSERT_TRUE(concurrentResponse->has_value());
+    EXPECT_EQ(concurrentResponse->value().at("result"), "submit");
+}
+
+TEST_F(ForwardingSourcePoolTests, ConnectionClosedWhileWaiting)
+{
+    boost::asio::spawn(ctx, [&](boost::asio::yield_context yield) {
+        auto connection = serverConnection(yield);
+        receiveRequest(connection, yield);
+        connection.close(yield);
+    });
+
+    runSpawn([&](boost::asio::yield_context yield) {
+        auto result = forwardingSource.forwardToRippled({{"command", "fee"}}, {}, {}, yield);
+        ASSERT_FALSE(result);
+        EXPECT_EQ(result.error(), rpc::ClioError::etlREQUEST_ERROR);
+    });
+}
@@ -17,12 +17,14 @@
 */
 //==============================================================================
 
+#include "etl/InitialLoadCheckpoint.hpp"
 #include "etl/impl/GrpcSource.hpp"
 #include "util/LoggerFixtures.hpp"
 #include "util/MockBackend.hpp"
 #include "util/MockPrometheus.hpp"
 #include "util/MockXrpLedgerAPIService.hpp"
 #include "util/TestObject.hpp"
+#include "util/TmpFile.hpp"
 #include "util/config/Config.hpp"
 
 #include <gmock/gmock.h>
@@ -33,8 +35,10 @@
 #include <org/xrpl/rpc/v1/get_ledger_data.pb.h>
 #include <xrpl/basics/base_uint.h>
 
+#include <chrono>
 #include <cstdint>
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -149,3 +153,121 @@ TEST_F(GrpcSourceLoadInitialLedgerTests, worksFine)
     EXPECT_TRUE(success);
     EXPECT_EQ(data, std::vector<std::string>(4, keyStr));
 }
+
+TEST_F(GrpcSourceLoadInitialLedgerTests, worksFineWithMultipleThreads)
+{
+    testing::StrictMock<GrpcSource> multiThreadedGrpcSource{
+        "localhost", std::to_string(getXRPLMockPort()), mockBackend_, numMarkers_ / 2
+    };
+
+    auto const object = CreateTicketLedgerObject("rf1BiGeXwwQoi8Z2ueFYTEXSwuJYfV2Jpn", sequence_);
+    auto const objectData = object.getSerializer().peekData();
+
+    EXPECT_CALL(mockXrpLedgerAPIService, GetLedgerData)
+        .Times(numMarkers_)
+        .WillRepeatedly([&](grpc::ServerContext* /*context*/,
+                            org::xrpl::rpc::v1::GetLedgerDataRequest const* request,
+                            org::xrpl::rpc::v1::GetLedgerDataResponse* response) {
+            EXPECT_EQ(request->ledger().sequence(), sequence_);
+
+            // every range returns an object starting with its marker so that the edge keys are all different
+            auto key = ripple::uint256{};
+            if (not request->marker().empty())
+                key = *ripple::uint256::fromVoidChecked(request->marker());
+            key.data()[ripple::uint256::size() - 1] = 1;
+
+            response->set_is_unlimited(true);
+            auto newObject = response->mutable_ledger_objects()->add_objects();
+            newObject->set_key(key.data(), ripple::uint256::size());
+            newObject->set_data(objectData.data(), objectData.size());
+
+            return grpc::Status{};
+        });
+
+    EXPECT_CALL(*mockBackend_, writeNFTs).Times(numMarkers_);
+    EXPECT_CALL(*mockBackend_, writeLedgerObject).Times(numMarkers_);
+
+    auto const [data, success] = multiThreadedGrpcSource.loadInitialLedger(sequence_, numMarkers_, cacheOnly_);
+
+    EXPECT_TRUE(success);
+    EXPECT_EQ(data.size(), numMarkers_);
+    EXPECT_EQ(std::set<std::string>(data.begin(), data.end()).size(), numMarkers_);
+    EXPECT_EQ(mockBackend_->cache().size(), numMarkers_);
+}
+
+TEST_F(GrpcSourceLoadInitialLedgerTests, resumesFromCheckpoint)
+{
+    auto const key = ripple::uint256{4};
+    std::string const keyStr{reinterpret_cast<char const*>(key.data()), ripple::uint256::size()};
+    auto const object = CreateTicketLedgerObject("rf1BiGeXwwQoi8Z2ueFYTEXSwuJYfV2Jpn", sequence_);
+    auto const objectData = object.getSerializer().peekData();
+
+    TmpFile const checkpointFile{""};
+    {
+        InitialLoadCheckpoint checkpoint{checkpointFile.path, sequence_, numMarkers_, std::chrono::seconds{0}};
+        for (uint32_t i = 0; i < numMarkers_; ++i)
+            ASSERT_TRUE(checkpoint.record(i, key, [] {}).has_value());
+    }
+    auto const checkpoint = std::make_shared<InitialLoadCheckpoint>(checkpointFile.path, sequence_, numMarkers_);
+
+    EXPECT_CALL(mockXrpLedgerAPIService, GetLedgerData)
+        .Times(numMarkers_)
+        .WillRepeatedly([&](grpc::ServerContext* /*context*/,
+                            org::xrpl::rpc::v1::GetLedgerDataRequest const* /*request*/,
+                            org::xrpl::rpc::v1::GetLedgerDataResponse* response) {
+            response->set_is_unlimited(true);
+            auto newObject = response->mutable_ledger_objects()->add_objects();
+            newObject->set_key(key.data(), ripple::uint256::size());
+            newObject->set_data(objectData.data(), objectData.size());
+
+            return grpc::Status{};
+        });
+
+    // everything was written before the interruption so the objects only go to the cache
+    auto const [data, success] = grpcSource_.loadInitialLedger(sequence_, numMarkers_, cacheOnly_, checkpoint);
+
+    EXPECT_TRUE(success);
+    EXPECT_EQ(data, std::vector<std::string>(numMarkers_, keyStr));
+    EXPECT_EQ(mockBackend_->cache().size(), 1u);
+}
+
+TEST_F(GrpcSourceLoadInitialLedgerTests, savesCheckpointOnlyAfterWaitingForWrites)
+{
+    // a single thread so that no save is skipped because another thread is saving at the same time
+    testing::StrictMock<GrpcSource> singleThreadedGrpcSource{
+        "localhost", std::to_string(getXRPLMockPort()), mockBackend_, 1
+    };
+
+    auto const key = ripple::uint256{4};
+    auto const object = CreateTicketLedgerObject("rf1BiGeXwwQoi8Z2ueFYTEXSwuJYfV2Jpn", sequence_);
+    auto const objectData = object.getSerializer().peekData();
+
+    TmpFile const checkpointFile{""};
+    auto const checkpoint = std::make_shared<InitialLoadCheckpoint>(
+        checkpointFile.path, sequence_, numMarkers_, std::chrono::seconds{0}
+    );
+
+    EXPECT_CALL(mockXrpLedgerAPIService, GetLedgerData)
+        .Times(numMarkers_)
+        .WillRepeatedly([&](grpc::ServerContext* /*context*/,
+                            org::xrpl::rpc::v1::GetLedgerDataRequest const* /*request*/,
+                            org::xrpl::rpc::v1::GetLedgerDataResponse* response) {
+            response->set_is_unlimited(true);
+            auto newObject = response->mutable_ledger_objects()->add_objects();
+            newObject->set_key(key.data(), ripple::uint256::size());
+            newObject->set_data(objectData.data(), objectData.size());
+
+            return grpc::Status{};
+        });
+
+    EXPECT_CALL(*mockBackend_, writeNFTs).Times(numMarkers_);
+    EXPECT_CALL(*mockBackend_, writeLedgerObject).Times(numMarkers_);
+    EXPECT_CALL(*mockBackend_, waitForWrites).Times(numMarkers_);
+
+    auto const [data, success] =
+        singleThreadedGrpcSource.loadInitialLedger(sequence_, numMarkers_, cacheOnly_, checkpoint);
+
+    EXPECT_TRUE(success);
+    for (uint32_t i = 0; i < numMarkers_; ++i)
+        EXPECT_EQ(checkpoint->writtenUpTo(i), key);
+}
@@ -0,0 +1,130 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "etl/InitialLoadCheckpoint.hpp"
+#include "util/TmpFile.hpp"
+
+#include <gtest/gtest.h>
+#include <xrpl/basics/base_uint.h>
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+
+using namespace etl;
+
+namespace {
+
+constexpr auto KEY1 = "1B8590C01B0006EFFF0000000000000000000000000000000000000000000001";
+constexpr auto KEY2 = "7E8590C01B0006EFFF0000000000000000000000000000000000000000000002";
+constexpr auto KEY3 = "7E8590C01B0006EFFF0000000000000000000000000000000000000000000003";
+
+constexpr uint32_t SEQ = 30;
+constexpr auto NUM_RANGES = 2;
+
+std::function<void()> const NO_WAIT = [] {};
+
+}  // namespace
+
+struct InitialLoadCheckpointTests : testing::Test {
+    TmpFile const file{""};
+
+    InitialLoadCheckpointTests()
+    {
+        std::filesystem::remove(file.path);
+    }
+};
+
+TEST_F(InitialLoadCheckpointTests, NothingWrittenWithoutFile)
+{
+    InitialLoadCheckpoint const checkpoint{file.path, SEQ, NUM_RANGES};
+    EXPECT_EQ(checkpoint.seq(), SEQ);
+    EXPECT_FALSE(checkpoint.writtenUpTo(0));
+    EXPECT_FALSE(checkpoint.writtenUpTo(1));
+    EXPECT_FALSE(InitialLoadCheckpoint::readSequence(file.path).has_value());
+}
+
+TEST_F(InitialLoadCheckpointTests, PersistsRecordedKeys)
+{
+    {
+        InitialLoadCheckpoint checkpoint{file.path, SEQ, NUM_RANGES, std::chrono::seconds{0}};
+        EXPECT_TRUE(checkpoint.record(0, ripple::uint256{KEY1}, NO_WAIT).has_value());
+        EXPECT_TRUE(checkpoint.record(1, ripple::uint256{KEY2}, NO_WAIT).has_value());
+        EXPECT_TRUE(checkpoint.record(1, ripple::uint256{KEY3}, NO_WAIT).has_value());
+        EXPECT_EQ(checkpoint.writtenUpTo(1), ripple::uint256{KEY3});
+    }
+
+    EXPECT_EQ(InitialLoadCheckpoint::readSequence(file.path), SEQ);
+
+    InitialLoadCheckpoint const checkpoint{file.path, SEQ, NUM_RANGES};
+    EXPECT_EQ(checkpoint.writtenUpTo(0), ripple::uint256{KEY1});
+    EXPECT_EQ(checkpoint.writtenUpTo(1), ripple::uint256{KEY3});
+}
+
+TEST_F(InitialLoadCheckpointTests, WaitsForWritesBeforeSaving)
+{
+    InitialLoadCheckpoint checkpoint{file.path, SEQ, NUM_RANGES, std::chrono::seconds{0}};
+    auto numWaits = 0;
+    auto const res = checkpoint.record(0, ripple::uint256{KEY1}, [&] {
+        ++numWaits;
+        EXPECT_FALSE(std::filesystem::exists(file.path));
+        EXPECT_FALSE(checkpoint.writtenUpTo(0));
+    });
+
+    EXPECT_TRUE(res.has_value());
+    EXPECT_EQ(numWaits, 1);
+    EXPECT_EQ(checkpoint.writtenUpTo(0), ripple::uint256{KEY1});
+    EXPECT_EQ(InitialLoadCheckpoint(file.path, SEQ, NUM_RANGES).writtenUpTo(0), ripple::uint256{KEY1});
+}
+
+TEST_F(InitialLoadCheckpointTests, DoesNotSaveBeforeInterval)
+{
+    InitialLoadCheckpoint checkpoint{file.path, SEQ, NUM_RANGES, std::chrono::hours{1}};
+    auto numWaits = 0;
+    EXPECT_TRUE(checkpoint.record(0, ripple::uint256{KEY1}, [&] { ++numWaits; }).has_value());
+    EXPECT_EQ(numWaits, 0);
+    EXPECT_FALSE(checkpoint.writtenUpTo(0));
+    EXPECT_FALSE(std::filesystem::exists(file.path));
+}
+
+TEST_F(InitialLoadCheckpointTests, IgnoresFileOfOtherDownload)
+{
+    {
+        InitialLoadCheckpoint checkpoint{file.path, SEQ, NUM_RANGES, std::chrono::seconds{0}};
+        EXPECT_TRUE(checkpoint.record(0, ripple::uint256{KEY1}, NO_WAIT).has_value());
+    }
+
+    EXPECT_FALSE(InitialLoadCheckpoint(file.path, SEQ + 1, NUM_RANGES).writtenUpTo(0));
+    EXPECT_FALSE(InitialLoadCheckpoint(file.path, SEQ, NUM_RANGES + 1).writtenUpTo(0));
+    EXPECT_EQ(InitialLoadCheckpoint(file.path, SEQ, NUM_RANGES).writtenUpTo(0), ripple::uint256{KEY1});
+}
+
+TEST_F(InitialLoadCheckpointTests, Remove)
+{
+    {
+        InitialLoadCheckpoint checkpoint{file.path, SEQ, NUM_RANGES, std::chrono::seconds{0}};
+        EXPECT_TRUE(checkpoint.record(0, ripple::uint256{KEY1}, NO_WAIT).has_value());
+    }
+    EXPECT_TRUE(std::filesystem::exists(file.path));
+
+    InitialLoadCheckpoint::remove(file.path);
+    EXPECT_FALSE(std::filesystem::exists(file.path));
+    EXPECT_FALSE(InitialLoadCheckpoint(file.path, SEQ, NUM_RANGES).writtenUpTo(0));
+}
@@ -17,6 +17,7 @@
 */
 //==============================================================================
 
+#include "etl/InitialLoadCheckpoint.hpp"
 #include "etl/LoadBalancer.hpp"
 #include "etl/Source.hpp"
 #include "rpc/Errors.hpp"
@@ -28,10 +29,12 @@
 #include "util/MockSubscriptionManager.hpp"
 #include "util/NameGenerator.hpp"
 #include "util/Random.hpp"
+#include "util/TmpFile.hpp"
 #include "util/config/Config.hpp"
 
 #include <boost/asio/io_context.hpp>
 #include <boost/asio/spawn.hpp>
+#include <boost/asio/steady_timer.hpp>
 #include <boost/json/array.hpp>
 #include <boost/json/object.hpp>
 #include <boost/json/parse.hpp>
@@ -40,6 +43,7 @@
 #include <grpcpp/support/status.h>
 #include <gtest/gtest.h>
 #include <org/xrpl/rpc/v1/get_ledger.pb.h>
+#include <xrpl/basics/base_uint.h>
 
 #include <chrono>
 #include <cstdint>
@@ -373,7 +377,7 @@ struct LoadBalancerLoadInitialLedgerTests : LoadBalancerOnConnectHookTests {
 TEST_F(LoadBalancerLoadInitialLedgerTests, load)
 {
     EXPECT_CALL(sourceFactory_.sourceAt(0), hasLedger(sequence_)).WillOnce(Return(true));
-    EXPECT_CALL(sourceFactory_.sourceAt(0), loadInitialLedger(sequence_, numMarkers_, cacheOnly_))
+    EXPECT_CALL(sourceFactory_.sourceAt(0), loadInitialLedger(sequence_, numMarkers_, cacheOnly_, testing::_))
         .WillOnce(Return(response_));
 
     EXPECT_EQ(loadBalancer_->loadInitialLedger(sequence_, cacheOnly_), response_.first);
@@ -383,7 +387,7 @@ TEST_F(LoadBalancerLoadInitialLedgerTests, load_source0DoesntHaveLedger)
 {
     EXPECT_CALL(sourceFactory_.sourceAt(0), hasLedger(sequence_)).WillOnce(Return(false));
     EXPECT_CALL(sourceFactory_.sourceAt(1), hasLedger(sequence_)).WillOnce(Return(true));
-    EXPECT_CALL(sourceFactory_.sourceAt(1), loadInitialLedger(sequence_, numMarkers_, cacheOnly_))
+    EXPECT_CALL(sourceFactory_.sourceAt(1), loadInitialLedger(sequence_, numMarkers_, cacheOnly_, testing::_))
         .WillOnce(Return(response_));
 
     EXPECT_EQ(loadBalancer_->loadInitialLedger(sequence_, cacheOnly_), response_.first);
@@ -393,7 +397,7 @@ TEST_F(LoadBalancerLoadInitialLedgerTests, load_bothSourcesDontHaveLedger)
 {
     EXPECT_CALL(sourceFactory_.sourceAt(0), hasLedger(sequence_)).Times(2).WillRepeatedly(Return(false));
     EXPECT_CALL(sourceFactory_.sourceAt(1), hasLedger(sequence_)).WillOnce(Return(false)).WillOnce(Return(true));
-    EXPECT_CALL(sourceFactory_.sourceAt(1), loadInitialLedger(sequence_, numMarkers_, cacheOnly_))
+    EXPECT_CALL(sourceFactory_.sourceAt(1), loadInitialLedger(sequence_, numMarkers_, cacheOnly_, testing::_))
         .WillOnce(Return(response_));
 
     EXPECT_EQ(loadBalancer_->loadInitialLedger(sequence_, cacheOnly_, std::chrono::milliseconds{1}), response_.first);
@@ -402,10 +406,10 @@ TEST_F(LoadBalancerLoadInitialLedgerTests, load_bothSourcesDontHaveLedger)
 TEST_F(LoadBalancerLoadInitialLedgerTests, load_source0ReturnsStatusFalse)
 {
     EXPECT_CALL(sourceFactory_.sourceAt(0), hasLedger(sequence_)).WillOnce(Return(true));
-    EXPECT_CALL(sourceFactory_.sourceAt(0), loadInitialLedger(sequence_, numMarkers_, cacheOnly_))
+    EXPECT_CALL(sourceFactory_.sourceAt(0), loadInitialLedger(sequence_, numMarkers_, cacheOnly_, testing::_))
         .WillOnce(Return(std::make_pair(std::vector<std::string>{}, false)));
     EXPECT_CALL(sourceFactory_.sourceAt(1), hasLedger(sequence_)).WillOnce(Return(true));
-    EXPECT_CALL(sourceFactory_.sourceAt(1), loadInitialLedger(sequence_, numMarkers_, cacheOnly_))
+    EXPECT_CALL(sourceFactory_.sourceAt(1), loadInitialLedger(sequence_, numMarkers_, cacheOnly_, testing::_))
         .WillOnce(Return(response_));
 
     EXPECT_EQ(loadBalancer_->loadInitialLedger(sequence_, cacheOnly_), response_.first);
@@ -431,12 +435,66 @@ TEST_F(LoadBalancerLoadInitialLedgerCustomNumMarkersTests, loadInitialLedger)
 
     util::Random::setSeed(0);
     EXPECT_CALL(sourceFactory_.sourceAt(0), hasLedger(sequence_)).WillOnce(Return(true));
-    EXPECT_CALL(sourceFactory_.sourceAt(0), loadInitialLedger(sequence_, numMarkers_, cacheOnly_))
+    EXPECT_CALL(sourceFactory_.sourceAt(0), loadInitialLedger(sequence_, numMarkers_, cacheOnly_, testing::_))
         .WillOnce(Return(response_));
 
     EXPECT_EQ(loadBalancer->loadInitialLedger(sequence_, cacheOnly_), response_.first);
 }
 
+struct LoadBalancerInitialLoadCheckpointTests : LoadBalancerConstructorTests {
+    uint32_t const sequence_ = 123;
+    TmpFile const checkpointFile_{""};
+
+    std::unique_ptr<LoadBalancer>
+    makeLoadBalancerWithCheckpoint()
+    {
+        configJson_.as_object()["initial_load_checkpoint_path"] = checkpointFile_.path;
+
+        EXPECT_CALL(sourceFactory_, makeSource).Times(2);
+        EXPECT_CALL(sourceFactory_.sourceAt(0), forwardToRippled).WillOnce(Return(boost::json::object{}));
+        EXPECT_CALL(sourceFactory_.sourceAt(0), run);
+        EXPECT_CALL(sourceFactory_.sourceAt(1), forwardToRippled).WillOnce(Return(boost::json::object{}));
+        EXPECT_CALL(sourceFactory_.sourceAt(1), run);
+        return makeLoadBalancer();
+    }
+};
+
+TEST_F(LoadBalancerInitialLoadCheckpointTests, checkpointPassedToSource)
+{
+    auto loadBalancer = makeLoadBalancerWithCheckpoint();
+
+    util::Random::setSeed(0);
+    EXPECT_CALL(sourceFactory_.sourceAt(0), hasLedger(sequence_)).WillOnce(Return(true));
+    auto const checkpointForSequence = testing::Pointee(testing::Property(&InitialLoadCheckpoint::seq, sequence_));
+    EXPECT_CALL(sourceFactory_.sourceAt(0), loadInitialLedger(sequence_, testing::_, false, checkpointForSequence))
+        .WillOnce(Return(std::make_pair(std::vector<std::string>{}, true)));
+
+    loadBalancer->loadInitialLedger(sequence_);
+}
+
+TEST_F(LoadBalancerInitialLoadCheckpointTests, resumableInitialLedger)
+{
+    auto loadBalancer = makeLoadBalancerWithCheckpoint();
+
+    // nothing to resume from an empty file
+    EXPECT_FALSE(loadBalancer->resumableInitialLedger());
+
+    {
+        InitialLoadCheckpoint checkpoint{checkpointFile_.path, sequence_, 1, std::chrono::seconds{0}};
+        EXPECT_TRUE(checkpoint.record(0, ripple::uint256{1}, [] {}).has_value());
+    }
+
+    EXPECT_CALL(sourceFactory_.sourceAt(0), hasLedger(sequence_)).WillOnce(Return(false));
+    EXPECT_CALL(sourceFactory_.sourceAt(1), hasLedger(sequence_)).WillOnce(Return(false));
+    EXPECT_FALSE(loadBalancer->resumableInitialLedger());
+
+    EXPECT_CALL(sourceFactory_.sourceAt(0), hasLedger(sequence_)).WillOnce(Return(true));
+    EXPECT_EQ(loadBalancer->resumableInitialLedger(), sequence_);
+
+    loadBalancer->removeInitialLoadCheckpoint();
+    EXPECT_FALSE(loadBalancer->resumableInitialLedger());
+}
+
 struct LoadBalancerFetchLegerTests : LoadBalancerOnConnectHookTests {
     LoadBalancerFetchLegerTests()
     {
@@ -714,6 +772,56 @@ TEST_F(LoadBalancerForwardToRippledTests, commandLineMissing)
     });
 }
 
+TEST_F(LoadBalancerForwardToRippledTests, hedgedRequestUsesFasterSource)
+{
+    configJson_.as_object()["forwarding"] = boost::json::object{{"hedge_delay", 0.001}};
+    EXPECT_CALL(sourceFactory_, makeSource).Times(2);
+    auto loadBalancer = makeLoadBalancer();
+
+    auto const request = boost::json::object{{"command", "server_info"}};
+    boost::json::object const slowResponse{{"response", "slow"}};
+
+    EXPECT_CALL(
+        sourceFactory_.sourceAt(0),
+        forwardToRippled(request, clientIP_, LoadBalancer::USER_FORWARDING_X_USER_VALUE, testing::_)
+    )
+        .WillOnce([&](auto&&, auto&&, auto&&, boost::asio::yield_context yield) {
+            boost::asio::steady_timer timer{yield.get_executor(), std::chrono::milliseconds{50}};
+            timer.async_wait(yield);
+            return slowResponse;
+        });
+    EXPECT_CALL(
+        sourceFactory_.sourceAt(1),
+        forwardToRippled(request, clientIP_, LoadBalancer::USER_FORWARDING_X_USER_VALUE, testing::_)
+    )
+        .WillOnce(Return(response_));
+
+    runSpawn([&](boost::asio::yield_context yield) {
+        EXPECT_EQ(loadBalancer->forwardToRippled(request, clientIP_, false, yield), response_);
+    });
+}
+
+TEST_F(LoadBalancerForwardToRippledTests, notIdempotentRequestIsNotHedged)
+{
+    configJson_.as_object()["forwarding"] = boost::json::object{{"hedge_delay", 0.001}};
+    EXPECT_CALL(sourceFactory_, makeSource).Times(2);
+    auto loadBalancer = makeLoadBalancer();
+
+    EXPECT_CALL(
+        sourceFactory_.sourceAt(0),
+        forwardToRippled(request_, clientIP_, LoadBalancer::USER_FORWARDING_X_USER_VALUE, testing::_)
+    )
+        .WillOnce([&](auto&&, auto&&, auto&&, boost::asio::yield_context yield) {
+            boost::asio::steady_timer timer{yield.get_executor(), std::chrono::milliseconds{10}};
+            timer.async_wait(yield);
+            return response_;
+        });
+
+    runSpawn([&](boost::asio::yield_context yield) {
+        EXPECT_EQ(loadBalancer->forwardToRippled(request_, clientIP_, false, yield), response_);
+    });
+}
+
 struct LoadBalancerToJsonTests : LoadBalancerOnConnectHookTests {};
 
 TEST_F(LoadBalancerToJsonTests, toJson)
@@ -721,7 +829,10 @@ TEST_F(LoadBalancerToJsonTests, toJson)
     EXPECT_CALL(sourceFactory_.sourceAt(0), toJson).WillOnce(Return(boost::json::object{{"source1", "value1"}}));
     EXPECT_CALL(sourceFactory_.sourceAt(1), toJson).WillOnce(Return(boost::json::object{{"source2", "value2"}}));
 
-    auto const expectedJson =
-        boost::json::array({boost::json::object{{"source1", "value1"}}, boost::json::object{{"source2", "value2"}}});
+    boost::json::object const stats{{"error_rate", 0.}, {"outstanding_requests", 0u}, {"circuit_open", false}};
+    auto const expectedJson = boost::json::array(
+        {boost::json::object{{"source1", "value1"}, {"stats", stats}},
+         boost::json::object{{"source2", "value2"}, {"stats", stats}}}
+    );
     EXPECT_EQ(loadBalancer_->toJson(), expectedJson);
 }
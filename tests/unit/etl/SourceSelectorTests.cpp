@@ -0,0 +1,173 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "etl/impl/SourceSelector.hpp"
+#include "etl/impl/SourceStats.hpp"
+#include "util/MockPrometheus.hpp"
+#include "util/Random.hpp"
+#include "util/prometheus/Label.hpp"
+#include "util/prometheus/Prometheus.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace etl::impl;
+
+struct SourceSelectorTests : util::prometheus::WithPrometheus {
+    SourceSelector selector_;
+
+    SourceSelectorTests()
+    {
+        util::Random::setSeed(0);
+        for (auto i = 0; i < 3; ++i)
+            selector_.addSource(std::to_string(i));
+    }
+};
+
+TEST_F(SourceSelectorTests, EveryIndexIsInOrder)
+{
+    auto order = selector_.order();
+    std::ranges::sort(order);
+    EXPECT_EQ(order, (std::vector<std::size_t>{0, 1, 2}));
+}
+
+TEST_F(SourceSelectorTests, FastSourceIsPreferred)
+{
+    selector_.stats(0).onStart();
+    selector_.stats(0).onSuccess(std::chrono::milliseconds{100});
+    selector_.stats(1).onStart();
+    selector_.stats(1).onSuccess(std::chrono::milliseconds{1});
+    selector_.stats(2).onStart();
+    selector_.stats(2).onSuccess(std::chrono::milliseconds{50});
+
+    for (auto i = 0; i < 10; ++i) {
+        auto const order = selector_.order();
+        // the slowest source is never picked first and the rest are ordered by latency
+        EXPECT_NE(order.front(), 0u);
+        EXPECT_EQ(order.back(), 0u);
+    }
+}
+
+TEST_F(SourceSelectorTests, BusySourceIsAvoided)
+{
+    for (auto i = 0; i < 10; ++i)
+        selector_.stats(1).onStart();
+
+    for (auto i = 0; i < 10; ++i)
+        EXPECT_EQ(selector_.order().back(), 1u);
+}
+
+TEST_F(SourceSelectorTests, SourceWithOpenCircuitGoesLast)
+{
+    for (std::size_t i = 0; i < SourceStats::FAILURES_TO_OPEN_CIRCUIT; ++i) {
+        selector_.stats(2).onStart();
+        selector_.stats(2).onFailure();
+    }
+    // make the failed source look the fastest otherwise
+    selector_.stats(0).onStart();
+    selector_.stats(0).onSuccess(std::chrono::seconds{1});
+    selector_.stats(1).onStart();
+    selector_.stats(1).onSuccess(std::chrono::seconds{1});
+
+    EXPECT_FALSE(selector_.stats(2).isAvailable());
+    for (auto i = 0; i < 10; ++i)
+        EXPECT_EQ(selector_.order().back(), 2u);
+}
+
+struct SourceStatsTests : util::prometheus::WithPrometheus {
+    std::chrono::steady_clock::time_point now{std::chrono::hours{1}};
+    SourceStats stats_{"test", [this] { return now; }};
+
+    static bool
+    circuitOpenMetric()
+    {
+        return PrometheusService::boolMetric("etl_source_circuit_open", util::prometheus::Labels({{"source", "test"}}));
+    }
+};
+
+TEST_F(SourceStatsTests, TracksOutstandingRequests)
+{
+    stats_.onStart();
+    stats_.onStart();
+    EXPECT_EQ(stats_.toJson().at("outstanding_requests").as_uint64(), 2u);
+
+    auto const scoreWithTwo = stats_.score();
+    stats_.onSuccess(std::nullopt);
+    EXPECT_EQ(stats_.toJson().at("outstanding_requests").as_uint64(), 1u);
+    EXPECT_LT(stats_.score(), scoreWithTwo);
+}
+
+TEST_F(SourceStatsTests, LatencyIsMovingAverage)
+{
+    stats_.onStart();
+    stats_.onSuccess(std::chrono::milliseconds{10});
+    EXPECT_DOUBLE_EQ(stats_.toJson().at("latency_ms").as_double(), 10.);
+
+    stats_.onStart();
+    stats_.onSuccess(std::chrono::milliseconds{20});
+    EXPECT_DOUBLE_EQ(
+        stats_.toJson().at("latency_ms").as_double(),
+        (SourceStats::LATENCY_WEIGHT * 20.) + ((1. - SourceStats::LATENCY_WEIGHT) * 10.)
+    );
+}
+
+TEST_F(SourceStatsTests, CircuitOpensAfterConsecutiveFailuresAndClosesOnSuccess)
+{
+    for (std::size_t i = 0; i < SourceStats::FAILURES_TO_OPEN_CIRCUIT; ++i) {
+        EXPECT_TRUE(stats_.isAvailable());
+        stats_.onStart();
+        stats_.onFailure();
+    }
+    EXPECT_FALSE(stats_.isAvailable());
+    EXPECT_TRUE(stats_.toJson().at("circuit_open").as_bool());
+    EXPECT_GT(stats_.toJson().at("error_rate").as_double(), 0.);
+
+    stats_.onStart();
+    stats_.onSuccess(std::nullopt);
+    EXPECT_TRUE(stats_.isAvailable());
+    EXPECT_FALSE(stats_.toJson().at("circuit_open").as_bool());
+}
+
+TEST_F(SourceStatsTests, CircuitClosesWhenItTimesOut)
+{
+    for (std::size_t i = 0; i < SourceStats::FAILURES_TO_OPEN_CIRCUIT; ++i) {
+        stats_.onStart();
+        stats_.onFailure();
+    }
+    EXPECT_FALSE(stats_.isAvailable());
+    EXPECT_TRUE(circuitOpenMetric());
+
+    now += SourceStats::CIRCUIT_OPEN_DURATION;
+    EXPECT_TRUE(stats_.isAvailable());
+    EXPECT_FALSE(stats_.toJson().at("circuit_open").as_bool());
+    EXPECT_FALSE(circuitOpenMetric());
+
+    // a failure while probing opens the circuit again
+    stats_.onStart();
+    stats_.onFailure();
+    EXPECT_FALSE(stats_.isAvailable());
+    EXPECT_TRUE(stats_.toJson().at("circuit_open").as_bool());
+    EXPECT_TRUE(circuitOpenMetric());
+}
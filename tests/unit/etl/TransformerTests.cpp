@@ -116,6 +116,7 @@ TEST_F(ETLTransformerTest, StopsOnEmptyFetchResponse)
     EXPECT_CALL(*backend, writeAccountTransactions).Times(AtLeast(1));
     EXPECT_CALL(*backend, writeNFTs).Times(AtLeast(1));
     EXPECT_CALL(*backend, writeNFTTransactions).Times(AtLeast(1));
+    EXPECT_CALL(*backend, markLedgerSubmitted).Times(AtLeast(1));
     EXPECT_CALL(*backend, doFinishWrites).Times(AtLeast(1));
     EXPECT_CALL(ledgerPublisher_, publish(_)).Times(AtLeast(1));
 
@@ -157,4 +158,28 @@ TEST_F(ETLTransformerTest, DoesNotPublishIfCanNotBuildNextLedger)
     );
 }
 
+TEST_F(ETLTransformerTest, StopsCommittingAfterFailedCommit)
+{
+    backend->cache().setFull();  // to avoid throwing exception in updateCache
+
+    auto const blob = hexStringToBinaryString(RAW_HEADER);
+    auto const response = std::make_optional<FakeFetchResponse>(blob);
+
+    ON_CALL(dataPipe_, popNext).WillByDefault(Return(response));
+
+    // ledgers submitted while the first one was being committed must not be committed after it failed
+    EXPECT_CALL(dataPipe_, popNext).Times(AtLeast(1));
+    EXPECT_CALL(*backend, writeLedger(_, _)).Times(AtLeast(1));
+    EXPECT_CALL(ledgerLoader_, insertTransactions).Times(AtLeast(1));
+    EXPECT_CALL(*backend, doFinishWrites(_)).WillOnce(Return(false));
+    EXPECT_CALL(ledgerPublisher_, publish(_)).Times(0);
+
+    transformer_ = std::make_unique<TransformerType>(
+        dataPipe_, backend, ledgerLoader_, ledgerPublisher_, amendmentBlockHandler_, 0, state_
+    );
+    transformer_->waitTillFinished();
+
+    EXPECT_TRUE(state_.writeConflict);
+}
+
 // TODO: implement tests for amendment block. requires more refactoring
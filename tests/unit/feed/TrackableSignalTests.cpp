@@ -136,3 +136,44 @@ TEST_F(FeedTrackableSignalTests, MapAutoDisconnect)
     signalMap.emit("test1", "test1");
     EXPECT_TRUE(testString.empty());
 }
+
+TEST_F(FeedTrackableSignalTests, DisconnectWhileEmitting)
+{
+    feed::impl::TrackableSignal<web::ConnectionBase, std::string> signal;
+    auto const session2 = std::make_shared<MockSession>();
+    std::string testString;
+    auto const slot = [&](std::string const& s) {
+        testString += s;
+        signal.disconnect(sessionPtr.get());
+        signal.disconnect(session2.get());
+    };
+    EXPECT_TRUE(signal.connectTrackableSlot(sessionPtr, slot));
+    EXPECT_TRUE(signal.connectTrackableSlot(session2, slot));
+
+    // the second slot is disconnected by the first one so it is not called even though the emit is in progress
+    signal.emit("test");
+    EXPECT_EQ(testString, "test");
+    EXPECT_EQ(signal.count(), 0);
+
+    testString.clear();
+    signal.emit("test2");
+    EXPECT_TRUE(testString.empty());
+}
+
+TEST_F(FeedTrackableSignalTests, MapConnectWhileEmitting)
+{
+    feed::impl::TrackableSignalMap<std::string, web::ConnectionBase, std::string> signalMap;
+    std::string testString;
+    auto const slot = [&](std::string const& s) { testString += s; };
+    auto const connectingSlot = [&](std::string const& s) {
+        testString += s;
+        signalMap.connectTrackableSlot(sessionPtr, "test1", slot);
+    };
+    EXPECT_TRUE(signalMap.connectTrackableSlot(sessionPtr, "test", connectingSlot));
+
+    signalMap.emit("test", "test");
+    EXPECT_EQ(testString, "test");
+
+    signalMap.emit("test1", "test1");
+    EXPECT_EQ(testString, "testtest1");
+}
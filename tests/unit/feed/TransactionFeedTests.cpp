@@ -40,6 +40,9 @@
 #include <xrpl/protocol/TER.h>
 
 #include <memory>
+#include <string>
+#include <utility>
+#include <vector>
 
 constexpr static auto ACCOUNT1 = "rf1BiGeXwwQoi8Z2ueFYTEXSwuJYfV2Jpn";
 constexpr static auto ACCOUNT2 = "rLEsXccBGNR3UPuPu2hUXPjziKC3qKSBun";
@@ -1013,6 +1016,90 @@ TEST_F(FeedTransactionTest, SubProposedAccountDisconnect)
     testFeedPtr->pub(trans1, ledgerHeader, backend);
 }
 
+TEST_F(FeedTransactionTest, PubOfferCreationWithoutSubscribersDoesNotFetchOwnerFunds)
+{
+    // subscribed to an account which is not affected by the transaction
+    testFeedPtr->sub(GetAccountIDWithString(ACCOUNT2), sessionPtr);
+
+    auto const ledgerHeader = CreateLedgerHeader(LEDGERHASH, 33);
+    auto trans1 = TransactionAndMetadata();
+    ripple::STObject const obj = CreateCreateOfferTransactionObject(ACCOUNT1, 1, 32, CURRENCY, ISSUER, 1, 3);
+    trans1.transaction = obj.getSerializer().peekData();
+    trans1.ledgerSequence = 32;
+    ripple::STArray const metaArray{0};
+    ripple::STObject metaObj(ripple::sfTransactionMetaData);
+    metaObj.setFieldArray(ripple::sfAffectedNodes, metaArray);
+    metaObj.setFieldU8(ripple::sfTransactionResult, ripple::tesSUCCESS);
+    metaObj.setFieldU32(ripple::sfTransactionIndex, 22);
+    trans1.metadata = metaObj.getSerializer().peekData();
+
+    EXPECT_CALL(*backend, doFetchLedgerObject).Times(0);
+    EXPECT_CALL(*mockSessionPtr, send(testing::_)).Times(0);
+    testFeedPtr->pub(trans1, ledgerHeader, backend);
+
+    testFeedPtr->unsub(GetAccountIDWithString(ACCOUNT2), sessionPtr);
+    testFeedPtr->pub(trans1, ledgerHeader, backend);
+}
+
+TEST_F(FeedTransactionTest, SubscribersOfSameVersionShareMessage)
+{
+    auto const session2 = std::make_shared<MockSession>();
+    session2->apiSubVersion = 1;
+    auto const session3 = std::make_shared<MockSession>();
+    session3->apiSubVersion = 2;
+
+    testFeedPtr->sub(sessionPtr);
+    testFeedPtr->sub(session2);
+    testFeedPtr->sub(session3);
+
+    auto const ledgerHeader = CreateLedgerHeader(LEDGERHASH, 33);
+    auto trans1 = TransactionAndMetadata();
+    ripple::STObject const obj = CreatePaymentTransactionObject(ACCOUNT1, ACCOUNT2, 1, 1, 32);
+    trans1.transaction = obj.getSerializer().peekData();
+    trans1.ledgerSequence = 32;
+    trans1.metadata = CreatePaymentTransactionMetaObject(ACCOUNT1, ACCOUNT2, 110, 30, 22).getSerializer().peekData();
+
+    std::shared_ptr<std::string> msg1;
+    std::shared_ptr<std::string> msg2;
+    EXPECT_CALL(*mockSessionPtr, send(SharedStringJsonEq(TRAN_V1))).WillOnce(testing::SaveArg<0>(&msg1));
+    EXPECT_CALL(*session2, send(SharedStringJsonEq(TRAN_V1))).WillOnce(testing::SaveArg<0>(&msg2));
+    EXPECT_CALL(*session3, send(SharedStringJsonEq(TRAN_V2))).Times(1);
+    testFeedPtr->pub(trans1, ledgerHeader, backend);
+
+    EXPECT_EQ(msg1, msg2);
+}
+
+TEST_F(FeedTransactionTest, ShardedFeedNotifiesEachSessionOnce)
+{
+    static constexpr auto NUM_SHARDS = 4;
+    static constexpr auto NUM_SESSIONS = 8;
+
+    auto const shardedFeed = std::make_shared<TransactionFeed>(ctx, NUM_SHARDS);
+    auto const account1 = GetAccountIDWithString(ACCOUNT1);
+    auto const account2 = GetAccountIDWithString(ACCOUNT2);
+
+    std::vector<std::shared_ptr<MockSession>> sessions;
+    for (auto i = 0; i < NUM_SESSIONS; ++i) {
+        auto session = std::make_shared<MockSession>();
+        session->apiSubVersion = 1;
+        shardedFeed->sub(account1, session);
+        shardedFeed->sub(account2, session);
+        sessions.push_back(std::move(session));
+    }
+    EXPECT_EQ(shardedFeed->accountSubCount(), NUM_SESSIONS * 2);
+
+    auto const ledgerHeader = CreateLedgerHeader(LEDGERHASH, 33);
+    auto trans1 = TransactionAndMetadata();
+    ripple::STObject const obj = CreatePaymentTransactionObject(ACCOUNT1, ACCOUNT2, 1, 1, 32);
+    trans1.transaction = obj.getSerializer().peekData();
+    trans1.ledgerSequence = 32;
+    trans1.metadata = CreatePaymentTransactionMetaObject(ACCOUNT1, ACCOUNT2, 110, 30, 22).getSerializer().peekData();
+
+    for (auto const& session : sessions)
+        EXPECT_CALL(*session, send(SharedStringJsonEq(TRAN_V1))).Times(1);
+    shardedFeed->pub(trans1, ledgerHeader, backend);
+}
+
 struct TransactionFeedMockPrometheusTest : WithMockPrometheus, SyncExecutionCtxFixture {
 protected:
     std::shared_ptr<web::ConnectionBase> sessionPtr;
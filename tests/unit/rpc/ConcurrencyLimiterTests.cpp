@@ -0,0 +1,102 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "rpc/ConcurrencyLimiter.hpp"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstddef>
+
+using namespace rpc;
+
+namespace {
+
+constexpr std::size_t MIN_LIMIT = 4;
+constexpr std::size_t MAX_LIMIT = 100;
+constexpr std::chrono::microseconds FAST{1'000};
+constexpr std::chrono::microseconds SLOW{10'000};
+
+}  // namespace
+
+struct ConcurrencyLimiterTest : ::testing::Test {
+    ConcurrencyLimiter limiter{MIN_LIMIT, MAX_LIMIT};
+
+    void
+    feed(std::chrono::microseconds latency, std::size_t numSamples)
+    {
+        for (std::size_t i = 0; i < numSamples; ++i)
+            limiter.onSample(latency, limiter.limit());
+    }
+};
+
+TEST_F(ConcurrencyLimiterTest, StartsAtMaximum)
+{
+    EXPECT_EQ(limiter.limit(), MAX_LIMIT);
+}
+
+TEST_F(ConcurrencyLimiterTest, StaysAtMaximumWhileLatencyIsStable)
+{
+    feed(FAST, 1'000);
+    EXPECT_EQ(limiter.limit(), MAX_LIMIT);
+}
+
+TEST_F(ConcurrencyLimiterTest, ShrinksWhenLatencyGrows)
+{
+    feed(FAST, 1'000);
+    feed(SLOW, 10);
+    auto const shrunk = limiter.limit();
+    EXPECT_LT(shrunk, MAX_LIMIT);
+
+    feed(SLOW, 10);
+    EXPECT_LT(limiter.limit(), shrunk);
+
+    feed(SLOW, 100);
+    EXPECT_EQ(limiter.limit(), MIN_LIMIT);
+}
+
+TEST_F(ConcurrencyLimiterTest, GrowsBackWhenLatencyRecovers)
+{
+    feed(FAST, 1'000);
+    feed(SLOW, 100);
+    ASSERT_LT(limiter.limit(), MAX_LIMIT);
+
+    feed(FAST, 1'000);
+    EXPECT_EQ(limiter.limit(), MAX_LIMIT);
+}
+
+TEST_F(ConcurrencyLimiterTest, UnusedLimitDoesNotChange)
+{
+    feed(FAST, 1'000);
+    feed(SLOW, 100);
+    auto const limit = limiter.limit();
+
+    for (auto i = 0; i < 1'000; ++i)
+        limiter.onSample(FAST, 1);
+    EXPECT_EQ(limiter.limit(), limit);
+}
+
+TEST_F(ConcurrencyLimiterTest, BoundsAreSane)
+{
+    ConcurrencyLimiter const zero{0, 0};
+    EXPECT_EQ(zero.limit(), 1u);
+
+    ConcurrencyLimiter const inverted{10, 5};
+    EXPECT_EQ(inverted.limit(), 10u);
+}
@@ -0,0 +1,126 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "rpc/LedgerResponseCache.hpp"
+#include "rpc/RequestKey.hpp"
+#include "util/MockPrometheus.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+using namespace rpc;
+
+namespace {
+
+constexpr auto SEQ = 30;
+
+RequestKey
+historicalKey(std::string key)
+{
+    return RequestKey{.key = std::move(key), .isLatestLedger = false};
+}
+
+RequestKey
+latestKey(std::string key)
+{
+    return RequestKey{.key = std::move(key), .isLatestLedger = true};
+}
+
+std::shared_ptr<std::string const>
+makeResponse(std::size_t size)
+{
+    return std::make_shared<std::string const>(size, 'r');
+}
+
+}  // namespace
+
+struct LedgerResponseCacheTest : util::prometheus::WithPrometheus {
+    static constexpr std::size_t RESPONSE_SIZE = 100;
+    LedgerResponseCache cache{{"ledger"}, 3 * (RESPONSE_SIZE + 2)};
+};
+
+TEST_F(LedgerResponseCacheTest, ShouldCacheConfiguredMethodsOnly)
+{
+    EXPECT_TRUE(cache.shouldCache("ledger"));
+    EXPECT_FALSE(cache.shouldCache("account_info"));
+    EXPECT_FALSE(LedgerResponseCache({"ledger"}, 0).shouldCache("ledger"));
+}
+
+TEST_F(LedgerResponseCacheTest, GetReturnsStoredResponse)
+{
+    auto const response = makeResponse(RESPONSE_SIZE);
+    cache.put(historicalKey("a"), SEQ, response);
+
+    EXPECT_EQ(cache.get(historicalKey("a"), SEQ), response);
+    EXPECT_EQ(cache.get(historicalKey("b"), SEQ), nullptr);
+}
+
+TEST_F(LedgerResponseCacheTest, HistoricalResponsesSurviveNewLedgers)
+{
+    cache.put(historicalKey("a"), SEQ, makeResponse(RESPONSE_SIZE));
+
+    EXPECT_NE(cache.get(historicalKey("a"), SEQ + 1), nullptr);
+}
+
+TEST_F(LedgerResponseCacheTest, LatestLedgerResponsesAreDroppedOnNewLedger)
+{
+    cache.put(latestKey("a"), SEQ, makeResponse(RESPONSE_SIZE));
+    EXPECT_NE(cache.get(latestKey("a"), SEQ), nullptr);
+
+    EXPECT_EQ(cache.get(latestKey("a"), SEQ + 1), nullptr);
+    EXPECT_EQ(cache.size(), 0u);
+    EXPECT_EQ(cache.bytes(), 0u);
+}
+
+TEST_F(LedgerResponseCacheTest, LatestLedgerResponseOfOutdatedLedgerIsNotStored)
+{
+    EXPECT_EQ(cache.get(latestKey("b"), SEQ + 1), nullptr);
+    cache.put(latestKey("a"), SEQ, makeResponse(RESPONSE_SIZE));
+
+    EXPECT_EQ(cache.size(), 0u);
+}
+
+TEST_F(LedgerResponseCacheTest, EvictsLeastRecentlyUsed)
+{
+    cache.put(historicalKey("a"), SEQ, makeResponse(RESPONSE_SIZE));
+    cache.put(historicalKey("b"), SEQ, makeResponse(RESPONSE_SIZE));
+    cache.put(historicalKey("c"), SEQ, makeResponse(RESPONSE_SIZE));
+
+    // makes "a" the most recently used
+    EXPECT_NE(cache.get(historicalKey("a"), SEQ), nullptr);
+
+    cache.put(historicalKey("d"), SEQ, makeResponse(RESPONSE_SIZE));
+
+    EXPECT_EQ(cache.size(), 3u);
+    EXPECT_NE(cache.get(historicalKey("a"), SEQ), nullptr);
+    EXPECT_EQ(cache.get(historicalKey("b"), SEQ), nullptr);
+    EXPECT_NE(cache.get(historicalKey("c"), SEQ), nullptr);
+    EXPECT_NE(cache.get(historicalKey("d"), SEQ), nullptr);
+}
+
+TEST_F(LedgerResponseCacheTest, ResponseBiggerThanCacheIsNotStored)
+{
+    cache.put(historicalKey("a"), SEQ, makeResponse(10 * RESPONSE_SIZE));
+
+    EXPECT_EQ(cache.size(), 0u);
+    EXPECT_EQ(cache.bytes(), 0u);
+}
@@ -24,6 +24,9 @@
 #include "rpc/RPCEngine.hpp"
 #include "rpc/WorkQueue.hpp"
 #include "rpc/common/AnyHandler.hpp"
+#include "rpc/common/Specs.hpp"
+#include "rpc/common/Types.hpp"
+#include "rpc/common/Validators.hpp"
 #include "util/AsioContextTestFixture.hpp"
 #include "util/MockBackendTestFixture.hpp"
 #include "util/MockCounters.hpp"
@@ -39,11 +42,15 @@
 #include "web/dosguard/DOSGuard.hpp"
 #include "web/dosguard/WhitelistHandler.hpp"
 
+#include <boost/json/conversion.hpp>
 #include <boost/json/object.hpp>
 #include <boost/json/parse.hpp>
+#include <boost/json/value.hpp>
+#include <boost/json/value_to.hpp>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <cstdint>
 #include <exception>
 #include <memory>
 #include <optional>
@@ -64,6 +71,73 @@ constexpr auto FORWARD_REPLY = R"JSON({
         "forwarded": true
     }
 })JSON";
+
+struct LedgerIndexInput {
+    std::optional<uint32_t> ledgerIndex;
+};
+
+struct LedgerIndexOutput {
+    uint32_t ledgerIndex;
+};
+
+LedgerIndexInput
+tag_invoke(boost::json::value_to_tag<LedgerIndexInput>, boost::json::value const& jv)
+{
+    if (not jv.as_object().contains("ledger_index"))
+        return {};
+
+    return {boost::json::value_to<uint32_t>(jv.as_object().at("ledger_index"))};
+}
+
+void
+tag_invoke(boost::json::value_from_tag, boost::json::value& jv, LedgerIndexOutput const& output)
+{
+    jv = {{"ledger_index", output.ledgerIndex}};
+}
+
+// answers for the requested or the latest ledger and publishes a new ledger before reading it
+struct PublishingHandlerFake {
+    using Input = LedgerIndexInput;
+    using Output = LedgerIndexOutput;
+    using Result = rpc::HandlerReturnType<Output>;
+
+    std::shared_ptr<BackendInterface> backend;
+
+    static rpc::RpcSpecConstRef
+    spec([[maybe_unused]] uint32_t apiVersion)
+    {
+        static auto const rpcSpec = rpc::RpcSpec{{"ledger_index", rpc::validation::Type<uint32_t>{}}};
+        return rpcSpec;
+    }
+
+    Result
+    process(Input input, [[maybe_unused]] rpc::Context const& ctx) const
+    {
+        backend->updateRange(backend->fetchLedgerRange()->maxSequence + 1);
+        return Output{input.ledgerIndex.value_or(backend->fetchLedgerRange()->maxSequence)};
+    }
+};
+
+// answers with the parameters it was given; takes no ledger
+struct EchoHandlerFake {
+    using Input = boost::json::object;
+    using Output = boost::json::object;
+    using Result = rpc::HandlerReturnType<Output>;
+
+    static rpc::RpcSpecConstRef
+    spec([[maybe_unused]] uint32_t apiVersion)
+    {
+        static auto const rpcSpec = rpc::RpcSpec{{"hello", rpc::validation::Type<std::string>{}}};
+        return rpcSpec;
+    }
+
+    Result
+    process(Input input, [[maybe_unused]] rpc::Context const& ctx) const
+    {
+        return input;
+    }
+};
+
 }  // namespace
 
 struct RPCEngineTest : util::prometheus::WithPrometheus,
@@ -474,3 +548,70 @@ TEST_F(RPCEngineTest, NotCacheIfErrorHappen)
         });
     }
 }
+
+TEST_F(RPCEngineTest, CachedResponseIsForPinnedLedgerWhenLedgerIsPublishedMeanwhile)
+{
+    auto const cfgCache = Config{json::parse(R"JSON({
+        "server": {"max_queue_size": 2},
+        "workers": 4,
+        "rpc": {"response_cache": {"methods": ["account_info"]}}
+    })JSON")};
+
+    auto const method = "account_info";
+    std::shared_ptr<RPCEngine<MockLoadBalancer, MockCounters>> engine =
+        RPCEngine<MockLoadBalancer, MockCounters>::make_RPCEngine(
+            cfgCache, backend, mockLoadBalancerPtr, dosGuard, queue, *mockCountersPtr, handlerProvider
+        );
+
+    backend->setRange(10, 30);
+    EXPECT_CALL(*backend, isTooBusy).WillOnce(Return(false));
+    EXPECT_CALL(*handlerProvider, isClioOnly).WillOnce(Return(false));
+    EXPECT_CALL(*handlerProvider, getHandler(method))
+        .WillOnce(Return(AnyHandler{PublishingHandlerFake{.backend = backend}}));
+
+    runSpawn([&](auto yield) {
+        auto const ctx = web::Context(
+            yield, method, 1, boost::json::object{}, nullptr, tagFactory, LedgerRange{10, 30}, "127.0.0.2", false
+        );
+
+        // the key is pinned to ledger 30, so the response cached under it must be for ledger 30 and not 31
+        auto const res = engine->buildResponse(ctx);
+        auto const response = std::get_if<boost::json::object>(&res.response);
+        ASSERT_NE(response, nullptr);
+        EXPECT_EQ(*response, json::parse(R"JSON({"ledger_index": 30})JSON").as_object());
+        ASSERT_NE(res.serializedResponse, nullptr);
+        EXPECT_EQ(json::parse(*res.serializedResponse), json::parse(R"JSON({"ledger_index": 30})JSON"));
+    });
+}
+
+TEST_F(RPCEngineTest, CachedMethodNotTakingLedgerIsNotPinned)
+{
+    auto const cfgCache = Config{json::parse(R"JSON({
+        "server": {"max_queue_size": 2},
+        "workers": 4,
+        "rpc": {"response_cache": {"methods": ["echo"]}}
+    })JSON")};
+
+    auto const method = "echo";
+    std::shared_ptr<RPCEngine<MockLoadBalancer, MockCounters>> engine =
+        RPCEngine<MockLoadBalancer, MockCounters>::make_RPCEngine(
+            cfgCache, backend, mockLoadBalancerPtr, dosGuard, queue, *mockCountersPtr, handlerProvider
+        );
+
+    backend->setRange(10, 30);
+    EXPECT_CALL(*backend, isTooBusy).WillOnce(Return(false));
+    EXPECT_CALL(*handlerProvider, isClioOnly).WillOnce(Return(false));
+    EXPECT_CALL(*handlerProvider, getHandler(method)).WillOnce(Return(AnyHandler{EchoHandlerFake{}}));
+
+    runSpawn([&](auto yield) {
+        auto const params = json::parse(R"JSON({"hello": "world"})JSON").as_object();
+        auto const ctx =
+            web::Context(yield, method, 1, params, nullptr, tagFactory, LedgerRange{10, 30}, "127.0.0.2", false);
+
+        // the handler doesn't take ledger_index so it must not be added to the parameters
+        auto const res = engine->buildResponse(ctx);
+        auto const response = std::get_if<boost::json::object>(&res.response);
+        ASSERT_NE(response, nullptr);
+        EXPECT_EQ(*response, params);
+    });
+}
@@ -313,6 +313,112 @@ TEST_F(RPCHelpersTest, TraverseOwnedNodesWithUnexistingIndexMarker)
     ctx.run();
 }
 
+// 4 pages of 10 objects, the pages following the root page are fetched together with the objects of the root page
+TEST_F(RPCHelpersTest, TraverseOwnedNodesPrefetchesFollowingPages)
+{
+    auto const account = GetAccountIDWithString(ACCOUNT);
+    auto const ownerDirKl = ripple::keylet::ownerDir(account);
+    constexpr static auto numPages = 4;
+    constexpr static auto objectsPerPage = 10;
+
+    std::vector<ripple::uint256> const indexes(objectsPerPage, ripple::uint256{INDEX1});
+    auto const channel = CreatePaymentChannelLedgerObject(ACCOUNT, ACCOUNT2, 100, 10, 32, TXNID, 28);
+
+    ripple::STObject rootDir = CreateOwnerDirLedgerObject(indexes, INDEX1);
+    rootDir.setFieldU64(ripple::sfIndexNext, 1);
+    rootDir.setFieldU64(ripple::sfIndexPrevious, numPages - 1);
+    EXPECT_CALL(*backend, doFetchLedgerObject(ownerDirKl.key, testing::_, testing::_))
+        .WillOnce(Return(rootDir.getSerializer().peekData()));
+
+    std::vector<ripple::uint256> prefetchedKeys;
+    std::vector<Blob> prefetchedBlobs;
+    for (auto page = 1; page < numPages; ++page) {
+        ripple::STObject dir = CreateOwnerDirLedgerObject(indexes, INDEX1);
+        dir.setFieldU64(ripple::sfIndexNext, page + 1 == numPages ? 0 : page + 1);
+        prefetchedKeys.push_back(ripple::keylet::page(ownerDirKl, page).key);
+        prefetchedBlobs.push_back(dir.getSerializer().peekData());
+    }
+    prefetchedKeys.insert(prefetchedKeys.end(), indexes.begin(), indexes.end());
+    prefetchedBlobs.insert(prefetchedBlobs.end(), objectsPerPage, channel.getSerializer().peekData());
+
+    EXPECT_CALL(*backend, doFetchLedgerObjects(prefetchedKeys, testing::_, testing::_))
+        .WillOnce(Return(prefetchedBlobs));
+
+    auto constexpr remaining = (numPages - 1) * objectsPerPage;
+    EXPECT_CALL(
+        *backend,
+        doFetchLedgerObjects(std::vector<ripple::uint256>(remaining, ripple::uint256{INDEX1}), testing::_, testing::_)
+    )
+        .WillOnce(Return(std::vector<Blob>(remaining, channel.getSerializer().peekData())));
+
+    boost::asio::spawn(ctx, [&, this](boost::asio::yield_context yield) {
+        auto count = 0;
+        auto ret = traverseOwnedNodes(*backend, account, 9, 100, {}, yield, [&](auto) { count++; });
+        auto cursor = std::get_if<AccountCursor>(&ret);
+        ASSERT_TRUE(cursor != nullptr);
+        EXPECT_EQ(count, numPages * objectsPerPage);
+        EXPECT_EQ(cursor->toString(), "0000000000000000000000000000000000000000000000000000000000000000,0");
+    });
+    ctx.run();
+}
+
+// starting from a marker, the root page is fetched together with the next page to find out where the directory ends
+TEST_F(RPCHelpersTest, TraverseOwnedNodesWithMarkerPrefetchesFollowingPages)
+{
+    auto const account = GetAccountIDWithString(ACCOUNT);
+    auto const ownerDirKl = ripple::keylet::ownerDir(account);
+    constexpr static auto objectsPerPage = 10;
+    constexpr static auto limit = 50;
+
+    std::vector<ripple::uint256> const indexes(objectsPerPage, ripple::uint256{INDEX1});
+    auto const channel = CreatePaymentChannelLedgerObject(ACCOUNT, ACCOUNT2, 100, 10, 32, TXNID, 28);
+
+    ripple::STObject rootDir = CreateOwnerDirLedgerObject(indexes, INDEX1);
+    rootDir.setFieldU64(ripple::sfIndexNext, 1);
+    rootDir.setFieldU64(ripple::sfIndexPrevious, 3);
+
+    auto makePage = [&](std::uint64_t next) {
+        ripple::STObject dir = CreateOwnerDirLedgerObject(indexes, INDEX1);
+        dir.setFieldU64(ripple::sfIndexNext, next);
+        return dir.getSerializer().peekData();
+    };
+
+    // the hint page is read once to validate the marker and once more to start the traversal
+    EXPECT_CALL(*backend, doFetchLedgerObject(ripple::keylet::page(ownerDirKl, 1).key, testing::_, testing::_))
+        .Times(2)
+        .WillRepeatedly(Return(makePage(2)));
+
+    // 9 objects left on the hint page, so 41 more objects need 2 pages at most
+    std::vector<ripple::uint256> prefetchedKeys{
+        ripple::keylet::page(ownerDirKl, 2).key, ripple::keylet::page(ownerDirKl, 3).key, ownerDirKl.key
+    };
+    std::vector<Blob> prefetchedBlobs{makePage(3), makePage(0), rootDir.getSerializer().peekData()};
+    prefetchedKeys.insert(prefetchedKeys.end(), objectsPerPage - 1, ripple::uint256{INDEX1});
+    prefetchedBlobs.insert(prefetchedBlobs.end(), objectsPerPage - 1, channel.getSerializer().peekData());
+
+    EXPECT_CALL(*backend, doFetchLedgerObjects(prefetchedKeys, testing::_, testing::_))
+        .WillOnce(Return(prefetchedBlobs));
+
+    auto constexpr remaining = 2 * objectsPerPage;
+    EXPECT_CALL(
+        *backend,
+        doFetchLedgerObjects(std::vector<ripple::uint256>(remaining, ripple::uint256{INDEX1}), testing::_, testing::_)
+    )
+        .WillOnce(Return(std::vector<Blob>(remaining, channel.getSerializer().peekData())));
+
+    boost::asio::spawn(ctx, [&, this](boost::asio::yield_context yield) {
+        auto count = 0;
+        auto ret = traverseOwnedNodes(
+            *backend, account, 9, limit, fmt::format("{},{}", INDEX1, 1), yield, [&](auto) { count++; }
+        );
+        auto cursor = std::get_if<AccountCursor>(&ret);
+        ASSERT_TRUE(cursor != nullptr);
+        EXPECT_EQ(count, objectsPerPage - 1 + remaining);
+        EXPECT_EQ(cursor->toString(), "0000000000000000000000000000000000000000000000000000000000000000,0");
+    });
+    ctx.run();
+}
+
 TEST_F(RPCHelpersTest, EncodeCTID)
 {
     auto const ctid = encodeCTID(0x1234, 0x67, 0x89);
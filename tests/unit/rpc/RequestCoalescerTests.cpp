@@ -0,0 +1,187 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "rpc/Errors.hpp"
+#include "rpc/RequestCoalescer.hpp"
+#include "rpc/RequestKey.hpp"
+#include "rpc/common/Types.hpp"
+#include "util/MockPrometheus.hpp"
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/spawn.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/json/object.hpp>
+#include <boost/json/parse.hpp>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <variant>
+#include <vector>
+
+using namespace rpc;
+
+namespace {
+
+constexpr auto SEQ = 30;
+
+boost::json::object
+params(std::string const& json)
+{
+    return boost::json::parse(json).as_object();
+}
+
+}  // namespace
+
+struct RequestCoalescerTest : util::prometheus::WithPrometheus {
+    RequestCoalescer coalescer;
+};
+
+TEST_F(RequestCoalescerTest, KeyIgnoresOrderOfParams)
+{
+    auto const key1 = coalescer.makeKey("account_info", params(R"({"account": "a", "strict": true})"), 2, SEQ);
+    auto const key2 = coalescer.makeKey("account_info", params(R"({"strict": true, "account": "a"})"), 2, SEQ);
+
+    ASSERT_TRUE(key1.has_value());
+    EXPECT_EQ(key1, key2);
+}
+
+TEST_F(RequestCoalescerTest, KeyPinsLatestLedger)
+{
+    auto const implicit = coalescer.makeKey("account_info", params(R"({"account": "a"})"), 2, SEQ);
+    auto const validated =
+        coalescer.makeKey("account_info", params(R"({"account": "a", "ledger_index": "validated"})"), 2, SEQ);
+    auto const explicitSeq =
+        coalescer.makeKey("account_info", params(R"({"account": "a", "ledger_index": 30})"), 2, SEQ);
+
+    ASSERT_TRUE(implicit.has_value());
+    EXPECT_EQ(implicit, validated);
+    EXPECT_EQ(implicit, explicitSeq);
+    EXPECT_NE(implicit, coalescer.makeKey("account_info", params(R"({"account": "a"})"), 2, SEQ + 1));
+}
+
+TEST_F(RequestCoalescerTest, PinsLatestLedgerForExecution)
+{
+    auto const pinned = params(R"({"account": "a", "ledger_index": 30})");
+
+    EXPECT_EQ(pinToLatestLedger(params(R"({"account": "a"})"), SEQ), pinned);
+    EXPECT_EQ(pinToLatestLedger(params(R"({"account": "a", "ledger_index": "validated"})"), SEQ), pinned);
+
+    auto const explicitSeq = params(R"({"account": "a", "ledger_index": 25})");
+    EXPECT_EQ(pinToLatestLedger(explicitSeq, SEQ), explicitSeq);
+
+    auto const byHash = params(R"({"account": "a", "ledger_hash": "ABCD"})");
+    EXPECT_EQ(pinToLatestLedger(byHash, SEQ), byHash);
+}
+
+TEST_F(RequestCoalescerTest, KeyDependsOnMethodAndApiVersion)
+{
+    auto const key = coalescer.makeKey("account_info", params(R"({"account": "a"})"), 2, SEQ);
+
+    EXPECT_NE(key, coalescer.makeKey("account_info", params(R"({"account": "a"})"), 1, SEQ));
+    EXPECT_NE(key, coalescer.makeKey("account_lines", params(R"({"account": "a"})"), 2, SEQ));
+}
+
+TEST_F(RequestCoalescerTest, NoKeyForUnpinnedRequestOrOtherMethods)
+{
+    EXPECT_FALSE(coalescer.makeKey("account_info", params(R"({"ledger_index": "current"})"), 2, SEQ).has_value());
+    EXPECT_FALSE(coalescer.makeKey("account_tx", params(R"({"account": "a"})"), 2, SEQ).has_value());
+    EXPECT_FALSE(coalescer.makeKey("subscribe", params(R"({})"), 2, SEQ).has_value());
+}
+
+TEST_F(RequestCoalescerTest, IdenticalConcurrentRequestsAreExecutedOnce)
+{
+    static constexpr auto NUM_REQUESTS = 5;
+    boost::asio::io_context ctx;
+    auto numExecuted = 0;
+    std::vector<std::optional<Result>> results(NUM_REQUESTS);
+
+    for (auto i = 0; i < NUM_REQUESTS; ++i) {
+        boost::asio::spawn(ctx, [&, i](boost::asio::yield_context yield) {
+            results[i] = coalescer.run("ledger", "key", yield, [&]() {
+                ++numExecuted;
+
+                // let the other requests arrive while this one is executing
+                boost::asio::steady_timer timer{ctx, std::chrono::milliseconds{10}};
+                timer.async_wait(yield);
+                return Result{boost::json::object{{"ledger_index", SEQ}}};
+            });
+        });
+    }
+    ctx.run();
+
+    EXPECT_EQ(numExecuted, 1);
+    for (auto const& result : results) {
+        ASSERT_TRUE(result.has_value());
+        auto const* response = std::get_if<boost::json::object>(&result->response);
+        ASSERT_NE(response, nullptr);
+        EXPECT_EQ(response->at("ledger_index").as_int64(), SEQ);
+    }
+}
+
+TEST_F(RequestCoalescerTest, SequentialRequestsAreExecutedEachTime)
+{
+    boost::asio::io_context ctx;
+    auto numExecuted = 0;
+
+    boost::asio::spawn(ctx, [&](boost::asio::yield_context yield) {
+        for (auto i = 0; i < 3; ++i) {
+            coalescer.run("ledger", "key", yield, [&]() {
+                ++numExecuted;
+                return Result{boost::json::object{}};
+            });
+        }
+    });
+    ctx.run();
+
+    EXPECT_EQ(numExecuted, 3);
+}
+
+TEST_F(RequestCoalescerTest, WaitingRequestsGetInternalErrorWhenExecutionThrows)
+{
+    boost::asio::io_context ctx;
+    std::optional<Result> waiterResult;
+
+    boost::asio::spawn(ctx, [&](boost::asio::yield_context yield) {
+        EXPECT_THROW(
+            coalescer.run(
+                "ledger",
+                "key",
+                yield,
+                [&]() -> Result {
+                    boost::asio::steady_timer timer{ctx, std::chrono::milliseconds{10}};
+                    timer.async_wait(yield);
+                    throw std::runtime_error{"error"};
+                }
+            ),
+            std::runtime_error
+        );
+    });
+    boost::asio::spawn(ctx, [&](boost::asio::yield_context yield) {
+        waiterResult = coalescer.run("ledger", "key", yield, [&]() { return Result{boost::json::object{}}; });
+    });
+    ctx.run();
+
+    ASSERT_TRUE(waiterResult.has_value());
+    auto const* status = std::get_if<Status>(&waiterResult->response);
+    ASSERT_NE(status, nullptr);
+    EXPECT_EQ(*status, Status{RippledError::rpcINTERNAL});
+}
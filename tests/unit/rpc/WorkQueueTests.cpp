@@ -23,15 +23,22 @@
 #include "util/config/Config.hpp"
 #include "util/prometheus/Counter.hpp"
 #include "util/prometheus/Gauge.hpp"
+#include "util/prometheus/Histogram.hpp"
 
 #include <boost/json/parse.hpp>
+#include <fmt/core.h>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <chrono>
 #include <condition_variable>
 #include <cstdint>
 #include <mutex>
 #include <semaphore>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 
 using namespace util;
 using namespace rpc;
@@ -76,6 +83,36 @@ TEST_F(WorkQueueTest, WhitelistedExecutionCountAddsUp)
     EXPECT_EQ(report.at("queued"), TOTAL);
     EXPECT_EQ(report.at("current_queue_size"), 0);
     EXPECT_EQ(report.at("max_queue_size"), 2);
+    EXPECT_EQ(report.at("running"), 0);
+    EXPECT_EQ(report.at("max_running"), 4 * WorkQueue::DEFAULT_MAX_RUNNING_PER_WORKER);
+}
+
+TEST_F(WorkQueueTest, AdaptiveLimitDoesNotCapQueueAtFullLimit)
+{
+    WorkQueue adaptiveQueue{1, 0, 1, std::chrono::milliseconds{0}, true};
+    std::binary_semaphore semaphore{0};
+
+    EXPECT_TRUE(adaptiveQueue.postCoro([&](auto /* yield */) { semaphore.acquire(); }, false));
+    for (auto i = 0; i < 4; ++i)
+        EXPECT_TRUE(adaptiveQueue.postCoro([](auto /* yield */) {}, false));
+
+    semaphore.release();
+    adaptiveQueue.join();
+}
+
+TEST_F(WorkQueueTest, AdaptiveLimitKeepsExplicitMaxSize)
+{
+    WorkQueue adaptiveQueue{1, 3, 1, std::chrono::milliseconds{0}, true};
+    std::binary_semaphore semaphore{0};
+
+    EXPECT_TRUE(adaptiveQueue.postCoro([&](auto /* yield */) { semaphore.acquire(); }, false));
+    EXPECT_TRUE(adaptiveQueue.postCoro([](auto /* yield */) {}, false));
+    EXPECT_TRUE(adaptiveQueue.postCoro([](auto /* yield */) {}, false));
+    EXPECT_FALSE(adaptiveQueue.postCoro([](auto /* yield */) {}, false));
+    EXPECT_TRUE(adaptiveQueue.postCoro([](auto /* yield */) {}, true));
+
+    semaphore.release();
+    adaptiveQueue.join();
 }
 
 TEST_F(WorkQueueTest, NonWhitelistedPreventSchedulingAtQueueLimitExceeded)
@@ -113,6 +150,99 @@ TEST_F(WorkQueueTest, NonWhitelistedPreventSchedulingAtQueueLimitExceeded)
     EXPECT_TRUE(unblocked);
 }
 
+struct WorkQueueSchedulingTest : WithPrometheus, NoLoggerFixture {
+    std::mutex mtx;
+    std::vector<std::string> order;
+    std::binary_semaphore blockerReleased{0};
+
+    auto
+    record(std::string name)
+    {
+        return [this, name = std::move(name)](auto /* yield */) {
+            std::scoped_lock const lck{mtx};
+            order.push_back(name);
+        };
+    }
+
+    auto
+    blocker()
+    {
+        return [this](auto /* yield */) { blockerReleased.acquire(); };
+    }
+};
+
+TEST_F(WorkQueueSchedulingTest, CheapJobsGetMoreTurnsButExpensiveOnesAreNotStarved)
+{
+    WorkQueue queue{1, 0, 1};
+    using enum WorkQueue::Lane;
+
+    EXPECT_TRUE(queue.postCoro(blocker(), WorkQueue::JobInfo{.lane = Cheap}));
+    for (auto i = 1; i <= 3; ++i)
+        EXPECT_TRUE(queue.postCoro(record(fmt::format("E{}", i)), WorkQueue::JobInfo{.lane = Expensive}));
+    for (auto i = 1; i <= 5; ++i)
+        EXPECT_TRUE(queue.postCoro(record(fmt::format("C{}", i)), WorkQueue::JobInfo{.lane = Cheap}));
+
+    blockerReleased.release();
+    queue.join();
+
+    EXPECT_THAT(order, testing::ElementsAre("C1", "C2", "C3", "E1", "C4", "C5", "E2", "E3"));
+}
+
+TEST_F(WorkQueueSchedulingTest, ClientsTakeTurns)
+{
+    WorkQueue queue{1, 0, 1};
+
+    EXPECT_TRUE(queue.postCoro(blocker(), WorkQueue::JobInfo{.client = "blocker"}));
+    for (auto i = 1; i <= 3; ++i)
+        EXPECT_TRUE(queue.postCoro(record(fmt::format("A{}", i)), WorkQueue::JobInfo{.client = "a"}));
+    EXPECT_TRUE(queue.postCoro(record("B1"), WorkQueue::JobInfo{.client = "b"}));
+
+    blockerReleased.release();
+    queue.join();
+
+    EXPECT_THAT(order, testing::ElementsAre("A1", "B1", "A2", "A3"));
+}
+
+TEST_F(WorkQueueSchedulingTest, PrivilegedJobsDontWait)
+{
+    WorkQueue queue{2, 1, 1};
+
+    EXPECT_TRUE(queue.postCoro(blocker(), false));
+    EXPECT_FALSE(queue.postCoro(record("rejected"), false));
+    EXPECT_TRUE(queue.postCoro(
+        [this](auto /* yield */) {
+            {
+                std::scoped_lock const lck{mtx};
+                order.emplace_back("privileged");
+            }
+            blockerReleased.release();
+        },
+        true
+    ));
+
+    queue.join();
+
+    EXPECT_THAT(order, testing::ElementsAre("privileged"));
+}
+
+TEST_F(WorkQueueSchedulingTest, JobWaitingForTooLongExpires)
+{
+    WorkQueue queue{1, 0, 1, std::chrono::milliseconds{1}};
+    testing::StrictMock<testing::MockFunction<void()>> onExpired;
+
+    EXPECT_TRUE(queue.postCoro(blocker(), false));
+    EXPECT_TRUE(queue.postCoro(record("expired"), WorkQueue::JobInfo{.onExpired = onExpired.AsStdFunction()}));
+
+    EXPECT_CALL(onExpired, Call());
+    std::this_thread::sleep_for(std::chrono::milliseconds{10});
+    blockerReleased.release();
+    queue.join();
+
+    EXPECT_TRUE(order.empty());
+    EXPECT_EQ(queue.size(), 0u);
+    EXPECT_EQ(queue.report().at("expired"), 1);
+}
+
 struct WorkQueueStopTest : WorkQueueTest {
     testing::StrictMock<testing::MockFunction<void()>> onTasksComplete;
     testing::StrictMock<testing::MockFunction<void()>> taskMock;
@@ -158,12 +288,18 @@ TEST_F(WorkQueueStopTest, CallsOnTasksCompleteWhenStoppingOnLastTask)
     queue.join();
 }
 
-struct WorkQueueMockPrometheusTest : WithMockPrometheus, WorkQueueTestBase {};
+struct WorkQueueMockPrometheusTest : WithMockPrometheus, NoLoggerFixture {
+    Config cfg = Config{boost::json::parse(JSONConfig)};
+};
 
 TEST_F(WorkQueueMockPrometheusTest, postCoroCouhters)
 {
+    auto& runningLimitMock = makeMock<GaugeInt>("work_queue_running_limit", "");
+    EXPECT_CALL(runningLimitMock, set(4 * WorkQueue::DEFAULT_MAX_RUNNING_PER_WORKER));
+    auto queue = WorkQueue::make_WorkQueue(cfg);
+
     auto& queuedMock = makeMock<CounterInt>("work_queue_queued_total_number", "");
-    auto& durationMock = makeMock<CounterInt>("work_queue_cumulitive_tasks_duration_us", "");
+    auto& waitMock = makeMock<HistogramInt>("work_queue_wait_duration_microseconds_histogram", "{lane=\"cheap\"}");
     auto& curSizeMock = makeMock<GaugeInt>("work_queue_current_size", "");
 
     std::binary_semaphore semaphore{0};
@@ -171,7 +307,7 @@ TEST_F(WorkQueueMockPrometheusTest, postCoroCouhters)
     EXPECT_CALL(curSizeMock, value()).Times(2).WillRepeatedly(::testing::Return(0));
     EXPECT_CALL(curSizeMock, add(1));
     EXPECT_CALL(queuedMock, add(1));
-    EXPECT_CALL(durationMock, add(::testing::Gt(0))).WillOnce([&](auto) {
+    EXPECT_CALL(waitMock, observe(::testing::Ge(0))).WillOnce([&](auto) {
         EXPECT_CALL(curSizeMock, add(-1));
         semaphore.release();
     });
@@ -289,3 +289,11 @@ TEST_P(RpcSpecCheckTests, Check)
         }
     }
 }
+
+TEST_F(SpecsTests, HasField)
+{
+    RpcSpec const spec{{"key1", RequirementMockRef(requirementMock)}, {"key2", CheckMockRef(checkMock)}};
+    EXPECT_TRUE(spec.hasField("key1"));
+    EXPECT_TRUE(spec.hasField("key2"));
+    EXPECT_FALSE(spec.hasField("key3"));
+}
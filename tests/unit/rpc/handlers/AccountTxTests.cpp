@@ -1525,7 +1525,8 @@ TEST_F(RPCAccountTxHandlerTest, NFTTxs_API_v2)
         .Times(1);
 
     auto const ledgerHeader = CreateLedgerHeader(LEDGERHASH, 11);
-    EXPECT_CALL(*backend, fetchLedgerBySequence).Times(transactions.size()).WillRepeatedly(Return(ledgerHeader));
+    // all the transactions belong to the same ledger so its header is fetched once
+    EXPECT_CALL(*backend, fetchLedgerBySequence).Times(1).WillRepeatedly(Return(ledgerHeader));
 
     runSpawn([&, this](auto yield) {
         auto const handler = AnyHandler{AccountTxHandler{backend}};
@@ -1547,6 +1548,40 @@ TEST_F(RPCAccountTxHandlerTest, NFTTxs_API_v2)
     });
 }
 
+TEST_F(RPCAccountTxHandlerTest, TransactionKeysKeepTheirOrder_API_v2)
+{
+    backend->setRange(MINSEQ, MAXSEQ);
+
+    auto const transactions = genNFTTransactions(MINSEQ + 1);
+    auto const transCursor = TransactionsAndCursor{transactions, TransactionsCursor{12, 34}};
+    ON_CALL(*backend, fetchAccountTransactions).WillByDefault(Return(transCursor));
+    EXPECT_CALL(*backend, fetchAccountTransactions).Times(1);
+
+    auto const ledgerHeader = CreateLedgerHeader(LEDGERHASH, 11);
+    EXPECT_CALL(*backend, fetchLedgerBySequence).Times(1).WillRepeatedly(Return(ledgerHeader));
+
+    runSpawn([&, this](auto yield) {
+        auto const handler = AnyHandler{AccountTxHandler{backend}};
+        auto static const input = json::parse(fmt::format(R"({{"account": "{}"}})", ACCOUNT));
+        auto const output = handler.process(input, Context{.yield = yield, .apiVersion = 2u});
+        ASSERT_TRUE(output);
+
+        // the ledger header is fetched after all the transactions are built but its fields are not moved to the end
+        for (auto const& tx : output.result->at("transactions").as_array()) {
+            std::vector<std::string> keys;
+            for (auto const& [key, _] : tx.as_object())
+                keys.emplace_back(key);
+
+            EXPECT_EQ(
+                keys,
+                (std::vector<std::string>{
+                    "meta", "tx_json", "ledger_index", "hash", "ledger_hash", "close_time_iso", "validated"
+                })
+            );
+        }
+    });
+}
+
 struct AccountTxTransactionBundle {
     std::string testName;
     std::string testJson;
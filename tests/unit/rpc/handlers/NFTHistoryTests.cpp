@@ -600,6 +600,40 @@ TEST_F(RPCNFTHistoryHandlerTest, IndexSpecificForwardFalseV2)
     });
 }
 
+TEST_F(RPCNFTHistoryHandlerTest, TransactionKeysKeepTheirOrderV2)
+{
+    backend->setRange(MINSEQ, MAXSEQ);
+
+    auto const transactions = genTransactions(MINSEQ + 1, MAXSEQ - 1);
+    auto const transCursor = TransactionsAndCursor{transactions, TransactionsCursor{12, 34}};
+    EXPECT_CALL(*backend, fetchNFTTransactions).WillOnce(Return(transCursor));
+
+    auto const ledgerHeader = CreateLedgerHeader(LEDGERHASH, MAXSEQ);
+    ON_CALL(*backend, fetchLedgerBySequence).WillByDefault(Return(ledgerHeader));
+    EXPECT_CALL(*backend, fetchLedgerBySequence).Times(2);
+
+    runSpawn([&, this](auto yield) {
+        auto const handler = AnyHandler{NFTHistoryHandler{backend}};
+        auto static const input = json::parse(fmt::format(R"({{"nft_id":"{}"}})", NFTID));
+        auto const output = handler.process(input, Context{.yield = yield, .apiVersion = 2u});
+        ASSERT_TRUE(output);
+
+        // the ledger headers are fetched after all the transactions are built but their fields are not moved to the end
+        for (auto const& tx : output.result->at("transactions").as_array()) {
+            std::vector<std::string> keys;
+            for (auto const& [key, _] : tx.as_object())
+                keys.emplace_back(key);
+
+            EXPECT_EQ(
+                keys,
+                (std::vector<std::string>{
+                    "meta", "tx_json", "ledger_index", "hash", "close_time_iso", "ledger_hash", "validated"
+                })
+            );
+        }
+    });
+}
+
 TEST_F(RPCNFTHistoryHandlerTest, IndexNotSpecificForwardTrue)
 {
     backend->setRange(MINSEQ, MAXSEQ);
@@ -0,0 +1,54 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "util/File.hpp"
+#include "util/TmpFile.hpp"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+TEST(FileTests, ReplaceFileDurablyReplacesFile)
+{
+    TmpFile const from{"new"};
+    TmpFile const to{"old"};
+
+    auto const res = util::replaceFileDurably(from.path, to.path);
+    ASSERT_TRUE(res.has_value()) << res.error();
+
+    EXPECT_FALSE(std::filesystem::exists(from.path));
+
+    std::ifstream file{to.path};
+    std::stringstream content;
+    content << file.rdbuf();
+    EXPECT_EQ(content.str(), "new");
+}
+
+TEST(FileTests, ReplaceFileDurablyFailsWhenFileIsMissing)
+{
+    TmpFile const to{"old"};
+    auto const missing = to.path + ".missing";
+
+    auto const res = util::replaceFileDurably(missing, to.path);
+    ASSERT_FALSE(res.has_value());
+    EXPECT_NE(res.error().find(missing), std::string::npos);
+}
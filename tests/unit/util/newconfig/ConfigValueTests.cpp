@@ -174,9 +174,12 @@ INSTANTIATE_TEST_SUITE_P(
         ConstraintTestBundle{"logLevelConstraint", validateLogLevelName},
         ConstraintTestBundle{"cannsandraNameCnstraint", validateCassandraName},
         ConstraintTestBundle{"loadModeConstraint", validateLoadMode},
+        ConstraintTestBundle{"cacheMemoryModeConstraint", validateCacheMemoryMode},
+        ConstraintTestBundle{"wsOverflowPolicyConstraint", validateWsOverflowPolicy},
         ConstraintTestBundle{"ChannelNameConstraint", validateChannelName},
         ConstraintTestBundle{"ApiVersionConstraint", validateApiVersion},
         ConstraintTestBundle{"Uint16Constraint", validateUint16},
+        ConstraintTestBundle{"PositiveUint16Constraint", validatePositiveUint16},
         ConstraintTestBundle{"Uint32Constraint", validateUint32},
         ConstraintTestBundle{"PositiveDoubleConstraint", validatePositiveDouble}
     ),
@@ -220,4 +223,11 @@ TEST(ConfigValueDeathTest, OutOfBounceIntegerConstraint)
         },
         ".*"
     );
+    EXPECT_DEATH(
+        {
+            [[maybe_unused]] auto a =
+                ConfigValue{ConfigType::Integer}.defaultValue(0).withConstraint(validatePositiveUint16);
+        },
+        ".*"
+    );
 }
@@ -151,6 +151,80 @@ TEST_F(WebRPCServerHandlerTest, WsNormalPath)
     EXPECT_EQ(boost::json::parse(session->message), boost::json::parse(response));
 }
 
+TEST_F(WebRPCServerHandlerTest, HTTPSerializedResultPath)
+{
+    static auto constexpr request = R"({
+                                        "method": "ledger",
+                                        "params": [{"ledger_index": 30}]
+                                    })";
+
+    backend->setRange(MINSEQ, MAXSEQ);
+
+    static auto constexpr response = R"({
+                                        "result": {
+                                            "ledger_index": 30,
+                                            "validated": true,
+                                            "status": "success"
+                                        },
+                                        "warnings": [
+                                            {
+                                                "id": 2001,
+                                                "message": "This is a clio server. clio only serves validated data. If you want to talk to rippled, include 'ledger_index':'current' in your request"
+                                            }
+                                        ]
+                                    })";
+    EXPECT_CALL(*rpcEngine, buildResponse(testing::_))
+        .WillOnce(testing::Return(rpc::Result{
+            std::make_shared<std::string const>(R"({"ledger_index":30,"validated":true})")
+        }));
+    EXPECT_CALL(*rpcEngine, notifyComplete("ledger", testing::_)).Times(1);
+
+    EXPECT_CALL(*etl, lastCloseAgeSeconds()).WillOnce(testing::Return(45));
+
+    (*handler)(request, session);
+    EXPECT_EQ(boost::json::parse(session->message), boost::json::parse(response));
+}
+
+TEST_F(WebRPCServerHandlerTest, WsSerializedResultPath)
+{
+    session->upgraded = true;
+    static auto constexpr request = R"({
+                                        "command": "ledger",
+                                        "ledger_index": 30,
+                                        "id": 99,
+                                        "api_version": 2
+                                    })";
+
+    backend->setRange(MINSEQ, MAXSEQ);
+
+    static auto constexpr response = R"({
+                                        "result": {
+                                            "ledger_index": 30,
+                                            "validated": true
+                                        },
+                                        "id": 99,
+                                        "status": "success",
+                                        "type": "response",
+                                        "api_version": 2,
+                                        "warnings": [
+                                            {
+                                                "id": 2001,
+                                                "message": "This is a clio server. clio only serves validated data. If you want to talk to rippled, include 'ledger_index':'current' in your request"
+                                            }
+                                        ]
+                                    })";
+    EXPECT_CALL(*rpcEngine, buildResponse(testing::_))
+        .WillOnce(testing::Return(rpc::Result{
+            std::make_shared<std::string const>(R"({"ledger_index":30,"validated":true})")
+        }));
+    EXPECT_CALL(*rpcEngine, notifyComplete("ledger", testing::_)).Times(1);
+
+    EXPECT_CALL(*etl, lastCloseAgeSeconds()).WillOnce(testing::Return(45));
+
+    (*handler)(request, session);
+    EXPECT_EQ(boost::json::parse(session->message), boost::json::parse(response));
+}
+
 TEST_F(WebRPCServerHandlerTest, HTTPForwardedPath)
 {
     static auto constexpr request = R"({
@@ -39,6 +39,7 @@
 #include <boost/beast/http/field.hpp>
 #include <boost/beast/http/status.hpp>
 #include <boost/beast/websocket/error.hpp>
+#include <boost/json/object.hpp>
 #include <boost/json/parse.hpp>
 #include <boost/json/value.hpp>
 #include <boost/system/system_error.hpp>
@@ -46,7 +47,9 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <chrono>
 #include <condition_variable>
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <mutex>
@@ -421,6 +424,149 @@ TEST_F(WebServerTestsWithMockPrometheus, WsTooManyConnection)
     EXPECT_TRUE(exceptionThrown);
 }
 
+namespace {
+
+boost::json::value
+addWsSettings(boost::json::value config, boost::json::object const& settings)
+{
+    for (auto const& [key, value] : settings)
+        config.as_object()["server"].as_object()[key] = value;
+    return config;
+}
+
+class FeedExecutor {
+public:
+    static constexpr auto NUM_FEED_MESSAGES = 5;
+
+    void
+    operator()(std::string const& reqStr, std::shared_ptr<web::ConnectionBase> const& ws)
+    {
+        for (auto i = 1; i <= NUM_FEED_MESSAGES; ++i)
+            ws->send(std::make_shared<std::string>(std::to_string(i)));
+        ws->send(std::string(reqStr), http::status::ok);
+    }
+
+    void
+    operator()(boost::beast::error_code /* ec */, std::shared_ptr<web::ConnectionBase> const& /* ws */)
+    {
+    }
+};
+
+class DeferredExecutor {
+    std::mutex mtx_;
+    std::condition_variable cv_;
+    std::vector<std::pair<std::string, std::shared_ptr<web::ConnectionBase>>> requests_;
+
+public:
+    void
+    operator()(std::string const& reqStr, std::shared_ptr<web::ConnectionBase> const& ws)
+    {
+        {
+            std::scoped_lock const lk{mtx_};
+            requests_.emplace_back(reqStr, ws);
+        }
+        cv_.notify_all();
+    }
+
+    void
+    operator()(boost::beast::error_code /* ec */, std::shared_ptr<web::ConnectionBase> const& /* ws */)
+    {
+    }
+
+    bool
+    waitForRequests(std::size_t count, std::chrono::milliseconds timeout)
+    {
+        std::unique_lock lk{mtx_};
+        return cv_.wait_for(lk, timeout, [&] { return requests_.size() >= count; });
+    }
+
+    void
+    reply(std::size_t index)
+    {
+        std::unique_lock lk{mtx_};
+        auto [request, ws] = requests_.at(index);
+        lk.unlock();
+
+        ws->send(std::move(request), http::status::ok);
+    }
+};
+
+}  // namespace
+
+TEST_F(WebServerTest, WsStopsReadingWhenTooManyRequestsInFlight)
+{
+    Config const config{addWsSettings(generateJSONWithDynamicPort(port), {{"ws_max_requests_in_flight", 1}})};
+    auto e = std::make_shared<DeferredExecutor>();
+    auto const server = makeServerSync(config, ctx, dosGuard, e);
+    WebSocketSyncClient wsClient;
+    wsClient.connect("localhost", port);
+    wsClient.write(R"({"id":1})");
+    wsClient.write(R"({"id":2})");
+
+    ASSERT_TRUE(e->waitForRequests(1, std::chrono::seconds{5}));
+    EXPECT_FALSE(e->waitForRequests(2, std::chrono::milliseconds{100}));
+
+    e->reply(0);
+    EXPECT_EQ(wsClient.read(), R"({"id":1})");
+
+    ASSERT_TRUE(e->waitForRequests(2, std::chrono::seconds{5}));
+    e->reply(1);
+    EXPECT_EQ(wsClient.read(), R"({"id":2})");
+    wsClient.disconnect();
+}
+
+TEST_F(WebServerTestsWithMockPrometheus, WsSendingQueueOverflowDropsOldestFeedMessages)
+{
+    ::testing::StrictMock<util::prometheus::MockCounterImplInt>& wsMessagesCounterMock =
+        makeMock<util::prometheus::GaugeInt>("ws_messages_length", "");
+    ::testing::StrictMock<util::prometheus::MockCounterImplInt>& wsDroppedMessagesMock =
+        makeMock<util::prometheus::CounterInt>("ws_dropped_messages_total_number", "");
+
+    // the first message is being written while the others are queued so each following feed message pushes out the
+    // one queued before it; responses are never dropped so the last feed message is dropped in favour of the response
+    EXPECT_CALL(wsMessagesCounterMock, add(1)).Times(FeedExecutor::NUM_FEED_MESSAGES + 1);
+    EXPECT_CALL(wsMessagesCounterMock, add(-1)).Times(FeedExecutor::NUM_FEED_MESSAGES + 1);
+    EXPECT_CALL(wsDroppedMessagesMock, add(1)).Times(FeedExecutor::NUM_FEED_MESSAGES - 1);
+
+    Config const config{addWsSettings(generateJSONWithDynamicPort(port), {{"ws_max_sending_queue_size", 2}})};
+    auto e = std::make_shared<FeedExecutor>();
+    auto const server = makeServerSync(config, ctx, dosGuard, e);
+    WebSocketSyncClient wsClient;
+    wsClient.connect("localhost", port);
+    wsClient.write(R"({"Hello":1})");
+    EXPECT_EQ(wsClient.read(), "1");
+    EXPECT_EQ(wsClient.read(), R"({"Hello":1})");
+    wsClient.disconnect();
+}
+
+TEST_F(WebServerTest, WsSendingQueueOverflowDisconnects)
+{
+    Config const config{addWsSettings(
+        generateJSONWithDynamicPort(port), {{"ws_max_sending_queue_size", 2}, {"ws_queue_overflow", "disconnect"}}
+    )};
+    auto e = std::make_shared<FeedExecutor>();
+    auto const server = makeServerSync(config, ctx, dosGuard, e);
+    WebSocketSyncClient wsClient;
+    wsClient.connect("localhost", port);
+    wsClient.write(R"({"Hello":1})");
+
+    // at most the message that was being written can arrive before the connection is closed
+    EXPECT_THROW(
+        {
+            for (auto i = 0; i <= FeedExecutor::NUM_FEED_MESSAGES; ++i)
+                wsClient.read();
+        },
+        boost::system::system_error
+    );
+}
+
+TEST_F(WebServerTest, WsInvalidQueueOverflowPolicy)
+{
+    Config const config{addWsSettings(generateJSONWithDynamicPort(port), {{"ws_queue_overflow", "drop_newest"}})};
+    auto e = std::make_shared<EchoExecutor>();
+    EXPECT_THROW(web::make_HttpServer(config, ctx, dosGuard, e), std::logic_error);
+}
+
 std::string
 JSONServerConfigWithAdminPassword(uint32_t const port)
 {
@@ -22,10 +22,12 @@
 #include "web/dosguard/DOSGuard.hpp"
 #include "web/dosguard/WhitelistHandlerInterface.hpp"
 
+#include <boost/asio/ip/address.hpp>
 #include <boost/json/parse.hpp>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <chrono>
 #include <string_view>
 
 using namespace testing;
@@ -41,6 +43,7 @@ struct DOSGuardTest : NoLoggerFixture {
             "max_fetches": 100,
             "max_connections": 2,
             "max_requests": 3,
+            "sweep_interval": 0.05,
             "whitelist": [
                 "127.0.0.1"
             ]
@@ -49,24 +52,39 @@ struct DOSGuardTest : NoLoggerFixture {
 )JSON";
 
     static constexpr auto IP = "127.0.0.2";
+    static constexpr std::chrono::milliseconds REFILL_INTERVAL{50};
 
     struct MockWhitelistHandler : WhitelistHandlerInterface {
         MOCK_METHOD(bool, isWhiteListed, (std::string_view ip), (const));
+        MOCK_METHOD(bool, isWhiteListed, (boost::asio::ip::address const& ip), (const));
     };
 
     Config cfg{json::parse(JSONData)};
     NiceMock<MockWhitelistHandler> whitelistHandler;
-    DOSGuard guard{cfg, whitelistHandler};
+    std::chrono::steady_clock::time_point now{std::chrono::hours{1}};
+    DOSGuard guard{cfg, whitelistHandler, [this] { return now; }};
 };
 
 TEST_F(DOSGuardTest, Whitelisting)
 {
-    EXPECT_CALL(whitelistHandler, isWhiteListed("127.0.0.1")).Times(1).WillOnce(Return(false));
+    EXPECT_CALL(whitelistHandler, isWhiteListed(Matcher<std::string_view>("127.0.0.1"))).WillOnce(Return(false));
     EXPECT_FALSE(guard.isWhiteListed("127.0.0.1"));
-    EXPECT_CALL(whitelistHandler, isWhiteListed("127.0.0.1")).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(whitelistHandler, isWhiteListed(Matcher<std::string_view>("127.0.0.1"))).WillOnce(Return(true));
     EXPECT_TRUE(guard.isWhiteListed("127.0.0.1"));
 }
 
+TEST_F(DOSGuardTest, WhitelistedIpIsNotLimited)
+{
+    auto const whitelisted = boost::asio::ip::make_address("127.0.0.1");
+    EXPECT_CALL(whitelistHandler, isWhiteListed(whitelisted)).WillRepeatedly(Return(true));
+    EXPECT_CALL(whitelistHandler, isWhiteListed(Matcher<std::string_view>(_))).Times(0);
+
+    for (auto i = 0; i < 10; ++i)
+        EXPECT_TRUE(guard.request("127.0.0.1"));
+    EXPECT_TRUE(guard.add("127.0.0.1", 1'000));
+    EXPECT_TRUE(guard.isOk("127.0.0.1"));
+}
+
 TEST_F(DOSGuardTest, ConnectionCount)
 {
     EXPECT_TRUE(guard.isOk(IP));
@@ -88,21 +106,34 @@ TEST_F(DOSGuardTest, FetchCount)
     EXPECT_FALSE(guard.add(IP, 1));  // can't add even 1 anymore
     EXPECT_FALSE(guard.isOk(IP));
 
-    guard.clear();                // force clear the above fetch count
+    now += REFILL_INTERVAL;       // the allowance is refilled over time
     EXPECT_TRUE(guard.isOk(IP));  // can fetch again
 }
 
-TEST_F(DOSGuardTest, ClearFetchCountOnTimer)
+TEST_F(DOSGuardTest, ClearDoesNotResetLimits)
 {
     EXPECT_TRUE(guard.add(IP, 50));  // half of allowence
     EXPECT_TRUE(guard.add(IP, 50));  // now fully charged
     EXPECT_FALSE(guard.add(IP, 1));  // can't add even 1 anymore
     EXPECT_FALSE(guard.isOk(IP));
 
-    guard.clear();                // pretend sweep called from timer
+    guard.clear();                 // pretend sweep called from timer
+    EXPECT_FALSE(guard.isOk(IP));  // the client is still limited
+
+    now += REFILL_INTERVAL;
+    guard.clear();
     EXPECT_TRUE(guard.isOk(IP));  // can fetch again
 }
 
+TEST_F(DOSGuardTest, DebtIsLimitedToOneInterval)
+{
+    EXPECT_FALSE(guard.add(IP, 10'000));
+    EXPECT_FALSE(guard.isOk(IP));
+
+    now += 2 * REFILL_INTERVAL;
+    EXPECT_TRUE(guard.isOk(IP));
+}
+
 TEST_F(DOSGuardTest, RequestLimit)
 {
     EXPECT_TRUE(guard.request(IP));
@@ -111,18 +142,27 @@ TEST_F(DOSGuardTest, RequestLimit)
     EXPECT_TRUE(guard.isOk(IP));
     EXPECT_FALSE(guard.request(IP));
     EXPECT_FALSE(guard.isOk(IP));
-    guard.clear();
+
+    now += REFILL_INTERVAL;
     EXPECT_TRUE(guard.isOk(IP));  // can request again
 }
 
-TEST_F(DOSGuardTest, RequestLimitOnTimer)
+TEST_F(DOSGuardTest, RequestLimitIsSharedByIpv4AndMappedIpv6)
 {
     EXPECT_TRUE(guard.request(IP));
+    EXPECT_TRUE(guard.request("::ffff:127.0.0.2"));
     EXPECT_TRUE(guard.request(IP));
-    EXPECT_TRUE(guard.request(IP));
-    EXPECT_TRUE(guard.isOk(IP));
-    EXPECT_FALSE(guard.request(IP));
+    EXPECT_FALSE(guard.request("::ffff:127.0.0.2"));
     EXPECT_FALSE(guard.isOk(IP));
-    guard.clear();
-    EXPECT_TRUE(guard.isOk(IP));  // can request again
+    EXPECT_TRUE(guard.isOk("127.0.0.3"));
+}
+
+TEST_F(DOSGuardTest, NotAnAddressIsLimitedToo)
+{
+    static constexpr auto NOT_IP = "not_an_ip";
+    EXPECT_TRUE(guard.request(NOT_IP));
+    EXPECT_TRUE(guard.request(NOT_IP));
+    EXPECT_TRUE(guard.request(NOT_IP));
+    EXPECT_FALSE(guard.request(NOT_IP));
+    EXPECT_TRUE(guard.isOk(IP));
 }
@@ -20,10 +20,13 @@
 #include "util/config/Config.hpp"
 #include "web/dosguard/WhitelistHandler.hpp"
 
+#include <boost/asio/ip/address.hpp>
 #include <boost/json/parse.hpp>
+#include <fmt/core.h>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <stdexcept>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -109,3 +112,68 @@ TEST_F(WhitelistHandlerTest, TestWhiteListIPV6)
     EXPECT_TRUE(whitelistHandler.isWhiteListed("2001:0db8:85a3:0000:0000:8a2e:0000:0000"));
     EXPECT_TRUE(whitelistHandler.isWhiteListed("2001:0db8:85a3:0000:1111:8a2e:0370:7334"));
 }
+
+TEST_F(WhitelistHandlerTest, TestWhiteListWholeNetwork)
+{
+    Whitelist whitelist;
+    whitelist.add("192.168.0.1/22");
+    whitelist.add("2001:0db8:85a3:0000:0000:8a2e:0000:0000/48");
+
+    EXPECT_TRUE(whitelist.isWhiteListed("192.168.0.0"));
+    EXPECT_TRUE(whitelist.isWhiteListed("192.168.3.255"));
+    EXPECT_FALSE(whitelist.isWhiteListed("192.168.4.0"));
+    EXPECT_FALSE(whitelist.isWhiteListed("192.167.255.255"));
+    EXPECT_TRUE(whitelist.isWhiteListed("2001:db8:85a3::"));
+    EXPECT_TRUE(whitelist.isWhiteListed("2001:db8:85a3:ffff:ffff:ffff:ffff:ffff"));
+    EXPECT_FALSE(whitelist.isWhiteListed("2001:db8:85a4::"));
+}
+
+TEST_F(WhitelistHandlerTest, TestWhiteListIPV4MappedToIPV6)
+{
+    Whitelist whitelist;
+    whitelist.add("10.0.0.0/8");
+    whitelist.add("::ffff:127.0.0.1");
+
+    EXPECT_TRUE(whitelist.isWhiteListed("::ffff:10.1.2.3"));
+    EXPECT_FALSE(whitelist.isWhiteListed("::ffff:11.1.2.3"));
+    EXPECT_TRUE(whitelist.isWhiteListed("127.0.0.1"));
+    EXPECT_FALSE(whitelist.isWhiteListed("::a01:203"));
+}
+
+TEST_F(WhitelistHandlerTest, TestWhiteListOverlappingNetworks)
+{
+    Whitelist whitelist;
+    whitelist.add("10.1.2.3");
+    whitelist.add("10.1.0.0/16");
+    whitelist.add("10.0.0.0/8");
+    whitelist.add("10.2.0.0/16");
+
+    EXPECT_TRUE(whitelist.isWhiteListed("10.1.2.3"));
+    EXPECT_TRUE(whitelist.isWhiteListed("10.1.2.4"));
+    EXPECT_TRUE(whitelist.isWhiteListed("10.200.0.1"));
+    EXPECT_FALSE(whitelist.isWhiteListed("11.0.0.1"));
+}
+
+TEST_F(WhitelistHandlerTest, TestWhiteListManyNetworks)
+{
+    Whitelist whitelist;
+    for (auto i = 0; i < 256; ++i) {
+        for (auto j = 0; j < 16; ++j)
+            whitelist.add(fmt::format("{}.{}.0.0/24", i, j * 16));
+    }
+
+    EXPECT_TRUE(whitelist.isWhiteListed("17.32.0.255"));
+    EXPECT_FALSE(whitelist.isWhiteListed("17.32.1.0"));
+    EXPECT_FALSE(whitelist.isWhiteListed("17.33.0.1"));
+    EXPECT_TRUE(whitelist.isWhiteListed(boost::asio::ip::make_address("255.240.0.1")));
+}
+
+TEST_F(WhitelistHandlerTest, TestWhiteListInvalidInput)
+{
+    Whitelist whitelist;
+    whitelist.add("10.0.0.0/8");
+
+    EXPECT_FALSE(whitelist.isWhiteListed("not_an_ip"));
+    EXPECT_FALSE(whitelist.isWhiteListed(""));
+    EXPECT_THROW(whitelist.add("10.0.0.0/8/8"), std::runtime_error);
+}